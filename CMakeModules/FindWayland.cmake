@@ -16,6 +16,7 @@
 #    Wayland_cursor_LIBRARY
 #    Wayland_SCANNER
 #    Wayland_PROTOCOLS_DIR
+#    Wayland_DATA_DIR
 #
 
 
@@ -40,6 +41,14 @@ if(PKG_CONFIG_FOUND AND Wayland_PROTOCOLS_FOUND)
 endif()
 set(Wayland_PROTOCOLS_DIR "${Wayland_PROTOCOLS_DIR}" CACHE PATH "Wayland protocols directory.")
 
+# Wayland data directory
+# (it contains wayland.xml core protocol description)
+pkg_check_modules(Wayland_SCANNER_PC wayland-scanner QUIET)
+if(PKG_CONFIG_FOUND AND Wayland_SCANNER_PC_FOUND)
+	pkg_get_variable(Wayland_DATA_DIR wayland-scanner pkgdatadir)
+endif()
+set(Wayland_DATA_DIR "${Wayland_DATA_DIR}" CACHE PATH "Wayland data directory containing wayland.xml.")
+
 # handle required variables and set ${CMAKE_FIND_PACKAGE_NAME}_FOUND variable
 include(FindPackageHandleStandardArgs)
 if(Wayland_client_INCLUDE_DIR OR NOT Wayland_server_INCLUDE_DIR)
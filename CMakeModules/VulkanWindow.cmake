@@ -21,14 +21,14 @@ macro(VulkanWindowConfigure APP_SOURCES APP_INCLUDES libs defines includes)
 				endif()
 			endif()
 		endif()
-		set(GUI_TYPE ${guiTypeDetected} CACHE STRING "Gui type. Accepted values: default, Win32, Xlib, Wayland, SDL3, SDL2, GLFW, Qt6 and Qt5." FORCE)
+		set(GUI_TYPE ${guiTypeDetected} CACHE STRING "Gui type. Accepted values: default, Win32, Xlib, Wayland, WaylandXlib, SDL3, SDL2, GLFW, Qt6, Qt5 and Display." FORCE)
 
 	endif()
 
 	# give error on invalid GUI_TYPE
-	set(guiList "Win32" "Xlib" "Wayland" "SDL3" "SDL2" "GLFW" "Qt6" "Qt5")
+	set(guiList "Win32" "Xlib" "Wayland" "WaylandXlib" "SDL3" "SDL2" "GLFW" "Qt6" "Qt5" "Display")
 	if(NOT GUI_TYPE IN_LIST guiList)
-		message(FATAL_ERROR "GUI_TYPE value is invalid. It must be set to default, Win32, Xlib, Wayland, SDL3, SDL2, GLFW, Qt6 or Qt5.")
+		message(FATAL_ERROR "GUI_TYPE value is invalid. It must be set to default, Win32, Xlib, Wayland, WaylandXlib, SDL3, SDL2, GLFW, Qt6, Qt5 or Display.")
 	endif()
 
 	# provide a list of valid values in CMake GUI
@@ -44,12 +44,14 @@ macro(VulkanWindowConfigure APP_SOURCES APP_INCLUDES libs defines includes)
 
 		# configure for Xlib
 		find_package(X11 REQUIRED)
-		set(${libs} ${${libs}} X11 xkbcommon)
+		set(${libs} ${${libs}} X11 ${CMAKE_DL_LIBS})  # libxkbcommon is loaded by dlopen()
 		set(${defines} ${${defines}} USE_PLATFORM_XLIB)
 
-	elseif("${GUI_TYPE}" STREQUAL "Wayland")
+	elseif("${GUI_TYPE}" STREQUAL "Wayland" OR "${GUI_TYPE}" STREQUAL "WaylandXlib")
 
 		# configure for Wayland
+		# (WaylandXlib builds both backends into the binary and selects one of them in VulkanWindow::init();
+		# libwayland-client, libwayland-cursor and libX11 are not linked but loaded by dlopen())
 		find_package(Wayland REQUIRED)
 
 		if(Wayland_client_FOUND AND Wayland_SCANNER AND Wayland_PROTOCOLS_DIR)
@@ -62,11 +64,39 @@ macro(VulkanWindowConfigure APP_SOURCES APP_INCLUDES libs defines includes)
 			                   COMMAND ${Wayland_SCANNER} client-header ${Wayland_PROTOCOLS_DIR}/unstable/xdg-decoration/xdg-decoration-unstable-v1.xml xdg-decoration-client-protocol.h)
 			add_custom_command(OUTPUT xdg-decoration-protocol.c
 			                   COMMAND ${Wayland_SCANNER} private-code  ${Wayland_PROTOCOLS_DIR}/unstable/xdg-decoration/xdg-decoration-unstable-v1.xml xdg-decoration-protocol.c)
+			add_custom_command(OUTPUT single-pixel-buffer-v1-client-protocol.h
+			                   COMMAND ${Wayland_SCANNER} client-header ${Wayland_PROTOCOLS_DIR}/staging/single-pixel-buffer/single-pixel-buffer-v1.xml single-pixel-buffer-v1-client-protocol.h)
+			add_custom_command(OUTPUT single-pixel-buffer-v1-protocol.c
+			                   COMMAND ${Wayland_SCANNER} private-code  ${Wayland_PROTOCOLS_DIR}/staging/single-pixel-buffer/single-pixel-buffer-v1.xml single-pixel-buffer-v1-protocol.c)
+			add_custom_command(OUTPUT viewporter-client-protocol.h
+			                   COMMAND ${Wayland_SCANNER} client-header ${Wayland_PROTOCOLS_DIR}/stable/viewporter/viewporter.xml viewporter-client-protocol.h)
+			add_custom_command(OUTPUT viewporter-protocol.c
+			                   COMMAND ${Wayland_SCANNER} private-code  ${Wayland_PROTOCOLS_DIR}/stable/viewporter/viewporter.xml viewporter-protocol.c)
+
+			list(APPEND ${APP_SOURCES}  xdg-shell-protocol.c        xdg-decoration-protocol.c
+			                            single-pixel-buffer-v1-protocol.c        viewporter-protocol.c)
+			list(APPEND ${APP_INCLUDES} xdg-shell-client-protocol.h xdg-decoration-client-protocol.h
+			                            single-pixel-buffer-v1-client-protocol.h viewporter-client-protocol.h)
+			if("${GUI_TYPE}" STREQUAL "Wayland")
+				set(${libs} ${${libs}} Wayland::client Wayland::cursor -lrt ${CMAKE_DL_LIBS})  # libxkbcommon and libdecor are loaded by dlopen()
+				set(${defines} ${${defines}} USE_PLATFORM_WAYLAND)
+			else()
+
+				# core protocol interfaces
+				# (they are otherwise provided by libwayland-client)
+				if(NOT Wayland_DATA_DIR)
+					message(FATAL_ERROR "Wayland_DATA_DIR containing wayland.xml was not detected.")
+				endif()
+				add_custom_command(OUTPUT wayland-protocol.c
+				                   COMMAND ${Wayland_SCANNER} private-code  ${Wayland_DATA_DIR}/wayland.xml wayland-protocol.c)
+				list(APPEND ${APP_SOURCES} wayland-protocol.c)
+
+				find_package(X11 REQUIRED)
+				set(${includes} ${${includes}} ${Wayland_client_INCLUDE_DIR} ${Wayland_cursor_INCLUDE_DIR} ${X11_INCLUDE_DIR})
+				set(${libs} ${${libs}} -lrt ${CMAKE_DL_LIBS})  # all Wayland and X11 libraries are loaded by dlopen()
+				set(${defines} ${${defines}} USE_PLATFORM_WAYLAND USE_PLATFORM_XLIB)
 
-			list(APPEND ${APP_SOURCES}  xdg-shell-protocol.c        xdg-decoration-protocol.c)
-			list(APPEND ${APP_INCLUDES} xdg-shell-client-protocol.h xdg-decoration-client-protocol.h)
-			set(${libs} ${${libs}} Wayland::client Wayland::cursor -lrt -l:libxkbcommon.so.0)
-			set(${defines} ${${defines}} USE_PLATFORM_WAYLAND)
+			endif()
 
 		else()
 			message(FATAL_ERROR "Not all Wayland variables were detected properly.")
@@ -114,6 +144,16 @@ macro(VulkanWindowConfigure APP_SOURCES APP_INCLUDES libs defines includes)
 			set(QT5_WINDEPLOYQT_EXECUTABLE "${_qt_bin_dir}/windeployqt.exe")
 		endif()
 
+	elseif("${GUI_TYPE}" STREQUAL "Display")
+
+		# configure for direct rendering to display using VK_KHR_display
+		# (no windowing system is used; input is read from evdev devices)
+		if(NOT UNIX OR APPLE)
+			message(FATAL_ERROR "Display GUI_TYPE is supported on Linux only.")
+		endif()
+		set(${libs} ${${libs}} ${CMAKE_DL_LIBS})  # libxkbcommon is loaded by dlopen()
+		set(${defines} ${${defines}} USE_PLATFORM_DISPLAY)
+
 	else()
 		message(FATAL_ERROR "Invalid GUI_TYPE value: ${GUI_TYPE}")
 	endif()
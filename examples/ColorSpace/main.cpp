@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: MIT-0
 
 #include "VulkanWindow.h"
+#include "VulkanWindowPipeline.h"
 #include <vulkan/vulkan.hpp>
 #include <algorithm>
 #include <chrono>
@@ -64,6 +65,7 @@ public:
 	vk::ShaderModule vsModule;
 	vk::ShaderModule fsModule;
 	vk::PipelineLayout pipelineLayout;
+	VulkanWindowPipelineCache pipelineCache;
 	vk::Pipeline pipeline;
 
 };
@@ -102,6 +104,7 @@ App::~App()
 		// destroy handles
 		// (the handles are destructed in certain (not arbitrary) order)
 		device.destroy(pipeline);
+		pipelineCache.cleanUp();
 		device.destroy(pipelineLayout);
 		device.destroy(fsModule);
 		device.destroy(vsModule);
@@ -631,10 +634,27 @@ void App::init()
 				nullptr  // pPushConstantRanges
 			}
 		);
+
+	// pipeline cache
+	// (it is stored on disk to speed up the next application start)
+	pipelineCache.init(physicalDevice, device, string(appName) + ".pipelineCache");
+
+	// pipeline
+	// (viewport and scissor are dynamic, so the pipeline is not recreated on resize)
+	pipeline =
+		VulkanWindowPipeline::createSimple(
+			device,  // device
+			pipelineCache.get(),  // pipelineCache
+			pipelineLayout,  // pipelineLayout
+			renderPass,  // renderPass
+			vsModule,  // vsModule
+			fsModule,  // fsModule
+			vk::PrimitiveTopology::eTriangleFan  // topology
+		);
 }
 
 
-/** Recreate swapchain and pipeline callback.
+/** Recreate swapchain callback.
  *  The function is usually called after the window resize and on the application start. */
 void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 {
@@ -679,8 +699,6 @@ void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 	swapchainImageViews.clear();
 	for(auto f : framebuffers)  device.destroy(f);
 	framebuffers.clear();
-	device.destroy(pipeline);
-	pipeline = nullptr;
 
 	// print info
 	cout << "Recreating swapchain (extent: " << newSurfaceExtent.width << "x" << newSurfaceExtent.height
@@ -769,124 +787,6 @@ void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 			renderingFinishedSemaphores.emplace_back(
 				device.createSemaphore(semaphoreCreateInfo));
 	}
-
-	// pipeline
-	pipeline =
-		device.createGraphicsPipeline(
-			nullptr,  // pipelineCache
-			vk::GraphicsPipelineCreateInfo(
-				vk::PipelineCreateFlags(),  // flags
-
-				// shader stages
-				2,  // stageCount
-				array{  // pStages
-					vk::PipelineShaderStageCreateInfo{
-						vk::PipelineShaderStageCreateFlags(),  // flags
-						vk::ShaderStageFlagBits::eVertex,  // stage
-						vsModule,  // module
-						"main",  // pName
-						nullptr  // pSpecializationInfo
-					},
-					vk::PipelineShaderStageCreateInfo{
-						vk::PipelineShaderStageCreateFlags(),  // flags
-						vk::ShaderStageFlagBits::eFragment,  // stage
-						fsModule,  // module
-						"main",  // pName
-						nullptr  // pSpecializationInfo
-					},
-				}.data(),
-
-				// vertex input
-				&(const vk::PipelineVertexInputStateCreateInfo&)vk::PipelineVertexInputStateCreateInfo{  // pVertexInputState
-					vk::PipelineVertexInputStateCreateFlags(),  // flags
-					0,        // vertexBindingDescriptionCount
-					nullptr,  // pVertexBindingDescriptions
-					0,        // vertexAttributeDescriptionCount
-					nullptr   // pVertexAttributeDescriptions
-				},
-
-				// input assembly
-				&(const vk::PipelineInputAssemblyStateCreateInfo&)vk::PipelineInputAssemblyStateCreateInfo{  // pInputAssemblyState
-					vk::PipelineInputAssemblyStateCreateFlags(),  // flags
-					vk::PrimitiveTopology::eTriangleFan,  // topology
-					VK_FALSE  // primitiveRestartEnable
-				},
-
-				// tessellation
-				nullptr, // pTessellationState
-
-				// viewport
-				&(const vk::PipelineViewportStateCreateInfo&)vk::PipelineViewportStateCreateInfo{  // pViewportState
-					vk::PipelineViewportStateCreateFlags(),  // flags
-					1,  // viewportCount
-					array{  // pViewports
-						vk::Viewport(0.f, 0.f, float(newSurfaceExtent.width), float(newSurfaceExtent.height), 0.f, 1.f),
-					}.data(),
-					1,  // scissorCount
-					array{  // pScissors
-						vk::Rect2D(vk::Offset2D(0,0), newSurfaceExtent)
-					}.data(),
-				},
-
-				// rasterization
-				&(const vk::PipelineRasterizationStateCreateInfo&)vk::PipelineRasterizationStateCreateInfo{  // pRasterizationState
-					vk::PipelineRasterizationStateCreateFlags(),  // flags
-					VK_FALSE,  // depthClampEnable
-					VK_FALSE,  // rasterizerDiscardEnable
-					vk::PolygonMode::eFill,  // polygonMode
-					vk::CullModeFlagBits::eNone,  // cullMode
-					vk::FrontFace::eCounterClockwise,  // frontFace
-					VK_FALSE,  // depthBiasEnable
-					0.f,  // depthBiasConstantFactor
-					0.f,  // depthBiasClamp
-					0.f,  // depthBiasSlopeFactor
-					1.f   // lineWidth
-				},
-
-				// multisampling
-				&(const vk::PipelineMultisampleStateCreateInfo&)vk::PipelineMultisampleStateCreateInfo{  // pMultisampleState
-					vk::PipelineMultisampleStateCreateFlags(),  // flags
-					vk::SampleCountFlagBits::e1,  // rasterizationSamples
-					VK_FALSE,  // sampleShadingEnable
-					0.f,       // minSampleShading
-					nullptr,   // pSampleMask
-					VK_FALSE,  // alphaToCoverageEnable
-					VK_FALSE   // alphaToOneEnable
-				},
-
-				// depth and stencil
-				nullptr,  // pDepthStencilState
-
-				// blending
-				&(const vk::PipelineColorBlendStateCreateInfo&)vk::PipelineColorBlendStateCreateInfo{  // pColorBlendState
-					vk::PipelineColorBlendStateCreateFlags(),  // flags
-					VK_FALSE,  // logicOpEnable
-					vk::LogicOp::eClear,  // logicOp
-					1,  // attachmentCount
-					array{  // pAttachments
-						vk::PipelineColorBlendAttachmentState{
-							VK_FALSE,  // blendEnable
-							vk::BlendFactor::eZero,  // srcColorBlendFactor
-							vk::BlendFactor::eZero,  // dstColorBlendFactor
-							vk::BlendOp::eAdd,       // colorBlendOp
-							vk::BlendFactor::eZero,  // srcAlphaBlendFactor
-							vk::BlendFactor::eZero,  // dstAlphaBlendFactor
-							vk::BlendOp::eAdd,       // alphaBlendOp
-							vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
-								vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA  // colorWriteMask
-						},
-					}.data(),
-					array<float,4>{0.f,0.f,0.f,0.f}  // blendConstants
-				},
-
-				nullptr,  // pDynamicState
-				pipelineLayout,  // layout
-				renderPass,  // renderPass
-				0,  // subpass
-				vk::Pipeline(nullptr),  // basePipelineHandle
-				-1 // basePipelineIndex
-			)
-		).value;
 }
 
 
@@ -954,6 +854,8 @@ void App::frame(VulkanWindow&)
 
 	// rendering commands
 	commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);  // bind pipeline
+	VulkanWindowPipeline::setViewportAndScissor(  // set dynamic viewport and scissor
+		commandBuffer, vk::Extent2D(window.surfaceWidth(), window.surfaceHeight()));
 	commandBuffer.draw(  // draw single triangle
 		444,  // vertexCount
 		1,  // instanceCount
@@ -0,0 +1,391 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#include "CpuRenderer.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+# define CPU_RENDERER_X86
+# include <immintrin.h>
+# if defined(_MSC_VER)
+#  include <intrin.h>
+# endif
+# if defined(_MSC_VER) && !defined(__clang__)
+   // MSVC allows intrinsics of any instruction set without compiler switches
+#  define TARGET_SSE2
+#  define TARGET_AVX2
+#  define TARGET_AVX512
+# else
+#  define TARGET_SSE2 __attribute__((target("sse2")))
+#  define TARGET_AVX2 __attribute__((target("avx2")))
+#  define TARGET_AVX512 __attribute__((target("avx512f")))
+# endif
+#endif
+
+// keep multiplications and additions separate
+// (fused multiply-add would make the results of the kernels differ)
+#if defined(__GNUC__) && !defined(__clang__)
+# pragma GCC optimize("fp-contract=off")
+#elif defined(__clang__)
+# pragma STDC FP_CONTRACT OFF
+#endif
+
+using namespace std;
+
+
+// All the kernels perform the same operations in the same order,
+// so they produce identical results.
+// Vector kernels compute whole vectors also at the end of the row
+// and the values of the lanes beyond the row end are thrown away.
+
+static void renderRowScalar(uint32_t* row, uint32_t x, uint32_t count, double minX, double cy,
+	double pixelSize, const uint32_t* palette, int maxIterations)
+{
+	for(uint32_t k=0; k<count; k++) {
+		double cx = minX + (double(x + k) + 0.5) * pixelSize;
+		double zx = 0.;
+		double zy = 0.;
+		int i = 0;
+		for(; i<maxIterations; i++) {
+			double nx = (zx * zx - zy * zy) + cx;
+			double ny = (zx + zx) * zy + cy;
+			zx = nx;
+			zy = ny;
+			if(zx * zx + zy * zy >= 4.)
+				break;
+		}
+		row[k] = palette[i];
+	}
+}
+
+
+#if defined(CPU_RENDERER_X86)
+
+TARGET_SSE2 static void renderRowSSE2(uint32_t* row, uint32_t x, uint32_t count, double minX, double cy,
+	double pixelSize, const uint32_t* palette, int maxIterations)
+{
+	const __m128d four = _mm_set1_pd(4.);
+	const __m128d one = _mm_set1_pd(1.);
+	const __m128d cyv = _mm_set1_pd(cy);
+	alignas(16) double iterations[2];
+	for(uint32_t k=0; k<count; k+=2) {
+		double p = double(x + k) + 0.5;
+		__m128d cx = _mm_add_pd(_mm_set1_pd(minX), _mm_mul_pd(_mm_set_pd(p+1., p), _mm_set1_pd(pixelSize)));
+		__m128d zx = _mm_setzero_pd();
+		__m128d zy = _mm_setzero_pd();
+		__m128d n = _mm_setzero_pd();
+		__m128d running = _mm_castsi128_pd(_mm_set1_epi32(-1));
+		for(int i=0; i<maxIterations; i++) {
+			__m128d nx = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(zx, zx), _mm_mul_pd(zy, zy)), cx);
+			__m128d ny = _mm_add_pd(_mm_mul_pd(_mm_add_pd(zx, zx), zy), cyv);
+			zx = nx;
+			zy = ny;
+			__m128d r = _mm_add_pd(_mm_mul_pd(zx, zx), _mm_mul_pd(zy, zy));
+			running = _mm_and_pd(running, _mm_cmplt_pd(r, four));
+			if(_mm_movemask_pd(running) == 0)
+				break;
+			n = _mm_add_pd(n, _mm_and_pd(running, one));
+		}
+		_mm_store_pd(iterations, n);
+		for(uint32_t j=0, c=min(count-k, 2u); j<c; j++)
+			row[k+j] = palette[int(iterations[j])];
+	}
+}
+
+
+TARGET_AVX2 static void renderRowAVX2(uint32_t* row, uint32_t x, uint32_t count, double minX, double cy,
+	double pixelSize, const uint32_t* palette, int maxIterations)
+{
+	const __m256d four = _mm256_set1_pd(4.);
+	const __m256d one = _mm256_set1_pd(1.);
+	const __m256d cyv = _mm256_set1_pd(cy);
+	alignas(32) double iterations[4];
+	for(uint32_t k=0; k<count; k+=4) {
+		double p = double(x + k) + 0.5;
+		__m256d cx = _mm256_add_pd(_mm256_set1_pd(minX),
+			_mm256_mul_pd(_mm256_set_pd(p+3., p+2., p+1., p), _mm256_set1_pd(pixelSize)));
+		__m256d zx = _mm256_setzero_pd();
+		__m256d zy = _mm256_setzero_pd();
+		__m256d n = _mm256_setzero_pd();
+		__m256d running = _mm256_castsi256_pd(_mm256_set1_epi32(-1));
+		for(int i=0; i<maxIterations; i++) {
+			__m256d nx = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(zx, zx), _mm256_mul_pd(zy, zy)), cx);
+			__m256d ny = _mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(zx, zx), zy), cyv);
+			zx = nx;
+			zy = ny;
+			__m256d r = _mm256_add_pd(_mm256_mul_pd(zx, zx), _mm256_mul_pd(zy, zy));
+			running = _mm256_and_pd(running, _mm256_cmp_pd(r, four, _CMP_LT_OQ));
+			if(_mm256_movemask_pd(running) == 0)
+				break;
+			n = _mm256_add_pd(n, _mm256_and_pd(running, one));
+		}
+		_mm256_store_pd(iterations, n);
+		for(uint32_t j=0, c=min(count-k, 4u); j<c; j++)
+			row[k+j] = palette[int(iterations[j])];
+	}
+}
+
+
+TARGET_AVX512 static void renderRowAVX512(uint32_t* row, uint32_t x, uint32_t count, double minX, double cy,
+	double pixelSize, const uint32_t* palette, int maxIterations)
+{
+	const __m512d four = _mm512_set1_pd(4.);
+	const __m512d one = _mm512_set1_pd(1.);
+	const __m512d cyv = _mm512_set1_pd(cy);
+	alignas(64) double iterations[8];
+	for(uint32_t k=0; k<count; k+=8) {
+		double p = double(x + k) + 0.5;
+		__m512d cx = _mm512_add_pd(_mm512_set1_pd(minX),
+			_mm512_mul_pd(_mm512_set_pd(p+7., p+6., p+5., p+4., p+3., p+2., p+1., p), _mm512_set1_pd(pixelSize)));
+		__m512d zx = _mm512_setzero_pd();
+		__m512d zy = _mm512_setzero_pd();
+		__m512d n = _mm512_setzero_pd();
+		__mmask8 running = 0xff;
+		for(int i=0; i<maxIterations; i++) {
+			__m512d nx = _mm512_add_pd(_mm512_sub_pd(_mm512_mul_pd(zx, zx), _mm512_mul_pd(zy, zy)), cx);
+			__m512d ny = _mm512_add_pd(_mm512_mul_pd(_mm512_add_pd(zx, zx), zy), cyv);
+			zx = nx;
+			zy = ny;
+			__m512d r = _mm512_add_pd(_mm512_mul_pd(zx, zx), _mm512_mul_pd(zy, zy));
+			running &= _mm512_cmp_pd_mask(r, four, _CMP_LT_OQ);
+			if(running == 0)
+				break;
+			n = _mm512_mask_add_pd(n, running, n, one);
+		}
+		_mm512_store_pd(iterations, n);
+		for(uint32_t j=0, c=min(count-k, 8u); j<c; j++)
+			row[k+j] = palette[int(iterations[j])];
+	}
+}
+
+
+# if defined(_MSC_VER)
+// detect instruction sets by cpuid
+// (AVX2 and AVX-512 need also the support of the operating system that is reported by xgetbv)
+static void detectInstructionSets(bool& sse2, bool& avx2, bool& avx512f)
+{
+	int info[4];
+	__cpuid(info, 0);
+	int maxLeaf = info[0];
+	__cpuid(info, 1);
+	sse2 = (info[3] & (1 << 26)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+	avx2 = false;
+	avx512f = false;
+	if(maxLeaf >= 7 && avx) {
+		__cpuidex(info, 7, 0);
+		avx2 = (xcr0 & 0x06) == 0x06 && (info[1] & (1 << 5)) != 0;
+		avx512f = (xcr0 & 0xe6) == 0xe6 && (info[1] & (1 << 16)) != 0;
+	}
+}
+# endif
+
+#endif
+
+
+void CpuRenderer::renderRow(Kernel kernel, uint32_t* row, uint32_t x, uint32_t count, double minX, double cy,
+	double pixelSize, const uint32_t* palette, int maxIterations)
+{
+	switch(kernel) {
+#if defined(CPU_RENDERER_X86)
+	case Kernel::AVX512: renderRowAVX512(row, x, count, minX, cy, pixelSize, palette, maxIterations); return;
+	case Kernel::AVX2: renderRowAVX2(row, x, count, minX, cy, pixelSize, palette, maxIterations); return;
+	case Kernel::SSE2: renderRowSSE2(row, x, count, minX, cy, pixelSize, palette, maxIterations); return;
+#endif
+	default: renderRowScalar(row, x, count, minX, cy, pixelSize, palette, maxIterations); return;
+	}
+}
+
+
+bool CpuRenderer::isKernelSupported(Kernel kernel)
+{
+#if defined(CPU_RENDERER_X86)
+# if defined(_MSC_VER)
+	bool sse2, avx2, avx512f;
+	detectInstructionSets(sse2, avx2, avx512f);
+# else
+	bool sse2 = __builtin_cpu_supports("sse2");
+	bool avx2 = __builtin_cpu_supports("avx2");
+	bool avx512f = __builtin_cpu_supports("avx512f");
+# endif
+	switch(kernel) {
+	case Kernel::Scalar: return true;
+	case Kernel::SSE2: return sse2;
+	case Kernel::AVX2: return avx2;
+	case Kernel::AVX512: return avx512f;
+	}
+	return false;
+#else
+	return kernel == Kernel::Scalar;
+#endif
+}
+
+
+CpuRenderer::Kernel CpuRenderer::bestSupportedKernel()
+{
+	for(Kernel k : { Kernel::AVX512, Kernel::AVX2, Kernel::SSE2 })
+		if(isKernelSupported(k))
+			return k;
+	return Kernel::Scalar;
+}
+
+
+const char* CpuRenderer::kernelName(Kernel kernel)
+{
+	switch(kernel) {
+	case Kernel::Scalar: return "scalar";
+	case Kernel::SSE2: return "SSE2";
+	case Kernel::AVX2: return "AVX2";
+	case Kernel::AVX512: return "AVX-512";
+	}
+	return "unknown";
+}
+
+
+void CpuRenderer::setKernel(Kernel kernel)
+{
+	if(!isKernelSupported(kernel))
+		throw runtime_error(string("CpuRenderer::setKernel(): Kernel ") + kernelName(kernel) + " is not supported by the processor.");
+	_kernel = kernel;
+}
+
+
+CpuRenderer::CpuRenderer(unsigned numThreads)
+	: _kernel(bestSupportedKernel())
+{
+	if(numThreads == 0)
+		numThreads = max(thread::hardware_concurrency(), 1u);
+
+	// queues and threads
+	_queues.reserve(numThreads);
+	for(unsigned i=0; i<numThreads; i++)
+		_queues.emplace_back(make_unique<Queue>());
+	_threads.reserve(numThreads);
+	for(unsigned i=0; i<numThreads; i++)
+		_threads.emplace_back(&CpuRenderer::workerMain, this, i);
+}
+
+
+CpuRenderer::~CpuRenderer()
+{
+	// stop threads
+	{
+		lock_guard<mutex> lock(_mutex);
+		_exit = true;
+	}
+	_startCondition.notify_all();
+	for(thread& t : _threads)
+		t.join();
+}
+
+
+void CpuRenderer::render(uint32_t* image, uint32_t width, uint32_t height,
+	double minX, double minY, double pixelSize, const uint32_t* palette, int maxIterations)
+{
+	if(width == 0 || height == 0)
+		return;
+
+	// parameters
+	// (they are published to the threads by the queue mutexes)
+	_image = image;
+	_width = width;
+	_height = height;
+	_numTilesX = (width + tileWidth - 1) / tileWidth;
+	_minX = minX;
+	_minY = minY;
+	_pixelSize = pixelSize;
+	_palette = palette;
+	_maxIterations = maxIterations;
+
+	// distribute tiles to the queues
+	// (each thread gets contiguous range of tiles for better memory locality)
+	size_t numTiles = size_t(_numTilesX) * ((height + tileHeight - 1) / tileHeight);
+	size_t numQueues = _queues.size();
+	_remainingTiles = numTiles;
+	for(size_t i=0; i<numQueues; i++) {
+		Queue& q = *_queues[i];
+		lock_guard<mutex> lock(q.mutex);
+		for(size_t t=numTiles*i/numQueues, e=numTiles*(i+1)/numQueues; t<e; t++)
+			q.tiles.push_back(uint32_t(t));
+	}
+
+	// start the threads and wait for them
+	{
+		lock_guard<mutex> lock(_mutex);
+		_generation++;
+	}
+	_startCondition.notify_all();
+	unique_lock<mutex> lock(_mutex);
+	_doneCondition.wait(lock, [this]() { return _remainingTiles == 0; });
+}
+
+
+void CpuRenderer::workerMain(unsigned index)
+{
+	size_t generation = 0;
+	while(true) {
+
+		// wait for work
+		{
+			unique_lock<mutex> lock(_mutex);
+			_startCondition.wait(lock, [&]() { return _exit || _generation != generation; });
+			if(_exit)
+				return;
+			generation = _generation;
+		}
+
+		// render tiles
+		uint32_t tile;
+		while(takeTile(index, tile)) {
+			renderTile(tile);
+			if(_remainingTiles.fetch_sub(1) == 1) {
+				lock_guard<mutex> lock(_mutex);
+				_doneCondition.notify_all();
+			}
+		}
+	}
+}
+
+
+bool CpuRenderer::takeTile(unsigned index, uint32_t& tile)
+{
+	// take tile from the front of own queue
+	{
+		Queue& q = *_queues[index];
+		lock_guard<mutex> lock(q.mutex);
+		if(!q.tiles.empty()) {
+			tile = q.tiles.front();
+			q.tiles.pop_front();
+			return true;
+		}
+	}
+
+	// steal tile from the back of the other queues
+	for(size_t i=1, c=_queues.size(); i<c; i++) {
+		Queue& q = *_queues[(index + i) % c];
+		lock_guard<mutex> lock(q.mutex);
+		if(!q.tiles.empty()) {
+			tile = q.tiles.back();
+			q.tiles.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void CpuRenderer::renderTile(uint32_t tile)
+{
+	uint32_t x1 = (tile % _numTilesX) * tileWidth;
+	uint32_t y1 = (tile / _numTilesX) * tileHeight;
+	uint32_t count = min(tileWidth, _width - x1);
+	uint32_t y2 = min(y1 + tileHeight, _height);
+	for(uint32_t y=y1; y<y2; y++)
+		renderRow(_kernel, _image + size_t(y) * _width + x1, x1, count,
+		          _minX, _minY + (double(y) + 0.5) * _pixelSize, _pixelSize, _palette, _maxIterations);
+}
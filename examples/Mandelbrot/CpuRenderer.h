@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Mandelbrot renderer running on CPU.
+// The escape-time kernel is vectorized by AVX-512, AVX2 or SSE2, the best one supported
+// by the processor is selected at runtime. The image is split into tiles that are processed
+// in parallel by the thread pool; each thread takes tiles from its own queue first
+// and steals the tiles of other threads when its queue gets empty.
+// The iterations are computed in double precision, so the result serves as the reference
+// for validation of the shaders.
+class CpuRenderer {
+public:
+
+	enum class Kernel { Scalar, SSE2, AVX2, AVX512 };
+
+	static constexpr uint32_t tileWidth = 64;
+	static constexpr uint32_t tileHeight = 16;
+
+protected:
+
+	struct Queue {
+		std::mutex mutex;
+		std::deque<uint32_t> tiles;
+	};
+
+	Kernel _kernel;
+	std::vector<std::thread> _threads;
+	std::vector<std::unique_ptr<Queue>> _queues;  // one queue for each thread
+	std::mutex _mutex;
+	std::condition_variable _startCondition;
+	std::condition_variable _doneCondition;
+	size_t _generation = 0;
+	bool _exit = false;
+	std::atomic<size_t> _remainingTiles{0};
+
+	// parameters of the current render() call
+	uint32_t* _image;
+	uint32_t _width;
+	uint32_t _height;
+	uint32_t _numTilesX;
+	double _minX;
+	double _minY;
+	double _pixelSize;
+	const uint32_t* _palette;
+	int _maxIterations;
+
+	void workerMain(unsigned index);
+	bool takeTile(unsigned index, uint32_t& tile);
+	void renderTile(uint32_t tile);
+
+public:
+
+	// construction and destruction
+	// (numThreads equal to zero means the number of hardware threads)
+	CpuRenderer(unsigned numThreads = 0);
+	~CpuRenderer();
+
+	// deleted constructors and operators
+	CpuRenderer(const CpuRenderer&) = delete;
+	CpuRenderer& operator=(const CpuRenderer&) = delete;
+
+	// renders width x height image into the image memory (tightly packed rows);
+	// pixel x,y samples c = (minX + (x+0.5)*pixelSize, minY + (y+0.5)*pixelSize)
+	// and it is set to palette[i], where i is the number of iterations of z = z^2 + c
+	// before z escapes, or maxIterations if it does not escape (palette has maxIterations+1 items)
+	void render(uint32_t* image, uint32_t width, uint32_t height,
+		double minX, double minY, double pixelSize, const uint32_t* palette, int maxIterations);
+
+	// kernel selection
+	// (setKernel() throws if the kernel is not supported by the processor)
+	Kernel kernel() const;
+	void setKernel(Kernel kernel);
+	static Kernel bestSupportedKernel();
+	static bool isKernelSupported(Kernel kernel);
+	static const char* kernelName(Kernel kernel);
+
+	// getters
+	unsigned numThreads() const;
+
+	// renders count pixels of single row starting by pixel x by the given kernel,
+	// cy is the imaginary part of c of the row; it is used by render()
+	// and it is exposed for the validation of the kernels
+	static void renderRow(Kernel kernel, uint32_t* row, uint32_t x, uint32_t count, double minX, double cy,
+		double pixelSize, const uint32_t* palette, int maxIterations);
+
+};
+
+
+// inline methods
+inline CpuRenderer::Kernel CpuRenderer::kernel() const  { return _kernel; }
+inline unsigned CpuRenderer::numThreads() const  { return unsigned(_threads.size()); }
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#version 450
+
+// push constants
+layout(push_constant) uniform pushConstants {
+	layout(offset=0) vec2 referencePixel;  // position of the reference point in pixels
+	layout(offset=8) float pixelSize;
+	layout(offset=12) int maxIterations;
+	layout(offset=16) int referenceLength;  // number of items in the reference orbit
+	layout(offset=20) int skippedIterations;  // iterations skipped by the series approximation
+	layout(offset=24) vec2 seriesA;  // series approximation coefficients scaled for deltas in pixels
+	layout(offset=32) vec2 seriesB;
+	layout(offset=40) vec2 seriesC;
+};
+
+// reference orbit computed on the host in double-double precision
+layout(binding = 0) readonly buffer ReferenceOrbit {
+	vec2 orbit[];
+};
+
+// output
+layout(location = 0) out vec4 outColor;
+
+
+// complex multiplication
+vec2 cmul(vec2 a, vec2 b)
+{
+	return vec2(a.x*b.x - a.y*b.y, a.x*b.y + a.y*b.x);
+}
+
+
+// hsvToRgb - convert color given in HSV (Hue Saturation Value) into color given in RGB (Red Green Blue)
+vec3 hsvToRgb(vec3 hsv)
+{
+	vec3 c = clamp(abs(fract(vec3(hsv.x + 1, hsv.x + 2./3., hsv.x + 1./3.)) * 6 - 3) - 1, 0, 1);
+	return hsv.z * mix(vec3(1,1,1), c, hsv.y);
+}
+
+
+void main()
+{
+	// deltas are kept in pixels, so they do not underflow on deep zoom;
+	// the delta of c is the distance from the reference point
+	// and the delta of z after the skipped iterations is given by the series approximation
+	vec2 dc = gl_FragCoord.xy - referencePixel;
+	vec2 d = cmul(dc, seriesA + cmul(dc, seriesB + cmul(dc, seriesC)));
+	int n = skippedIterations;
+
+	// iterate delta of z = z^2 + c against the reference orbit Z:
+	// delta' = (2*Z + delta) * delta + delta of c
+	int i = skippedIterations;
+	for(; i<maxIterations; i++) {
+		d = cmul(2.*orbit[n] + pixelSize*d, d) + dc;
+		n++;
+		vec2 delta = pixelSize * d;
+		vec2 z = orbit[n] + delta;
+		if(dot(z, z) >= 4.0)
+			break;
+
+		// rebase to the start of the reference orbit
+		// when z gets closer to zero than delta (this avoids glitches)
+		// or when the end of the reference orbit is reached
+		if(dot(z, z) < dot(delta, delta) || n == referenceLength-1) {
+			d = z / pixelSize;
+			n = 0;
+		}
+	}
+
+	// assign color
+	// (colors of shader.frag repeated every 256 iterations)
+	if(i >= maxIterations)
+		outColor = vec4(0,0,0,1);
+	else {
+		float l = float(i % 256) / 255.;
+		outColor = vec4(hsvToRgb(vec3(2./3. - l, 1, 1)), 1);
+	}
+}
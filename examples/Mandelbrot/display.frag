@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#version 450
+
+// iteration state computed by mandelbrot.comp
+layout(binding = 0, rgba32f) uniform readonly image2D stateImage;
+
+// output
+layout(location = 0) out vec4 outColor;
+
+// pixel status
+const float statusEscaped = 1.;
+
+
+// hsvToRgb - convert color given in HSV (Hue Saturation Value) into color given in RGB (Red Green Blue)
+vec3 hsvToRgb(vec3 hsv)
+{
+	vec3 c = clamp(abs(fract(vec3(hsv.x + 1, hsv.x + 2./3., hsv.x + 1./3.)) * 6 - 3) - 1, 0, 1);
+	return hsv.z * mix(vec3(1,1,1), c, hsv.y);
+}
+
+
+void main()
+{
+	// pixels inside the set and pixels still being computed are black,
+	// escaped pixels use the colors of shader.frag repeated every 256 iterations
+	vec4 state = imageLoad(stateImage, ivec2(gl_FragCoord.xy));
+	if(state.w != statusEscaped)
+		outColor = vec4(0,0,0,1);
+	else {
+		float l = float(int(state.z) % 256) / 255.;
+		outColor = vec4(hsvToRgb(vec3(2./3. - l, 1, 1)), 1);
+	}
+}
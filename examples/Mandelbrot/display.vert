@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#version 450
+
+// output variables
+out gl_PerVertex {
+	vec4 gl_Position;
+};
+
+
+vec2 coords[4] = vec2[](
+	vec2(-1.0,-1.0),
+	vec2(-1.0, 1.0),
+	vec2( 1.0,-1.0),
+	vec2( 1.0, 1.0)
+);
+
+
+void main()
+{
+	gl_Position = vec4(coords[gl_VertexIndex], 0.0, 1.0);
+}
@@ -3,11 +3,16 @@
 // SPDX-License-Identifier: MIT-0
 
 #include "VulkanWindow.h"
+#include "VulkanWindowPipeline.h"
+#include "CpuRenderer.h"
 #include <vulkan/vulkan.hpp>
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <complex>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
 
 using namespace std;
 
@@ -23,6 +28,76 @@ static const uint32_t vsSpirv[] = {
 static const uint32_t fsSpirv[] = {
 #include "shader.frag.spv"
 };
+static const uint32_t compSpirv[] = {
+#include "mandelbrot.comp.spv"
+};
+static const uint32_t reprojectSpirv[] = {
+#include "reproject.comp.spv"
+};
+static const uint32_t displayVsSpirv[] = {
+#include "display.vert.spv"
+};
+static const uint32_t displayFsSpirv[] = {
+#include "display.frag.spv"
+};
+static const uint32_t deepZoomFsSpirv[] = {
+#include "deepzoom.frag.spv"
+};
+
+
+// find memory type supporting all the given flags
+static uint32_t findMemoryType(vk::PhysicalDevice physicalDevice, uint32_t typeBits, vk::MemoryPropertyFlags flags)
+{
+	vk::PhysicalDeviceMemoryProperties memoryProperties = physicalDevice.getMemoryProperties();
+	for(uint32_t i=0; i<memoryProperties.memoryTypeCount; i++)
+		if((typeBits & (1 << i)) && (memoryProperties.memoryTypes[i].propertyFlags & flags) == flags)
+			return i;
+	throw runtime_error("No suitable memory type found.");
+}
+
+
+// double-double number
+// (unevaluated sum of two doubles giving about 106 bits of mantissa;
+// it keeps the view center of the deep zoom and it is used to compute the reference orbit)
+struct DoubleDouble {
+	double hi;
+	double lo;
+	DoubleDouble() = default;
+	constexpr DoubleDouble(double v) : hi(v), lo(0.)  {}
+	constexpr DoubleDouble(double h, double l) : hi(h), lo(l)  {}
+	explicit operator double() const  { return hi + lo; }
+};
+
+static DoubleDouble quickTwoSum(double a, double b)
+{
+	double s = a + b;
+	return { s, b - (s - a) };
+}
+
+static DoubleDouble twoSum(double a, double b)
+{
+	double s = a + b;
+	double bb = s - a;
+	return { s, (a - (s - bb)) + (b - bb) };
+}
+
+static DoubleDouble operator+(DoubleDouble a, DoubleDouble b)
+{
+	DoubleDouble s = twoSum(a.hi, b.hi);
+	DoubleDouble t = twoSum(a.lo, b.lo);
+	s = quickTwoSum(s.hi, s.lo + t.hi);
+	return quickTwoSum(s.hi, s.lo + t.lo);
+}
+
+static DoubleDouble operator-(DoubleDouble a)  { return { -a.hi, -a.lo }; }
+static DoubleDouble operator-(DoubleDouble a, DoubleDouble b)  { return a + (-b); }
+
+static DoubleDouble operator*(DoubleDouble a, DoubleDouble b)
+{
+	double p = a.hi * b.hi;
+	double e = fma(a.hi, b.hi, -p) + (a.hi * b.lo + a.lo * b.hi);
+	return quickTwoSum(p, e);
+}
 
 
 // global application data
@@ -39,6 +114,16 @@ public:
 	void mouseButton(VulkanWindow&, size_t button, VulkanWindow::ButtonState buttonState, const VulkanWindow::MouseState& mouseState);
 	void mouseWheel(VulkanWindow& window, float wheelX, float wheelY, const VulkanWindow::MouseState& mouseState);
 	void key(VulkanWindow& window, VulkanWindow::KeyState keyState, VulkanWindow::ScanCode scanCode);
+	void initCompute();
+	void resizeCompute(vk::Extent2D extent);
+	void recordCompute();
+	void resetTiles();
+	void reproject();
+	void initDeepZoom();
+	void computeReferenceOrbit();
+	void initCpu();
+	void resizeCpu(vk::Extent2D extent);
+	void recordCpu(uint32_t imageIndex);
 
 	// Vulkan instance must be destructed as the last Vulkan handle.
 	// It is probably good idea to destroy it after the display connection.
@@ -59,6 +144,7 @@ public:
 	vk::SurfaceFormatKHR surfaceFormat;
 	vk::RenderPass renderPass;
 	vk::SwapchainKHR swapchain;
+	vector<vk::Image> swapchainImages;
 	vector<vk::ImageView> swapchainImageViews;
 	vector<vk::Framebuffer> framebuffers;
 	vector<vk::Semaphore> renderingFinishedSemaphores;
@@ -69,6 +155,7 @@ public:
 	vk::ShaderModule vsModule;
 	vk::ShaderModule fsModule;
 	vk::PipelineLayout pipelineLayout;
+	VulkanWindowPipelineCache pipelineCache;
 	vk::Pipeline pipeline;
 
 	enum class FrameUpdateMode { OnDemand, Continuous, MaxFrameRate };
@@ -77,10 +164,109 @@ public:
 	size_t fpsNumFrames = ~size_t(0);
 	chrono::high_resolution_clock::time_point fpsStartTime;
 
-	float valueGradient = -1.f;
+	// view
+	// (the center is kept in double-double precision for the deep zoom,
+	// minX, minY, maxX and maxY are used by single precision renderers)
+	double valueGradient = -1.;  // size of the pixel
 	uint32_t windowHeight;
+	DoubleDouble centerX, centerY;
 	float minX, minY, maxX, maxY;
-	void setView(float coordX, float coordY, float valueX, float valueY);
+	void setView(float coordX, float coordY, DoubleDouble valueX, DoubleDouble valueY);
+
+	// progressive compute renderer
+	// (the screen is split into tiles; each frame, the tiles are given iterationsPerPass iterations
+	// in round-robin order until iterationBudget is spent, in more passes if the budget is not spent
+	// by the first one; the iteration state is kept in state image;
+	// when the view is panned or zoomed, the state is reprojected into the other state image,
+	// so only the newly exposed pixels and the pixels whose sampling position moved
+	// by more than reprojectionThreshold are recomputed)
+	bool useCompute = false;
+	bool useReprojection = true;
+	uint64_t iterationBudget = 100'000'000;  // pixel iterations per frame
+	int maxIterations = 1024;
+	static constexpr int iterationsPerPass = 64;
+	static constexpr uint32_t tileSize = 64;
+	static constexpr float reprojectionThreshold = 0.25f;  // in pixels
+	vk::ShaderModule compModule;
+	vk::ShaderModule reprojectModule;
+	vk::ShaderModule displayVsModule;
+	vk::ShaderModule displayFsModule;
+	vk::DescriptorSetLayout computeDescriptorSetLayout;
+	vk::DescriptorPool computeDescriptorPool;
+	array<vk::DescriptorSet, 2> computeDescriptorSets;  // set i uses stateImages[i] as the current state and the other one as the previous state
+	vk::PipelineLayout computePipelineLayout;
+	vk::Pipeline computePipeline;
+	vk::Pipeline reprojectPipeline;
+	vk::Pipeline displayPipeline;
+	array<vk::Image, 2> stateImages;
+	array<vk::DeviceMemory, 2> stateImageMemories;
+	array<vk::ImageView, 2> stateImageViews;
+	unsigned currentStateImage = 0;
+	bool stateImageInitialized = false;
+	float stateView[4];  // view of the current state image
+	struct AxisMap {
+		int32_t source;
+		float offset;
+	};
+	vk::Buffer axisMapBuffer;
+	vk::DeviceMemory axisMapBufferMemory;
+	AxisMap* axisMaps = nullptr;
+
+	// deep zoom renderer
+	// (reference orbit is computed on the host in double-double precision and the fragment shader
+	// iterates float deltas against it; the deltas are kept in pixels, so they do not underflow
+	// until the pixel size approaches the smallest float, e.g. zoom of about 1e35)
+	bool useDeepZoom = false;
+	bool deepZoomVerbose = false;  // print reference orbit info on each recomputation
+	vk::ShaderModule deepZoomFsModule;
+	vk::DescriptorSetLayout deepZoomDescriptorSetLayout;
+	vk::DescriptorPool deepZoomDescriptorPool;
+	vk::DescriptorSet deepZoomDescriptorSet;
+	vk::PipelineLayout deepZoomPipelineLayout;
+	vk::Pipeline deepZoomPipeline;
+	vk::Buffer orbitBuffer;
+	vk::DeviceMemory orbitBufferMemory;
+	float* orbitData = nullptr;  // pairs of floats
+	bool orbitUpToDate = false;
+	struct DeepZoomPushData {
+		float referencePixel[2];
+		float pixelSize;
+		int32_t maxIterations;
+		int32_t referenceLength;
+		int32_t skippedIterations;
+		float seriesA[2];
+		float seriesB[2];
+		float seriesC[2];
+	};
+	static_assert(sizeof(DeepZoomPushData) == 48, "Wrong DeepZoomPushData size.");
+	DeepZoomPushData deepZoomPushData;
+	vk::Buffer tileBuffer;
+	vk::DeviceMemory tileBufferMemory;
+	uint32_t* tileCounters = nullptr;
+	struct Tile {
+		uint32_t unfinishedPixels;
+		bool reset;
+	};
+	vector<Tile> tiles;
+	uint32_t numTilesX = 0;
+	vk::Extent2D computeExtent;
+	size_t tileCursor = 0;
+	vector<uint32_t> dispatchedTiles;
+
+	// CPU renderer
+	// (the image is rendered by SIMD kernels on all processor cores into the host visible
+	// staging buffer and copied into the swapchain image; it uses the iteration count
+	// and the colors of shader.frag, so it serves as the reference image for the shader)
+	bool useCpu = false;
+	unsigned cpuThreads = 0;  // zero means the number of hardware threads
+	CpuRenderer::Kernel cpuKernel = CpuRenderer::bestSupportedKernel();
+	static constexpr int cpuMaxIterations = 255;
+	unique_ptr<CpuRenderer> cpuRenderer;
+	array<uint32_t, cpuMaxIterations+1> cpuPalette;  // colors in the format of the swapchain images
+	vk::Buffer stagingBuffer;
+	vk::DeviceMemory stagingBufferMemory;
+	uint32_t* stagingData = nullptr;
+	vk::Extent2D stagingExtent;
 
 };
 
@@ -96,6 +282,43 @@ App::App(int argc, char** argv)
 			frameUpdateMode = FrameUpdateMode::Continuous;
 		else if(strcmp(argv[i], "--max-frame-rate") == 0)
 			frameUpdateMode = FrameUpdateMode::MaxFrameRate;
+		else if(strcmp(argv[i], "--compute") == 0)
+			useCompute = true;
+		else if(strcmp(argv[i], "--no-reprojection") == 0)
+			useReprojection = false;
+		else if(strcmp(argv[i], "--deep-zoom") == 0)
+			useDeepZoom = true;
+		else if(strcmp(argv[i], "--verbose") == 0)
+			deepZoomVerbose = true;
+		else if(strcmp(argv[i], "--cpu") == 0)
+			useCpu = true;
+		else if(strcmp(argv[i], "--cpu-kernel") == 0 && i+1 < argc) {
+			i++;
+			if(strcmp(argv[i], "scalar") == 0)
+				cpuKernel = CpuRenderer::Kernel::Scalar;
+			else if(strcmp(argv[i], "sse2") == 0)
+				cpuKernel = CpuRenderer::Kernel::SSE2;
+			else if(strcmp(argv[i], "avx2") == 0)
+				cpuKernel = CpuRenderer::Kernel::AVX2;
+			else if(strcmp(argv[i], "avx512") == 0)
+				cpuKernel = CpuRenderer::Kernel::AVX512;
+			else {
+				cout << "Unrecognized CPU kernel: " << argv[i] << endl;
+				exit(99);
+			}
+		}
+		else if(strcmp(argv[i], "--threads") == 0 && i+1 < argc) {
+			i++;
+			cpuThreads = unsigned(max(atoi(argv[i]), 0));
+		}
+		else if(strcmp(argv[i], "--iteration-budget") == 0 && i+1 < argc) {
+			i++;
+			iterationBudget = uint64_t(max(strtod(argv[i], nullptr), 1.) * 1e6);
+		}
+		else if(strcmp(argv[i], "--max-iterations") == 0 && i+1 < argc) {
+			i++;
+			maxIterations = max(atoi(argv[i]), 1);
+		}
 		else {
 			if(strcmp(argv[i], "--help") != 0 && strcmp(argv[i], "-h") != 0)
 				cout << "Unrecognized option: " << argv[i] << endl;
@@ -106,9 +329,36 @@ App::App(int argc, char** argv)
 			        "   --continuous:  constantly update window content using\n"
 			        "                  screen refresh rate, this is the default\n"
 			        "   --max-frame-rate:  ignore screen refresh rate, update\n"
-			        "                      window content as often as possible\n" << endl;
+			        "                      window content as often as possible\n"
+			        "   --compute:     progressive tiled compute renderer, coarse image\n"
+			        "                  is shown at once and refined in the next frames\n"
+			        "   --iteration-budget <millions>:  pixel iterations computed\n"
+			        "                  per frame by --compute, default is 100\n"
+			        "   --max-iterations <n>:  maximum number of iterations\n"
+			        "                  used by --compute and --deep-zoom,\n"
+			        "                  default is 1024\n"
+			        "   --no-reprojection:  recompute whole image by --compute\n"
+			        "                  on each pan and zoom\n"
+			        "   --deep-zoom:   perturbation renderer allowing zoom\n"
+			        "                  of about 1e30, it cannot be combined\n"
+			        "                  with --compute\n"
+			        "   --verbose:     print reference orbit info of --deep-zoom\n"
+			        "                  on each pan and zoom\n"
+			        "   --cpu:         render on CPU by SIMD kernels on all cores,\n"
+			        "                  it cannot be combined with --compute\n"
+			        "                  and --deep-zoom\n"
+			        "   --cpu-kernel <scalar|sse2|avx2|avx512>:  kernel used\n"
+			        "                  by --cpu, default is the best supported one\n"
+			        "   --threads <n>: number of threads used by --cpu,\n"
+			        "                  default is the number of hardware threads\n" << endl;
 			exit(99);
 		}
+
+	// only one of the alternative renderers can be used
+	if(int(useCompute) + int(useDeepZoom) + int(useCpu) > 1) {
+		cout << "Options --compute, --deep-zoom and --cpu cannot be combined." << endl;
+		exit(99);
+	}
 }
 
 
@@ -125,7 +375,42 @@ App::~App()
 		// destroy handles
 		// (the handles are destructed in certain (not arbitrary) order)
 		device.destroy(commandPool);
+		if(stagingBufferMemory)
+			device.unmapMemory(stagingBufferMemory);
+		device.destroy(stagingBuffer);
+		device.free(stagingBufferMemory);
+		if(orbitBufferMemory)
+			device.unmapMemory(orbitBufferMemory);
+		device.destroy(orbitBuffer);
+		device.free(orbitBufferMemory);
+		device.destroy(deepZoomPipeline);
+		device.destroy(deepZoomPipelineLayout);
+		device.destroy(deepZoomDescriptorPool);
+		device.destroy(deepZoomDescriptorSetLayout);
+		device.destroy(deepZoomFsModule);
+		if(axisMapBufferMemory)
+			device.unmapMemory(axisMapBufferMemory);
+		device.destroy(axisMapBuffer);
+		device.free(axisMapBufferMemory);
+		if(tileBufferMemory)
+			device.unmapMemory(tileBufferMemory);
+		device.destroy(tileBuffer);
+		device.free(tileBufferMemory);
+		for(auto v : stateImageViews)  device.destroy(v);
+		for(auto i : stateImages)  device.destroy(i);
+		for(auto m : stateImageMemories)  device.free(m);
+		device.destroy(displayPipeline);
+		device.destroy(reprojectPipeline);
+		device.destroy(computePipeline);
+		device.destroy(computePipelineLayout);
+		device.destroy(computeDescriptorPool);
+		device.destroy(computeDescriptorSetLayout);
+		device.destroy(displayFsModule);
+		device.destroy(displayVsModule);
+		device.destroy(reprojectModule);
+		device.destroy(compModule);
 		device.destroy(pipeline);
+		pipelineCache.cleanUp();
 		device.destroy(pipelineLayout);
 		device.destroy(fsModule);
 		device.destroy(vsModule);
@@ -448,10 +733,513 @@ void App::init()
 				}.data()
 			}
 		);
+
+	// pipeline cache
+	// (it is stored on disk to speed up the next application start)
+	pipelineCache.init(physicalDevice, device, string(appName) + ".pipelineCache");
+
+	// pipeline
+	// (viewport and scissor are dynamic, so the pipeline is not recreated on resize)
+	pipeline =
+		VulkanWindowPipeline::createSimple(
+			device,  // device
+			pipelineCache.get(),  // pipelineCache
+			pipelineLayout,  // pipelineLayout
+			renderPass,  // renderPass
+			vsModule,  // vsModule
+			fsModule,  // fsModule
+			vk::PrimitiveTopology::eTriangleStrip  // topology
+		);
+
+	// full screen vertex shader
+	// (shared by the compute renderer display and by the deep zoom renderer)
+	if(useCompute || useDeepZoom)
+		displayVsModule =
+			device.createShaderModule(
+				vk::ShaderModuleCreateInfo(
+					vk::ShaderModuleCreateFlags(),  // flags
+					sizeof(displayVsSpirv),  // codeSize
+					displayVsSpirv  // pCode
+				)
+			);
+
+	// progressive compute renderer
+	if(useCompute)
+		initCompute();
+
+	// deep zoom renderer
+	if(useDeepZoom)
+		initDeepZoom();
+
+	// CPU renderer
+	if(useCpu)
+		initCpu();
 }
 
 
-/** Recreate swapchain and pipeline callback.
+void App::initCompute()
+{
+	// shader modules
+	compModule =
+		device.createShaderModule(
+			vk::ShaderModuleCreateInfo(
+				vk::ShaderModuleCreateFlags(),  // flags
+				sizeof(compSpirv),  // codeSize
+				compSpirv  // pCode
+			)
+		);
+	reprojectModule =
+		device.createShaderModule(
+			vk::ShaderModuleCreateInfo(
+				vk::ShaderModuleCreateFlags(),  // flags
+				sizeof(reprojectSpirv),  // codeSize
+				reprojectSpirv  // pCode
+			)
+		);
+	displayFsModule =
+		device.createShaderModule(
+			vk::ShaderModuleCreateInfo(
+				vk::ShaderModuleCreateFlags(),  // flags
+				sizeof(displayFsSpirv),  // codeSize
+				displayFsSpirv  // pCode
+			)
+		);
+
+	// descriptor set layout
+	// (state image is written by compute shader and read by display fragment shader,
+	// previous state image and axis maps are used by the reprojection)
+	computeDescriptorSetLayout =
+		device.createDescriptorSetLayout(
+			vk::DescriptorSetLayoutCreateInfo(
+				vk::DescriptorSetLayoutCreateFlags(),  // flags
+				4,  // bindingCount
+				array{  // pBindings
+					vk::DescriptorSetLayoutBinding(
+						0,  // binding
+						vk::DescriptorType::eStorageImage,  // descriptorType
+						1,  // descriptorCount
+						vk::ShaderStageFlagBits::eCompute | vk::ShaderStageFlagBits::eFragment,  // stageFlags
+						nullptr  // pImmutableSamplers
+					),
+					vk::DescriptorSetLayoutBinding(
+						1,  // binding
+						vk::DescriptorType::eStorageBuffer,  // descriptorType
+						1,  // descriptorCount
+						vk::ShaderStageFlagBits::eCompute,  // stageFlags
+						nullptr  // pImmutableSamplers
+					),
+					vk::DescriptorSetLayoutBinding(
+						2,  // binding
+						vk::DescriptorType::eStorageImage,  // descriptorType
+						1,  // descriptorCount
+						vk::ShaderStageFlagBits::eCompute,  // stageFlags
+						nullptr  // pImmutableSamplers
+					),
+					vk::DescriptorSetLayoutBinding(
+						3,  // binding
+						vk::DescriptorType::eStorageBuffer,  // descriptorType
+						1,  // descriptorCount
+						vk::ShaderStageFlagBits::eCompute,  // stageFlags
+						nullptr  // pImmutableSamplers
+					),
+				}.data()
+			)
+		);
+
+	// descriptor pool and sets
+	// (one set for each state image being the current one)
+	computeDescriptorPool =
+		device.createDescriptorPool(
+			vk::DescriptorPoolCreateInfo(
+				vk::DescriptorPoolCreateFlags(),  // flags
+				2,  // maxSets
+				2,  // poolSizeCount
+				array{  // pPoolSizes
+					vk::DescriptorPoolSize(vk::DescriptorType::eStorageImage, 4),
+					vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer, 4),
+				}.data()
+			)
+		);
+	vector<vk::DescriptorSet> sets =
+		device.allocateDescriptorSets(
+			vk::DescriptorSetAllocateInfo(
+				computeDescriptorPool,  // descriptorPool
+				2,  // descriptorSetCount
+				array{ computeDescriptorSetLayout, computeDescriptorSetLayout }.data()  // pSetLayouts
+			)
+		);
+	computeDescriptorSets = { sets[0], sets[1] };
+
+	// pipeline layout
+	// (shared by compute and display pipeline)
+	computePipelineLayout =
+		device.createPipelineLayout(
+			vk::PipelineLayoutCreateInfo{
+				vk::PipelineLayoutCreateFlags(),  // flags
+				1,       // setLayoutCount
+				&computeDescriptorSetLayout,  // pSetLayouts
+				1,       // pushConstantRangeCount
+				array{   // pPushConstantRanges
+					vk::PushConstantRange{
+						vk::ShaderStageFlagBits::eCompute,  // stage flags
+						0,  // offset
+						48,  // size
+					},
+				}.data()
+			}
+		);
+
+	// pipelines
+	computePipeline =
+		device.createComputePipeline(
+			pipelineCache.get(),  // pipelineCache
+			vk::ComputePipelineCreateInfo(
+				vk::PipelineCreateFlags(),  // flags
+				vk::PipelineShaderStageCreateInfo(  // stage
+					vk::PipelineShaderStageCreateFlags(),  // flags
+					vk::ShaderStageFlagBits::eCompute,  // stage
+					compModule,  // module
+					"main",  // pName
+					nullptr  // pSpecializationInfo
+				),
+				computePipelineLayout,  // layout
+				vk::Pipeline(nullptr),  // basePipelineHandle
+				-1  // basePipelineIndex
+			)
+		).value;
+	reprojectPipeline =
+		device.createComputePipeline(
+			pipelineCache.get(),  // pipelineCache
+			vk::ComputePipelineCreateInfo(
+				vk::PipelineCreateFlags(),  // flags
+				vk::PipelineShaderStageCreateInfo(  // stage
+					vk::PipelineShaderStageCreateFlags(),  // flags
+					vk::ShaderStageFlagBits::eCompute,  // stage
+					reprojectModule,  // module
+					"main",  // pName
+					nullptr  // pSpecializationInfo
+				),
+				computePipelineLayout,  // layout
+				vk::Pipeline(nullptr),  // basePipelineHandle
+				-1  // basePipelineIndex
+			)
+		).value;
+	displayPipeline =
+		VulkanWindowPipeline::createSimple(
+			device,  // device
+			pipelineCache.get(),  // pipelineCache
+			computePipelineLayout,  // pipelineLayout
+			renderPass,  // renderPass
+			displayVsModule,  // vsModule
+			displayFsModule,  // fsModule
+			vk::PrimitiveTopology::eTriangleStrip  // topology
+		);
+}
+
+
+void App::initDeepZoom()
+{
+	// shader module
+	deepZoomFsModule =
+		device.createShaderModule(
+			vk::ShaderModuleCreateInfo(
+				vk::ShaderModuleCreateFlags(),  // flags
+				sizeof(deepZoomFsSpirv),  // codeSize
+				deepZoomFsSpirv  // pCode
+			)
+		);
+
+	// reference orbit buffer
+	// (the buffer is host visible and coherent, it is written after the frame fence is signaled)
+	orbitBuffer =
+		device.createBuffer(
+			vk::BufferCreateInfo(
+				vk::BufferCreateFlags(),  // flags
+				(size_t(maxIterations) + 1) * 2 * sizeof(float),  // size
+				vk::BufferUsageFlagBits::eStorageBuffer,  // usage
+				vk::SharingMode::eExclusive,  // sharingMode
+				0,  // queueFamilyIndexCount
+				nullptr  // pQueueFamilyIndices
+			)
+		);
+	vk::MemoryRequirements memoryRequirements = device.getBufferMemoryRequirements(orbitBuffer);
+	orbitBufferMemory =
+		device.allocateMemory(
+			vk::MemoryAllocateInfo(
+				memoryRequirements.size,  // allocationSize
+				findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits,  // memoryTypeIndex
+				               vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+			)
+		);
+	device.bindBufferMemory(orbitBuffer, orbitBufferMemory, 0);
+	orbitData = reinterpret_cast<float*>(device.mapMemory(orbitBufferMemory, 0, VK_WHOLE_SIZE));
+
+	// descriptor set layout, pool and set
+	deepZoomDescriptorSetLayout =
+		device.createDescriptorSetLayout(
+			vk::DescriptorSetLayoutCreateInfo(
+				vk::DescriptorSetLayoutCreateFlags(),  // flags
+				1,  // bindingCount
+				array{  // pBindings
+					vk::DescriptorSetLayoutBinding(
+						0,  // binding
+						vk::DescriptorType::eStorageBuffer,  // descriptorType
+						1,  // descriptorCount
+						vk::ShaderStageFlagBits::eFragment,  // stageFlags
+						nullptr  // pImmutableSamplers
+					),
+				}.data()
+			)
+		);
+	deepZoomDescriptorPool =
+		device.createDescriptorPool(
+			vk::DescriptorPoolCreateInfo(
+				vk::DescriptorPoolCreateFlags(),  // flags
+				1,  // maxSets
+				1,  // poolSizeCount
+				array{  // pPoolSizes
+					vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer, 1),
+				}.data()
+			)
+		);
+	deepZoomDescriptorSet =
+		device.allocateDescriptorSets(
+			vk::DescriptorSetAllocateInfo(
+				deepZoomDescriptorPool,  // descriptorPool
+				1,  // descriptorSetCount
+				&deepZoomDescriptorSetLayout  // pSetLayouts
+			)
+		)[0];
+	device.updateDescriptorSets(
+		vk::WriteDescriptorSet(
+			deepZoomDescriptorSet,  // dstSet
+			0,  // dstBinding
+			0,  // dstArrayElement
+			1,  // descriptorCount
+			vk::DescriptorType::eStorageBuffer,  // descriptorType
+			nullptr,  // pImageInfo
+			&(const vk::DescriptorBufferInfo&)vk::DescriptorBufferInfo(  // pBufferInfo
+				orbitBuffer,  // buffer
+				0,  // offset
+				VK_WHOLE_SIZE  // range
+			),
+			nullptr  // pTexelBufferView
+		),
+		nullptr  // descriptorCopies
+	);
+
+	// pipeline layout and pipeline
+	deepZoomPipelineLayout =
+		device.createPipelineLayout(
+			vk::PipelineLayoutCreateInfo{
+				vk::PipelineLayoutCreateFlags(),  // flags
+				1,       // setLayoutCount
+				&deepZoomDescriptorSetLayout,  // pSetLayouts
+				1,       // pushConstantRangeCount
+				array{   // pPushConstantRanges
+					vk::PushConstantRange{
+						vk::ShaderStageFlagBits::eFragment,  // stage flags
+						0,  // offset
+						sizeof(DeepZoomPushData),  // size
+					},
+				}.data()
+			}
+		);
+	deepZoomPipeline =
+		VulkanWindowPipeline::createSimple(
+			device,  // device
+			pipelineCache.get(),  // pipelineCache
+			deepZoomPipelineLayout,  // pipelineLayout
+			renderPass,  // renderPass
+			displayVsModule,  // vsModule
+			deepZoomFsModule,  // fsModule
+			vk::PrimitiveTopology::eTriangleStrip  // topology
+		);
+}
+
+
+void App::initCpu()
+{
+	// renderer
+	cpuRenderer = make_unique<CpuRenderer>(cpuThreads);
+	cpuRenderer->setKernel(cpuKernel);
+	cout << "CPU renderer:\n"
+	        "   " << CpuRenderer::kernelName(cpuRenderer->kernel()) << " kernel, "
+	     << cpuRenderer->numThreads() << " threads" << endl;
+
+	// component order and encoding of the swapchain images
+	// (the image is written by the copy, so sRGB encoding is not performed by the hardware)
+	bool bgra, srgb;
+	switch(surfaceFormat.format) {
+	case vk::Format::eB8G8R8A8Srgb:        bgra = true;  srgb = true;  break;
+	case vk::Format::eB8G8R8A8Unorm:       bgra = true;  srgb = false; break;
+	case vk::Format::eR8G8B8A8Srgb:
+	case vk::Format::eA8B8G8R8SrgbPack32:  bgra = false; srgb = true;  break;
+	case vk::Format::eR8G8B8A8Unorm:
+	case vk::Format::eA8B8G8R8UnormPack32: bgra = false; srgb = false; break;
+	default:
+		throw runtime_error("CPU renderer does not support surface format " + to_string(surfaceFormat.format) + ".");
+	}
+
+	// palette
+	// (colors of shader.frag)
+	auto toByte =
+		[](double v, bool srgb) -> uint32_t {
+			if(srgb)
+				v = (v <= 0.0031308) ? v * 12.92 : 1.055 * pow(v, 1./2.4) - 0.055;
+			return uint32_t(lround(clamp(v, 0., 1.) * 255.));
+		};
+	for(int i=0; i<=cpuMaxIterations; i++) {
+		double l = double(i) / cpuMaxIterations;
+		double rgb[3] = { 0., 0., 0. };
+		if(l <= 0.999) {
+			double h = 2./3. - l;
+			const double offsets[3] = { 1., 2./3., 1./3. };
+			for(int j=0; j<3; j++) {
+				double x = h + offsets[j];
+				rgb[j] = clamp(abs((x - floor(x)) * 6. - 3.) - 1., 0., 1.);
+			}
+		}
+		uint32_t r = toByte(rgb[0], srgb);
+		uint32_t g = toByte(rgb[1], srgb);
+		uint32_t b = toByte(rgb[2], srgb);
+		cpuPalette[i] = bgra
+			? b | (g << 8) | (r << 16) | (0xffu << 24)
+			: r | (g << 8) | (b << 16) | (0xffu << 24);
+	}
+}
+
+
+void App::resizeCpu(vk::Extent2D extent)
+{
+	// destroy previous resources
+	if(stagingBufferMemory)
+		device.unmapMemory(stagingBufferMemory);
+	device.destroy(stagingBuffer);
+	device.free(stagingBufferMemory);
+
+	// staging buffer
+	// (the buffer is host visible and coherent, it is written after the frame fence is signaled)
+	stagingExtent = extent;
+	stagingBuffer =
+		device.createBuffer(
+			vk::BufferCreateInfo(
+				vk::BufferCreateFlags(),  // flags
+				size_t(extent.width) * extent.height * sizeof(uint32_t),  // size
+				vk::BufferUsageFlagBits::eTransferSrc,  // usage
+				vk::SharingMode::eExclusive,  // sharingMode
+				0,  // queueFamilyIndexCount
+				nullptr  // pQueueFamilyIndices
+			)
+		);
+	vk::MemoryRequirements memoryRequirements = device.getBufferMemoryRequirements(stagingBuffer);
+	stagingBufferMemory =
+		device.allocateMemory(
+			vk::MemoryAllocateInfo(
+				memoryRequirements.size,  // allocationSize
+				findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits,  // memoryTypeIndex
+				               vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+			)
+		);
+	device.bindBufferMemory(stagingBuffer, stagingBufferMemory, 0);
+	stagingData = reinterpret_cast<uint32_t*>(device.mapMemory(stagingBufferMemory, 0, VK_WHOLE_SIZE));
+}
+
+
+// compute orbit of z = z^2 + c in double-double precision until it escapes or maxIterations is reached;
+// the orbit starts by z = 0
+static void computeOrbit(DoubleDouble cx, DoubleDouble cy, int maxIterations, vector<complex<double>>& orbit)
+{
+	orbit.clear();
+	orbit.emplace_back(0., 0.);
+	DoubleDouble x = 0., y = 0.;
+	for(int i=0; i<maxIterations; i++) {
+		DoubleDouble xy = x * y;
+		x = x * x - y * y + cx;
+		y = xy + xy + cy;
+		complex<double> z{ double(x), double(y) };
+		orbit.push_back(z);
+		if(norm(z) >= 4.)
+			break;
+	}
+}
+
+
+void App::computeReferenceOrbit()
+{
+	// reference point
+	// (the view center is used if it does not escape; otherwise, the point with the longest orbit
+	// from the grid of candidates is used, because the pixels that outlive the reference orbit
+	// lose their precision)
+	uint32_t width = window.surfaceWidth();
+	uint32_t height = window.surfaceHeight();
+	vector<complex<double>> orbit;
+	computeOrbit(centerX, centerY, maxIterations, orbit);
+	double referenceX = width / 2.;
+	double referenceY = height / 2.;
+	if(orbit.size() <= size_t(maxIterations)) {
+		constexpr int gridSize = 5;
+		vector<complex<double>> candidateOrbit;
+		for(int j=0; j<gridSize; j++)
+			for(int i=0; i<gridSize; i++) {
+				double x = width * (i + 0.5) / gridSize;
+				double y = height * (j + 0.5) / gridSize;
+				computeOrbit(centerX + (x - width / 2.) * valueGradient,
+				             centerY + (y - height / 2.) * valueGradient,
+				             maxIterations, candidateOrbit);
+				if(candidateOrbit.size() > orbit.size()) {
+					orbit.swap(candidateOrbit);
+					referenceX = x;
+					referenceY = y;
+				}
+			}
+	}
+
+	// upload the orbit
+	for(size_t n=0; n<orbit.size(); n++) {
+		orbitData[n*2+0] = float(orbit[n].real());
+		orbitData[n*2+1] = float(orbit[n].imag());
+	}
+
+	// series approximation
+	// (delta of z after n iterations is approximated by A*dc + B*dc^2 + C*dc^3;
+	// the coefficients are scaled by the pixel size, so they are used with dc in pixels;
+	// iterations are skipped while the cubic term stays negligible for the farthest pixel)
+	double s = valueGradient;
+	double dMax = hypot(max(referenceX, width - referenceX), max(referenceY, height - referenceY));
+	complex<double> a = 0., b = 0., c = 0.;
+	int skippedIterations = 0;
+	for(size_t n=0; n+2<orbit.size(); n++) {
+		complex<double> z2 = 2. * orbit[n];
+		complex<double> a2 = z2 * a + 1.;
+		complex<double> b2 = z2 * b + s * a * a;
+		complex<double> c2 = z2 * c + 2. * s * a * b;
+		if(abs(c2) * dMax * dMax > 1e-7 * abs(a2) || !isfinite(abs(a2)) || abs(a2) > 1e30)
+			break;
+		a = a2;
+		b = b2;
+		c = c2;
+		skippedIterations = int(n + 1);
+	}
+
+	deepZoomPushData = {
+		{ float(referenceX), float(referenceY) },
+		float(valueGradient),
+		maxIterations,
+		int32_t(orbit.size()),
+		skippedIterations,
+		{ float(a.real()), float(a.imag()) },
+		{ float(b.real()), float(b.imag()) },
+		{ float(c.real()), float(c.imag()) },
+	};
+	orbitUpToDate = true;
+	if(deepZoomVerbose)
+		cout << "Reference orbit: " << orbit.size() << " items, " << skippedIterations
+		     << " iterations skipped by series approximation" << endl;
+}
+
+
+/** Recreate swapchain callback.
  *  The function is usually called after the window resize and on the application start. */
 void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 {
@@ -487,6 +1275,14 @@ void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 	else
 		newSurfaceExtent = surfaceCapabilities.currentExtent;
 
+	// CPU renderer copies its image into the swapchain images
+	vk::ImageUsageFlags imageUsage = vk::ImageUsageFlagBits::eColorAttachment;
+	if(useCpu) {
+		if(!(surfaceCapabilities.supportedUsageFlags & vk::ImageUsageFlagBits::eTransferDst))
+			throw runtime_error("CPU renderer is not supported because swapchain images cannot be used as transfer destination.");
+		imageUsage |= vk::ImageUsageFlagBits::eTransferDst;
+	}
+
 	// update VulkanWindow surface size
 	widthToBeSet = newSurfaceExtent.width;
 	heightToBeSet = newSurfaceExtent.height;
@@ -496,8 +1292,6 @@ void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 	swapchainImageViews.clear();
 	for(auto f : framebuffers)  device.destroy(f);
 	framebuffers.clear();
-	device.destroy(pipeline);
-	pipeline = nullptr;
 
 	// print info
 	cout << "Recreating swapchain (extent: " << newSurfaceExtent.width << "x" << newSurfaceExtent.height
@@ -519,7 +1313,7 @@ void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 				surfaceFormat.colorSpace,       // imageColorSpace
 				newSurfaceExtent,               // imageExtent
 				1,                              // imageArrayLayers
-				vk::ImageUsageFlagBits::eColorAttachment,  // imageUsage
+				imageUsage,                     // imageUsage
 				(graphicsQueueFamily==presentationQueueFamily) ? vk::SharingMode::eExclusive : vk::SharingMode::eConcurrent, // imageSharingMode
 				uint32_t(2),  // queueFamilyIndexCount
 				array<uint32_t, 2>{graphicsQueueFamily, presentationQueueFamily}.data(),  // pQueueFamilyIndices
@@ -548,7 +1342,7 @@ void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 	swapchain = newSwapchain.release();
 
 	// swapchain images and image views
-	vector<vk::Image> swapchainImages = device.getSwapchainImagesKHR(swapchain);
+	swapchainImages = device.getSwapchainImagesKHR(swapchain);
 	swapchainImageViews.reserve(swapchainImages.size());
 	for(vk::Image image : swapchainImages)
 		swapchainImageViews.emplace_back(
@@ -601,144 +1395,598 @@ void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 				device.createSemaphore(semaphoreCreateInfo));
 	}
 
-	// pipeline
-	pipeline =
-		device.createGraphicsPipeline(
-			nullptr,  // pipelineCache
-			vk::GraphicsPipelineCreateInfo(
-				vk::PipelineCreateFlags(),  // flags
+	// compute renderer resources
+	if(useCompute)
+		resizeCompute(newSurfaceExtent);
 
-				// shader stages
-				2,  // stageCount
-				array{  // pStages
-					vk::PipelineShaderStageCreateInfo{
-						vk::PipelineShaderStageCreateFlags(),  // flags
-						vk::ShaderStageFlagBits::eVertex,  // stage
-						vsModule,  // module
-						"main",  // pName
-						nullptr  // pSpecializationInfo
-					},
-					vk::PipelineShaderStageCreateInfo{
-						vk::PipelineShaderStageCreateFlags(),  // flags
-						vk::ShaderStageFlagBits::eFragment,  // stage
-						fsModule,  // module
-						"main",  // pName
-						nullptr  // pSpecializationInfo
-					},
-				}.data(),
+	// CPU renderer resources
+	if(useCpu)
+		resizeCpu(newSurfaceExtent);
 
-				// vertex input
-				&(const vk::PipelineVertexInputStateCreateInfo&)vk::PipelineVertexInputStateCreateInfo{  // pVertexInputState
-					vk::PipelineVertexInputStateCreateFlags(),  // flags
-					0,        // vertexBindingDescriptionCount
-					nullptr,  // pVertexBindingDescriptions
-					0,        // vertexAttributeDescriptionCount
-					nullptr   // pVertexAttributeDescriptions
-				},
+	// set view
+	if(valueGradient == -1.) {
+		valueGradient = 4. / newSurfaceExtent.height;
+		setView(float(newSurfaceExtent.width)/2, float(newSurfaceExtent.height)/2, 0., 0.);
+	}
+	else {
+		valueGradient *= double(windowHeight) / newSurfaceExtent.height;
+		setView(float(newSurfaceExtent.width)/2, float(newSurfaceExtent.height)/2, centerX, centerY);
+	}
+	windowHeight = newSurfaceExtent.height;
+}
 
-				// input assembly
-				&(const vk::PipelineInputAssemblyStateCreateInfo&)vk::PipelineInputAssemblyStateCreateInfo{  // pInputAssemblyState
-					vk::PipelineInputAssemblyStateCreateFlags(),  // flags
-					vk::PrimitiveTopology::eTriangleStrip,  // topology
-					VK_FALSE  // primitiveRestartEnable
-				},
 
-				// tessellation
-				nullptr, // pTessellationState
-
-				// viewport
-				&(const vk::PipelineViewportStateCreateInfo&)vk::PipelineViewportStateCreateInfo{  // pViewportState
-					vk::PipelineViewportStateCreateFlags(),  // flags
-					1,  // viewportCount
-					array{  // pViewports
-						vk::Viewport(0.f, 0.f, float(newSurfaceExtent.width), float(newSurfaceExtent.height), 0.f, 1.f),
-					}.data(),
-					1,  // scissorCount
-					array{  // pScissors
-						vk::Rect2D(vk::Offset2D(0,0), newSurfaceExtent)
-					}.data(),
-				},
+void App::setView(float coordX, float coordY, DoubleDouble valueX, DoubleDouble valueY)
+{
+	double halfWidth = window.surfaceWidth() / 2.;
+	double halfHeight = window.surfaceHeight() / 2.;
+	centerX = valueX + (halfWidth - coordX) * valueGradient;
+	centerY = valueY + (halfHeight - coordY) * valueGradient;
+	minX = float(double(centerX) - halfWidth * valueGradient);
+	minY = float(double(centerY) - halfHeight * valueGradient);
+	maxX = float(double(centerX) + halfWidth * valueGradient);
+	maxY = float(double(centerY) + halfHeight * valueGradient);
+	cout << "New coords: " << minX << "," << minY << ", " << maxX << "," << maxY
+	     << " (zoom " << 4. / (window.surfaceHeight() * valueGradient) << ")" << endl;
+
+	// compute renderer detects the view change in recordCompute()
+	// and reprojects or recomputes the tiles,
+	// deep zoom renderer recomputes the reference orbit in frame()
+	orbitUpToDate = false;
+}
 
-				// rasterization
-				&(const vk::PipelineRasterizationStateCreateInfo&)vk::PipelineRasterizationStateCreateInfo{  // pRasterizationState
-					vk::PipelineRasterizationStateCreateFlags(),  // flags
-					VK_FALSE,  // depthClampEnable
-					VK_FALSE,  // rasterizerDiscardEnable
-					vk::PolygonMode::eFill,  // polygonMode
-					vk::CullModeFlagBits::eNone,  // cullMode
-					vk::FrontFace::eCounterClockwise,  // frontFace
-					VK_FALSE,  // depthBiasEnable
-					0.f,  // depthBiasConstantFactor
-					0.f,  // depthBiasClamp
-					0.f,  // depthBiasSlopeFactor
-					1.f   // lineWidth
-				},
 
-				// multisampling
-				&(const vk::PipelineMultisampleStateCreateInfo&)vk::PipelineMultisampleStateCreateInfo{  // pMultisampleState
-					vk::PipelineMultisampleStateCreateFlags(),  // flags
-					vk::SampleCountFlagBits::e1,  // rasterizationSamples
-					VK_FALSE,  // sampleShadingEnable
-					0.f,       // minSampleShading
-					nullptr,   // pSampleMask
-					VK_FALSE,  // alphaToCoverageEnable
-					VK_FALSE   // alphaToOneEnable
-				},
+void App::resizeCompute(vk::Extent2D extent)
+{
+	// destroy previous resources
+	if(axisMapBufferMemory)
+		device.unmapMemory(axisMapBufferMemory);
+	device.destroy(axisMapBuffer);
+	device.free(axisMapBufferMemory);
+	if(tileBufferMemory)
+		device.unmapMemory(tileBufferMemory);
+	device.destroy(tileBuffer);
+	device.free(tileBufferMemory);
+	for(auto v : stateImageViews)  device.destroy(v);
+	for(auto i : stateImages)  device.destroy(i);
+	for(auto m : stateImageMemories)  device.free(m);
+
+	// state images
+	// (the current one and the previous one used by the reprojection)
+	for(size_t i=0; i<stateImages.size(); i++) {
+		stateImages[i] =
+			device.createImage(
+				vk::ImageCreateInfo(
+					vk::ImageCreateFlags(),  // flags
+					vk::ImageType::e2D,  // imageType
+					vk::Format::eR32G32B32A32Sfloat,  // format
+					vk::Extent3D(extent.width, extent.height, 1),  // extent
+					1,  // mipLevels
+					1,  // arrayLayers
+					vk::SampleCountFlagBits::e1,  // samples
+					vk::ImageTiling::eOptimal,  // tiling
+					vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eTransferDst,  // usage
+					vk::SharingMode::eExclusive,  // sharingMode
+					0,  // queueFamilyIndexCount
+					nullptr,  // pQueueFamilyIndices
+					vk::ImageLayout::eUndefined  // initialLayout
+				)
+			);
+		vk::MemoryRequirements memoryRequirements = device.getImageMemoryRequirements(stateImages[i]);
+		stateImageMemories[i] =
+			device.allocateMemory(
+				vk::MemoryAllocateInfo(
+					memoryRequirements.size,  // allocationSize
+					findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits,  // memoryTypeIndex
+					               vk::MemoryPropertyFlagBits::eDeviceLocal)
+				)
+			);
+		device.bindImageMemory(stateImages[i], stateImageMemories[i], 0);
+		stateImageViews[i] =
+			device.createImageView(
+				vk::ImageViewCreateInfo(
+					vk::ImageViewCreateFlags(),  // flags
+					stateImages[i],              // image
+					vk::ImageViewType::e2D,      // viewType
+					vk::Format::eR32G32B32A32Sfloat,  // format
+					vk::ComponentMapping(),      // components
+					vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)  // subresourceRange
+				)
+			);
+	}
+	currentStateImage = 0;
+	stateImageInitialized = false;
+
+	// tiles and tile counter buffer
+	// (the buffer is host visible and coherent, it is read after the frame fence is signaled)
+	numTilesX = (extent.width + tileSize - 1) / tileSize;
+	uint32_t numTilesY = (extent.height + tileSize - 1) / tileSize;
+	computeExtent = extent;
+	tiles.resize(size_t(numTilesX) * numTilesY);
+	tileBuffer =
+		device.createBuffer(
+			vk::BufferCreateInfo(
+				vk::BufferCreateFlags(),  // flags
+				tiles.size() * sizeof(uint32_t),  // size
+				vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,  // usage
+				vk::SharingMode::eExclusive,  // sharingMode
+				0,  // queueFamilyIndexCount
+				nullptr  // pQueueFamilyIndices
+			)
+		);
+	vk::MemoryRequirements memoryRequirements = device.getBufferMemoryRequirements(tileBuffer);
+	tileBufferMemory =
+		device.allocateMemory(
+			vk::MemoryAllocateInfo(
+				memoryRequirements.size,  // allocationSize
+				findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits,  // memoryTypeIndex
+				               vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+			)
+		);
+	device.bindBufferMemory(tileBuffer, tileBufferMemory, 0);
+	tileCounters = reinterpret_cast<uint32_t*>(device.mapMemory(tileBufferMemory, 0, VK_WHOLE_SIZE));
+	resetTiles();
+
+	// axis map buffer
+	// (one item for each column and each row, written by the host before the reprojection)
+	axisMapBuffer =
+		device.createBuffer(
+			vk::BufferCreateInfo(
+				vk::BufferCreateFlags(),  // flags
+				(size_t(extent.width) + extent.height) * sizeof(AxisMap),  // size
+				vk::BufferUsageFlagBits::eStorageBuffer,  // usage
+				vk::SharingMode::eExclusive,  // sharingMode
+				0,  // queueFamilyIndexCount
+				nullptr  // pQueueFamilyIndices
+			)
+		);
+	memoryRequirements = device.getBufferMemoryRequirements(axisMapBuffer);
+	axisMapBufferMemory =
+		device.allocateMemory(
+			vk::MemoryAllocateInfo(
+				memoryRequirements.size,  // allocationSize
+				findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits,  // memoryTypeIndex
+				               vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+			)
+		);
+	device.bindBufferMemory(axisMapBuffer, axisMapBufferMemory, 0);
+	axisMaps = reinterpret_cast<AxisMap*>(device.mapMemory(axisMapBufferMemory, 0, VK_WHOLE_SIZE));
+
+	// update descriptors
+	for(size_t i=0; i<computeDescriptorSets.size(); i++)
+		device.updateDescriptorSets(
+			array{
+				vk::WriteDescriptorSet(
+					computeDescriptorSets[i],  // dstSet
+					0,  // dstBinding
+					0,  // dstArrayElement
+					1,  // descriptorCount
+					vk::DescriptorType::eStorageImage,  // descriptorType
+					&(const vk::DescriptorImageInfo&)vk::DescriptorImageInfo(  // pImageInfo
+						nullptr,  // sampler
+						stateImageViews[i],  // imageView
+						vk::ImageLayout::eGeneral  // imageLayout
+					),
+					nullptr,  // pBufferInfo
+					nullptr  // pTexelBufferView
+				),
+				vk::WriteDescriptorSet(
+					computeDescriptorSets[i],  // dstSet
+					1,  // dstBinding
+					0,  // dstArrayElement
+					1,  // descriptorCount
+					vk::DescriptorType::eStorageBuffer,  // descriptorType
+					nullptr,  // pImageInfo
+					&(const vk::DescriptorBufferInfo&)vk::DescriptorBufferInfo(  // pBufferInfo
+						tileBuffer,  // buffer
+						0,  // offset
+						VK_WHOLE_SIZE  // range
+					),
+					nullptr  // pTexelBufferView
+				),
+				vk::WriteDescriptorSet(
+					computeDescriptorSets[i],  // dstSet
+					2,  // dstBinding
+					0,  // dstArrayElement
+					1,  // descriptorCount
+					vk::DescriptorType::eStorageImage,  // descriptorType
+					&(const vk::DescriptorImageInfo&)vk::DescriptorImageInfo(  // pImageInfo
+						nullptr,  // sampler
+						stateImageViews[1-i],  // imageView
+						vk::ImageLayout::eGeneral  // imageLayout
+					),
+					nullptr,  // pBufferInfo
+					nullptr  // pTexelBufferView
+				),
+				vk::WriteDescriptorSet(
+					computeDescriptorSets[i],  // dstSet
+					3,  // dstBinding
+					0,  // dstArrayElement
+					1,  // descriptorCount
+					vk::DescriptorType::eStorageBuffer,  // descriptorType
+					nullptr,  // pImageInfo
+					&(const vk::DescriptorBufferInfo&)vk::DescriptorBufferInfo(  // pBufferInfo
+						axisMapBuffer,  // buffer
+						0,  // offset
+						VK_WHOLE_SIZE  // range
+					),
+					nullptr  // pTexelBufferView
+				),
+			},
+			nullptr  // descriptorCopies
+		);
+}
 
-				// depth and stencil
-				nullptr,  // pDepthStencilState
 
-				// blending
-				&(const vk::PipelineColorBlendStateCreateInfo&)vk::PipelineColorBlendStateCreateInfo{  // pColorBlendState
-					vk::PipelineColorBlendStateCreateFlags(),  // flags
-					VK_FALSE,  // logicOpEnable
-					vk::LogicOp::eClear,  // logicOp
-					1,  // attachmentCount
-					array{  // pAttachments
-						vk::PipelineColorBlendAttachmentState{
-							VK_FALSE,  // blendEnable
-							vk::BlendFactor::eZero,  // srcColorBlendFactor
-							vk::BlendFactor::eZero,  // dstColorBlendFactor
-							vk::BlendOp::eAdd,       // colorBlendOp
-							vk::BlendFactor::eZero,  // srcAlphaBlendFactor
-							vk::BlendFactor::eZero,  // dstAlphaBlendFactor
-							vk::BlendOp::eAdd,       // alphaBlendOp
-							vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
-								vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA  // colorWriteMask
-						},
-					}.data(),
-					array<float,4>{0.f,0.f,0.f,0.f}  // blendConstants
-				},
+void App::resetTiles()
+{
+	// mark all tiles for recomputation
+	for(size_t i=0; i<tiles.size(); i++) {
+		uint32_t x = uint32_t(i % numTilesX) * tileSize;
+		uint32_t y = uint32_t(i / numTilesX) * tileSize;
+		tiles[i].unfinishedPixels = min(tileSize, computeExtent.width - x) * min(tileSize, computeExtent.height - y);
+		tiles[i].reset = true;
+	}
+	tileCursor = 0;
+	dispatchedTiles.clear();
+}
 
-				nullptr,  // pDynamicState
-				pipelineLayout,  // layout
-				renderPass,  // renderPass
-				0,  // subpass
-				vk::Pipeline(nullptr),  // basePipelineHandle
-				-1 // basePipelineIndex
-			)
-		).value;
 
-	// set view
-	if(valueGradient == -1.f) {
-		valueGradient = 4.f / newSurfaceExtent.height;
-		setView(float(newSurfaceExtent.width)/2, float(newSurfaceExtent.height)/2, 0.f, 0.f);
+void App::reproject()
+{
+	// axis maps
+	// (they are computed in double precision; x and y are independent,
+	// so the previous state pixel is found separately for each column and each row;
+	// the previous frame is finished, so the buffer can be rewritten)
+	auto mapAxis =
+		[](AxisMap* axisMap, uint32_t size, double newMin, double newMax, double oldMin, double oldMax)
+		{
+			double newPixelSize = (newMax - newMin) / size;
+			double oldPixelSize = (oldMax - oldMin) / size;
+			for(uint32_t i=0; i<size; i++) {
+				double u = (newMin + (i + 0.5) * newPixelSize - oldMin) / oldPixelSize - 0.5;
+				double p = floor(u + 0.5);
+				if(p < 0. || p >= size)
+					axisMap[i] = { -1, 0.f };
+				else
+					axisMap[i] = { int32_t(p), float((p - u) * oldPixelSize / newPixelSize) };
+			}
+		};
+	uint32_t width = computeExtent.width;
+	uint32_t height = computeExtent.height;
+	mapAxis(axisMaps, width, minX, maxX, stateView[0], stateView[2]);
+	mapAxis(axisMaps + width, height, minY, maxY, stateView[1], stateView[3]);
+
+	// estimate unfinished pixels of each tile
+	// (the pixels not covered by reused columns and rows need to be recomputed;
+	// tiles that are expected to be finished get non-zero estimate, so they are dispatched once
+	// and the exact number of unfinished pixels is read back from the tile counters)
+	auto isReused = [](const AxisMap& m) { return m.source >= 0 && fabs(m.offset) <= reprojectionThreshold; };
+	for(size_t i=0; i<tiles.size(); i++) {
+		uint32_t x1 = uint32_t(i % numTilesX) * tileSize;
+		uint32_t y1 = uint32_t(i / numTilesX) * tileSize;
+		uint32_t x2 = min(x1 + tileSize, width);
+		uint32_t y2 = min(y1 + tileSize, height);
+		uint32_t reusedColumns = 0;
+		for(uint32_t x=x1; x<x2; x++)
+			reusedColumns += isReused(axisMaps[x]);
+		uint32_t reusedRows = 0;
+		for(uint32_t y=y1; y<y2; y++)
+			reusedRows += isReused(axisMaps[width + y]);
+		tiles[i].unfinishedPixels = max((x2 - x1) * (y2 - y1) - reusedColumns * reusedRows, 1u);
+		tiles[i].reset = false;
+	}
+	tileCursor = 0;
+
+	// reproject previous state into the other state image
+	unsigned newStateImage = 1 - currentStateImage;
+	commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, reprojectPipeline);
+	commandBuffer.bindDescriptorSets(
+		vk::PipelineBindPoint::eCompute,  // pipelineBindPoint
+		computePipelineLayout,  // layout
+		0,  // firstSet
+		computeDescriptorSets[newStateImage],  // descriptorSets
+		nullptr  // dynamicOffsets
+	);
+	struct ReprojectPushData {
+		int32_t viewSize[2];
+		float scale;
+		float threshold;
+	};
+	commandBuffer.pushConstants(
+		computePipelineLayout,  // layout
+		vk::ShaderStageFlagBits::eCompute,  // stageFlags
+		0,  // offset
+		sizeof(ReprojectPushData),  // size
+		&(const ReprojectPushData&)ReprojectPushData{  // pValues
+			{ int32_t(width), int32_t(height) },
+			float((double(stateView[2]) - stateView[0]) / (double(maxX) - minX)),
+			reprojectionThreshold,
+		}
+	);
+	commandBuffer.dispatch((width + 7) / 8, (height + 7) / 8, 1);
+	currentStateImage = newStateImage;
+
+	// make the new state visible to the tile dispatches
+	commandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eComputeShader,  // srcStageMask
+		vk::PipelineStageFlagBits::eComputeShader,  // dstStageMask
+		vk::DependencyFlags(),  // dependencyFlags
+		vk::MemoryBarrier(  // memoryBarriers
+			vk::AccessFlagBits::eShaderWrite,  // srcAccessMask
+			vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite  // dstAccessMask
+		),
+		nullptr,  // bufferMemoryBarriers
+		nullptr  // imageMemoryBarriers
+	);
+}
+
+
+void App::recordCompute()
+{
+	// update tiles by the results of the previous frame
+	// (the previous frame is already finished because its fence was waited for)
+	for(uint32_t t : dispatchedTiles)
+		tiles[t].unfinishedPixels = tileCounters[t];
+	dispatchedTiles.clear();
+
+	// make state images available to the compute shaders
+	// (on the first use, the layout is changed to eGeneral and both images are cleared
+	// to running state with zero iterations, so the reprojection never reads undefined content)
+	if(!stateImageInitialized) {
+		auto makeBarrier =
+			[](vk::Image image) {
+				return
+					vk::ImageMemoryBarrier(
+						vk::AccessFlags(),  // srcAccessMask
+						vk::AccessFlagBits::eTransferWrite,  // dstAccessMask
+						vk::ImageLayout::eUndefined,  // oldLayout
+						vk::ImageLayout::eGeneral,  // newLayout
+						VK_QUEUE_FAMILY_IGNORED,  // srcQueueFamilyIndex
+						VK_QUEUE_FAMILY_IGNORED,  // dstQueueFamilyIndex
+						image,  // image
+						vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)  // subresourceRange
+					);
+			};
+		commandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eTopOfPipe,  // srcStageMask
+			vk::PipelineStageFlagBits::eTransfer,  // dstStageMask
+			vk::DependencyFlags(),  // dependencyFlags
+			nullptr,  // memoryBarriers
+			nullptr,  // bufferMemoryBarriers
+			array{  // imageMemoryBarriers
+				makeBarrier(stateImages[0]),
+				makeBarrier(stateImages[1]),
+			}
+		);
+		for(vk::Image image : stateImages)
+			commandBuffer.clearColorImage(
+				image,  // image
+				vk::ImageLayout::eGeneral,  // imageLayout
+				vk::ClearColorValue(array<float, 4>{0.f, 0.f, 0.f, 0.f}),  // color - zero z, zero iterations, statusRunning
+				vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)  // ranges
+			);
+		commandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eTransfer,  // srcStageMask
+			vk::PipelineStageFlagBits::eComputeShader,  // dstStageMask
+			vk::DependencyFlags(),  // dependencyFlags
+			vk::MemoryBarrier(  // memoryBarriers
+				vk::AccessFlagBits::eTransferWrite,  // srcAccessMask
+				vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite  // dstAccessMask
+			),
+			nullptr,  // bufferMemoryBarriers
+			nullptr  // imageMemoryBarriers
+		);
+		stateImageInitialized = true;
+		stateView[0] = minX;
+		stateView[1] = minY;
+		stateView[2] = maxX;
+		stateView[3] = maxY;
 	}
 	else {
-		valueGradient *= float(windowHeight) / newSurfaceExtent.height;
-		setView(float(newSurfaceExtent.width)/2, float(newSurfaceExtent.height)/2, (minX+maxX)/2, (minY+maxY)/2);
+		commandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eFragmentShader,  // srcStageMask
+			vk::PipelineStageFlagBits::eComputeShader,  // dstStageMask
+			vk::DependencyFlags(),  // dependencyFlags
+			vk::MemoryBarrier(  // memoryBarriers
+				vk::AccessFlagBits::eShaderWrite,  // srcAccessMask
+				vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite  // dstAccessMask
+			),
+			nullptr,  // bufferMemoryBarriers
+			nullptr  // imageMemoryBarriers
+		);
+
+		// view changed since the state was computed
+		if(minX != stateView[0] || minY != stateView[1] || maxX != stateView[2] || maxY != stateView[3]) {
+			if(useReprojection)
+				reproject();
+			else
+				resetTiles();
+			stateView[0] = minX;
+			stateView[1] = minY;
+			stateView[2] = maxX;
+			stateView[3] = maxY;
+		}
 	}
-	windowHeight = newSurfaceExtent.height;
+
+	// dispatch unfinished tiles in round-robin order
+	// until the iteration budget is spent (at least one tile is dispatched);
+	// if all unfinished tiles were dispatched and the budget remains, they are dispatched again in the next pass
+	// (the pass count is limited by the number of passes needed to reach maxIterations)
+	commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, computePipeline);
+	commandBuffer.bindDescriptorSets(
+		vk::PipelineBindPoint::eCompute,  // pipelineBindPoint
+		computePipelineLayout,  // layout
+		0,  // firstSet
+		computeDescriptorSets[currentStateImage],  // descriptorSets
+		nullptr  // dynamicOffsets
+	);
+	struct ComputePushData {
+		float view[4];
+		int32_t tileOffset[2];
+		int32_t viewSize[2];
+		int32_t iterationsPerPass;
+		int32_t maxIterations;
+		int32_t resetTile;
+		uint32_t tileIndex;
+	};
+	static_assert(sizeof(ComputePushData) == 48, "Wrong ComputePushData size.");
+	uint64_t budget = iterationBudget;
+	int maxPasses = (maxIterations + iterationsPerPass - 1) / iterationsPerPass;
+	vector<uint32_t> passTiles;
+	for(int pass=0; pass<maxPasses; pass++) {
+
+		// select tiles of this pass
+		passTiles.clear();
+		bool budgetSpent = false;
+		for(size_t n=0, c=tiles.size(); n<c; n++) {
+			uint32_t t = uint32_t(tileCursor);
+			Tile& tile = tiles[t];
+			if(tile.unfinishedPixels == 0) {
+				tileCursor = (tileCursor + 1) % c;
+				continue;
+			}
+			uint64_t cost = uint64_t(tile.unfinishedPixels) * iterationsPerPass;
+			if(cost > budget && (pass != 0 || !passTiles.empty())) {
+				budgetSpent = true;
+				break;
+			}
+			budget -= min(cost, budget);
+			tileCursor = (tileCursor + 1) % c;
+			passTiles.push_back(t);
+		}
+		if(passTiles.empty())
+			break;
+
+		// reset tile counters
+		// (counters of the first pass are reset by the host; in the next passes,
+		// the counters are cleared after the previous pass, so they hold the result of the last pass only)
+		if(pass == 0) {
+			for(uint32_t t : passTiles)
+				tileCounters[t] = 0;
+			dispatchedTiles = passTiles;
+		}
+		else {
+			commandBuffer.pipelineBarrier(
+				vk::PipelineStageFlagBits::eComputeShader,  // srcStageMask
+				vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eComputeShader,  // dstStageMask
+				vk::DependencyFlags(),  // dependencyFlags
+				vk::MemoryBarrier(  // memoryBarriers
+					vk::AccessFlagBits::eShaderWrite,  // srcAccessMask
+					vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite  // dstAccessMask
+				),
+				nullptr,  // bufferMemoryBarriers
+				nullptr  // imageMemoryBarriers
+			);
+			for(uint32_t t : passTiles)
+				commandBuffer.fillBuffer(tileBuffer, t * sizeof(uint32_t), sizeof(uint32_t), 0);
+			commandBuffer.pipelineBarrier(
+				vk::PipelineStageFlagBits::eTransfer,  // srcStageMask
+				vk::PipelineStageFlagBits::eComputeShader,  // dstStageMask
+				vk::DependencyFlags(),  // dependencyFlags
+				vk::MemoryBarrier(  // memoryBarriers
+					vk::AccessFlagBits::eTransferWrite,  // srcAccessMask
+					vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite  // dstAccessMask
+				),
+				nullptr,  // bufferMemoryBarriers
+				nullptr  // imageMemoryBarriers
+			);
+		}
+
+		// dispatch
+		for(uint32_t t : passTiles) {
+			Tile& tile = tiles[t];
+			commandBuffer.pushConstants(
+				computePipelineLayout,  // layout
+				vk::ShaderStageFlagBits::eCompute,  // stageFlags
+				0,  // offset
+				sizeof(ComputePushData),  // size
+				&(const ComputePushData&)ComputePushData{  // pValues
+					{ minX, minY, maxX, maxY },
+					{ int32_t(t % numTilesX * tileSize), int32_t(t / numTilesX * tileSize) },
+					{ int32_t(computeExtent.width), int32_t(computeExtent.height) },
+					iterationsPerPass,
+					maxIterations,
+					tile.reset ? 1 : 0,
+					t,
+				}
+			);
+			commandBuffer.dispatch(tileSize / 8, tileSize / 8, 1);
+			tile.reset = false;
+		}
+
+		// continue only if all unfinished tiles were dispatched
+		if(budgetSpent)
+			break;
+	}
+
+	// make the results visible to the display shader and to the host
+	commandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eComputeShader,  // srcStageMask
+		vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eHost,  // dstStageMask
+		vk::DependencyFlags(),  // dependencyFlags
+		vk::MemoryBarrier(  // memoryBarriers
+			vk::AccessFlagBits::eShaderWrite,  // srcAccessMask
+			vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eHostRead  // dstAccessMask
+		),
+		nullptr,  // bufferMemoryBarriers
+		nullptr  // imageMemoryBarriers
+	);
 }
 
 
-void App::setView(float coordX, float coordY, float valueX, float valueY)
+void App::recordCpu(uint32_t imageIndex)
 {
-	minY = valueY - (coordY * valueGradient);
-	maxY = valueY + ((int(window.surfaceHeight()) - coordY) * valueGradient);
-	minX = valueX - (coordX * valueGradient);
-	maxX = valueX + ((int(window.surfaceWidth()) - coordX) * valueGradient);
-	cout << "New coords: " << minX << "," << minY << ", " << maxX << "," << maxY << endl;
+	// copy the image rendered by CPU into the swapchain image
+	// (the previous content of the swapchain image is discarded)
+	vk::Image image = swapchainImages[imageIndex];
+	commandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTransfer,  // srcStageMask
+		vk::PipelineStageFlagBits::eTransfer,  // dstStageMask
+		vk::DependencyFlags(),  // dependencyFlags
+		nullptr,  // memoryBarriers
+		nullptr,  // bufferMemoryBarriers
+		vk::ImageMemoryBarrier(  // imageMemoryBarriers
+			vk::AccessFlags(),  // srcAccessMask
+			vk::AccessFlagBits::eTransferWrite,  // dstAccessMask
+			vk::ImageLayout::eUndefined,  // oldLayout
+			vk::ImageLayout::eTransferDstOptimal,  // newLayout
+			VK_QUEUE_FAMILY_IGNORED,  // srcQueueFamilyIndex
+			VK_QUEUE_FAMILY_IGNORED,  // dstQueueFamilyIndex
+			image,  // image
+			vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)  // subresourceRange
+		)
+	);
+	commandBuffer.copyBufferToImage(
+		stagingBuffer,  // srcBuffer
+		image,  // dstImage
+		vk::ImageLayout::eTransferDstOptimal,  // dstImageLayout
+		vk::BufferImageCopy(  // regions
+			0,  // bufferOffset
+			0,  // bufferRowLength
+			0,  // bufferImageHeight
+			vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1),  // imageSubresource
+			vk::Offset3D(0, 0, 0),  // imageOffset
+			vk::Extent3D(stagingExtent.width, stagingExtent.height, 1)  // imageExtent
+		)
+	);
+	commandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTransfer,  // srcStageMask
+		vk::PipelineStageFlagBits::eBottomOfPipe,  // dstStageMask
+		vk::DependencyFlags(),  // dependencyFlags
+		nullptr,  // memoryBarriers
+		nullptr,  // bufferMemoryBarriers
+		vk::ImageMemoryBarrier(  // imageMemoryBarriers
+			vk::AccessFlagBits::eTransferWrite,  // srcAccessMask
+			vk::AccessFlags(),  // dstAccessMask
+			vk::ImageLayout::eTransferDstOptimal,  // oldLayout
+			vk::ImageLayout::ePresentSrcKHR,  // newLayout
+			VK_QUEUE_FAMILY_IGNORED,  // srcQueueFamilyIndex
+			VK_QUEUE_FAMILY_IGNORED,  // dstQueueFamilyIndex
+			image,  // image
+			vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)  // subresourceRange
+		)
+	);
 }
 
 
@@ -761,6 +2009,25 @@ void App::frame(VulkanWindow&)
 	}
 	device.resetFences(renderFinishedFence);
 
+	// update reference orbit of the deep zoom renderer
+	// (the previous frame is finished, so the orbit buffer can be rewritten)
+	if(useDeepZoom && !orbitUpToDate)
+		computeReferenceOrbit();
+
+	// render by the CPU renderer
+	// (the previous frame is finished, so the staging buffer can be rewritten)
+	if(useCpu)
+		cpuRenderer->render(
+			stagingData,  // image
+			stagingExtent.width,  // width
+			stagingExtent.height,  // height
+			double(centerX) - stagingExtent.width / 2. * valueGradient,  // minX
+			double(centerY) - stagingExtent.height / 2. * valueGradient,  // minY
+			valueGradient,  // pixelSize
+			cpuPalette.data(),  // palette
+			cpuMaxIterations  // maxIterations
+		);
+
 	// increment frame counter
 	frameID++;
 
@@ -808,50 +2075,110 @@ void App::frame(VulkanWindow&)
 			nullptr  // pInheritanceInfo
 		)
 	);
-	commandBuffer.beginRenderPass(
-		vk::RenderPassBeginInfo(
-			renderPass,  // renderPass
-			framebuffers[imageIndex],  // framebuffer
-			vk::Rect2D(vk::Offset2D(0, 0), vk::Extent2D(window.surfaceWidth(), window.surfaceHeight())),  // renderArea
-			1,  // clearValueCount
-			&(const vk::ClearValue&)vk::ClearValue(  // pClearValues
-				vk::ClearColorValue(array<float, 4>{0.0f, 0.0f, 0.0f, 1.f})
-			)
-		),
-		vk::SubpassContents::eInline
-	);
+	if(useCompute)
+		recordCompute();
+	if(useCpu)
+		recordCpu(imageIndex);
+	else {
 
-	// push constants
-	struct PushData {
-		float juliaCoords[4];
-		int viewPlane;
-		int dummy;
-		float constantParameters[2];
-	};
-	commandBuffer.pushConstants(
-		pipelineLayout,  // layout
-		vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,  // stageFlags
-		0,  // offset
-		32,  // size
-		&(const PushData&)PushData{  // pValues
-			minX, minY, maxX, maxY,
-			0,
-			0,
-			0.f, 0.f,
+		commandBuffer.beginRenderPass(
+			vk::RenderPassBeginInfo(
+				renderPass,  // renderPass
+				framebuffers[imageIndex],  // framebuffer
+				vk::Rect2D(vk::Offset2D(0, 0), vk::Extent2D(window.surfaceWidth(), window.surfaceHeight())),  // renderArea
+				1,  // clearValueCount
+				&(const vk::ClearValue&)vk::ClearValue(  // pClearValues
+					vk::ClearColorValue(array<float, 4>{0.0f, 0.0f, 0.0f, 1.f})
+				)
+			),
+			vk::SubpassContents::eInline
+		);
+
+		// display results of the compute renderer
+		if(useCompute) {
+			commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, displayPipeline);  // bind pipeline
+			commandBuffer.bindDescriptorSets(
+				vk::PipelineBindPoint::eGraphics,  // pipelineBindPoint
+				computePipelineLayout,  // layout
+				0,  // firstSet
+				computeDescriptorSets[currentStateImage],  // descriptorSets
+				nullptr  // dynamicOffsets
+			);
+			VulkanWindowPipeline::setViewportAndScissor(  // set dynamic viewport and scissor
+				commandBuffer, vk::Extent2D(window.surfaceWidth(), window.surfaceHeight()));
+			commandBuffer.draw(  // draw full screen quad
+				4,  // vertexCount
+				1,  // instanceCount
+				0,  // firstVertex
+				0  // firstInstance
+			);
 		}
-	);
 
-	// rendering commands
-	commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);  // bind pipeline
-	commandBuffer.draw(  // draw single triangle
-		4,  // vertexCount
-		1,  // instanceCount
-		0,  // firstVertex
-		uint32_t(frameID)  // firstInstance
-	);
+		// draw by the deep zoom renderer
+		else if(useDeepZoom) {
+			commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, deepZoomPipeline);  // bind pipeline
+			commandBuffer.bindDescriptorSets(
+				vk::PipelineBindPoint::eGraphics,  // pipelineBindPoint
+				deepZoomPipelineLayout,  // layout
+				0,  // firstSet
+				deepZoomDescriptorSet,  // descriptorSets
+				nullptr  // dynamicOffsets
+			);
+			commandBuffer.pushConstants(
+				deepZoomPipelineLayout,  // layout
+				vk::ShaderStageFlagBits::eFragment,  // stageFlags
+				0,  // offset
+				sizeof(DeepZoomPushData),  // size
+				&deepZoomPushData  // pValues
+			);
+			VulkanWindowPipeline::setViewportAndScissor(  // set dynamic viewport and scissor
+				commandBuffer, vk::Extent2D(window.surfaceWidth(), window.surfaceHeight()));
+			commandBuffer.draw(  // draw full screen quad
+				4,  // vertexCount
+				1,  // instanceCount
+				0,  // firstVertex
+				0  // firstInstance
+			);
+		}
+		else {
+
+			// push constants
+			struct PushData {
+				float juliaCoords[4];
+				int viewPlane;
+				int dummy;
+				float constantParameters[2];
+			};
+			commandBuffer.pushConstants(
+				pipelineLayout,  // layout
+				vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,  // stageFlags
+				0,  // offset
+				32,  // size
+				&(const PushData&)PushData{  // pValues
+					minX, minY, maxX, maxY,
+					0,
+					0,
+					0.f, 0.f,
+				}
+			);
+
+			// draw by the fragment shader
+			commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);  // bind pipeline
+			VulkanWindowPipeline::setViewportAndScissor(  // set dynamic viewport and scissor
+				commandBuffer, vk::Extent2D(window.surfaceWidth(), window.surfaceHeight()));
+			commandBuffer.draw(  // draw single triangle
+				4,  // vertexCount
+				1,  // instanceCount
+				0,  // firstVertex
+				uint32_t(frameID)  // firstInstance
+			);
 
-	// end render pass and command buffer
-	commandBuffer.endRenderPass();
+		}
+
+		// end render pass
+		commandBuffer.endRenderPass();
+
+	}
 	commandBuffer.end();
 
 	// submit frame
@@ -862,7 +2189,7 @@ void App::frame(VulkanWindow&)
 			&(const vk::SubmitInfo&)vk::SubmitInfo(
 				1, &imageAvailableSemaphore,  // waitSemaphoreCount + pWaitSemaphores +
 				&(const vk::PipelineStageFlags&)vk::PipelineStageFlags(  // pWaitDstStageMask
-					vk::PipelineStageFlagBits::eColorAttachmentOutput),
+					useCpu ? vk::PipelineStageFlagBits::eTransfer : vk::PipelineStageFlagBits::eColorAttachmentOutput),
 				1, &commandBuffer,  // commandBufferCount + pCommandBuffers
 				1, &renderingFinishedSemaphore  // signalSemaphoreCount + pSignalSemaphores
 			)
@@ -891,7 +2218,8 @@ void App::frame(VulkanWindow&)
 	}
 
 	// schedule next frame
-	if(frameUpdateMode != FrameUpdateMode::OnDemand)
+	// (compute renderer keeps rendering until all the tiles are finished)
+	if(frameUpdateMode != FrameUpdateMode::OnDemand || !dispatchedTiles.empty())
 		window.scheduleFrame();
 }
 
@@ -903,9 +2231,9 @@ void App::mouseMove(VulkanWindow&, const VulkanWindow::MouseState& s)
 #endif
 
 	if(s.buttons.test(VulkanWindow::MouseButton::Left)) {
-		float rx = (s.posX-s.relX) / window.surfaceWidth();
-		float ry = (s.posY-s.relY) / window.surfaceHeight();
-		setView(s.posX, s.posY, minX*(1.f-rx) + maxX*rx, minY*(1.f-ry) + maxY*ry);
+		DoubleDouble valueX = centerX + (s.posX - s.relX - window.surfaceWidth() / 2.) * valueGradient;
+		DoubleDouble valueY = centerY + (s.posY - s.relY - window.surfaceHeight() / 2.) * valueGradient;
+		setView(s.posX, s.posY, valueX, valueY);
 		window.scheduleFrame();
 	}
 }
@@ -931,10 +2259,10 @@ void App::mouseWheel(VulkanWindow&, float wheelX, float wheelY, const VulkanWind
 {
 	cout << "w(" << wheelX << "," << wheelY << ")" << flush;
 
-	float rx = s.posX / window.surfaceWidth();
-	float ry = s.posY / window.surfaceHeight();
-	valueGradient *= powf(0.9f, wheelY / 120);
-	setView(s.posX, s.posY, minX*(1.f-rx) + maxX*rx, minY*(1.f-ry) + maxY*ry);
+	DoubleDouble valueX = centerX + (s.posX - window.surfaceWidth() / 2.) * valueGradient;
+	DoubleDouble valueY = centerY + (s.posY - window.surfaceHeight() / 2.) * valueGradient;
+	valueGradient *= pow(0.9, wheelY / 120);
+	setView(s.posX, s.posY, valueX, valueY);
 	window.scheduleFrame();
 }
 
@@ -3,9 +3,13 @@
 // SPDX-License-Identifier: MIT-0
 
 #include "VulkanWindow.h"
+#include "VulkanWindowCapture.h"
+#include "VulkanWindowPipeline.h"
 #include <vulkan/vulkan.hpp>
 #include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 using namespace std;
@@ -54,6 +58,7 @@ public:
 	vk::SurfaceFormatKHR surfaceFormat;
 	vk::RenderPass renderPass;
 	vk::SwapchainKHR swapchain;
+	vector<vk::Image> swapchainImages;
 	vector<vk::ImageView> swapchainImageViews;
 	vector<vk::Framebuffer> framebuffers;
 	vector<vk::Semaphore> renderingFinishedSemaphores;
@@ -64,14 +69,21 @@ public:
 	vk::ShaderModule vsModule;
 	vk::ShaderModule fsModule;
 	vk::PipelineLayout pipelineLayout;
+	VulkanWindowPipelineCache pipelineCache;
 	vk::Pipeline pipeline;
 
 	enum class FrameUpdateMode { OnDemand, Continuous, MaxFrameRate };
 	FrameUpdateMode frameUpdateMode = FrameUpdateMode::Continuous;
+	double frameRateLimit = 0.;  // negative value means the limit recommended for the window outputs
 	size_t frameID = ~size_t(0);
 	size_t fpsNumFrames = ~size_t(0);
 	chrono::high_resolution_clock::time_point fpsStartTime;
 
+	// frame capture
+	VulkanWindowCapture capture;
+	string capturePrefix;  // empty string means no capture
+	VulkanWindowCapture::FileFormat captureFormat = VulkanWindowCapture::FileFormat::PNG;
+
 };
 
 
@@ -86,6 +98,22 @@ App::App(int argc, char** argv)
 			frameUpdateMode = FrameUpdateMode::Continuous;
 		else if(strcmp(argv[i], "--max-frame-rate") == 0)
 			frameUpdateMode = FrameUpdateMode::MaxFrameRate;
+		else if(strcmp(argv[i], "--frame-rate-limit") == 0 && i+1 < argc) {
+			i++;
+			frameRateLimit = (strcmp(argv[i], "auto") == 0) ? -1. : strtod(argv[i], nullptr);
+		}
+		else if(strcmp(argv[i], "--capture") == 0 && i+1 < argc) {
+			i++;
+			capturePrefix = argv[i];
+		}
+		else if(strcmp(argv[i], "--capture-format") == 0 && i+1 < argc &&
+		        (strcmp(argv[i+1], "ppm") == 0 || strcmp(argv[i+1], "png") == 0 || strcmp(argv[i+1], "y4m") == 0)) {
+			i++;
+			captureFormat =
+				(strcmp(argv[i], "ppm") == 0) ? VulkanWindowCapture::FileFormat::PPM :
+				(strcmp(argv[i], "png") == 0) ? VulkanWindowCapture::FileFormat::PNG :
+				VulkanWindowCapture::FileFormat::Y4M;
+		}
 		else {
 			if(strcmp(argv[i], "--help") != 0 && strcmp(argv[i], "-h") != 0)
 				cout << "Unrecognized option: " << argv[i] << endl;
@@ -96,7 +124,17 @@ App::App(int argc, char** argv)
 			        "   --continuous:  constantly update window content using\n"
 			        "                  screen refresh rate, this is the default\n"
 			        "   --max-frame-rate:  ignore screen refresh rate, update\n"
-			        "                      window content as often as possible\n" << endl;
+			        "                      window content as often as possible\n"
+			        "   --frame-rate-limit <fps|auto>:  limit frame rate, auto uses\n"
+			        "                      refresh rate of the screen, slightly lowered\n"
+			        "                      on VRR screens with known VRR range (Xlib);\n"
+			        "                      with --max-frame-rate, this gives\n"
+			        "                      low latency without wasting GPU power\n"
+			        "   --capture <prefix>:  capture rendered frames into files\n"
+			        "                        starting with prefix\n"
+			        "   --capture-format <ppm|png|y4m>:  capture file format,\n"
+			        "                        png is the default, y4m writes single\n"
+			        "                        video file\n" << endl;
 			exit(99);
 		}
 }
@@ -112,9 +150,17 @@ App::~App()
 		// because the device might be in the lost state already, etc.
 		vkDeviceWaitIdle(device);
 
+		// deliver captured frames
+		if(!capturePrefix.empty()) {
+			capture.cleanUp();
+			cout << "Captured frames: " << capture.numCaptured() << ", dropped: " << capture.numDropped()
+			     << ", failed: " << capture.numFailed() << endl;
+		}
+
 		// destroy handles
 		// (the handles are destructed in certain (not arbitrary) order)
 		device.destroy(pipeline);
+		pipelineCache.cleanUp();
 		device.destroy(pipelineLayout);
 		device.destroy(fsModule);
 		device.destroy(vsModule);
@@ -287,6 +333,12 @@ void App::init()
 	graphicsQueue = device.getQueue(graphicsQueueFamily, 0);
 	presentationQueue = device.getQueue(presentationQueueFamily, 0);
 
+	// frame capture
+	if(!capturePrefix.empty()) {
+		capture.init(physicalDevice, device);
+		capture.setFileOutput(capturePrefix, captureFormat);
+	}
+
 	// print surface formats
 	cout << "Surface formats:" << endl;
 	vector<vk::SurfaceFormatKHR> availableSurfaceFormats = physicalDevice.getSurfaceFormatsKHR(surface);
@@ -435,10 +487,27 @@ void App::init()
 				nullptr  // pPushConstantRanges
 			}
 		);
+
+	// pipeline cache
+	// (it is stored on disk to speed up the next application start)
+	pipelineCache.init(physicalDevice, device, string(appName) + ".pipelineCache");
+
+	// pipeline
+	// (viewport and scissor are dynamic, so the pipeline is not recreated on resize)
+	pipeline =
+		VulkanWindowPipeline::createSimple(
+			device,  // device
+			pipelineCache.get(),  // pipelineCache
+			pipelineLayout,  // pipelineLayout
+			renderPass,  // renderPass
+			vsModule,  // vsModule
+			fsModule,  // fsModule
+			vk::PrimitiveTopology::eTriangleList  // topology
+		);
 }
 
 
-/** Recreate swapchain and pipeline callback.
+/** Recreate swapchain callback.
  *  The function is usually called after the window resize and on the application start. */
 void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 {
@@ -474,6 +543,16 @@ void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 	else
 		newSurfaceExtent = surfaceCapabilities.currentExtent;
 
+	// captured swapchain images need transfer source usage
+	vk::ImageUsageFlags imageUsage = vk::ImageUsageFlagBits::eColorAttachment;
+	if(!capturePrefix.empty()) {
+		if(!(surfaceCapabilities.supportedUsageFlags & vk::ImageUsageFlagBits::eTransferSrc))
+			throw runtime_error("Frame capture is not supported because swapchain images cannot be used as transfer source.");
+		if(!VulkanWindowCapture::isFormatSupported(surfaceFormat.format))
+			throw runtime_error("Frame capture does not support surface format " + to_string(surfaceFormat.format) + ".");
+		imageUsage |= vk::ImageUsageFlagBits::eTransferSrc;
+	}
+
 	// update VulkanWindow surface size
 	widthToBeSet = newSurfaceExtent.width;
 	heightToBeSet = newSurfaceExtent.height;
@@ -483,8 +562,6 @@ void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 	swapchainImageViews.clear();
 	for(auto f : framebuffers)  device.destroy(f);
 	framebuffers.clear();
-	device.destroy(pipeline);
-	pipeline = nullptr;
 
 	// print info
 	cout << "Recreating swapchain (extent: " << newSurfaceExtent.width << "x" << newSurfaceExtent.height
@@ -506,7 +583,7 @@ void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 				surfaceFormat.colorSpace,       // imageColorSpace
 				newSurfaceExtent,               // imageExtent
 				1,                              // imageArrayLayers
-				vk::ImageUsageFlagBits::eColorAttachment,  // imageUsage
+				imageUsage,                     // imageUsage
 				(graphicsQueueFamily==presentationQueueFamily) ? vk::SharingMode::eExclusive : vk::SharingMode::eConcurrent, // imageSharingMode
 				uint32_t(2),  // queueFamilyIndexCount
 				array<uint32_t, 2>{graphicsQueueFamily, presentationQueueFamily}.data(),  // pQueueFamilyIndices
@@ -535,7 +612,7 @@ void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 	swapchain = newSwapchain.release();
 
 	// swapchain images and image views
-	vector<vk::Image> swapchainImages = device.getSwapchainImagesKHR(swapchain);
+	swapchainImages = device.getSwapchainImagesKHR(swapchain);
 	swapchainImageViews.reserve(swapchainImages.size());
 	for(vk::Image image : swapchainImages)
 		swapchainImageViews.emplace_back(
@@ -587,124 +664,6 @@ void App::resize(VulkanWindow&, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 			renderingFinishedSemaphores.emplace_back(
 				device.createSemaphore(semaphoreCreateInfo));
 	}
-
-	// pipeline
-	pipeline =
-		device.createGraphicsPipeline(
-			nullptr,  // pipelineCache
-			vk::GraphicsPipelineCreateInfo(
-				vk::PipelineCreateFlags(),  // flags
-
-				// shader stages
-				2,  // stageCount
-				array{  // pStages
-					vk::PipelineShaderStageCreateInfo{
-						vk::PipelineShaderStageCreateFlags(),  // flags
-						vk::ShaderStageFlagBits::eVertex,  // stage
-						vsModule,  // module
-						"main",  // pName
-						nullptr  // pSpecializationInfo
-					},
-					vk::PipelineShaderStageCreateInfo{
-						vk::PipelineShaderStageCreateFlags(),  // flags
-						vk::ShaderStageFlagBits::eFragment,  // stage
-						fsModule,  // module
-						"main",  // pName
-						nullptr  // pSpecializationInfo
-					},
-				}.data(),
-
-				// vertex input
-				&(const vk::PipelineVertexInputStateCreateInfo&)vk::PipelineVertexInputStateCreateInfo{  // pVertexInputState
-					vk::PipelineVertexInputStateCreateFlags(),  // flags
-					0,        // vertexBindingDescriptionCount
-					nullptr,  // pVertexBindingDescriptions
-					0,        // vertexAttributeDescriptionCount
-					nullptr   // pVertexAttributeDescriptions
-				},
-
-				// input assembly
-				&(const vk::PipelineInputAssemblyStateCreateInfo&)vk::PipelineInputAssemblyStateCreateInfo{  // pInputAssemblyState
-					vk::PipelineInputAssemblyStateCreateFlags(),  // flags
-					vk::PrimitiveTopology::eTriangleList,  // topology
-					VK_FALSE  // primitiveRestartEnable
-				},
-
-				// tessellation
-				nullptr, // pTessellationState
-
-				// viewport
-				&(const vk::PipelineViewportStateCreateInfo&)vk::PipelineViewportStateCreateInfo{  // pViewportState
-					vk::PipelineViewportStateCreateFlags(),  // flags
-					1,  // viewportCount
-					array{  // pViewports
-						vk::Viewport(0.f, 0.f, float(newSurfaceExtent.width), float(newSurfaceExtent.height), 0.f, 1.f),
-					}.data(),
-					1,  // scissorCount
-					array{  // pScissors
-						vk::Rect2D(vk::Offset2D(0,0), newSurfaceExtent)
-					}.data(),
-				},
-
-				// rasterization
-				&(const vk::PipelineRasterizationStateCreateInfo&)vk::PipelineRasterizationStateCreateInfo{  // pRasterizationState
-					vk::PipelineRasterizationStateCreateFlags(),  // flags
-					VK_FALSE,  // depthClampEnable
-					VK_FALSE,  // rasterizerDiscardEnable
-					vk::PolygonMode::eFill,  // polygonMode
-					vk::CullModeFlagBits::eNone,  // cullMode
-					vk::FrontFace::eCounterClockwise,  // frontFace
-					VK_FALSE,  // depthBiasEnable
-					0.f,  // depthBiasConstantFactor
-					0.f,  // depthBiasClamp
-					0.f,  // depthBiasSlopeFactor
-					1.f   // lineWidth
-				},
-
-				// multisampling
-				&(const vk::PipelineMultisampleStateCreateInfo&)vk::PipelineMultisampleStateCreateInfo{  // pMultisampleState
-					vk::PipelineMultisampleStateCreateFlags(),  // flags
-					vk::SampleCountFlagBits::e1,  // rasterizationSamples
-					VK_FALSE,  // sampleShadingEnable
-					0.f,       // minSampleShading
-					nullptr,   // pSampleMask
-					VK_FALSE,  // alphaToCoverageEnable
-					VK_FALSE   // alphaToOneEnable
-				},
-
-				// depth and stencil
-				nullptr,  // pDepthStencilState
-
-				// blending
-				&(const vk::PipelineColorBlendStateCreateInfo&)vk::PipelineColorBlendStateCreateInfo{  // pColorBlendState
-					vk::PipelineColorBlendStateCreateFlags(),  // flags
-					VK_FALSE,  // logicOpEnable
-					vk::LogicOp::eClear,  // logicOp
-					1,  // attachmentCount
-					array{  // pAttachments
-						vk::PipelineColorBlendAttachmentState{
-							VK_FALSE,  // blendEnable
-							vk::BlendFactor::eZero,  // srcColorBlendFactor
-							vk::BlendFactor::eZero,  // dstColorBlendFactor
-							vk::BlendOp::eAdd,       // colorBlendOp
-							vk::BlendFactor::eZero,  // srcAlphaBlendFactor
-							vk::BlendFactor::eZero,  // dstAlphaBlendFactor
-							vk::BlendOp::eAdd,       // alphaBlendOp
-							vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
-								vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA  // colorWriteMask
-						},
-					}.data(),
-					array<float,4>{0.f,0.f,0.f,0.f}  // blendConstants
-				},
-
-				nullptr,  // pDynamicState
-				pipelineLayout,  // layout
-				renderPass,  // renderPass
-				0,  // subpass
-				vk::Pipeline(nullptr),  // basePipelineHandle
-				-1 // basePipelineIndex
-			)
-		).value;
 }
 
 
@@ -789,6 +748,8 @@ void App::frame(VulkanWindow&)
 
 	// rendering commands
 	commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);  // bind pipeline
+	VulkanWindowPipeline::setViewportAndScissor(  // set dynamic viewport and scissor
+		commandBuffer, vk::Extent2D(window.surfaceWidth(), window.surfaceHeight()));
 	commandBuffer.draw(  // draw single triangle
 		3,  // vertexCount
 		1,  // instanceCount
@@ -798,6 +759,9 @@ void App::frame(VulkanWindow&)
 
 	// end render pass and command buffer
 	commandBuffer.endRenderPass();
+	if(!capturePrefix.empty())
+		capture.recordCopy(commandBuffer, swapchainImages[imageIndex], surfaceFormat.format,
+		                   vk::Extent2D(window.surfaceWidth(), window.surfaceHeight()));
 	commandBuffer.end();
 
 	// submit frame
@@ -815,6 +779,8 @@ void App::frame(VulkanWindow&)
 		),
 		renderFinishedFence  // fence
 	);
+	if(!capturePrefix.empty())
+		capture.submitted(graphicsQueue);
 
 	// present
 	r =
@@ -862,6 +828,14 @@ int main(int argc, char* argv[])
 		app.window.setFrameCallback(
 			bind(&App::frame, &app, placeholders::_1)
 		);
+		if(app.frameRateLimit > 0.)
+			app.window.setFrameRateLimit(app.frameRateLimit);
+		else if(app.frameRateLimit < 0.)
+			app.window.setOutputsChangedCallback(
+				[](VulkanWindow& window) {
+					window.setFrameRateLimit(window.recommendedFrameRateLimit());
+				}
+			);
 		app.window.show();
 		app.window.mainLoop();
 
@@ -13,19 +13,30 @@
 # include <windowsx.h>
 # include <tchar.h>
 # include <type_traits>
-#elif defined(USE_PLATFORM_XLIB)
-# include <X11/Xutil.h>
-# include <map>
-#elif defined(USE_PLATFORM_WAYLAND)
-# include "xdg-shell-client-protocol.h"
-# include "xdg-decoration-client-protocol.h"
-# include <wayland-cursor.h>
-# include <climits>
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
+# if defined(USE_PLATFORM_XLIB)
+#  include <X11/Xutil.h>
+#  include <cerrno>
+#  include <cstdlib>
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
+#  include <wayland-client-core.h>  // protocol headers are included below, after libwayland functions of multi-backend build
+#  include <wayland-cursor.h>
+#  include <cerrno>
+#  include <poll.h>
+#  include <sys/eventfd.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#  include <atomic>
+#  include <deque>
+# endif
 # include <cstring>
 # include <dlfcn.h>
-# include <sys/mman.h>
-# include <unistd.h>
 # include <map>
+# include <mutex>
+# include <sys/select.h>
+# include <sys/timerfd.h>
+# include <unistd.h>
 #elif defined(USE_PLATFORM_SDL3)
 # include <SDL3/SDL_error.h>
 # include <SDL3/SDL_events.h>
@@ -34,9 +45,11 @@
 # include <SDL3/SDL_keycode.h>
 # include <SDL3/SDL_properties.h>
 # include <SDL3/SDL_scancode.h>
+# include <SDL3/SDL_stdinc.h>
 # include <SDL3/SDL_timer.h>
 # include <SDL3/SDL_video.h>
 # include <SDL3/SDL_vulkan.h>
+# include <cmath>
 #elif defined(USE_PLATFORM_SDL2)
 # include "SDL.h"
 # include "SDL_vulkan.h"
@@ -53,19 +66,200 @@
 # include <QVulkanInstance>
 # include <QMouseEvent>
 # include <QWheelEvent>
+# include <QScreen>
+# include <cmath>
 # include <fstream>
+#elif defined(USE_PLATFORM_DISPLAY)
+# include <linux/input.h>
+# include <cerrno>
+# include <cstring>
+# include <dirent.h>
+# include <dlfcn.h>
+# include <fcntl.h>
+# include <poll.h>
+# include <sys/eventfd.h>
+# include <sys/ioctl.h>
+# include <sys/timerfd.h>
+# include <unistd.h>
 #endif
 #include "VulkanWindow.h"
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <climits>
+#include <cstddef>
 #include <stdexcept>
 #include <iostream>  // for debugging
+#if !defined(USE_PLATFORM_WIN32) && !defined(USE_PLATFORM_XLIB) && !defined(USE_PLATFORM_WAYLAND) && !defined(USE_PLATFORM_DISPLAY)
+# include <cerrno>
+# include <ctime>
+# include <thread>
+#endif
 
 // define VULKAN_WINDOW_DEBUG to get console debug output
 #if 0
 #define VULKAN_WINDOW_DEBUG
 #endif
 
+// libX11, libwayland-client and libwayland-cursor functions
+// (in the multi-backend build, Xlib and Wayland are compiled in together and init() selects one of them;
+// the libraries of the selected backend are loaded by dlopen(), so machines using the other backend
+// never load them; the calls, including those made by the inline functions of the Wayland protocol headers,
+// are redirected to the function pointers by the following macros)
+#if defined(USE_PLATFORM_XLIB) && defined(USE_PLATFORM_WAYLAND)
+struct libx11 {
+	struct Funcs {
+		decltype(&::XInitThreads) XInitThreads;
+		decltype(&::XOpenDisplay) XOpenDisplay;
+		decltype(&::XCloseDisplay) XCloseDisplay;
+		decltype(&::XDisplayString) XDisplayString;
+		decltype(&::XDefaultScreen) XDefaultScreen;
+		decltype(&::XResourceManagerString) XResourceManagerString;
+		decltype(&::XInternAtom) XInternAtom;
+		decltype(&::XFlush) XFlush;
+		decltype(&::XEventsQueued) XEventsQueued;
+		decltype(&::XNextEvent) XNextEvent;
+		decltype(&::XPeekEvent) XPeekEvent;
+		decltype(&::XCheckTypedWindowEvent) XCheckTypedWindowEvent;
+		decltype(&::XSendEvent) XSendEvent;
+		decltype(&::XLookupString) XLookupString;
+		decltype(&::XCreateWindow) XCreateWindow;
+		decltype(&::XDestroyWindow) XDestroyWindow;
+		decltype(&::XMapWindow) XMapWindow;
+		decltype(&::XWithdrawWindow) XWithdrawWindow;
+		decltype(&::XIconifyWindow) XIconifyWindow;
+		decltype(&::XStoreName) XStoreName;
+		decltype(&::XSetStandardProperties) XSetStandardProperties;
+		decltype(&::XSetWMProtocols) XSetWMProtocols;
+		decltype(&::XChangeProperty) XChangeProperty;
+		decltype(&::XGetWindowProperty) XGetWindowProperty;
+		decltype(&::XGetGeometry) XGetGeometry;
+		decltype(&::XTranslateCoordinates) XTranslateCoordinates;
+		decltype(&::XSetWindowBackground) XSetWindowBackground;
+		decltype(&::XSetWindowBackgroundPixmap) XSetWindowBackgroundPixmap;
+		decltype(&::XFree) XFree;
+	};
+	static inline Funcs funcs;
+	static inline void* handle = nullptr;
+};
+# define XInitThreads                libx11::funcs.XInitThreads
+# define XOpenDisplay                libx11::funcs.XOpenDisplay
+# define XCloseDisplay               libx11::funcs.XCloseDisplay
+# define XDisplayString              libx11::funcs.XDisplayString
+# define XDefaultScreen              libx11::funcs.XDefaultScreen
+# define XResourceManagerString      libx11::funcs.XResourceManagerString
+# define XInternAtom                 libx11::funcs.XInternAtom
+# define XFlush                      libx11::funcs.XFlush
+# define XEventsQueued               libx11::funcs.XEventsQueued
+# define XNextEvent                  libx11::funcs.XNextEvent
+# define XPeekEvent                  libx11::funcs.XPeekEvent
+# define XCheckTypedWindowEvent      libx11::funcs.XCheckTypedWindowEvent
+# define XSendEvent                  libx11::funcs.XSendEvent
+# define XLookupString               libx11::funcs.XLookupString
+# define XCreateWindow               libx11::funcs.XCreateWindow
+# define XDestroyWindow              libx11::funcs.XDestroyWindow
+# define XMapWindow                  libx11::funcs.XMapWindow
+# define XWithdrawWindow             libx11::funcs.XWithdrawWindow
+# define XIconifyWindow              libx11::funcs.XIconifyWindow
+# define XStoreName                  libx11::funcs.XStoreName
+# define XSetStandardProperties      libx11::funcs.XSetStandardProperties
+# define XSetWMProtocols             libx11::funcs.XSetWMProtocols
+# define XChangeProperty             libx11::funcs.XChangeProperty
+# define XGetWindowProperty          libx11::funcs.XGetWindowProperty
+# define XGetGeometry                libx11::funcs.XGetGeometry
+# define XTranslateCoordinates       libx11::funcs.XTranslateCoordinates
+# define XSetWindowBackground        libx11::funcs.XSetWindowBackground
+# define XSetWindowBackgroundPixmap  libx11::funcs.XSetWindowBackgroundPixmap
+# define XFree                       libx11::funcs.XFree
+struct libwayland {
+	struct Funcs {
+		decltype(&::wl_display_connect) wl_display_connect;
+		decltype(&::wl_display_disconnect) wl_display_disconnect;
+		decltype(&::wl_display_get_fd) wl_display_get_fd;
+		decltype(&::wl_display_dispatch) wl_display_dispatch;
+		decltype(&::wl_display_dispatch_pending) wl_display_dispatch_pending;
+		decltype(&::wl_display_dispatch_queue) wl_display_dispatch_queue;
+		decltype(&::wl_display_dispatch_queue_pending) wl_display_dispatch_queue_pending;
+		decltype(&::wl_display_flush) wl_display_flush;
+		decltype(&::wl_display_roundtrip) wl_display_roundtrip;
+		decltype(&::wl_display_roundtrip_queue) wl_display_roundtrip_queue;
+		decltype(&::wl_display_prepare_read) wl_display_prepare_read;
+		decltype(&::wl_display_prepare_read_queue) wl_display_prepare_read_queue;
+		decltype(&::wl_display_cancel_read) wl_display_cancel_read;
+		decltype(&::wl_display_read_events) wl_display_read_events;
+		decltype(&::wl_display_create_queue) wl_display_create_queue;
+		decltype(&::wl_event_queue_destroy) wl_event_queue_destroy;
+		decltype(&::wl_proxy_create_wrapper) wl_proxy_create_wrapper;
+		decltype(&::wl_proxy_wrapper_destroy) wl_proxy_wrapper_destroy;
+		decltype(&::wl_proxy_set_queue) wl_proxy_set_queue;
+		decltype(&::wl_proxy_get_version) wl_proxy_get_version;
+		decltype(&::wl_proxy_set_tag) wl_proxy_set_tag;
+		decltype(&::wl_proxy_get_tag) wl_proxy_get_tag;
+		decltype(&::wl_proxy_marshal) wl_proxy_marshal;
+		decltype(&::wl_proxy_marshal_constructor) wl_proxy_marshal_constructor;
+		decltype(&::wl_proxy_marshal_constructor_versioned) wl_proxy_marshal_constructor_versioned;
+# ifdef WL_MARSHAL_FLAG_DESTROY  // wayland 1.20+
+		decltype(&::wl_proxy_marshal_flags) wl_proxy_marshal_flags;
+# endif
+		decltype(&::wl_proxy_destroy) wl_proxy_destroy;
+		decltype(&::wl_proxy_add_listener) wl_proxy_add_listener;
+		decltype(&::wl_proxy_set_user_data) wl_proxy_set_user_data;
+		decltype(&::wl_proxy_get_user_data) wl_proxy_get_user_data;
+		decltype(&::wl_cursor_theme_load) wl_cursor_theme_load;
+		decltype(&::wl_cursor_theme_destroy) wl_cursor_theme_destroy;
+		decltype(&::wl_cursor_theme_get_cursor) wl_cursor_theme_get_cursor;
+		decltype(&::wl_cursor_image_get_buffer) wl_cursor_image_get_buffer;
+	};
+	static inline Funcs funcs;
+	static inline void* clientHandle = nullptr;
+	static inline void* cursorHandle = nullptr;
+};
+# define wl_display_connect                      libwayland::funcs.wl_display_connect
+# define wl_display_disconnect                   libwayland::funcs.wl_display_disconnect
+# define wl_display_get_fd                       libwayland::funcs.wl_display_get_fd
+# define wl_display_dispatch                     libwayland::funcs.wl_display_dispatch
+# define wl_display_dispatch_pending             libwayland::funcs.wl_display_dispatch_pending
+# define wl_display_dispatch_queue               libwayland::funcs.wl_display_dispatch_queue
+# define wl_display_dispatch_queue_pending       libwayland::funcs.wl_display_dispatch_queue_pending
+# define wl_display_flush                        libwayland::funcs.wl_display_flush
+# define wl_display_roundtrip                    libwayland::funcs.wl_display_roundtrip
+# define wl_display_roundtrip_queue              libwayland::funcs.wl_display_roundtrip_queue
+# define wl_display_prepare_read                 libwayland::funcs.wl_display_prepare_read
+# define wl_display_prepare_read_queue           libwayland::funcs.wl_display_prepare_read_queue
+# define wl_display_cancel_read                  libwayland::funcs.wl_display_cancel_read
+# define wl_display_read_events                  libwayland::funcs.wl_display_read_events
+# define wl_display_create_queue                 libwayland::funcs.wl_display_create_queue
+# define wl_event_queue_destroy                  libwayland::funcs.wl_event_queue_destroy
+# define wl_proxy_create_wrapper                 libwayland::funcs.wl_proxy_create_wrapper
+# define wl_proxy_wrapper_destroy                libwayland::funcs.wl_proxy_wrapper_destroy
+# define wl_proxy_set_queue                      libwayland::funcs.wl_proxy_set_queue
+# define wl_proxy_get_version                    libwayland::funcs.wl_proxy_get_version
+# define wl_proxy_set_tag                        libwayland::funcs.wl_proxy_set_tag
+# define wl_proxy_get_tag                        libwayland::funcs.wl_proxy_get_tag
+# define wl_proxy_marshal                        libwayland::funcs.wl_proxy_marshal
+# define wl_proxy_marshal_constructor            libwayland::funcs.wl_proxy_marshal_constructor
+# define wl_proxy_marshal_constructor_versioned  libwayland::funcs.wl_proxy_marshal_constructor_versioned
+# ifdef WL_MARSHAL_FLAG_DESTROY
+#  define wl_proxy_marshal_flags                 libwayland::funcs.wl_proxy_marshal_flags
+# endif
+# define wl_proxy_destroy                        libwayland::funcs.wl_proxy_destroy
+# define wl_proxy_add_listener                   libwayland::funcs.wl_proxy_add_listener
+# define wl_proxy_set_user_data                  libwayland::funcs.wl_proxy_set_user_data
+# define wl_proxy_get_user_data                  libwayland::funcs.wl_proxy_get_user_data
+# define wl_cursor_theme_load                    libwayland::funcs.wl_cursor_theme_load
+# define wl_cursor_theme_destroy                 libwayland::funcs.wl_cursor_theme_destroy
+# define wl_cursor_theme_get_cursor              libwayland::funcs.wl_cursor_theme_get_cursor
+# define wl_cursor_image_get_buffer              libwayland::funcs.wl_cursor_image_get_buffer
+#endif
+
+// Wayland protocol headers
+#if defined(USE_PLATFORM_WAYLAND)
+# include "xdg-shell-client-protocol.h"
+# include "xdg-decoration-client-protocol.h"
+# include "single-pixel-buffer-v1-client-protocol.h"
+# include "viewporter-client-protocol.h"
+#endif
+
 
 // Vulkan C99 API
 // (the minimal part required by VulkanWindow.cpp)
@@ -105,7 +299,8 @@ struct VkXlibSurfaceCreateInfoKHR {
 };
 constexpr const VkStructureType VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR = 1000004000;
 typedef VkResult (VKAPI_PTR *PFN_vkCreateXlibSurfaceKHR)(VkInstance instance, const VkXlibSurfaceCreateInfoKHR* pCreateInfo, const void* pAllocator, VkSurfaceKHR* pSurface);
-#elif defined(USE_PLATFORM_WAYLAND)
+#endif
+#if defined(USE_PLATFORM_WAYLAND)
 struct VkWaylandSurfaceCreateInfoKHR {
 	VkStructureType      sType;
 	const void*          pNext;
@@ -116,19 +311,85 @@ struct VkWaylandSurfaceCreateInfoKHR {
 constexpr const VkStructureType VK_STRUCTURE_TYPE_WAYLAND_SURFACE_CREATE_INFO_KHR = 1000006000;
 typedef VkResult (VKAPI_PTR *PFN_vkCreateWaylandSurfaceKHR)(VkInstance instance, const VkWaylandSurfaceCreateInfoKHR* pCreateInfo, const void* pAllocator, VkSurfaceKHR* pSurface);
 #endif
+#if defined(USE_PLATFORM_DISPLAY)
+typedef struct VkPhysicalDevice_T* VkPhysicalDevice;
+typedef uint64_t VkDisplayKHR;
+typedef uint64_t VkDisplayModeKHR;
+typedef uint32_t VkBool32;
+struct VkExtent2D {
+	uint32_t width;
+	uint32_t height;
+};
+struct VkOffset2D {
+	int32_t x;
+	int32_t y;
+};
+struct VkDisplayPropertiesKHR {
+	VkDisplayKHR  display;
+	const char*   displayName;
+	VkExtent2D    physicalDimensions;
+	VkExtent2D    physicalResolution;
+	uint32_t      supportedTransforms;
+	VkBool32      planeReorderPossible;
+	VkBool32      persistentContent;
+};
+struct VkDisplayModePropertiesKHR {
+	VkDisplayModeKHR  displayMode;
+	VkExtent2D        visibleRegion;
+	uint32_t          refreshRate;  // in mHz
+};
+struct VkDisplayPlanePropertiesKHR {
+	VkDisplayKHR  currentDisplay;
+	uint32_t      currentStackIndex;
+};
+struct VkDisplayPlaneCapabilitiesKHR {
+	uint32_t    supportedAlpha;
+	VkOffset2D  minSrcPosition;
+	VkOffset2D  maxSrcPosition;
+	VkExtent2D  minSrcExtent;
+	VkExtent2D  maxSrcExtent;
+	VkOffset2D  minDstPosition;
+	VkOffset2D  maxDstPosition;
+	VkExtent2D  minDstExtent;
+	VkExtent2D  maxDstExtent;
+};
+struct VkDisplaySurfaceCreateInfoKHR {
+	VkStructureType   sType;
+	const void*       pNext;
+	uint32_t          flags;
+	VkDisplayModeKHR  displayMode;
+	uint32_t          planeIndex;
+	uint32_t          planeStackIndex;
+	uint32_t          transform;
+	float             globalAlpha;
+	uint32_t          alphaMode;
+	VkExtent2D        imageExtent;
+};
+constexpr const VkResult VK_INCOMPLETE = 5;
+constexpr const VkStructureType VK_STRUCTURE_TYPE_DISPLAY_SURFACE_CREATE_INFO_KHR = 1000002001;
+constexpr const uint32_t VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR = 0x1;
+constexpr const uint32_t VK_DISPLAY_PLANE_ALPHA_OPAQUE_BIT_KHR = 0x1;
+constexpr const uint32_t VK_DISPLAY_PLANE_ALPHA_GLOBAL_BIT_KHR = 0x2;
+typedef VkResult (VKAPI_PTR *PFN_vkEnumeratePhysicalDevices)(VkInstance instance, uint32_t* pPhysicalDeviceCount, VkPhysicalDevice* pPhysicalDevices);
+typedef VkResult (VKAPI_PTR *PFN_vkGetPhysicalDeviceDisplayPropertiesKHR)(VkPhysicalDevice physicalDevice, uint32_t* pPropertyCount, VkDisplayPropertiesKHR* pProperties);
+typedef VkResult (VKAPI_PTR *PFN_vkGetPhysicalDeviceDisplayPlanePropertiesKHR)(VkPhysicalDevice physicalDevice, uint32_t* pPropertyCount, VkDisplayPlanePropertiesKHR* pProperties);
+typedef VkResult (VKAPI_PTR *PFN_vkGetDisplayPlaneSupportedDisplaysKHR)(VkPhysicalDevice physicalDevice, uint32_t planeIndex, uint32_t* pDisplayCount, VkDisplayKHR* pDisplays);
+typedef VkResult (VKAPI_PTR *PFN_vkGetDisplayModePropertiesKHR)(VkPhysicalDevice physicalDevice, VkDisplayKHR display, uint32_t* pPropertyCount, VkDisplayModePropertiesKHR* pProperties);
+typedef VkResult (VKAPI_PTR *PFN_vkGetDisplayPlaneCapabilitiesKHR)(VkPhysicalDevice physicalDevice, VkDisplayModeKHR mode, uint32_t planeIndex, VkDisplayPlaneCapabilitiesKHR* pCapabilities);
+typedef VkResult (VKAPI_PTR *PFN_vkCreateDisplayPlaneSurfaceKHR)(VkInstance instance, const VkDisplaySurfaceCreateInfoKHR* pCreateInfo, const void* pAllocator, VkSurfaceKHR* pSurface);
+#endif
 typedef void (VKAPI_PTR *PFN_vkDestroySurfaceKHR)(VkInstance instance, VkSurfaceKHR surface, const void* pAllocator);
 
-// xcbcommon types and funcs
+// xcbcommon types
 // (we avoid dependency on include xkbcommon/xkbcommon.h to lessen VulkanWindow dependencies)
-#if defined(USE_PLATFORM_XLIB)
+#if defined(USE_PLATFORM_XLIB) && !defined(USE_PLATFORM_WAYLAND)
 typedef uint32_t xkb_keysym_t;
-extern "C" uint32_t xkb_keysym_to_utf32(xkb_keysym_t keysym);
 #endif
 
 // xkb type and function definitions
 // (we avoid dependency on include xkbcommon/xkbcommon.h to lessen VulkanWindow dependencies;
 // instead we replace the include by the following enums and structs)
-#if defined(USE_PLATFORM_WAYLAND)
+#if defined(USE_PLATFORM_WAYLAND) || defined(USE_PLATFORM_DISPLAY)
 enum xkb_context_flags {
 	XKB_CONTEXT_NO_FLAGS = 0,
 };
@@ -143,20 +404,127 @@ typedef uint32_t xkb_keycode_t;
 typedef uint32_t xkb_keysym_t;
 typedef uint32_t xkb_mod_mask_t;
 typedef uint32_t xkb_layout_index_t;
-extern "C" struct xkb_context* xkb_context_new(enum xkb_context_flags flags);
-extern "C" struct xkb_keymap* xkb_keymap_new_from_string(
-	struct xkb_context* context, const char* string,
-	enum xkb_keymap_format format, enum xkb_keymap_compile_flags flags);
-extern "C" void xkb_keymap_unref(struct xkb_keymap* keymap);
-extern "C" struct xkb_state* xkb_state_new(struct xkb_keymap* keymap);
-extern "C" void xkb_state_unref(struct xkb_state* state);
-extern "C" enum xkb_state_component xkb_state_update_mask(
-	struct xkb_state *state, xkb_mod_mask_t depressed_mods,
-	xkb_mod_mask_t latched_mods, xkb_mod_mask_t locked_mods,
-	xkb_layout_index_t depressed_layout, xkb_layout_index_t latched_layout,
-	xkb_layout_index_t locked_layout);
-extern "C" uint32_t xkb_state_key_get_utf32(struct xkb_state* state, xkb_keycode_t key);
-extern "C" void xkb_context_unref(struct xkb_context* context);
+#endif
+#if defined(USE_PLATFORM_DISPLAY)
+struct xkb_rule_names {
+	const char* rules;
+	const char* model;
+	const char* layout;
+	const char* variant;
+	const char* options;
+};
+#endif
+
+// libxkbcommon functions
+// (the library is loaded by dlopen() on the first use,
+// so the processes that never process keyboard input do not load it)
+#if defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND) || defined(USE_PLATFORM_DISPLAY)
+struct xkbcommon {
+	struct Funcs {
+#if defined(USE_PLATFORM_XLIB)
+		uint32_t (*xkb_keysym_to_utf32)(xkb_keysym_t keysym);
+#endif
+#if defined(USE_PLATFORM_WAYLAND) || defined(USE_PLATFORM_DISPLAY)
+		struct xkb_context* (*xkb_context_new)(enum xkb_context_flags flags);
+		void (*xkb_context_unref)(struct xkb_context* context);
+# if defined(USE_PLATFORM_WAYLAND)
+		struct xkb_keymap* (*xkb_keymap_new_from_string)(struct xkb_context* context, const char* string,
+			enum xkb_keymap_format format, enum xkb_keymap_compile_flags flags);
+# else
+		struct xkb_keymap* (*xkb_keymap_new_from_names)(struct xkb_context* context, const struct xkb_rule_names* names,
+			enum xkb_keymap_compile_flags flags);
+# endif
+		void (*xkb_keymap_unref)(struct xkb_keymap* keymap);
+		struct xkb_state* (*xkb_state_new)(struct xkb_keymap* keymap);
+		void (*xkb_state_unref)(struct xkb_state* state);
+		uint32_t (*xkb_state_key_get_utf32)(struct xkb_state* state, xkb_keycode_t key);
+#endif
+	};
+	static inline Funcs funcs;
+	static inline void* handle = nullptr;
+};
+#endif
+
+// XRandR types and functions
+// (we avoid dependency on include X11/extensions/Xrandr.h to lessen VulkanWindow dependencies;
+// the library is loaded by dlopen() on the first outputs query)
+#if defined(USE_PLATFORM_XLIB)
+typedef XID RROutput;
+typedef XID RRCrtc;
+typedef XID RRMode;
+struct XRRModeInfo {
+	RRMode id;
+	unsigned int width;
+	unsigned int height;
+	unsigned long dotClock;
+	unsigned int hSyncStart;
+	unsigned int hSyncEnd;
+	unsigned int hTotal;
+	unsigned int hSkew;
+	unsigned int vSyncStart;
+	unsigned int vSyncEnd;
+	unsigned int vTotal;
+	char* name;
+	unsigned int nameLength;
+	unsigned long modeFlags;
+};
+struct XRRScreenResources {
+	Time timestamp;
+	Time configTimestamp;
+	int ncrtc;
+	RRCrtc* crtcs;
+	int noutput;
+	RROutput* outputs;
+	int nmode;
+	XRRModeInfo* modes;
+};
+struct XRROutputInfo {
+	Time timestamp;
+	RRCrtc crtc;
+	char* name;
+	int nameLen;
+	unsigned long mm_width;
+	unsigned long mm_height;
+	unsigned short connection;
+	unsigned short subpixel_order;
+	int ncrtc;
+	RRCrtc* crtcs;
+	int nclone;
+	RROutput* clones;
+	int nmode;
+	int npreferred;
+	RRMode* modes;
+};
+struct XRRCrtcInfo {
+	Time timestamp;
+	int x, y;
+	unsigned int width, height;
+	RRMode mode;
+	unsigned short rotation;
+	int noutput;
+	RROutput* outputs;
+	unsigned short rotations;
+	int npossible;
+	RROutput* possible;
+};
+constexpr const unsigned short RR_Connected = 0;
+constexpr const unsigned long RR_Interlace = 0x10;
+constexpr const unsigned long RR_DoubleScan = 0x20;
+struct xrandr {
+	struct Funcs {
+		XRRScreenResources* (*XRRGetScreenResourcesCurrent)(Display* dpy, Window window);
+		void (*XRRFreeScreenResources)(XRRScreenResources* resources);
+		XRROutputInfo* (*XRRGetOutputInfo)(Display* dpy, XRRScreenResources* resources, RROutput output);
+		void (*XRRFreeOutputInfo)(XRROutputInfo* outputInfo);
+		XRRCrtcInfo* (*XRRGetCrtcInfo)(Display* dpy, XRRScreenResources* resources, RRCrtc crtc);
+		void (*XRRFreeCrtcInfo)(XRRCrtcInfo* crtcInfo);
+		int (*XRRGetOutputProperty)(Display* dpy, RROutput output, Atom property, long offset, long length,
+			Bool _delete, Bool pending, Atom req_type, Atom* actual_type, int* actual_format,
+			unsigned long* nitems, unsigned long* bytes_after, unsigned char** prop);
+	};
+	static inline Funcs funcs;
+	static inline void* handle = nullptr;
+};
 #endif
 
 // libdecor enums and structs
@@ -235,6 +603,386 @@ struct libdecor_frame_workaround {  // taken from libdecor-plugin.h to workaroun
 using namespace std;
 
 
+// startup timing
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// current time for the frame rate limiter
+static int64_t steadyNanoseconds()
+{
+	return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#if defined(USE_PLATFORM_WIN32)
+
+// frame timer
+// (waitable timer waited for together with the messages, so the main loop wakes up at the time of the deferred frame;
+// high resolution timer is available since Windows 10 1803, older systems get the timer of the system timer resolution)
+# ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#  define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+# endif
+struct FrameTimer {
+	HANDLE handle = NULL;
+	~FrameTimer()  { if(handle) CloseHandle(handle); }
+};
+static thread_local FrameTimer frameTimer;
+
+// arm frame timer for the given steady clock time and return its handle
+static HANDLE armFrameTimer(int64_t wakeUpTime)
+{
+	if(frameTimer.handle == NULL) {
+		frameTimer.handle = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		if(frameTimer.handle == NULL)
+			frameTimer.handle = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+		if(frameTimer.handle == NULL)
+			throw runtime_error("VulkanWindow: CreateWaitableTimerExW() failed.");
+	}
+
+	// negative due time is relative, in 100ns units
+	LARGE_INTEGER dueTime;
+	dueTime.QuadPart = -max((wakeUpTime - steadyNanoseconds()) / 100, int64_t(1));
+	if(!SetWaitableTimer(frameTimer.handle, &dueTime, 0, NULL, NULL, FALSE))
+		throw runtime_error("VulkanWindow: SetWaitableTimer() failed.");
+	return frameTimer.handle;
+}
+
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND) || defined(USE_PLATFORM_DISPLAY)
+
+// frame timer
+// (timerfd polled by the main loop together with the other file descriptors; it is armed for the absolute time
+// of the deferred frame, so the main loop wakes up on time without rounding the timeout to milliseconds;
+// steady_clock uses CLOCK_MONOTONIC on Linux)
+struct FrameTimer {
+
+	int fd = -1;
+	int64_t armedTime = -1;  // -1 means disarmed
+
+	~FrameTimer()  { if(fd != -1) close(fd); }
+
+	int getFd()
+	{
+		if(fd == -1) {
+			fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+			if(fd == -1)
+				throw runtime_error("VulkanWindow: timerfd_create() failed.");
+		}
+		return fd;
+	}
+
+	// arm the timer for the given steady clock time, -1 disarms it
+	void arm(int64_t wakeUpTime)
+	{
+		if(wakeUpTime == armedTime)
+			return;
+		itimerspec ts = {};
+		if(wakeUpTime != -1) {
+			ts.it_value.tv_sec = time_t(wakeUpTime / 1000000000);
+			ts.it_value.tv_nsec = long(wakeUpTime % 1000000000);
+		}
+		if(timerfd_settime(getFd(), TFD_TIMER_ABSTIME, &ts, nullptr) == -1)
+			throw runtime_error("VulkanWindow: timerfd_settime() failed.");
+		armedTime = wakeUpTime;
+	}
+
+	// read the expiration, so the fd is not readable any more
+	void reset()
+	{
+		uint64_t numExpirations;
+		if(read(fd, &numExpirations, sizeof(numExpirations)) == -1 && errno != EAGAIN)
+			throw runtime_error("VulkanWindow: read() from timerfd failed.");
+		armedTime = -1;
+	}
+
+};
+static thread_local FrameTimer frameTimer;
+
+#else
+
+// wait timeout in milliseconds until the given steady clock time
+// (rounded down, so the wait does not end after the given time, the rest is slept by sleepUntil();
+// -1 wakeUpTime means infinite wait and gives -1)
+static int timeoutMilliseconds(int64_t wakeUpTime)
+{
+	if(wakeUpTime < 0)
+		return -1;
+	int64_t timeout = wakeUpTime - steadyNanoseconds();
+	if(timeout <= 0)
+		return 0;
+	return int(min(timeout / 1000000, int64_t(INT_MAX)));
+}
+
+// sleep until the given steady clock time
+// (the event waiting functions of SDL, GLFW and Qt take milliseconds, so they are used only for the whole milliseconds
+// and this function sleeps the rest; clock_nanosleep() with absolute time wakes up within tens of microseconds
+// on Linux; steady_clock uses CLOCK_MONOTONIC there)
+static void sleepUntil(int64_t wakeUpTime)
+{
+# if defined(__linux__)
+	timespec ts;
+	ts.tv_sec = time_t(wakeUpTime / 1000000000);
+	ts.tv_nsec = long(wakeUpTime % 1000000000);
+	while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR);
+# elif defined(USE_PLATFORM_SDL3)
+	int64_t t = wakeUpTime - steadyNanoseconds();
+	if(t > 0)
+		SDL_DelayPrecise(Uint64(t));
+# else
+	this_thread::sleep_until(chrono::steady_clock::time_point(chrono::nanoseconds(wakeUpTime)));
+# endif
+}
+
+#endif
+
+
+#if defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND) || defined(USE_PLATFORM_DISPLAY)
+
+// load libxkbcommon on the first use
+static void loadXkbCommon()
+{
+	if(xkbcommon::handle)
+		return;
+
+	// load library
+	xkbcommon::handle = dlopen("libxkbcommon.so.0", RTLD_NOW);
+	if(xkbcommon::handle == nullptr)
+		throw runtime_error("VulkanWindow: Cannot open libxkbcommon.so.0 library.");
+
+	// function pointers
+	bool ok = true;
+#if defined(USE_PLATFORM_XLIB)
+	reinterpret_cast<void*&>(xkbcommon::funcs.xkb_keysym_to_utf32)        = dlsym(xkbcommon::handle, "xkb_keysym_to_utf32");
+	ok = ok && xkbcommon::funcs.xkb_keysym_to_utf32;
+#endif
+#if defined(USE_PLATFORM_WAYLAND) || defined(USE_PLATFORM_DISPLAY)
+	reinterpret_cast<void*&>(xkbcommon::funcs.xkb_context_new)            = dlsym(xkbcommon::handle, "xkb_context_new");
+	reinterpret_cast<void*&>(xkbcommon::funcs.xkb_context_unref)          = dlsym(xkbcommon::handle, "xkb_context_unref");
+# if defined(USE_PLATFORM_WAYLAND)
+	reinterpret_cast<void*&>(xkbcommon::funcs.xkb_keymap_new_from_string) = dlsym(xkbcommon::handle, "xkb_keymap_new_from_string");
+# else
+	reinterpret_cast<void*&>(xkbcommon::funcs.xkb_keymap_new_from_names)  = dlsym(xkbcommon::handle, "xkb_keymap_new_from_names");
+# endif
+	reinterpret_cast<void*&>(xkbcommon::funcs.xkb_keymap_unref)           = dlsym(xkbcommon::handle, "xkb_keymap_unref");
+	reinterpret_cast<void*&>(xkbcommon::funcs.xkb_state_new)              = dlsym(xkbcommon::handle, "xkb_state_new");
+	reinterpret_cast<void*&>(xkbcommon::funcs.xkb_state_unref)            = dlsym(xkbcommon::handle, "xkb_state_unref");
+	reinterpret_cast<void*&>(xkbcommon::funcs.xkb_state_key_get_utf32)    = dlsym(xkbcommon::handle, "xkb_state_key_get_utf32");
+# if defined(USE_PLATFORM_WAYLAND)
+	ok = ok && xkbcommon::funcs.xkb_keymap_new_from_string;
+# else
+	ok = ok && xkbcommon::funcs.xkb_keymap_new_from_names;
+# endif
+	ok = ok && xkbcommon::funcs.xkb_context_new && xkbcommon::funcs.xkb_context_unref &&
+	     xkbcommon::funcs.xkb_keymap_unref && xkbcommon::funcs.xkb_state_new && xkbcommon::funcs.xkb_state_unref &&
+	     xkbcommon::funcs.xkb_state_key_get_utf32;
+#endif
+	if(!ok)
+	{
+		dlclose(xkbcommon::handle);
+		xkbcommon::handle = nullptr;
+		throw runtime_error("VulkanWindow: Cannot retrieve all function pointers out of libxkbcommon.so.0.");
+	}
+}
+
+#endif
+
+
+#if defined(USE_PLATFORM_XLIB)
+
+// load libXrandr on the first use
+static void loadXrandr()
+{
+	if(xrandr::handle)
+		return;
+
+	// load library
+	xrandr::handle = dlopen("libXrandr.so.2", RTLD_NOW);
+	if(xrandr::handle == nullptr)
+		throw runtime_error("VulkanWindow: Cannot open libXrandr.so.2 library.");
+
+	// function pointers
+	reinterpret_cast<void*&>(xrandr::funcs.XRRGetScreenResourcesCurrent) = dlsym(xrandr::handle, "XRRGetScreenResourcesCurrent");
+	reinterpret_cast<void*&>(xrandr::funcs.XRRFreeScreenResources)       = dlsym(xrandr::handle, "XRRFreeScreenResources");
+	reinterpret_cast<void*&>(xrandr::funcs.XRRGetOutputInfo)             = dlsym(xrandr::handle, "XRRGetOutputInfo");
+	reinterpret_cast<void*&>(xrandr::funcs.XRRFreeOutputInfo)            = dlsym(xrandr::handle, "XRRFreeOutputInfo");
+	reinterpret_cast<void*&>(xrandr::funcs.XRRGetCrtcInfo)               = dlsym(xrandr::handle, "XRRGetCrtcInfo");
+	reinterpret_cast<void*&>(xrandr::funcs.XRRFreeCrtcInfo)              = dlsym(xrandr::handle, "XRRFreeCrtcInfo");
+	reinterpret_cast<void*&>(xrandr::funcs.XRRGetOutputProperty)         = dlsym(xrandr::handle, "XRRGetOutputProperty");
+	if(!xrandr::funcs.XRRGetScreenResourcesCurrent || !xrandr::funcs.XRRFreeScreenResources ||
+	   !xrandr::funcs.XRRGetOutputInfo || !xrandr::funcs.XRRFreeOutputInfo || !xrandr::funcs.XRRGetCrtcInfo ||
+	   !xrandr::funcs.XRRFreeCrtcInfo || !xrandr::funcs.XRRGetOutputProperty)
+	{
+		dlclose(xrandr::handle);
+		xrandr::handle = nullptr;
+		throw runtime_error("VulkanWindow: Cannot retrieve all function pointers out of libXrandr.so.2.");
+	}
+}
+
+#endif
+
+
+#if defined(USE_PLATFORM_XLIB) && defined(USE_PLATFORM_WAYLAND)
+
+// selected backend of the multi-backend build
+struct backend {
+	static inline bool xlib = false;
+};
+static bool xlibSelected()  { return backend::xlib; }
+static bool waylandSelected()  { return !backend::xlib; }
+
+// load libX11 in the multi-backend build
+// (returns false if the library is not installed)
+static bool loadLibX11()
+{
+	if(libx11::handle)
+		return true;
+
+	// load library
+	libx11::handle = dlopen("libX11.so.6", RTLD_NOW);
+	if(libx11::handle == nullptr)
+		return false;
+
+	// function pointers
+	// (the names are redirected to libx11::funcs members by the macros on the top of this file)
+	auto get =
+		[](void*& f, const char* name) {
+			f = dlsym(libx11::handle, name);
+			if(f == nullptr) {
+				dlclose(libx11::handle);
+				libx11::handle = nullptr;
+				throw runtime_error(string("VulkanWindow: Cannot retrieve ") + name + " function pointer out of libX11.so.6.");
+			}
+		};
+	get(reinterpret_cast<void*&>(XInitThreads),               "XInitThreads");
+	get(reinterpret_cast<void*&>(XOpenDisplay),               "XOpenDisplay");
+	get(reinterpret_cast<void*&>(XCloseDisplay),              "XCloseDisplay");
+	get(reinterpret_cast<void*&>(XDisplayString),             "XDisplayString");
+	get(reinterpret_cast<void*&>(XDefaultScreen),             "XDefaultScreen");
+	get(reinterpret_cast<void*&>(XResourceManagerString),     "XResourceManagerString");
+	get(reinterpret_cast<void*&>(XInternAtom),                "XInternAtom");
+	get(reinterpret_cast<void*&>(XFlush),                     "XFlush");
+	get(reinterpret_cast<void*&>(XEventsQueued),              "XEventsQueued");
+	get(reinterpret_cast<void*&>(XNextEvent),                 "XNextEvent");
+	get(reinterpret_cast<void*&>(XPeekEvent),                 "XPeekEvent");
+	get(reinterpret_cast<void*&>(XCheckTypedWindowEvent),     "XCheckTypedWindowEvent");
+	get(reinterpret_cast<void*&>(XSendEvent),                 "XSendEvent");
+	get(reinterpret_cast<void*&>(XLookupString),              "XLookupString");
+	get(reinterpret_cast<void*&>(XCreateWindow),              "XCreateWindow");
+	get(reinterpret_cast<void*&>(XDestroyWindow),             "XDestroyWindow");
+	get(reinterpret_cast<void*&>(XMapWindow),                 "XMapWindow");
+	get(reinterpret_cast<void*&>(XWithdrawWindow),            "XWithdrawWindow");
+	get(reinterpret_cast<void*&>(XIconifyWindow),             "XIconifyWindow");
+	get(reinterpret_cast<void*&>(XStoreName),                 "XStoreName");
+	get(reinterpret_cast<void*&>(XSetStandardProperties),     "XSetStandardProperties");
+	get(reinterpret_cast<void*&>(XSetWMProtocols),            "XSetWMProtocols");
+	get(reinterpret_cast<void*&>(XChangeProperty),            "XChangeProperty");
+	get(reinterpret_cast<void*&>(XGetWindowProperty),         "XGetWindowProperty");
+	get(reinterpret_cast<void*&>(XGetGeometry),               "XGetGeometry");
+	get(reinterpret_cast<void*&>(XTranslateCoordinates),      "XTranslateCoordinates");
+	get(reinterpret_cast<void*&>(XSetWindowBackground),       "XSetWindowBackground");
+	get(reinterpret_cast<void*&>(XSetWindowBackgroundPixmap), "XSetWindowBackgroundPixmap");
+	get(reinterpret_cast<void*&>(XFree),                      "XFree");
+	return true;
+}
+
+// unload libX11
+static void unloadLibX11()
+{
+	if(libx11::handle) {
+		dlclose(libx11::handle);
+		libx11::handle = nullptr;
+		libx11::funcs = {};
+	}
+}
+
+// load libwayland-client and libwayland-cursor in the multi-backend build
+// (returns false if the libraries are not installed)
+static bool loadLibWayland()
+{
+	if(libwayland::clientHandle)
+		return true;
+
+	// load libraries
+	libwayland::clientHandle = dlopen("libwayland-client.so.0", RTLD_NOW);
+	if(libwayland::clientHandle == nullptr)
+		return false;
+	libwayland::cursorHandle = dlopen("libwayland-cursor.so.0", RTLD_NOW);
+	if(libwayland::cursorHandle == nullptr) {
+		dlclose(libwayland::clientHandle);
+		libwayland::clientHandle = nullptr;
+		return false;
+	}
+
+	// function pointers
+	// (the names are redirected to libwayland::funcs members by the macros on the top of this file)
+	auto get =
+		[](void* handle, void*& f, const char* name) {
+			f = dlsym(handle, name);
+			if(f == nullptr) {
+				dlclose(libwayland::cursorHandle);
+				dlclose(libwayland::clientHandle);
+				libwayland::cursorHandle = nullptr;
+				libwayland::clientHandle = nullptr;
+				throw runtime_error(string("VulkanWindow: Cannot retrieve ") + name + " function pointer out of libwayland libraries.");
+			}
+		};
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_connect),                     "wl_display_connect");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_disconnect),                  "wl_display_disconnect");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_get_fd),                      "wl_display_get_fd");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_dispatch),                    "wl_display_dispatch");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_dispatch_pending),            "wl_display_dispatch_pending");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_dispatch_queue),              "wl_display_dispatch_queue");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_dispatch_queue_pending),      "wl_display_dispatch_queue_pending");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_flush),                       "wl_display_flush");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_roundtrip),                   "wl_display_roundtrip");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_roundtrip_queue),             "wl_display_roundtrip_queue");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_prepare_read),                "wl_display_prepare_read");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_prepare_read_queue),          "wl_display_prepare_read_queue");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_cancel_read),                 "wl_display_cancel_read");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_read_events),                 "wl_display_read_events");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_display_create_queue),                "wl_display_create_queue");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_event_queue_destroy),                 "wl_event_queue_destroy");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_create_wrapper),                "wl_proxy_create_wrapper");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_wrapper_destroy),               "wl_proxy_wrapper_destroy");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_set_queue),                     "wl_proxy_set_queue");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_get_version),                   "wl_proxy_get_version");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_set_tag),                       "wl_proxy_set_tag");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_get_tag),                       "wl_proxy_get_tag");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_marshal),                       "wl_proxy_marshal");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_marshal_constructor),           "wl_proxy_marshal_constructor");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_marshal_constructor_versioned), "wl_proxy_marshal_constructor_versioned");
+#ifdef WL_MARSHAL_FLAG_DESTROY
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_marshal_flags),                 "wl_proxy_marshal_flags");
+#endif
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_destroy),                       "wl_proxy_destroy");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_add_listener),                  "wl_proxy_add_listener");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_set_user_data),                 "wl_proxy_set_user_data");
+	get(libwayland::clientHandle, reinterpret_cast<void*&>(wl_proxy_get_user_data),                 "wl_proxy_get_user_data");
+	get(libwayland::cursorHandle, reinterpret_cast<void*&>(wl_cursor_theme_load),                   "wl_cursor_theme_load");
+	get(libwayland::cursorHandle, reinterpret_cast<void*&>(wl_cursor_theme_destroy),                "wl_cursor_theme_destroy");
+	get(libwayland::cursorHandle, reinterpret_cast<void*&>(wl_cursor_theme_get_cursor),             "wl_cursor_theme_get_cursor");
+	get(libwayland::cursorHandle, reinterpret_cast<void*&>(wl_cursor_image_get_buffer),             "wl_cursor_image_get_buffer");
+	return true;
+}
+
+// unload libwayland-client and libwayland-cursor
+static void unloadLibWayland()
+{
+	if(libwayland::clientHandle) {
+		dlclose(libwayland::cursorHandle);
+		dlclose(libwayland::clientHandle);
+		libwayland::cursorHandle = nullptr;
+		libwayland::clientHandle = nullptr;
+		libwayland::funcs = {};
+	}
+}
+
+#elif defined(USE_PLATFORM_XLIB)
+static constexpr bool xlibSelected()  { return true; }
+#elif defined(USE_PLATFORM_WAYLAND)
+static constexpr bool waylandSelected()  { return true; }
+#endif
+
 
 class VulkanWindowPrivate : public VulkanWindow {
 public:
@@ -242,11 +990,22 @@ public:
 	static LRESULT wndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) noexcept;
 #elif defined(USE_PLATFORM_WAYLAND)
 	static void registryListenerGlobal(void*, wl_registry* registry, uint32_t name, const char* interface, uint32_t version);
-	static void registryListenerGlobalRemove(void*, wl_registry*, uint32_t);
+	static void registryListenerGlobalRemove(void*, wl_registry*, uint32_t name);
+	static void outputListenerGeometry(void* data, wl_output* output, int32_t x, int32_t y, int32_t physicalWidth, int32_t physicalHeight,
+	                                   int32_t subpixel, const char* make, const char* model, int32_t transform);
+	static void outputListenerMode(void* data, wl_output* output, uint32_t flags, int32_t width, int32_t height, int32_t refresh);
+	static void outputListenerDone(void* data, wl_output* output);
+	static void outputListenerScale(void* data, wl_output* output, int32_t factor);
+	static void outputListenerName(void* data, wl_output* output, const char* name);
+	static void outputListenerDescription(void* data, wl_output* output, const char* description);
+	static void surfaceListenerEnter(void* data, wl_surface* surface, wl_output* output);
+	static void surfaceListenerLeave(void* data, wl_surface* surface, wl_output* output);
 	static void xdgWmBaseListenerPing(void*, xdg_wm_base* xdg, uint32_t serial);
 	static void xdgSurfaceListenerConfigure(void* data, xdg_surface* xdgSurface, uint32_t serial);
 	static void xdgToplevelListenerConfigure(void* data, xdg_toplevel* toplevel, int32_t width, int32_t height, wl_array*);
 	static void xdgToplevelListenerClose(void* data, xdg_toplevel* xdgTopLevel);
+	static void xdgToplevelListenerConfigureBounds(void* data, xdg_toplevel* toplevel, int32_t width, int32_t height);
+	static void placeholderBufferListenerRelease(void* data, wl_buffer* buffer);
 	static void libdecorError(libdecor* context, libdecor_error error, const char* message);
 	static void libdecorFrameConfigure(libdecor_frame* frame, libdecor_configuration* config, void* data);
 	static void libdecorFrameClose(libdecor_frame* frame, void* data);
@@ -255,6 +1014,10 @@ public:
 	static void frameListenerDone(void *data, wl_callback* cb, uint32_t time);
 	static void syncListenerDone(void *data, wl_callback* cb, uint32_t time);
 	static void seatListenerCapabilities(void* data, wl_seat* seat, uint32_t capabilities);
+	static void loadCursor();
+	struct InputEvent;
+	static void postInputEvent(const InputEvent& e);
+	static void processInputEvent(const InputEvent& e);
 	static void pointerListenerEnter(void* data, wl_pointer* pointer, uint32_t serial, wl_surface* surface,
 	                                 wl_fixed_t surface_x, wl_fixed_t surface_y);
 	static void pointerListenerLeave(void* data, wl_pointer* pointer, uint32_t serial, wl_surface* surface);
@@ -267,8 +1030,42 @@ public:
 	static void keyboardListenerKey(void* data, wl_keyboard* keyboard, uint32_t serial, uint32_t time, uint32_t scanCode, uint32_t state);
 	static void keyboardListenerModifiers(void* data, wl_keyboard* keyboard, uint32_t serial, uint32_t mods_depressed,
 	                                      uint32_t mods_latched, uint32_t mods_locked, uint32_t group);
+#elif defined(USE_PLATFORM_DISPLAY)
+	static void openInputDevices();
+	static void processInputEvent(const input_event& e);
 #endif
+#if !defined(USE_PLATFORM_QT)
+	static inline thread_local vector<VulkanWindow*> deferredFrameWindows;  // windows with _frameDeferred set
+	static void deferFrame(VulkanWindow* w);
+	static void cancelDeferredFrame(VulkanWindow* w);
+	static int64_t scheduleDeferredFrames();  // returns steady clock time to wake up for the next deferred frame or -1 if there is none
+#endif
+	struct LayoutChecks;
+};
+
+
+// layout checks
+// (hot members must stay within the first 64 bytes of the object, see VulkanWindow.h;
+// the checks use VulkanWindowPrivate scope to get access to protected members)
+#if defined(__GNUC__)
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
+struct VulkanWindowPrivate::LayoutChecks {
+	static_assert(offsetof(VulkanWindowPrivate, _listener) + sizeof(_listener) <= 64, "Listener is not in the first 64 bytes.");
+	static_assert(offsetof(VulkanWindowPrivate, _mouseState) + sizeof(_mouseState) <= 64, "Mouse state is not in the first 64 bytes.");
+	static_assert(offsetof(VulkanWindowPrivate, _win32.trackingMouseLeave) < 64, "Win32 frame pending flags are not in the first 64 bytes.");
+	static_assert(offsetof(VulkanWindowPrivate, _xlib.minimized) < 64, "Xlib frame pending flags are not in the first 64 bytes.");
+	static_assert(offsetof(VulkanWindowPrivate, _wayland.scheduledFrameCallback) + sizeof(void*) <= 64, "Wayland frame callback is not in the first 64 bytes.");
+	static_assert(offsetof(VulkanWindowPrivate, _sdl.minimized) < 64, "SDL frame pending flags are not in the first 64 bytes.");
+	static_assert(offsetof(VulkanWindowPrivate, _glfw.minimized) < 64, "GLFW frame pending flags are not in the first 64 bytes.");
+	static_assert(offsetof(VulkanWindowPrivate, _display.visible) < 64, "Display frame pending flags are not in the first 64 bytes.");
+	static_assert(offsetof(VulkanWindowPrivate, _frameCallback) > offsetof(VulkanWindowPrivate, _mouseState),
+	              "Frame callback is not placed after the hot members.");
 };
+#if defined(__GNUC__)
+# pragma GCC diagnostic pop
+#endif
 
 
 
@@ -301,7 +1098,9 @@ std::vector<const char*>& VulkanWindow::appendRequiredExtensions(std::vector<con
 uint32_t VulkanWindow::requiredExtensionCount()  { return uint32_t(win32::requiredInstanceExtensions.size()); }
 const char* const* VulkanWindow::requiredExtensionNames()  { return win32::requiredInstanceExtensions.data(); }
 
-#elif defined(USE_PLATFORM_XLIB)
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
+
+# if defined(USE_PLATFORM_XLIB)
 
 struct xlib {
 
@@ -309,7 +1108,12 @@ struct xlib {
 	static inline struct _XDisplay* display = nullptr;  // struct _XDisplay* is used instead of Display* type
 	static inline bool externalDisplayHandle;
 	static inline map<Window, VulkanWindow*> vulkanWindowMap;
-	static inline bool running;  // bool indicating that application is running and it shall not leave main loop
+	static inline mutex vulkanWindowMapMutex;  // vulkanWindowMap is shared by all threads
+	static inline thread_local bool running;  // bool indicating that application is running and it shall not leave main loop
+
+	// per-thread display connection
+	// (it is opened by VulkanWindow::initThread() and used by windows created on the thread)
+	static inline thread_local struct _XDisplay* threadDisplay = nullptr;
 	static inline unsigned long wmDeleteMessage;  // unsigned long is used for Atom type
 	static inline unsigned long wmStateProperty;  // unsigned long is used for Atom type
 	static inline unsigned long netWmName;  // unsigned long is used for Atom type
@@ -319,13 +1123,28 @@ struct xlib {
 
 };
 
-// required instance extensions functions
-const std::vector<const char*>& VulkanWindow::requiredExtensions()  { return xlib::requiredInstanceExtensions; }
-std::vector<const char*>& VulkanWindow::appendRequiredExtensions(std::vector<const char*>& v)  { v.insert(v.end(), xlib::requiredInstanceExtensions.begin(), xlib::requiredInstanceExtensions.end()); return v; }
-uint32_t VulkanWindow::requiredExtensionCount()  { return uint32_t(xlib::requiredInstanceExtensions.size()); }
-const char* const* VulkanWindow::requiredExtensionNames()  { return xlib::requiredInstanceExtensions.data(); }
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
+
+// input event forwarded to the thread owning the window
+struct VulkanWindowPrivate::InputEvent {
+	enum class Type : uint8_t { PointerEnter, PointerLeave, PointerMotion, PointerButton, PointerAxis, KeyboardEnter, KeyboardLeave, Key };
+	Type type;
+	bool pressed;  // button or key state
+	VulkanWindowPrivate* window;
+	std::bitset<16> modifiers;
+	float x, y;  // pointer position or wheel deltas
+	uint32_t code;  // button or scan code
+	uint32_t codePoint;
+};
 
-#elif defined(USE_PLATFORM_WAYLAND)
+// per-thread buffer of forwarded input events
+// (wakeFd is eventfd that wakes up the owning thread's main loop)
+struct WaylandInputBuffer {
+	mutex eventsMutex;
+	deque<VulkanWindowPrivate::InputEvent> events;
+	int wakeFd = -1;
+};
 
 struct wayland {
 
@@ -336,6 +1155,8 @@ struct wayland {
 	static inline struct wl_compositor* compositor = nullptr;
 	static inline struct xdg_wm_base* xdgWmBase = nullptr;
 	static inline struct zxdg_decoration_manager_v1* zxdgDecorationManagerV1 = nullptr;
+	static inline struct wp_single_pixel_buffer_manager_v1* singlePixelBufferManager = nullptr;
+	static inline struct wp_viewporter* viewporter = nullptr;
 	static inline struct libdecor* libdecorContext = nullptr;
 	static inline struct wl_shm* shm = nullptr;
 	static inline struct wl_cursor_theme* cursorTheme = nullptr;
@@ -348,9 +1169,35 @@ struct wayland {
 	static inline struct xkb_context* xkbContext = nullptr;
 	static inline struct xkb_state* xkbState = nullptr;
 	static inline std::bitset<16> modifiers;
-	static inline bool running;  // bool indicating that application is running and it shall not leave main loop
+	static inline thread_local bool running;  // bool indicating that application is running and it shall not leave main loop
 	static inline VulkanWindowPrivate* windowUnderPointer = nullptr;
 	static inline VulkanWindowPrivate* windowWithKbFocus = nullptr;
+	static inline mutex inputMutex;  // protects windowUnderPointer and windowWithKbFocus
+
+	// seat event queue
+	// (wl_seat, wl_pointer, wl_keyboard and xdg_wm_base live on their own queue that is dispatched
+	// by main loop of any thread, so input and pings are processed even if the main thread
+	// does not run the main loop; input events are then forwarded to the thread owning the window)
+	static inline struct wl_event_queue* seatQueue = nullptr;
+	static inline mutex seatQueueMutex;  // held while seatQueue is being dispatched
+	static inline atomic<bool> seatQueuePending = false;
+
+	// outputs
+	// (bound wl_outputs with their registry names and the last reported properties;
+	// the map is updated by the default queue dispatch and read by outputs() and windowOutputs() of any thread)
+	struct OutputData {
+		uint32_t registryName;
+		VulkanWindow::Output output;
+	};
+	static inline map<wl_output*, OutputData> outputs;
+	static inline mutex outputsMutex;  // protects outputs
+
+	// per-thread event queue
+	// (it is created by VulkanWindow::initThread() and used by windows created on the thread)
+	static inline thread_local struct wl_event_queue* threadQueue = nullptr;
+	static inline thread_local struct wl_display* threadDisplayWrapper = nullptr;
+	static inline thread_local WaylandInputBuffer* threadInputBuffer = nullptr;
+	static inline WaylandInputBuffer mainInputBuffer;  // input buffer of the windows using the default queue
 	static inline const char* vulkanWindowTag = "VulkanWindow";
 	static inline const vector<const char*> requiredInstanceExtensions =
 		{ "VK_KHR_surface", "VK_KHR_wayland_surface" };
@@ -379,17 +1226,35 @@ struct wayland {
 			struct libdecor_state* state, struct libdecor_configuration* configuration);
 		void (*libdecor_state_free)(struct libdecor_state* state);
 		int (*libdecor_dispatch)(struct libdecor* context, int timeout);
+		int (*libdecor_get_fd)(struct libdecor* context);
 	};
 	static inline Funcs funcs;
 	static inline void* libdecorHandle = nullptr;
 
 };
 
+# endif
+
+// required instance extensions of the selected backend
+// (the multi-backend build does not know the backend before init(), so init() is called if not done yet)
+static const vector<const char*>& requiredInstanceExtensions()
+{
+# if defined(USE_PLATFORM_XLIB) && defined(USE_PLATFORM_WAYLAND)
+	if(xlib::display == nullptr && wayland::display == nullptr)
+		VulkanWindow::init();
+	return xlibSelected() ? xlib::requiredInstanceExtensions : wayland::requiredInstanceExtensions;
+# elif defined(USE_PLATFORM_XLIB)
+	return xlib::requiredInstanceExtensions;
+# else
+	return wayland::requiredInstanceExtensions;
+# endif
+}
+
 // required instance extensions functions
-const std::vector<const char*>& VulkanWindow::requiredExtensions()  { return wayland::requiredInstanceExtensions; }
-std::vector<const char*>& VulkanWindow::appendRequiredExtensions(std::vector<const char*>& v)  { v.insert(v.end(), wayland::requiredInstanceExtensions.begin(), wayland::requiredInstanceExtensions.end()); return v; }
-uint32_t VulkanWindow::requiredExtensionCount()  { return uint32_t(wayland::requiredInstanceExtensions.size()); }
-const char* const* VulkanWindow::requiredExtensionNames()  { return wayland::requiredInstanceExtensions.data(); }
+const std::vector<const char*>& VulkanWindow::requiredExtensions()  { return requiredInstanceExtensions(); }
+std::vector<const char*>& VulkanWindow::appendRequiredExtensions(std::vector<const char*>& v)  { auto& e = requiredInstanceExtensions(); v.insert(v.end(), e.begin(), e.end()); return v; }
+uint32_t VulkanWindow::requiredExtensionCount()  { return uint32_t(requiredInstanceExtensions().size()); }
+const char* const* VulkanWindow::requiredExtensionNames()  { return requiredInstanceExtensions().data(); }
 
 #elif defined(USE_PLATFORM_SDL3) || defined(USE_PLATFORM_SDL2)
 
@@ -409,6 +1274,9 @@ struct sdl {
 
 struct glfw {
 
+	// true if glfwInit() was called
+	static inline bool initialized = false;
+
 	// bool indicating that application is running and it shall not leave main loop
 	static inline bool running;
 
@@ -425,9 +1293,10 @@ class QtRenderingWindow : public QWindow {
 public:
 	VulkanWindow* vulkanWindow;
 	int timer = 0;
-	QtRenderingWindow(QWindow* parent, VulkanWindow* vulkanWindow_) : QWindow(parent), vulkanWindow(vulkanWindow_)  {}
+	bool deferredFrameTimer = false;
+	QtRenderingWindow(QWindow* parent, VulkanWindow* vulkanWindow_);
 	bool event(QEvent* event) override;
-	void scheduleFrameTimer();
+	void scheduleFrameTimer(int timeout = 0);  // non-zero timeout is used for frames deferred by waitForFrameTime()
 };
 
 struct qt {
@@ -449,6 +1318,57 @@ struct qt {
 
 };
 
+#elif defined(USE_PLATFORM_DISPLAY)
+
+struct display {
+
+	// true if VulkanWindow::init() was called
+	static inline bool initialized = false;
+
+	// bool indicating that application is running and it shall not leave main loop
+	static inline bool running;
+
+	// list of windows waiting for frame rendering
+	// (the windows have _framePendingState set to FramePendingState::Pending or TentativePending)
+	static inline vector<VulkanWindow*> framePendingWindows;
+
+	// display and plane used by create(), see VulkanWindow::setDisplayTarget()
+	static inline uint32_t displayIndex = 0;
+	static inline uint32_t planeIndex = UINT32_MAX;
+
+	// Vulkan instance of the last create() call
+	// (there is no display server, so outputs() has to enumerate VkDisplayKHRs through it)
+	static inline VkInstance instance = nullptr;
+	static inline PFN_vkGetInstanceProcAddr getInstanceProcAddr = nullptr;
+
+	// file descriptors waited on by the main loop
+	// (the first one is eventfd that wakes up the main loop on scheduleFrame() and exitMainLoop(),
+	// the second one is the frame timer owned by frameTimer,
+	// the others starting at firstInputFd are evdev input devices that are read directly)
+	static inline vector<pollfd> pollFds;
+	static constexpr size_t firstInputFd = 2;
+	static inline bool grabInput = false;  // see VulkanWindow::setDisplayInputGrab()
+
+	// input
+	// (all input goes to the window with focus, which is the last shown one)
+	static inline VulkanWindowPrivate* windowWithFocus = nullptr;
+	static inline float pointerRelX = 0.f;  // relative motion accumulated until EV_SYN
+	static inline float pointerRelY = 0.f;
+	static inline std::bitset<16> modifiers;
+	static inline struct xkb_context* xkbContext = nullptr;
+	static inline struct xkb_state* xkbState = nullptr;
+
+	static inline const vector<const char*> requiredInstanceExtensions =
+		{ "VK_KHR_surface", "VK_KHR_display" };
+
+};
+
+// required instance extensions functions
+const std::vector<const char*>& VulkanWindow::requiredExtensions()  { return display::requiredInstanceExtensions; }
+std::vector<const char*>& VulkanWindow::appendRequiredExtensions(std::vector<const char*>& v)  { v.insert(v.end(), display::requiredInstanceExtensions.begin(), display::requiredInstanceExtensions.end()); return v; }
+uint32_t VulkanWindow::requiredExtensionCount()  { return uint32_t(display::requiredInstanceExtensions.size()); }
+const char* const* VulkanWindow::requiredExtensionNames()  { return display::requiredInstanceExtensions.data(); }
+
 #endif
 
 
@@ -567,6 +1487,10 @@ static const xdg_surface_listener xdgSurfaceListener{
 static const xdg_toplevel_listener xdgToplevelListener{
 	VulkanWindowPrivate::xdgToplevelListenerConfigure,
 	VulkanWindowPrivate::xdgToplevelListenerClose,
+	VulkanWindowPrivate::xdgToplevelListenerConfigureBounds,
+};
+static const wl_buffer_listener placeholderBufferListener{
+	VulkanWindowPrivate::placeholderBufferListenerRelease,
 };
 static libdecor_interface libdecorInterface{
 	VulkanWindowPrivate::libdecorError,
@@ -600,6 +1524,20 @@ static const wl_keyboard_listener keyboardListener{
 	VulkanWindowPrivate::keyboardListenerKey,
 	VulkanWindowPrivate::keyboardListenerModifiers,
 };
+static const wl_output_listener outputListener{
+	VulkanWindowPrivate::outputListenerGeometry,
+	VulkanWindowPrivate::outputListenerMode,
+	VulkanWindowPrivate::outputListenerDone,
+	VulkanWindowPrivate::outputListenerScale,
+# ifdef WL_OUTPUT_NAME_SINCE_VERSION
+	VulkanWindowPrivate::outputListenerName,
+	VulkanWindowPrivate::outputListenerDescription,
+# endif
+};
+static const wl_surface_listener surfaceListener{
+	VulkanWindowPrivate::surfaceListenerEnter,
+	VulkanWindowPrivate::surfaceListenerLeave,
+};
 
 // registry global object notification
 void VulkanWindowPrivate::registryListenerGlobal(void*, wl_registry* registry, uint32_t name, const char* interface, uint32_t version)
@@ -607,43 +1545,164 @@ void VulkanWindowPrivate::registryListenerGlobal(void*, wl_registry* registry, u
 	if(strcmp(interface, wl_compositor_interface.name) == 0)
 		wayland::compositor = static_cast<wl_compositor*>(
 			wl_registry_bind(registry, name, &wl_compositor_interface, 1));
-	else if(strcmp(interface, xdg_wm_base_interface.name) == 0)
+	else if(strcmp(interface, xdg_wm_base_interface.name) == 0) {
+		// (version 4 is used for xdg_toplevel.configure_bounds event)
 		wayland::xdgWmBase = static_cast<xdg_wm_base*>(
-			wl_registry_bind(registry, name, &xdg_wm_base_interface, 1));
+			wl_registry_bind(registry, name, &xdg_wm_base_interface, min(version, 4u)));
+		wl_proxy_set_queue(reinterpret_cast<wl_proxy*>(wayland::xdgWmBase), wayland::seatQueue);
+		if(xdg_wm_base_add_listener(wayland::xdgWmBase, &xdgWmBaseListener, nullptr))
+			throw runtime_error("xdg_wm_base_add_listener() failed.");
+	}
 	else if(strcmp(interface, zxdg_decoration_manager_v1_interface.name) == 0)
 		wayland::zxdgDecorationManagerV1 = static_cast<zxdg_decoration_manager_v1*>(
 			wl_registry_bind(registry, name, &zxdg_decoration_manager_v1_interface, 1));
-	else if(strcmp(interface, wl_seat_interface.name) == 0)
+	else if(strcmp(interface, wl_seat_interface.name) == 0) {
+		// (listener is added immediately, so the seat events are processed
+		// by the main loop without the need of another round trip;
+		// wl_pointer and wl_keyboard inherit seatQueue from the seat)
 		wayland::seat = static_cast<wl_seat*>(wl_registry_bind(registry, name, &wl_seat_interface, 1));
+		wl_proxy_set_queue(reinterpret_cast<wl_proxy*>(wayland::seat), wayland::seatQueue);
+		if(wl_seat_add_listener(wayland::seat, &seatListener, nullptr))
+			throw runtime_error("wl_seat_add_listener() failed.");
+	}
 	else if(strcmp(interface, wl_shm_interface.name) == 0)
 		wayland::shm = static_cast<wl_shm*>(wl_registry_bind(registry, name, &wl_shm_interface, 1));
+	else if(strcmp(interface, wp_single_pixel_buffer_manager_v1_interface.name) == 0)
+		wayland::singlePixelBufferManager = static_cast<wp_single_pixel_buffer_manager_v1*>(
+			wl_registry_bind(registry, name, &wp_single_pixel_buffer_manager_v1_interface, 1));
+	else if(strcmp(interface, wp_viewporter_interface.name) == 0)
+		wayland::viewporter = static_cast<wp_viewporter*>(
+			wl_registry_bind(registry, name, &wp_viewporter_interface, 1));
+	else if(strcmp(interface, wl_output_interface.name) == 0) {
+		// (version 2 is used for scale, version 4 for name and description)
+# ifdef WL_OUTPUT_NAME_SINCE_VERSION
+		uint32_t outputVersion = min(version, 4u);
+# else
+		uint32_t outputVersion = min(version, 2u);
+# endif
+		wl_output* output = static_cast<wl_output*>(wl_registry_bind(registry, name, &wl_output_interface, outputVersion));
+		lock_guard<mutex> lock(wayland::outputsMutex);
+		wayland::OutputData& d = wayland::outputs[output];
+		d.registryName = name;
+		d.output.handle = output;
+		if(wl_output_add_listener(output, &outputListener, nullptr))
+			throw runtime_error("wl_output_add_listener() failed.");
+	}
 }
 
 // registry global object removal notification
-void VulkanWindowPrivate::registryListenerGlobalRemove(void*, wl_registry*, uint32_t)
+void VulkanWindowPrivate::registryListenerGlobalRemove(void*, wl_registry*, uint32_t name)
 {
+	// remove output
+	// (windows learn about it by wl_surface.leave event sent before the removal)
+	lock_guard<mutex> lock(wayland::outputsMutex);
+	for(auto it=wayland::outputs.begin(); it!=wayland::outputs.end(); it++)
+		if(it->second.registryName == name) {
+			if(wl_proxy_get_version(reinterpret_cast<wl_proxy*>(it->first)) >= WL_OUTPUT_RELEASE_SINCE_VERSION)
+				wl_output_release(it->first);
+			else
+				wl_output_destroy(it->first);
+			wayland::outputs.erase(it);
+			return;
+		}
 }
 
-// ping-pong message
-void VulkanWindowPrivate::xdgWmBaseListenerPing(void*, xdg_wm_base* xdg, uint32_t serial)
+// output properties
+// (position and size are in compositor coordinates, mode is in pixels and refresh rate in mHz)
+void VulkanWindowPrivate::outputListenerGeometry(void*, wl_output* output, int32_t x, int32_t y, int32_t, int32_t,
+                                                 int32_t, const char* make, const char* model, int32_t)
 {
-	xdg_wm_base_pong(xdg, serial);
-};
+	lock_guard<mutex> lock(wayland::outputsMutex);
+	Output& o = wayland::outputs[output].output;
+	o.posX = x;
+	o.posY = y;
+	if(o.name.empty())
+		o.name = string(make) + " " + model;
+}
 
-// make sure all window state changes were processed by Wayland server
-// by waiting on all sync events
-static void waitAllSyncEvents(unsigned& numSyncEventsOnTheFly)
+void VulkanWindowPrivate::outputListenerMode(void*, wl_output* output, uint32_t flags, int32_t width, int32_t height, int32_t refresh)
 {
-	// if numSyncEventsOnTheFly is not zero, dispatch Wayland events until it becomes zero
-	while(numSyncEventsOnTheFly != 0)
-		if(wl_display_dispatch(wayland::display) == -1)  // it blocks if there are no events
-			throw runtime_error("wl_display_dispatch() failed.");
+	if((flags & WL_OUTPUT_MODE_CURRENT) == 0)
+		return;
+	lock_guard<mutex> lock(wayland::outputsMutex);
+	Output& o = wayland::outputs[output].output;
+	o.width = width;
+	o.height = height;
+	o.refreshRate = double(refresh) / 1000.;
 }
 
-#elif defined(USE_PLATFORM_GLFW)
+void VulkanWindowPrivate::outputListenerDone(void*, wl_output*)
+{
+}
 
-// GLFW error handling
-static void throwError(const string& funcName)
+void VulkanWindowPrivate::outputListenerScale(void*, wl_output* output, int32_t factor)
+{
+	lock_guard<mutex> lock(wayland::outputsMutex);
+	wayland::outputs[output].output.scale = factor;
+}
+
+void VulkanWindowPrivate::outputListenerName(void*, wl_output* output, const char* name)
+{
+	// name (e.g. "DP-1") replaces make and model given by geometry event
+	lock_guard<mutex> lock(wayland::outputsMutex);
+	wayland::outputs[output].output.name = name;
+}
+
+void VulkanWindowPrivate::outputListenerDescription(void*, wl_output*, const char*)
+{
+}
+
+// surface entered or left an output
+void VulkanWindowPrivate::surfaceListenerEnter(void* data, wl_surface*, wl_output* output)
+{
+	VulkanWindowPrivate* w = static_cast<VulkanWindowPrivate*>(data);
+	w->_outputHandles.push_back(output);
+	if(w->hasOutputsChangedHandler())
+		w->callOutputsChanged();
+}
+
+void VulkanWindowPrivate::surfaceListenerLeave(void* data, wl_surface*, wl_output* output)
+{
+	VulkanWindowPrivate* w = static_cast<VulkanWindowPrivate*>(data);
+	auto it = find(w->_outputHandles.begin(), w->_outputHandles.end(), output);
+	if(it == w->_outputHandles.end())
+		return;
+	w->_outputHandles.erase(it);
+	if(w->hasOutputsChangedHandler())
+		w->callOutputsChanged();
+}
+
+// ping-pong message
+void VulkanWindowPrivate::xdgWmBaseListenerPing(void*, xdg_wm_base* xdg, uint32_t serial)
+{
+	xdg_wm_base_pong(xdg, serial);
+};
+
+// make sure all window state changes were processed by Wayland server
+// by waiting on all sync events
+// (returns true if it had to wait for the server)
+static bool waitAllSyncEvents(unsigned& numSyncEventsOnTheFly, wl_event_queue* eventQueue)
+{
+	if(numSyncEventsOnTheFly == 0)
+		return false;
+
+	// dispatch Wayland events until numSyncEventsOnTheFly becomes zero
+	// (windows with per-thread event queue receive sync events on their own queue)
+	while(numSyncEventsOnTheFly != 0)
+		if(eventQueue) {
+			if(wl_display_dispatch_queue(wayland::display, eventQueue) == -1)  // it blocks if there are no events
+				throw runtime_error("wl_display_dispatch_queue() failed.");
+		}
+		else
+			if(wl_display_dispatch(wayland::display) == -1)  // it blocks if there are no events
+				throw runtime_error("wl_display_dispatch() failed.");
+	return true;
+}
+
+#elif defined(USE_PLATFORM_GLFW)
+
+// GLFW error handling
+static void throwError(const string& funcName)
 {
 	const char* errorString;
 	int errorCode = glfwGetError(&errorString);
@@ -668,6 +1727,109 @@ static bool canUpdateSavedGeometry(GLFWwindow* w)
 	return true;
 };
 
+#elif defined(USE_PLATFORM_DISPLAY)
+
+// VK_KHR_display functions
+// (they are instance functions, so they are retrieved for each instance again)
+struct DisplayFuncs {
+	PFN_vkEnumeratePhysicalDevices vkEnumeratePhysicalDevices;
+	PFN_vkGetPhysicalDeviceDisplayPropertiesKHR vkGetPhysicalDeviceDisplayPropertiesKHR;
+	PFN_vkGetPhysicalDeviceDisplayPlanePropertiesKHR vkGetPhysicalDeviceDisplayPlanePropertiesKHR;
+	PFN_vkGetDisplayPlaneSupportedDisplaysKHR vkGetDisplayPlaneSupportedDisplaysKHR;
+	PFN_vkGetDisplayModePropertiesKHR vkGetDisplayModePropertiesKHR;
+	PFN_vkGetDisplayPlaneCapabilitiesKHR vkGetDisplayPlaneCapabilitiesKHR;
+	PFN_vkCreateDisplayPlaneSurfaceKHR vkCreateDisplayPlaneSurfaceKHR;
+};
+
+static DisplayFuncs getDisplayFuncs(VkInstance instance, PFN_vkGetInstanceProcAddr getInstanceProcAddr)
+{
+	DisplayFuncs f;
+	f.vkEnumeratePhysicalDevices = reinterpret_cast<PFN_vkEnumeratePhysicalDevices>(
+		getInstanceProcAddr(instance, "vkEnumeratePhysicalDevices"));
+	f.vkGetPhysicalDeviceDisplayPropertiesKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceDisplayPropertiesKHR>(
+		getInstanceProcAddr(instance, "vkGetPhysicalDeviceDisplayPropertiesKHR"));
+	f.vkGetPhysicalDeviceDisplayPlanePropertiesKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceDisplayPlanePropertiesKHR>(
+		getInstanceProcAddr(instance, "vkGetPhysicalDeviceDisplayPlanePropertiesKHR"));
+	f.vkGetDisplayPlaneSupportedDisplaysKHR = reinterpret_cast<PFN_vkGetDisplayPlaneSupportedDisplaysKHR>(
+		getInstanceProcAddr(instance, "vkGetDisplayPlaneSupportedDisplaysKHR"));
+	f.vkGetDisplayModePropertiesKHR = reinterpret_cast<PFN_vkGetDisplayModePropertiesKHR>(
+		getInstanceProcAddr(instance, "vkGetDisplayModePropertiesKHR"));
+	f.vkGetDisplayPlaneCapabilitiesKHR = reinterpret_cast<PFN_vkGetDisplayPlaneCapabilitiesKHR>(
+		getInstanceProcAddr(instance, "vkGetDisplayPlaneCapabilitiesKHR"));
+	f.vkCreateDisplayPlaneSurfaceKHR = reinterpret_cast<PFN_vkCreateDisplayPlaneSurfaceKHR>(
+		getInstanceProcAddr(instance, "vkCreateDisplayPlaneSurfaceKHR"));
+	if(!f.vkEnumeratePhysicalDevices || !f.vkGetPhysicalDeviceDisplayPropertiesKHR ||
+	   !f.vkGetPhysicalDeviceDisplayPlanePropertiesKHR || !f.vkGetDisplayPlaneSupportedDisplaysKHR ||
+	   !f.vkGetDisplayModePropertiesKHR || !f.vkGetDisplayPlaneCapabilitiesKHR || !f.vkCreateDisplayPlaneSurfaceKHR)
+		throw runtime_error("VulkanWindow: Failed to get VK_KHR_display function pointers. "
+		                    "Was the instance created with VulkanWindow::requiredExtensions()?");
+	return f;
+}
+
+// call Vulkan function returning an array
+// (the function is called again while it returns VK_INCOMPLETE)
+template<typename T, typename F>
+static vector<T> enumerateVk(F&& func, const char* funcName)
+{
+	vector<T> v;
+	VkResult r;
+	do {
+		uint32_t count;
+		r = func(&count, nullptr);
+		if(r != VK_SUCCESS)
+			break;
+		v.resize(count);
+		r = func(&count, v.data());
+		v.resize(count);
+	} while(r == VK_INCOMPLETE);
+	if(r != VK_SUCCESS)
+		throw runtime_error(string("VulkanWindow: ") + funcName + "() failed (return code: " + to_string(r) + ").");
+	return v;
+}
+
+// displays of all physical devices
+// (the order is the same as in outputs())
+struct DisplayInfo {
+	VkPhysicalDevice physicalDevice;
+	VkDisplayPropertiesKHR properties;
+};
+
+static vector<DisplayInfo> getDisplays(const DisplayFuncs& f, VkInstance instance)
+{
+	vector<VkPhysicalDevice> physicalDevices = enumerateVk<VkPhysicalDevice>(
+		[&](uint32_t* count, VkPhysicalDevice* a) { return f.vkEnumeratePhysicalDevices(instance, count, a); },
+		"vkEnumeratePhysicalDevices");
+	vector<DisplayInfo> l;
+	for(VkPhysicalDevice pd : physicalDevices) {
+		vector<VkDisplayPropertiesKHR> displays = enumerateVk<VkDisplayPropertiesKHR>(
+			[&](uint32_t* count, VkDisplayPropertiesKHR* a) { return f.vkGetPhysicalDeviceDisplayPropertiesKHR(pd, count, a); },
+			"vkGetPhysicalDeviceDisplayPropertiesKHR");
+		for(VkDisplayPropertiesKHR& p : displays)
+			l.push_back({ pd, p });
+	}
+	return l;
+}
+
+static vector<VkDisplayModePropertiesKHR> getDisplayModes(const DisplayFuncs& f, const DisplayInfo& d)
+{
+	return enumerateVk<VkDisplayModePropertiesKHR>(
+		[&](uint32_t* count, VkDisplayModePropertiesKHR* a) {
+			return f.vkGetDisplayModePropertiesKHR(d.physicalDevice, d.properties.display, count, a);
+		},
+		"vkGetDisplayModePropertiesKHR");
+}
+
+// mode of the given resolution with the highest refresh rate, or nullptr
+static const VkDisplayModePropertiesKHR* findDisplayMode(const vector<VkDisplayModePropertiesKHR>& modes, uint32_t width, uint32_t height)
+{
+	const VkDisplayModePropertiesKHR* r = nullptr;
+	for(const VkDisplayModePropertiesKHR& m : modes)
+		if(m.visibleRegion.width == width && m.visibleRegion.height == height)
+			if(r == nullptr || m.refreshRate > r->refreshRate)
+				r = &m;
+	return r;
+}
+
 #endif
 
 
@@ -922,24 +2084,7 @@ void VulkanWindow::init()
 	// any layout change since application start is reported this way)
 	initKeyConversionTable();
 
-#elif defined(USE_PLATFORM_XLIB)
-
-	if(xlib::display)
-		return;
-
-	// open X connection
-	xlib::display = XOpenDisplay(nullptr);
-	if(xlib::display == nullptr)
-		throw runtime_error("Can not open display. No X-server running or wrong DISPLAY variable.");
-	xlib::externalDisplayHandle = false;
-
-	// get atoms
-	xlib::wmDeleteMessage = XInternAtom(xlib::display, "WM_DELETE_WINDOW", False);
-	xlib::wmStateProperty = XInternAtom(xlib::display, "WM_STATE", False);
-	xlib::netWmName  = XInternAtom(xlib::display, "_NET_WM_NAME", False);
-	xlib::utf8String = XInternAtom(xlib::display, "UTF8_STRING", False);
-
-#elif defined(USE_PLATFORM_WAYLAND)
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
 
 	init(nullptr);
 
@@ -955,6 +2100,7 @@ void VulkanWindow::init()
 	SDL_SetHint(SDL_HINT_VIDEO_ALLOW_SCREENSAVER, "1");  // allow screensaver
 
 	// initialize SDL
+	auto t = chrono::steady_clock::now();
 	if(!SDL_InitSubSystem(SDL_INIT_VIDEO))
 		throw runtime_error(string("SDL_InitSubSystem(SDL_INIT_VIDEO) function failed. Error details: ") + SDL_GetError());
 	sdl::initialized = true;
@@ -962,6 +2108,7 @@ void VulkanWindow::init()
 	// initialize Vulkan
 	if(!SDL_Vulkan_LoadLibrary(nullptr))
 		throw runtime_error(string("VulkanWindow: SDL_Vulkan_LoadLibrary(nullptr) function failed. Error details: ") + SDL_GetError());
+	_startupTimes.displayConnection = secondsSince(t);
 
 #elif defined(USE_PLATFORM_SDL2)
 
@@ -976,6 +2123,7 @@ void VulkanWindow::init()
 	SDL_SetHint(SDL_HINT_VIDEO_ALLOW_SCREENSAVER, "1");  // allow screensaver
 
 	// initialize SDL
+	auto t = chrono::steady_clock::now();
 	if(SDL_InitSubSystem(SDL_INIT_VIDEO) != 0)
 		throw runtime_error(string("SDL_InitSubSystem(SDL_INIT_VIDEO) function failed. Error details: ") + SDL_GetError());
 	sdl::initialized = true;
@@ -983,13 +2131,20 @@ void VulkanWindow::init()
 	// initialize Vulkan
 	if(SDL_Vulkan_LoadLibrary(nullptr) != 0)
 		throw runtime_error(string("VulkanWindow: SDL_Vulkan_LoadLibrary(nullptr) function failed. Error details: ") + SDL_GetError());
+	_startupTimes.displayConnection = secondsSince(t);
 
 #elif defined(USE_PLATFORM_GLFW)
 
+	// handle multiple init attempts
+	if(glfw::initialized)
+		return;
+
 	// initialize GLFW
-	// (it is safe to call glfwInit() multiple times)
+	auto t = chrono::steady_clock::now();
 	if(!glfwInit())
 		throwError("glfwInit");
+	glfw::initialized = true;
+	_startupTimes.displayConnection = secondsSince(t);
 
 #elif defined(USE_PLATFORM_QT)
 
@@ -1028,190 +2183,247 @@ void VulkanWindow::init()
 
 # endif
 
+#elif defined(USE_PLATFORM_DISPLAY)
+
+	// handle multiple init attempts
+	if(display::initialized)
+		return;
+
+	// create wake fd and open input devices
+	// (there is no display server to connect to; displays are enumerated by create() through Vulkan)
+	auto t = chrono::steady_clock::now();
+	int wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if(wakeFd == -1)
+		throw runtime_error("VulkanWindow::init(): eventfd() failed.");
+	display::pollFds.push_back({ wakeFd, POLLIN, 0 });
+	display::pollFds.push_back({ frameTimer.getFd(), POLLIN, 0 });
+	VulkanWindowPrivate::openInputDevices();
+	display::initialized = true;
+	_startupTimes.displayConnection = secondsSince(t);
+
 #endif
 }
 
 
 void VulkanWindow::init(void* data)
 {
-#if defined(USE_PLATFORM_XLIB)
+#if defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
 
-	// use data as Display* handle
+# if defined(USE_PLATFORM_XLIB) && defined(USE_PLATFORM_WAYLAND)
 
-	if(xlib::display)
+	// handle multiple init attempts
+	if(xlib::display || wayland::display)
 		return;
 
+	// select backend
+	bool externalHandle = true;
 	if(data) {
 
-		// use data as Display* handle
-		xlib::display = reinterpret_cast<Display*>(data);
-		xlib::externalDisplayHandle = true;
+		// the type of the external handle is given by the library the application has loaded
+		// (wl_display* if libwayland-client is loaded and Display* if libX11 is loaded)
+		void* waylandHandle = dlopen("libwayland-client.so.0", RTLD_NOW | RTLD_NOLOAD);
+		void* x11Handle = dlopen("libX11.so.6", RTLD_NOW | RTLD_NOLOAD);
+		if(waylandHandle)
+			dlclose(waylandHandle);
+		if(x11Handle)
+			dlclose(x11Handle);
+		if(waylandHandle && x11Handle)
+			throw runtime_error("VulkanWindow: Cannot determine the type of the display handle passed to init(). "
+			                    "Both libwayland-client.so.0 and libX11.so.6 are loaded in the process.");
+		if(!waylandHandle && !x11Handle)
+			throw runtime_error("VulkanWindow: The display handle passed to init() belongs to neither "
+			                    "libwayland-client.so.0 nor libX11.so.6 as none of them is loaded in the process.");
+		backend::xlib = x11Handle != nullptr;
+		if(backend::xlib)
+			loadLibX11();
+		else
+			loadLibWayland();
 
 	}
 	else {
 
-		// open X connection
-		xlib::display = XOpenDisplay(nullptr);
-		if(xlib::display == nullptr)
-			throw runtime_error("Can not open display. No X-server running or wrong DISPLAY variable.");
-		xlib::externalDisplayHandle = false;
+		// prefer Wayland and fall back to Xlib
+		// (Xlib is used if libwayland is not installed or no Wayland server is running)
+		auto t = chrono::steady_clock::now();
+		if(loadLibWayland()) {
+			data = wl_display_connect(nullptr);
+			if(data == nullptr)
+				unloadLibWayland();
+		}
+		backend::xlib = data == nullptr;
+		if(data) {
+			externalHandle = false;
+			_startupTimes.displayConnection = secondsSince(t);
+		}
+		else
+			if(!loadLibX11())
+				throw runtime_error("VulkanWindow: Cannot connect to Wayland display and cannot open libX11.so.6 library.");
 
 	}
 
-	// get atoms
-	xlib::wmDeleteMessage = XInternAtom(xlib::display, "WM_DELETE_WINDOW", False);
-	xlib::wmStateProperty = XInternAtom(xlib::display, "WM_STATE", False);
-	xlib::netWmName  = XInternAtom(xlib::display, "_NET_WM_NAME", False);
-	xlib::utf8String = XInternAtom(xlib::display, "UTF8_STRING", False);
+# endif
+# if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
 
-#elif defined(USE_PLATFORM_WAYLAND)
+		// use data as Display* handle
 
-	// use data as wl_display* handle
+		if(xlib::display)
+			return;
 
-	if(wayland::display)
-		return;
+		if(data) {
 
-	if(data) {
-		wayland::display = reinterpret_cast<wl_display*>(data);
-		wayland::externalDisplayHandle = true;
-	}
-	else {
+			// use data as Display* handle
+			xlib::display = reinterpret_cast<Display*>(data);
+			xlib::externalDisplayHandle = true;
 
-		// open Wayland connection
-		wayland::display = wl_display_connect(nullptr);
-		if(wayland::display == nullptr)
-			throw runtime_error("Cannot connect to Wayland display. No Wayland server is running or invalid WAYLAND_DISPLAY variable.");
-		wayland::externalDisplayHandle = false;
-
-	}
-
-	// registry listener
-	wayland::registry = wl_display_get_registry(wayland::display);
-	if(wayland::registry == nullptr)
-		throw runtime_error("Cannot get Wayland registry object.");
-	if(wl_registry_add_listener(wayland::registry, &registryListener, nullptr))
-		throw runtime_error("wl_registry_add_listener() failed.");
-	if(wl_display_roundtrip(wayland::display) == -1)
-		throw runtime_error("wl_display_roundtrip() failed.");
-
-	// make sure we have all required global objects
-	if(wayland::compositor == nullptr)
-		throw runtime_error("Cannot get Wayland wl_compositor object.");
-	if(wayland::xdgWmBase == nullptr)
-		throw runtime_error("Cannot get Wayland xdg_wm_base object.");
-	if(wayland::shm == nullptr)
-		throw runtime_error("Cannot get Wayland wl_shm object.");
-	if(wayland::seat == nullptr)
-		throw runtime_error("Cannot get Wayland wl_seat object.");
-
-	// add listeners
-	if(xdg_wm_base_add_listener(wayland::xdgWmBase, &xdgWmBaseListener, nullptr))
-		throw runtime_error("xdg_wm_base_add_listener() failed.");
-	if(wl_seat_add_listener(wayland::seat, &seatListener, nullptr))
-		throw runtime_error("wl_seat_add_listener() failed.");
-
-	// xkb_context
-	wayland::xkbContext = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-	if(wayland::xkbContext == NULL)
-		throw runtime_error("VulkanWindow::init(): Cannot create XKB context.");
-
-	// libdecor
-	if(!wayland::zxdgDecorationManagerV1) {
-
-		// load libdecor library
-		wayland::libdecorHandle = dlopen("libdecor-0.so.0", RTLD_NOW);
-		if(wayland::libdecorHandle == nullptr)
-			throw runtime_error("Cannot activate window decorations. There is no support for server-side decorations "
-			                    "in Wayland server (zxdg_decoration_manager_v1 protocol required) and "
-			                    "cannot open libdecor-0.so.0 library for client-side decorations.");
-
-		// function pointers
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_new)                 = dlsym(wayland::libdecorHandle, "libdecor_new");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_unref)               = dlsym(wayland::libdecorHandle, "libdecor_unref");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_unref)         = dlsym(wayland::libdecorHandle, "libdecor_frame_unref");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_set_user_data) = dlsym(wayland::libdecorHandle, "libdecor_frame_set_user_data");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_decorate)            = dlsym(wayland::libdecorHandle, "libdecor_decorate");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_set_title)     = dlsym(wayland::libdecorHandle, "libdecor_frame_set_title");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_set_minimized) = dlsym(wayland::libdecorHandle, "libdecor_frame_set_minimized");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_set_maximized) = dlsym(wayland::libdecorHandle, "libdecor_frame_set_maximized");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_unset_maximized) = dlsym(wayland::libdecorHandle, "libdecor_frame_unset_maximized");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_set_fullscreen) = dlsym(wayland::libdecorHandle, "libdecor_frame_set_fullscreen");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_unset_fullscreen) = dlsym(wayland::libdecorHandle, "libdecor_frame_unset_fullscreen");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_map)           = dlsym(wayland::libdecorHandle, "libdecor_frame_map");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_configuration_get_window_state) = dlsym(wayland::libdecorHandle, "libdecor_configuration_get_window_state");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_configuration_get_content_size) = dlsym(wayland::libdecorHandle, "libdecor_configuration_get_content_size");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_state_new)           = dlsym(wayland::libdecorHandle, "libdecor_state_new");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_commit)        = dlsym(wayland::libdecorHandle, "libdecor_frame_commit");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_state_free)          = dlsym(wayland::libdecorHandle, "libdecor_state_free");
-		reinterpret_cast<void*&>(wayland::funcs.libdecor_dispatch)            = dlsym(wayland::libdecorHandle, "libdecor_dispatch");
-		if(!wayland::funcs.libdecor_new || !wayland::funcs.libdecor_unref || !wayland::funcs.libdecor_frame_unref || !wayland::funcs.libdecor_decorate ||
-		   !wayland::funcs.libdecor_frame_set_title || !wayland::funcs.libdecor_frame_set_minimized || !wayland::funcs.libdecor_frame_set_maximized ||
-		   !wayland::funcs.libdecor_frame_unset_maximized || !wayland::funcs.libdecor_frame_set_fullscreen ||
-		   !wayland::funcs.libdecor_frame_unset_fullscreen || !wayland::funcs.libdecor_frame_map ||
-		   !wayland::funcs.libdecor_configuration_get_window_state || !wayland::funcs.libdecor_configuration_get_content_size ||
-		   !wayland::funcs.libdecor_state_new || !wayland::funcs.libdecor_frame_commit || !wayland::funcs.libdecor_state_free || !wayland::funcs.libdecor_dispatch)
-		{
-			throw runtime_error("Cannot retrieve all function pointers out of libdecor-0.so.");
 		}
+		else {
 
-		// workaround for missing libdecor_frame_set_user_data() in versions 0.1.0 to 0.2.2
-		if(wayland::funcs.libdecor_frame_set_user_data == nullptr)
-			wayland::funcs.libdecor_frame_set_user_data =
-				[](struct libdecor_frame* frame, void* user_data) -> void {
-					auto* priv = reinterpret_cast<libdecor_frame_workaround*>(frame)->priv;
-					reinterpret_cast<libdecor_frame_private_workaround*>(priv)->user_data = user_data;
-				};
+			// make Xlib thread-safe
+			// (Xlib keeps process-global state, such as the display list, error handlers and Xrm,
+			// so initThread() requires XInitThreads() before the first Xlib call;
+			// libX11 1.8+ calls it implicitly and the call does nothing there)
+			XInitThreads();
+
+			// open X connection
+			auto t = chrono::steady_clock::now();
+			xlib::display = XOpenDisplay(nullptr);
+			if(xlib::display == nullptr)
+				throw runtime_error("Can not open display. No X-server running or wrong DISPLAY variable.");
+			xlib::externalDisplayHandle = false;
+			_startupTimes.displayConnection = secondsSince(t);
+			_globalRoundTripCount++;  // connection setup
 
-		// create libdecor context
-		wayland::libdecorContext = wayland::funcs.libdecor_new(wayland::display, &libdecorInterface);
-		if(!wayland::libdecorContext)
-			throw runtime_error("libdecor_new() failed.");
+		}
 
+		// get atoms
+		// (each XInternAtom() call is a round trip)
+		_globalRoundTripCount += 4;
+		xlib::wmDeleteMessage = XInternAtom(xlib::display, "WM_DELETE_WINDOW", False);
+		xlib::wmStateProperty = XInternAtom(xlib::display, "WM_STATE", False);
+		xlib::netWmName  = XInternAtom(xlib::display, "_NET_WM_NAME", False);
+		xlib::utf8String = XInternAtom(xlib::display, "UTF8_STRING", False);
 	}
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
+	if(waylandSelected()) {
 
-	// cursor size
-	const char* cursorSizeString = getenv("XCURSOR_SIZE");
-	char* endp = nullptr;
-	int cursorSize = 0;
-	if(cursorSizeString) {
-		auto cursorSizeLong = strtol(cursorSizeString, &endp, 10);
-		if(endp-cursorSizeString == ptrdiff_t(strlen(cursorSizeString)) &&
-		   cursorSizeLong > 0 && cursorSizeLong <= INT_MAX)
-		{
-			cursorSize = int(cursorSizeLong);
+		// use data as wl_display* handle
+
+		if(wayland::display)
+			return;
+
+		if(data) {
+			wayland::display = reinterpret_cast<wl_display*>(data);
+#  if defined(USE_PLATFORM_XLIB)
+			wayland::externalDisplayHandle = externalHandle;  // the display might be connected by the backend selection above
+#  else
+			wayland::externalDisplayHandle = true;
+#  endif
 		}
-	}
-	if(cursorSize == 0)
-		cursorSize = 24;
+		else {
 
-	// cursor theme name
-	const char* cursorThemeName = getenv("XCURSOR_THEME");
+			// open Wayland connection
+			auto t = chrono::steady_clock::now();
+			wayland::display = wl_display_connect(nullptr);
+			if(wayland::display == nullptr)
+				throw runtime_error("Cannot connect to Wayland display. No Wayland server is running or invalid WAYLAND_DISPLAY variable.");
+			wayland::externalDisplayHandle = false;
+			_startupTimes.displayConnection = secondsSince(t);
 
-	// load cursor theme
-	wayland::cursorTheme = wl_cursor_theme_load(cursorThemeName, cursorSize, wayland::shm);
-	if(wayland::cursorTheme == nullptr)
-		throw runtime_error("Failed to load default cursor theme.");
+		}
 
-	// cursor surface
-	// (we need cursor for VulkanWindow, otherwise no cursor might be shown inside the window)
-	wayland::cursorSurface = wl_compositor_create_surface(wayland::compositor);
-	if(!wayland::cursorSurface)
-		throw runtime_error("wl_compositor_create_surface() failed to create cursor surface.");
-	wl_cursor* cursor = wl_cursor_theme_get_cursor(wayland::cursorTheme, "left_ptr");
-	if(!cursor)
-		throw runtime_error("Cursor error: Cannot load \"left_ptr\" cursor.");
-	wl_cursor_image* cursorImage = cursor->images[0];
-	wayland::cursorHotspotX = cursorImage->hotspot_x;
-	wayland::cursorHotspotY = cursorImage->hotspot_y;
-	wl_buffer* cursorBuffer = wl_cursor_image_get_buffer(cursorImage);
-	if(!cursorBuffer)
-		throw runtime_error("wl_cursor_image_get_buffer() failed.");
-	wl_surface_attach(wayland::cursorSurface, cursorBuffer, 0, 0);
-	wl_surface_commit(wayland::cursorSurface);
+		// seat event queue and input buffer of the default queue windows
+		wayland::seatQueue = wl_display_create_queue(wayland::display);
+		if(wayland::seatQueue == nullptr)
+			throw runtime_error("wl_display_create_queue() failed.");
+		wayland::mainInputBuffer.wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+		if(wayland::mainInputBuffer.wakeFd == -1)
+			throw runtime_error("eventfd() failed.");
+
+		// registry listener
+		auto t = chrono::steady_clock::now();
+		wayland::registry = wl_display_get_registry(wayland::display);
+		if(wayland::registry == nullptr)
+			throw runtime_error("Cannot get Wayland registry object.");
+		if(wl_registry_add_listener(wayland::registry, &registryListener, nullptr))
+			throw runtime_error("wl_registry_add_listener() failed.");
+		_globalRoundTripCount++;
+		if(wl_display_roundtrip(wayland::display) == -1)
+			throw runtime_error("wl_display_roundtrip() failed.");
+		_startupTimes.registryRoundTrips = secondsSince(t);
+
+		// make sure we have all required global objects
+		if(wayland::compositor == nullptr)
+			throw runtime_error("Cannot get Wayland wl_compositor object.");
+		if(wayland::xdgWmBase == nullptr)
+			throw runtime_error("Cannot get Wayland xdg_wm_base object.");
+		if(wayland::shm == nullptr)
+			throw runtime_error("Cannot get Wayland wl_shm object.");
+		if(wayland::seat == nullptr)
+			throw runtime_error("Cannot get Wayland wl_seat object.");
+
+		// libdecor
+		// (it is loaded only if the compositor does not support server-side decorations;
+		// cursor theme and xkb context are loaded lazily on the first pointer enter and keymap event)
+		if(!wayland::zxdgDecorationManagerV1) {
+
+			// load libdecor library
+			t = chrono::steady_clock::now();
+			wayland::libdecorHandle = dlopen("libdecor-0.so.0", RTLD_NOW);
+			if(wayland::libdecorHandle == nullptr)
+				throw runtime_error("Cannot activate window decorations. There is no support for server-side decorations "
+				                    "in Wayland server (zxdg_decoration_manager_v1 protocol required) and "
+				                    "cannot open libdecor-0.so.0 library for client-side decorations.");
+
+			// function pointers
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_new)                 = dlsym(wayland::libdecorHandle, "libdecor_new");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_unref)               = dlsym(wayland::libdecorHandle, "libdecor_unref");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_unref)         = dlsym(wayland::libdecorHandle, "libdecor_frame_unref");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_set_user_data) = dlsym(wayland::libdecorHandle, "libdecor_frame_set_user_data");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_decorate)            = dlsym(wayland::libdecorHandle, "libdecor_decorate");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_set_title)     = dlsym(wayland::libdecorHandle, "libdecor_frame_set_title");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_set_minimized) = dlsym(wayland::libdecorHandle, "libdecor_frame_set_minimized");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_set_maximized) = dlsym(wayland::libdecorHandle, "libdecor_frame_set_maximized");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_unset_maximized) = dlsym(wayland::libdecorHandle, "libdecor_frame_unset_maximized");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_set_fullscreen) = dlsym(wayland::libdecorHandle, "libdecor_frame_set_fullscreen");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_unset_fullscreen) = dlsym(wayland::libdecorHandle, "libdecor_frame_unset_fullscreen");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_map)           = dlsym(wayland::libdecorHandle, "libdecor_frame_map");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_configuration_get_window_state) = dlsym(wayland::libdecorHandle, "libdecor_configuration_get_window_state");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_configuration_get_content_size) = dlsym(wayland::libdecorHandle, "libdecor_configuration_get_content_size");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_state_new)           = dlsym(wayland::libdecorHandle, "libdecor_state_new");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_frame_commit)        = dlsym(wayland::libdecorHandle, "libdecor_frame_commit");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_state_free)          = dlsym(wayland::libdecorHandle, "libdecor_state_free");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_dispatch)            = dlsym(wayland::libdecorHandle, "libdecor_dispatch");
+			reinterpret_cast<void*&>(wayland::funcs.libdecor_get_fd)              = dlsym(wayland::libdecorHandle, "libdecor_get_fd");
+			if(!wayland::funcs.libdecor_new || !wayland::funcs.libdecor_unref || !wayland::funcs.libdecor_frame_unref || !wayland::funcs.libdecor_decorate ||
+			   !wayland::funcs.libdecor_frame_set_title || !wayland::funcs.libdecor_frame_set_minimized || !wayland::funcs.libdecor_frame_set_maximized ||
+			   !wayland::funcs.libdecor_frame_unset_maximized || !wayland::funcs.libdecor_frame_set_fullscreen ||
+			   !wayland::funcs.libdecor_frame_unset_fullscreen || !wayland::funcs.libdecor_frame_map ||
+			   !wayland::funcs.libdecor_configuration_get_window_state || !wayland::funcs.libdecor_configuration_get_content_size ||
+			   !wayland::funcs.libdecor_state_new || !wayland::funcs.libdecor_frame_commit || !wayland::funcs.libdecor_state_free || !wayland::funcs.libdecor_dispatch ||
+			   !wayland::funcs.libdecor_get_fd)
+			{
+				throw runtime_error("Cannot retrieve all function pointers out of libdecor-0.so.");
+			}
+
+			// workaround for missing libdecor_frame_set_user_data() in versions 0.1.0 to 0.2.2
+			if(wayland::funcs.libdecor_frame_set_user_data == nullptr)
+				wayland::funcs.libdecor_frame_set_user_data =
+					[](struct libdecor_frame* frame, void* user_data) -> void {
+						auto* priv = reinterpret_cast<libdecor_frame_workaround*>(frame)->priv;
+						reinterpret_cast<libdecor_frame_private_workaround*>(priv)->user_data = user_data;
+					};
 
-	// process wm_base and wl_seat listeners
-	if(wl_display_roundtrip(wayland::display) == -1)
-		throw runtime_error("wl_display_roundtrip() failed.");
+			// create libdecor context
+			wayland::libdecorContext = wayland::funcs.libdecor_new(wayland::display, &libdecorInterface);
+			if(!wayland::libdecorContext)
+				throw runtime_error("libdecor_new() failed.");
+			_startupTimes.libdecorLoad = secondsSince(t);
+
+		}
+	}
+# endif
 
 #elif defined(USE_PLATFORM_QT)
 
@@ -1269,6 +2481,143 @@ void VulkanWindow::init(int&, char*[])
 #endif
 
 
+void VulkanWindow::initThread()
+{
+#if defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
+
+# if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		// assert for valid usage
+		assert(xlib::display && "VulkanWindow class was not initialized. Call VulkanWindow::init() before VulkanWindow::initThread().");
+
+		if(xlib::threadDisplay)
+			return;
+
+		// open per-thread X connection to the same X-server
+		// (XInitThreads() was called by init(); if the Display handle was passed to init(void*),
+		// the application must have called XInitThreads() before opening it, unless libX11 1.8+ is used)
+		xlib::threadDisplay = XOpenDisplay(XDisplayString(xlib::display));
+		if(xlib::threadDisplay == nullptr)
+			throw runtime_error("VulkanWindow::initThread(): Cannot open per-thread display connection.");
+		_globalRoundTripCount++;  // connection setup
+	}
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
+	if(waylandSelected()) {
+		// assert for valid usage
+		assert(wayland::display && "VulkanWindow class was not initialized. Call VulkanWindow::init() before VulkanWindow::initThread().");
+
+		if(wayland::threadQueue)
+			return;
+
+		// libdecor dispatches its objects on the default queue only
+		if(wayland::libdecorContext)
+			throw runtime_error("VulkanWindow::initThread(): Per-thread event queues are not supported "
+			                    "with libdecor client-side decorations.");
+
+		// create event queue
+		wayland::threadQueue = wl_display_create_queue(wayland::display);
+		if(wayland::threadQueue == nullptr)
+			throw runtime_error("VulkanWindow::initThread(): wl_display_create_queue() failed.");
+
+		// display wrapper
+		// (wl_display_sync() and other requests made through the wrapper deliver their events to threadQueue)
+		wayland::threadDisplayWrapper = static_cast<wl_display*>(wl_proxy_create_wrapper(wayland::display));
+		if(wayland::threadDisplayWrapper == nullptr) {
+			wl_event_queue_destroy(wayland::threadQueue);
+			wayland::threadQueue = nullptr;
+			throw runtime_error("VulkanWindow::initThread(): wl_proxy_create_wrapper() failed.");
+		}
+		wl_proxy_set_queue(reinterpret_cast<wl_proxy*>(wayland::threadDisplayWrapper), wayland::threadQueue);
+
+		// input buffer
+		// (input events of the windows created on this thread are forwarded here by seatQueue listeners)
+		int wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+		if(wakeFd == -1) {
+			finalizeThread();
+			throw runtime_error("VulkanWindow::initThread(): eventfd() failed.");
+		}
+		wayland::threadInputBuffer = new WaylandInputBuffer;
+		wayland::threadInputBuffer->wakeFd = wakeFd;
+	}
+# endif
+
+#else
+
+	throw runtime_error("VulkanWindow::initThread(): Per-thread event processing is not supported on this platform.");
+
+#endif
+}
+
+
+void VulkanWindow::finalizeThread() noexcept
+{
+	// all windows created on the thread must be destroyed before finalizeThread() call
+#if defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
+
+# if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		if(xlib::threadDisplay) {
+			XCloseDisplay(xlib::threadDisplay);
+			xlib::threadDisplay = nullptr;
+		}
+	}
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
+	if(waylandSelected()) {
+		if(wayland::threadDisplayWrapper) {
+			wl_proxy_wrapper_destroy(wayland::threadDisplayWrapper);
+			wayland::threadDisplayWrapper = nullptr;
+		}
+		if(wayland::threadQueue) {
+			wl_event_queue_destroy(wayland::threadQueue);
+			wayland::threadQueue = nullptr;
+		}
+		if(wayland::threadInputBuffer) {
+			close(wayland::threadInputBuffer->wakeFd);
+			delete wayland::threadInputBuffer;
+			wayland::threadInputBuffer = nullptr;
+		}
+	}
+# endif
+
+#endif
+}
+
+
+#if defined(USE_PLATFORM_DISPLAY)
+
+void VulkanWindow::setDisplayTarget(uint32_t displayIndex, uint32_t planeIndex)
+{
+	display::displayIndex = displayIndex;
+	display::planeIndex = planeIndex;
+}
+
+
+void VulkanWindow::setDisplayInputGrab(bool grab)
+{
+	// update already opened input devices
+	display::grabInput = grab;
+	for(size_t i=display::firstInputFd; i<display::pollFds.size(); i++)
+		ioctl(display::pollFds[i].fd, EVIOCGRAB, grab ? 1 : 0);
+}
+
+#else
+
+void VulkanWindow::setDisplayTarget(uint32_t, uint32_t)
+{
+	throw runtime_error("VulkanWindow::setDisplayTarget(): Display selection is supported on Display platform only.");
+}
+
+
+void VulkanWindow::setDisplayInputGrab(bool)
+{
+	throw runtime_error("VulkanWindow::setDisplayInputGrab(): Input grab is supported on Display platform only.");
+}
+
+#endif
+
+
 void VulkanWindow::finalize() noexcept
 {
 #if defined(USE_PLATFORM_WIN32)
@@ -1286,70 +2635,118 @@ void VulkanWindow::finalize() noexcept
 		win32::windowClass = 0;
 	}
 
-#elif defined(USE_PLATFORM_XLIB)
-
-	if(xlib::display) {
-		if(!xlib::externalDisplayHandle)
-			XCloseDisplay(xlib::display);
-		xlib::display = nullptr;
-		xlib::vulkanWindowMap.clear();
-	}
-
-#elif defined(USE_PLATFORM_WAYLAND)
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
 
-	if(wayland::pointer) {
-		wl_pointer_release(wayland::pointer);
-		wayland::pointer = nullptr;
-	}
-	if(wayland::keyboard) {
-		wl_keyboard_release(wayland::keyboard);
-		wayland::keyboard = nullptr;
-	}
-	if(wayland::cursorSurface) {
-		wl_surface_destroy(wayland::cursorSurface);
-		wayland::cursorSurface = nullptr;
-	}
-	if(wayland::cursorTheme) {
-		wl_cursor_theme_destroy(wayland::cursorTheme);
-		wayland::cursorTheme = nullptr;
-	}
-	if(wayland::libdecorContext) {
-		wayland::funcs.libdecor_unref(wayland::libdecorContext);
-		wayland::libdecorContext = nullptr;
-	}
-	if(wayland::shm) {
-		wl_shm_destroy(wayland::shm);
-		wayland::shm = nullptr;
-	}
-	if(wayland::seat) {
-		wl_seat_release(wayland::seat);
-		wayland::seat = nullptr;
-	}
-	if(wayland::xkbState) {
-		xkb_state_unref(wayland::xkbState);
-		wayland::xkbState = nullptr;
-	}
-	if(wayland::xkbContext) {
-		xkb_context_unref(wayland::xkbContext);
-		wayland::xkbContext = nullptr;
+# if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		if(xlib::display) {
+			if(!xlib::externalDisplayHandle)
+				XCloseDisplay(xlib::display);
+			xlib::display = nullptr;
+			lock_guard<mutex> lock(xlib::vulkanWindowMapMutex);
+			xlib::vulkanWindowMap.clear();
+		}
+		if(xkbcommon::handle) {
+			dlclose(xkbcommon::handle);
+			xkbcommon::handle = nullptr;
+		}
+		if(xrandr::handle) {
+			dlclose(xrandr::handle);
+			xrandr::handle = nullptr;
+		}
 	}
-	if(wayland::xdgWmBase) {
-		xdg_wm_base_destroy(wayland::xdgWmBase);
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
+	if(waylandSelected()) {
+		if(wayland::pointer) {
+			wl_pointer_release(wayland::pointer);
+			wayland::pointer = nullptr;
+		}
+		if(wayland::keyboard) {
+			wl_keyboard_release(wayland::keyboard);
+			wayland::keyboard = nullptr;
+		}
+		if(wayland::cursorSurface) {
+			wl_surface_destroy(wayland::cursorSurface);
+			wayland::cursorSurface = nullptr;
+		}
+		{
+			lock_guard<mutex> lock(wayland::outputsMutex);
+			for(auto& item : wayland::outputs)
+				if(wl_proxy_get_version(reinterpret_cast<wl_proxy*>(item.first)) >= WL_OUTPUT_RELEASE_SINCE_VERSION)
+					wl_output_release(item.first);
+				else
+					wl_output_destroy(item.first);
+			wayland::outputs.clear();
+		}
+		if(wayland::cursorTheme) {
+			wl_cursor_theme_destroy(wayland::cursorTheme);
+			wayland::cursorTheme = nullptr;
+		}
+		if(wayland::libdecorContext) {
+			wayland::funcs.libdecor_unref(wayland::libdecorContext);
+			wayland::libdecorContext = nullptr;
+		}
+		if(wayland::shm) {
+			wl_shm_destroy(wayland::shm);
+			wayland::shm = nullptr;
+		}
+		if(wayland::seat) {
+			wl_seat_release(wayland::seat);
+			wayland::seat = nullptr;
+		}
+		if(wayland::xkbState) {
+			xkbcommon::funcs.xkb_state_unref(wayland::xkbState);
+			wayland::xkbState = nullptr;
+		}
+		if(wayland::xkbContext) {
+			xkbcommon::funcs.xkb_context_unref(wayland::xkbContext);
+			wayland::xkbContext = nullptr;
+		}
+		if(wayland::xdgWmBase) {
+			xdg_wm_base_destroy(wayland::xdgWmBase);
+			wayland::xdgWmBase = nullptr;
+		}
+		if(wayland::singlePixelBufferManager) {
+			wp_single_pixel_buffer_manager_v1_destroy(wayland::singlePixelBufferManager);
+			wayland::singlePixelBufferManager = nullptr;
+		}
+		if(wayland::viewporter) {
+			wp_viewporter_destroy(wayland::viewporter);
+			wayland::viewporter = nullptr;
+		}
+		if(wayland::seatQueue) {
+			wl_event_queue_destroy(wayland::seatQueue);
+			wayland::seatQueue = nullptr;
+		}
+		if(wayland::mainInputBuffer.wakeFd != -1) {
+			close(wayland::mainInputBuffer.wakeFd);
+			wayland::mainInputBuffer.wakeFd = -1;
+		}
+		wayland::mainInputBuffer.events.clear();
+		if(wayland::display) {
+			if(!wayland::externalDisplayHandle)
+				wl_display_disconnect(wayland::display);
+			wayland::display = nullptr;
+		}
+		if(wayland::libdecorHandle) {
+			dlclose(wayland::libdecorHandle);
+			wayland::libdecorHandle = nullptr;
+		}
+		if(xkbcommon::handle) {
+			dlclose(xkbcommon::handle);
+			xkbcommon::handle = nullptr;
+		}
+		wayland::registry = nullptr;
+		wayland::compositor = nullptr;
 		wayland::xdgWmBase = nullptr;
+		wayland::zxdgDecorationManagerV1 = nullptr;
 	}
-	if(wayland::display) {
-		if(!wayland::externalDisplayHandle)
-			wl_display_disconnect(wayland::display);
-		wayland::display = nullptr;
-	}
-	if(wayland::libdecorHandle) {
-		dlclose(wayland::libdecorHandle);
-		wayland::libdecorHandle = nullptr;
-	}
-	wayland::registry = nullptr;
-	wayland::compositor = nullptr;
-	wayland::xdgWmBase = nullptr;
-	wayland::zxdgDecorationManagerV1 = nullptr;
+# endif
+# if defined(USE_PLATFORM_XLIB) && defined(USE_PLATFORM_WAYLAND)
+	unloadLibWayland();
+	unloadLibX11();
+# endif
 
 #elif defined(USE_PLATFORM_SDL3) || defined(USE_PLATFORM_SDL2)
 
@@ -1365,6 +2762,7 @@ void VulkanWindow::finalize() noexcept
 	// finalize GLFW
 	// (it is safe to call glfwTerminate() even if GLFW was not initialized)
 	glfwTerminate();
+	glfw::initialized = false;
 # ifdef VULKAN_WINDOW_DEBUG
 	// print error if any
 	const char* errorString;
@@ -1393,6 +2791,34 @@ void VulkanWindow::finalize() noexcept
 		qt::qGuiApplication->~QGuiApplication();
 	qt::qGuiApplication = nullptr;
 
+#elif defined(USE_PLATFORM_DISPLAY)
+
+	// close wake fd and input devices
+	// (frame timer fd is closed by frameTimer)
+	for(size_t i=0; i<display::pollFds.size(); i++)
+		if(i != 1)
+			close(display::pollFds[i].fd);
+	display::pollFds.clear();
+	display::windowWithFocus = nullptr;
+
+	// release xkbcommon
+	if(display::xkbState) {
+		xkbcommon::funcs.xkb_state_unref(display::xkbState);
+		display::xkbState = nullptr;
+	}
+	if(display::xkbContext) {
+		xkbcommon::funcs.xkb_context_unref(display::xkbContext);
+		display::xkbContext = nullptr;
+	}
+	if(xkbcommon::handle) {
+		dlclose(xkbcommon::handle);
+		xkbcommon::handle = nullptr;
+	}
+
+	display::instance = nullptr;
+	display::getInstanceProcAddr = nullptr;
+	display::initialized = false;
+
 #endif
 }
 
@@ -1406,9 +2832,38 @@ VulkanWindow::~VulkanWindow()
 
 void VulkanWindow::destroy() noexcept
 {
+#if !defined(USE_PLATFORM_QT)
+	// cancel deferred frame, if any
+	if(_frameDeferred)
+		VulkanWindowPrivate::cancelDeferredFrame(this);
+#endif
+
 	// skip not created windows
-	if(_any.handle == nullptr)
+#if defined(USE_PLATFORM_WIN32)
+	if(_win32.hwnd == nullptr)
+		return;
+#elif defined(USE_PLATFORM_XLIB) && defined(USE_PLATFORM_WAYLAND)
+	if(xlibSelected() ? _xlib.window == 0 : _wayland.wlSurface == nullptr)
+		return;
+#elif defined(USE_PLATFORM_XLIB)
+	if(_xlib.window == 0)
+		return;
+#elif defined(USE_PLATFORM_WAYLAND)
+	if(_wayland.wlSurface == nullptr)
+		return;
+#elif defined(USE_PLATFORM_SDL3) || defined(USE_PLATFORM_SDL2)
+	if(_sdl.window == nullptr)
+		return;
+#elif defined(USE_PLATFORM_GLFW)
+	if(_glfw.window == nullptr)
+		return;
+#elif defined(USE_PLATFORM_QT)
+	if(_qt.window == nullptr)
+		return;
+#elif defined(USE_PLATFORM_DISPLAY)
+	if(_display.display == 0)
 		return;
+#endif
 
 	// destroy surface except Qt platform
 #if !defined(USE_PLATFORM_QT)
@@ -1446,47 +2901,72 @@ void VulkanWindow::destroy() noexcept
 	_win32.hwnd = nullptr;
 # endif
 
-#elif defined(USE_PLATFORM_XLIB)
-
-	// release resources
-	xlib::vulkanWindowMap.erase(_xlib.window);
-	XDestroyWindow(xlib::display, _xlib.window);
-	_xlib.window = 0;
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
 
-#elif defined(USE_PLATFORM_WAYLAND)
+# if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		// release resources
+		{
+			lock_guard<mutex> lock(xlib::vulkanWindowMapMutex);
+			xlib::vulkanWindowMap.erase(_xlib.window);
+		}
+		XDestroyWindow(_xlib.display, _xlib.window);
+		_xlib.window = 0;
+	}
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
+	if(waylandSelected()) {
+		// invalidate pointers to this object
+		// (maybe, leave events are sent on surface destroy and these are not necessary (?))
+		{
+			lock_guard<mutex> lock(wayland::inputMutex);
+			if(wayland::windowUnderPointer == this)
+				wayland::windowUnderPointer = nullptr;
+			if(wayland::windowWithKbFocus == this)
+				wayland::windowWithKbFocus = nullptr;
+		}
 
-	// invalidate pointers to this object
-	// (maybe, leave events are sent on surface destroy and these are not necessary (?))
-	if(wayland::windowUnderPointer == this)
-		wayland::windowUnderPointer = nullptr;
-	if(wayland::windowWithKbFocus == this)
-		wayland::windowWithKbFocus = nullptr;
+		// remove input events forwarded to this window
+		if(_wayland.inputBuffer) {
+			WaylandInputBuffer& b = *_wayland.inputBuffer;
+			lock_guard<mutex> lock(b.eventsMutex);
+			b.events.erase(
+				remove_if(b.events.begin(), b.events.end(),
+				          [this](const VulkanWindowPrivate::InputEvent& e) { return e.window == this; }),
+				b.events.end());
+		}
 
-	// release resources
-	if(_wayland.scheduledFrameCallback) {
-		wl_callback_destroy(_wayland.scheduledFrameCallback);
-		_wayland.scheduledFrameCallback = nullptr;
-	}
-	if(_wayland.libdecorFrame) {
-		wayland::funcs.libdecor_frame_unref(_wayland.libdecorFrame);
-		_wayland.libdecorFrame = nullptr;
-	}
-	if(_wayland.decoration) {
-		zxdg_toplevel_decoration_v1_destroy(_wayland.decoration);
-		_wayland.decoration = nullptr;
-	}
-	if(_wayland.xdgTopLevel) {
-		xdg_toplevel_destroy(_wayland.xdgTopLevel);
-		_wayland.xdgTopLevel = nullptr;
-	}
-	if(_wayland.xdgSurface) {
-		xdg_surface_destroy(_wayland.xdgSurface);
-		_wayland.xdgSurface = nullptr;
-	}
-	if(_wayland.wlSurface) {
-		wl_surface_destroy(_wayland.wlSurface);
-		_wayland.wlSurface = nullptr;
+		// release resources
+		if(_wayland.scheduledFrameCallback) {
+			wl_callback_destroy(_wayland.scheduledFrameCallback);
+			_wayland.scheduledFrameCallback = nullptr;
+		}
+		if(_wayland.placeholderBuffer) {
+			wl_buffer_destroy(_wayland.placeholderBuffer);
+			_wayland.placeholderBuffer = nullptr;
+		}
+		if(_wayland.libdecorFrame) {
+			wayland::funcs.libdecor_frame_unref(_wayland.libdecorFrame);
+			_wayland.libdecorFrame = nullptr;
+		}
+		if(_wayland.decoration) {
+			zxdg_toplevel_decoration_v1_destroy(_wayland.decoration);
+			_wayland.decoration = nullptr;
+		}
+		if(_wayland.xdgTopLevel) {
+			xdg_toplevel_destroy(_wayland.xdgTopLevel);
+			_wayland.xdgTopLevel = nullptr;
+		}
+		if(_wayland.xdgSurface) {
+			xdg_surface_destroy(_wayland.xdgSurface);
+			_wayland.xdgSurface = nullptr;
+		}
+		if(_wayland.wlSurface) {
+			wl_surface_destroy(_wayland.wlSurface);
+			_wayland.wlSurface = nullptr;
+		}
 	}
+# endif
 
 #elif defined(USE_PLATFORM_SDL3)
 
@@ -1589,7 +3069,30 @@ void VulkanWindow::destroy() noexcept
 	delete _qt.window;
 	_qt.window = nullptr;
 
+#elif defined(USE_PLATFORM_DISPLAY)
+
+	// cancel pending frame, if any
+	if(_display.framePendingState != FramePendingState::NotPending) {
+		_display.framePendingState = FramePendingState::NotPending;
+		for(size_t i=0; i<display::framePendingWindows.size(); i++)
+			if(display::framePendingWindows[i] == this) {
+				display::framePendingWindows[i] = display::framePendingWindows.back();
+				display::framePendingWindows.pop_back();
+				break;
+			}
+	}
+
+	// release input focus
+	if(display::windowWithFocus == this)
+		display::windowWithFocus = nullptr;
+	_display.visible = false;
+	_display.display = 0;
+
 #endif
+
+	// reset window state
+	// (no callback is called from destroy())
+	_windowState = WindowState::Hidden;
 }
 
 
@@ -1610,55 +3113,71 @@ VulkanWindow::VulkanWindow(VulkanWindow&& other) noexcept
 			break;
 		}
 
-#elif defined(USE_PLATFORM_XLIB)
-
-	// move Xlib members
-	_xlib = other._xlib;
-	other._xlib.window = 0;
-
-	// update pointers to this object
-	if(_xlib.window != 0)
-		xlib::vulkanWindowMap[_xlib.window] = this;
-
-#elif defined(USE_PLATFORM_WAYLAND)
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
 
-	if(other._wayland.wlSurface == nullptr)
-	{
-		// move uninitialized window
-		// (create() was not called on the window yet)
-		_wayland.wlSurface = nullptr;
-	}
-	else
-	{
-		// process all pending sync events
-		// because they are delivered to the original object address
-		waitAllSyncEvents(other._wayland.numSyncEventsOnTheFly);
-
-		// move Wayland members
-		_wayland = other._wayland;
-		if(_wayland.wlSurface)
-			wl_surface_set_user_data(_wayland.wlSurface, this);
-		if(_wayland.xdgSurface)
-			xdg_surface_set_user_data(_wayland.xdgSurface, this);
-		if(_wayland.xdgTopLevel)
-			xdg_toplevel_set_user_data(_wayland.xdgTopLevel, this);
-		if(_wayland.libdecorFrame)
-			wayland::funcs.libdecor_frame_set_user_data(_wayland.libdecorFrame, this);
-		if(_wayland.scheduledFrameCallback)
-			wl_callback_set_user_data(_wayland.scheduledFrameCallback, this);
-		other._wayland.wlSurface = nullptr;
-		other._wayland.xdgSurface = nullptr;
-		other._wayland.xdgTopLevel = nullptr;
-		other._wayland.decoration = nullptr;
-		other._wayland.libdecorFrame = nullptr;
-		other._wayland.scheduledFrameCallback = nullptr;
+# if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		// move Xlib members
+		_xlib = other._xlib;
+		other._xlib.window = 0;
 
 		// update pointers to this object
-		if(wayland::windowUnderPointer == &other)
-			wayland::windowUnderPointer = static_cast<VulkanWindowPrivate*>(this);
-		if(wayland::windowWithKbFocus == &other)
-			wayland::windowWithKbFocus = static_cast<VulkanWindowPrivate*>(this);
+		if(_xlib.window != 0) {
+			lock_guard<mutex> lock(xlib::vulkanWindowMapMutex);
+			xlib::vulkanWindowMap[_xlib.window] = this;
+		}
+	}
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
+	if(waylandSelected()) {
+		if(other._wayland.wlSurface == nullptr)
+		{
+			// move uninitialized window
+			// (create() was not called on the window yet)
+			_wayland.wlSurface = nullptr;
+		}
+		else
+		{
+			// process all pending sync events
+			// because they are delivered to the original object address
+			if(waitAllSyncEvents(other._wayland.numSyncEventsOnTheFly, other._wayland.eventQueue))
+				other.countRoundTrip();
+
+			// move Wayland members
+			_wayland = other._wayland;
+			if(_wayland.wlSurface)
+				wl_surface_set_user_data(_wayland.wlSurface, this);
+			if(_wayland.xdgSurface)
+				xdg_surface_set_user_data(_wayland.xdgSurface, this);
+			if(_wayland.xdgTopLevel)
+				xdg_toplevel_set_user_data(_wayland.xdgTopLevel, this);
+			if(_wayland.libdecorFrame)
+				wayland::funcs.libdecor_frame_set_user_data(_wayland.libdecorFrame, this);
+			if(_wayland.scheduledFrameCallback)
+				wl_callback_set_user_data(_wayland.scheduledFrameCallback, this);
+			if(_wayland.placeholderBuffer)
+				wl_buffer_set_user_data(_wayland.placeholderBuffer, this);
+			other._wayland.wlSurface = nullptr;
+			other._wayland.xdgSurface = nullptr;
+			other._wayland.xdgTopLevel = nullptr;
+			other._wayland.decoration = nullptr;
+			other._wayland.libdecorFrame = nullptr;
+			other._wayland.scheduledFrameCallback = nullptr;
+			other._wayland.placeholderBuffer = nullptr;
+
+			// update pointers to this object
+			lock_guard<mutex> lock(wayland::inputMutex);
+			if(wayland::windowUnderPointer == &other)
+				wayland::windowUnderPointer = static_cast<VulkanWindowPrivate*>(this);
+			if(wayland::windowWithKbFocus == &other)
+				wayland::windowWithKbFocus = static_cast<VulkanWindowPrivate*>(this);
+			lock_guard<mutex> eventsLock(_wayland.inputBuffer->eventsMutex);
+			for(VulkanWindowPrivate::InputEvent& e : _wayland.inputBuffer->events)
+				if(e.window == &other)
+					e.window = static_cast<VulkanWindowPrivate*>(this);
+		}
 	}
+# endif
 
 #elif defined(USE_PLATFORM_SDL3)
 
@@ -1709,10 +3228,35 @@ VulkanWindow::VulkanWindow(VulkanWindow&& other) noexcept
 		static_cast<QtRenderingWindow*>(_qt.window)->vulkanWindow = this;
 	}
 
+#elif defined(USE_PLATFORM_DISPLAY)
+
+	// move display members
+	_display = other._display;
+	other._display.display = 0;
+
+	// update pointers to this object
+	if(display::windowWithFocus == &other)
+		display::windowWithFocus = static_cast<VulkanWindowPrivate*>(this);
+	for(VulkanWindow*& w : display::framePendingWindows)
+		if(w == &other) {
+			w = this;
+			break;
+		}
+
 #endif
 
 	// move members
 	_frameCallback = move(other._frameCallback);
+	_frameInterval = other._frameInterval;
+	_nextFrameTime = other._nextFrameTime;
+	_idleTimeout = other._idleTimeout;
+	_idleFrameInterval = other._idleFrameInterval;
+	_lastActivityTime = other._lastActivityTime;
+	_idle = other._idle;
+	_focused = other._focused;
+	_throttleWhenUnfocused = other._throttleWhenUnfocused;
+	_frameDeferred = other._frameDeferred;
+	other._frameDeferred = false;
 	_instance = move(other._instance);
 	_surface = other._surface;
 	other._surface = nullptr;
@@ -1722,12 +3266,38 @@ VulkanWindow::VulkanWindow(VulkanWindow&& other) noexcept
 	_resizePending = other._resizePending;
 	_resizeCallback = move(other._resizeCallback);
 	_closeCallback = move(other._closeCallback);
+	_windowState = other._windowState;
+	_windowStateChangedCallback = move(other._windowStateChangedCallback);
+	_placeholderColor = other._placeholderColor;
+	_roundTripCount = other._roundTripCount;
 	_mouseState = other._mouseState;
 	_mouseMoveCallback = move(other._mouseMoveCallback);
+	_inputState = other._inputState;
+	_inputSnapshot = other._inputSnapshot;
+	_inputStateTracking = other._inputStateTracking;
+	_eventQueue = move(other._eventQueue);
+	_eventQueueFront = other._eventQueueFront;
+	other._eventQueue.clear();
+	other._eventQueueFront = 0;
+	_eventQueueEnabled = other._eventQueueEnabled;
+	_activity = other._activity;
 	_mouseButtonCallback = move(other._mouseButtonCallback);
 	_mouseWheelCallback = move(other._mouseWheelCallback);
 	_keyCallback = move(other._keyCallback);
+	_outputsChangedCallback = move(other._outputsChangedCallback);
+	_outputHandles = move(other._outputHandles);
+	_listener = other._listener;
 	_title = move(other._title);
+
+#if !defined(USE_PLATFORM_QT)
+	// update deferred frame pointer
+	if(_frameDeferred)
+		for(VulkanWindow*& w : VulkanWindowPrivate::deferredFrameWindows)
+			if(w == &other) {
+				w = this;
+				break;
+			}
+#endif
 }
 
 
@@ -1751,55 +3321,71 @@ VulkanWindow& VulkanWindow::operator=(VulkanWindow&& other) noexcept
 			break;
 		}
 
-#elif defined(USE_PLATFORM_XLIB)
-
-	// move Xlib members
-	_xlib = other._xlib;
-	other._xlib.window = 0;
-
-	// update pointers to this object
-	if(_xlib.window != 0)
-		xlib::vulkanWindowMap[_xlib.window] = this;
-
-#elif defined(USE_PLATFORM_WAYLAND)
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
 
-	if(other._wayland.wlSurface == nullptr)
-	{
-		// move uninitialized window
-		// (create() was not called on the window yet)
-		_wayland.wlSurface = nullptr;
-	}
-	else
-	{
-		// process all pending sync events
-		// because they are delivered to the original object address
-		waitAllSyncEvents(other._wayland.numSyncEventsOnTheFly);
-
-		// move Wayland members
-		_wayland = other._wayland;
-		if(_wayland.wlSurface)
-			wl_surface_set_user_data(_wayland.wlSurface, this);
-		if(_wayland.xdgSurface)
-			xdg_surface_set_user_data(_wayland.xdgSurface, this);
-		if(_wayland.xdgTopLevel)
-			xdg_toplevel_set_user_data(_wayland.xdgTopLevel, this);
-		if(_wayland.libdecorFrame)
-			wayland::funcs.libdecor_frame_set_user_data(_wayland.libdecorFrame, this);
-		if(_wayland.scheduledFrameCallback)
-			wl_callback_set_user_data(_wayland.scheduledFrameCallback, this);
-		other._wayland.wlSurface = nullptr;
-		other._wayland.xdgSurface = nullptr;
-		other._wayland.xdgTopLevel = nullptr;
-		other._wayland.decoration = nullptr;
-		other._wayland.libdecorFrame = nullptr;
-		other._wayland.scheduledFrameCallback = nullptr;
+# if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		// move Xlib members
+		_xlib = other._xlib;
+		other._xlib.window = 0;
 
 		// update pointers to this object
-		if(wayland::windowUnderPointer == &other)
-			wayland::windowUnderPointer = static_cast<VulkanWindowPrivate*>(this);
-		if(wayland::windowWithKbFocus == &other)
-			wayland::windowWithKbFocus = static_cast<VulkanWindowPrivate*>(this);
+		if(_xlib.window != 0) {
+			lock_guard<mutex> lock(xlib::vulkanWindowMapMutex);
+			xlib::vulkanWindowMap[_xlib.window] = this;
+		}
+	}
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
+	if(waylandSelected()) {
+		if(other._wayland.wlSurface == nullptr)
+		{
+			// move uninitialized window
+			// (create() was not called on the window yet)
+			_wayland.wlSurface = nullptr;
+		}
+		else
+		{
+			// process all pending sync events
+			// because they are delivered to the original object address
+			if(waitAllSyncEvents(other._wayland.numSyncEventsOnTheFly, other._wayland.eventQueue))
+				other.countRoundTrip();
+
+			// move Wayland members
+			_wayland = other._wayland;
+			if(_wayland.wlSurface)
+				wl_surface_set_user_data(_wayland.wlSurface, this);
+			if(_wayland.xdgSurface)
+				xdg_surface_set_user_data(_wayland.xdgSurface, this);
+			if(_wayland.xdgTopLevel)
+				xdg_toplevel_set_user_data(_wayland.xdgTopLevel, this);
+			if(_wayland.libdecorFrame)
+				wayland::funcs.libdecor_frame_set_user_data(_wayland.libdecorFrame, this);
+			if(_wayland.scheduledFrameCallback)
+				wl_callback_set_user_data(_wayland.scheduledFrameCallback, this);
+			if(_wayland.placeholderBuffer)
+				wl_buffer_set_user_data(_wayland.placeholderBuffer, this);
+			other._wayland.wlSurface = nullptr;
+			other._wayland.xdgSurface = nullptr;
+			other._wayland.xdgTopLevel = nullptr;
+			other._wayland.decoration = nullptr;
+			other._wayland.libdecorFrame = nullptr;
+			other._wayland.scheduledFrameCallback = nullptr;
+			other._wayland.placeholderBuffer = nullptr;
+
+			// update pointers to this object
+			lock_guard<mutex> lock(wayland::inputMutex);
+			if(wayland::windowUnderPointer == &other)
+				wayland::windowUnderPointer = static_cast<VulkanWindowPrivate*>(this);
+			if(wayland::windowWithKbFocus == &other)
+				wayland::windowWithKbFocus = static_cast<VulkanWindowPrivate*>(this);
+			lock_guard<mutex> eventsLock(_wayland.inputBuffer->eventsMutex);
+			for(VulkanWindowPrivate::InputEvent& e : _wayland.inputBuffer->events)
+				if(e.window == &other)
+					e.window = static_cast<VulkanWindowPrivate*>(this);
+		}
 	}
+# endif
 
 #elif defined(USE_PLATFORM_SDL3)
 
@@ -1850,10 +3436,35 @@ VulkanWindow& VulkanWindow::operator=(VulkanWindow&& other) noexcept
 		static_cast<QtRenderingWindow*>(_qt.window)->vulkanWindow = this;
 	}
 
+#elif defined(USE_PLATFORM_DISPLAY)
+
+	// move display members
+	_display = other._display;
+	other._display.display = 0;
+
+	// update pointers to this object
+	if(display::windowWithFocus == &other)
+		display::windowWithFocus = static_cast<VulkanWindowPrivate*>(this);
+	for(VulkanWindow*& w : display::framePendingWindows)
+		if(w == &other) {
+			w = this;
+			break;
+		}
+
 #endif
 
 	// move members
 	_frameCallback = move(other._frameCallback);
+	_frameInterval = other._frameInterval;
+	_nextFrameTime = other._nextFrameTime;
+	_idleTimeout = other._idleTimeout;
+	_idleFrameInterval = other._idleFrameInterval;
+	_lastActivityTime = other._lastActivityTime;
+	_idle = other._idle;
+	_focused = other._focused;
+	_throttleWhenUnfocused = other._throttleWhenUnfocused;
+	_frameDeferred = other._frameDeferred;
+	other._frameDeferred = false;
 	_instance = move(other._instance);
 	_surface = other._surface;
 	other._surface = nullptr;
@@ -1863,13 +3474,39 @@ VulkanWindow& VulkanWindow::operator=(VulkanWindow&& other) noexcept
 	_resizePending = other._resizePending;
 	_resizeCallback = move(other._resizeCallback);
 	_closeCallback = move(other._closeCallback);
+	_windowState = other._windowState;
+	_windowStateChangedCallback = move(other._windowStateChangedCallback);
+	_placeholderColor = other._placeholderColor;
+	_roundTripCount = other._roundTripCount;
 	_mouseState = other._mouseState;
 	_mouseMoveCallback = move(other._mouseMoveCallback);
+	_inputState = other._inputState;
+	_inputSnapshot = other._inputSnapshot;
+	_inputStateTracking = other._inputStateTracking;
+	_eventQueue = move(other._eventQueue);
+	_eventQueueFront = other._eventQueueFront;
+	other._eventQueue.clear();
+	other._eventQueueFront = 0;
+	_eventQueueEnabled = other._eventQueueEnabled;
+	_activity = other._activity;
 	_mouseButtonCallback = move(other._mouseButtonCallback);
 	_mouseWheelCallback = move(other._mouseWheelCallback);
 	_keyCallback = move(other._keyCallback);
+	_outputsChangedCallback = move(other._outputsChangedCallback);
+	_outputHandles = move(other._outputHandles);
+	_listener = other._listener;
 	_title = move(other._title);
 
+#if !defined(USE_PLATFORM_QT)
+	// update deferred frame pointer
+	if(_frameDeferred)
+		for(VulkanWindow*& w : VulkanWindowPrivate::deferredFrameWindows)
+			if(w == &other) {
+				w = this;
+				break;
+			}
+#endif
+
 	return *this;
 }
 
@@ -1881,28 +3518,82 @@ VkSurfaceKHR VulkanWindow::create(VkInstance instance, uint32_t width, uint32_t
 	// (this makes calling create() multiple times safe operation)
 	destroy();
 
+	// initialize on the first use
+	// (init() returns immediately if already initialized;
+	// the display connection is not opened in processes that never create a window)
+	init();
+
 	_title = title;
 	_vkGetInstanceProcAddr = getInstanceProcAddr;
 
-	return createInternal(instance, width, height);
+	auto t = chrono::steady_clock::now();
+	VkSurfaceKHR surface = createInternal(instance, width, height);
+	_startupTimes.surfaceCreation = secondsSince(t);
+	return surface;
+}
+
+
+// batched window creation and showing
+// (requests of all the windows are sent to the server by a single flush)
+static thread_local bool deferFlush = false;
+
+static void flushRequests()
+{
+#if defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
+
+# if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		XFlush(xlib::threadDisplay ? xlib::threadDisplay : xlib::display);
+	}
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
+	if(waylandSelected()) {
+		if(wl_display_flush(wayland::display) == -1 && errno != EAGAIN)
+			throw runtime_error("VulkanWindow: wl_display_flush() failed.");
+	}
+# endif
+
+#endif
+}
+
+
+void VulkanWindow::createMany(VulkanWindow* const* windows, size_t count, VkInstance instance, uint32_t width, uint32_t height,
+                              string_view title, PFN_vkGetInstanceProcAddr getInstanceProcAddr)
+{
+	deferFlush = true;
+	try {
+		for(size_t i=0; i<count; i++)
+			windows[i]->create(instance, width, height, title, getInstanceProcAddr);
+	}
+	catch(...) {
+		deferFlush = false;
+		throw;
+	}
+	deferFlush = false;
+	flushRequests();
+}
+
+
+void VulkanWindow::showMany(VulkanWindow* const* windows, size_t count)
+{
+	deferFlush = true;
+	try {
+		for(size_t i=0; i<count; i++)
+			windows[i]->show();
+	}
+	catch(...) {
+		deferFlush = false;
+		throw;
+	}
+	deferFlush = false;
+	flushRequests();
 }
 
 
 VkSurfaceKHR VulkanWindow::createInternal(VkInstance instance, uint32_t width, uint32_t height)
 {
-	// asserts for valid usage
+	// assert for valid usage
 	assert(instance && "The parameter instance must not be null.");
-#if defined(USE_PLATFORM_WIN32)
-	assert(win32::windowClass && "VulkanWindow class was not initialized. Call VulkanWindow::init() before VulkanWindow::create().");
-#elif defined(USE_PLATFORM_XLIB)
-	assert(xlib::display && "VulkanWindow class was not initialized. Call VulkanWindow::init() before VulkanWindow::create().");
-#elif defined(USE_PLATFORM_WAYLAND)
-	assert(wayland::display && "VulkanWindow class was not initialized. Call VulkanWindow::init() before VulkanWindow::create().");
-#elif defined(USE_PLATFORM_SDL3) || defined(USE_PLATFORM_SDL2)
-	assert(sdl::initialized && "VulkanWindow class was not initialized. Call VulkanWindow::init() before VulkanWindow::create().");
-#elif defined(USE_PLATFORM_QT)
-	assert(qt::qGuiApplication && "VulkanWindow class was not initialized. Call VulkanWindow::init() before VulkanWindow::create().");
-#endif
 
 	// set Vulkan instance
 	_instance = instance;
@@ -1918,6 +3609,7 @@ VkSurfaceKHR VulkanWindow::createInternal(VkInstance instance, uint32_t width, u
 	_win32.visible = false;
 	_win32.hiddenWindowFramePending = false;
 	_win32.titleBarLeftButtonDownMsgOnHold = false;
+	_win32.trackingMouseLeave = false;
 
 	DWORD style = WS_OVERLAPPEDWINDOW;
 	DWORD exStyle = WS_EX_CLIENTEDGE;
@@ -1965,116 +3657,140 @@ VkSurfaceKHR VulkanWindow::createInternal(VkInstance instance, uint32_t width, u
 
 	return _surface;
 
-#elif defined(USE_PLATFORM_XLIB)
-
-	// init variables
-	_xlib.framePending = true;
-	_xlib.visible = false;
-	_xlib.fullyObscured = false;
-	_xlib.iconVisible = false;
-	_xlib.minimized = false;
-
-	// create window
-	XSetWindowAttributes attr;
-	attr.event_mask = ExposureMask | StructureNotifyMask | VisibilityChangeMask | PropertyChangeMask |
-	                  PointerMotionMask | ButtonPressMask | ButtonReleaseMask | KeyPressMask | KeyReleaseMask;
-	_xlib.window =
-		XCreateWindow(
-			xlib::display,  // display
-			DefaultRootWindow(xlib::display),  // parent
-			0, 0,  // x,y
-			unsigned(_surfaceWidth), unsigned(_surfaceHeight),  // width, height
-			0,  // border_width
-			CopyFromParent,  // depth
-			InputOutput,  // class
-			CopyFromParent,  // visual
-			CWEventMask,  // valuemask
-			&attr  // attributes
-		);
-	if(xlib::vulkanWindowMap.emplace(_xlib.window, this).second == false)
-		throw runtime_error("VulkanWindow: The window already exists.");
-	XSetWMProtocols(xlib::display, _xlib.window, &xlib::wmDeleteMessage, 1);
-	XSetStandardProperties(xlib::display, _xlib.window, _title.c_str(), _title.c_str(), None, NULL, 0, NULL);
-	XChangeProperty(
-		xlib::display,
-		_xlib.window,
-		xlib::netWmName,  // property
-		xlib::utf8String,  // type
-		8,  // format
-		PropModeReplace,  // mode
-		reinterpret_cast<const unsigned char*>(_title.c_str()),  // data
-		_title.size()  // nelements
-	);
-
-	// create surface
-	PFN_vkCreateXlibSurfaceKHR vulkanCreateXlibSurfaceKHR =
-		reinterpret_cast<PFN_vkCreateXlibSurfaceKHR>(vkGetInstanceProcAddr(_instance, "vkCreateXlibSurfaceKHR"));
-	if(vulkanCreateXlibSurfaceKHR == nullptr)
-		throw runtime_error("VulkanWindow: Failed to get vkCreateXlibSurfaceKHR function pointer.");
-	VkResult r =
-		vulkanCreateXlibSurfaceKHR(
-			instance,  // instance
-			&(const VkXlibSurfaceCreateInfoKHR&)VkXlibSurfaceCreateInfoKHR{  // pCreateInfo
-				VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR,  // sType
-				nullptr,  // pNext
-				0,  // flags
-				xlib::display,  // dpy
-				_xlib.window  // window
-			},
-			nullptr,  // pAllocator
-			reinterpret_cast<VkSurfaceKHR*>(&_surface)  // pSurface
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
+
+# if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		// init variables
+		_xlib.framePending = true;
+		_xlib.visible = false;
+		_xlib.fullyObscured = false;
+		_xlib.iconVisible = false;
+		_xlib.minimized = false;
+
+		// use per-thread display connection if initThread() was called on the current thread
+		_xlib.display = xlib::threadDisplay ? xlib::threadDisplay : xlib::display;
+
+		// create window
+		XSetWindowAttributes attr;
+		attr.event_mask = ExposureMask | StructureNotifyMask | VisibilityChangeMask | PropertyChangeMask |
+		                  PointerMotionMask | ButtonPressMask | ButtonReleaseMask | KeyPressMask | KeyReleaseMask |
+		                  FocusChangeMask | LeaveWindowMask;
+		_xlib.window =
+			XCreateWindow(
+				_xlib.display,  // display
+				DefaultRootWindow(_xlib.display),  // parent
+				0, 0,  // x,y
+				unsigned(_surfaceWidth), unsigned(_surfaceHeight),  // width, height
+				0,  // border_width
+				CopyFromParent,  // depth
+				InputOutput,  // class
+				CopyFromParent,  // visual
+				CWEventMask,  // valuemask
+				&attr  // attributes
+			);
+		{
+			lock_guard<mutex> lock(xlib::vulkanWindowMapMutex);
+			if(xlib::vulkanWindowMap.emplace(_xlib.window, this).second == false)
+				throw runtime_error("VulkanWindow: The window already exists.");
+		}
+		XSetWMProtocols(_xlib.display, _xlib.window, &xlib::wmDeleteMessage, 1);
+		XSetStandardProperties(_xlib.display, _xlib.window, _title.c_str(), _title.c_str(), None, NULL, 0, NULL);
+		XChangeProperty(
+			_xlib.display,
+			_xlib.window,
+			xlib::netWmName,  // property
+			xlib::utf8String,  // type
+			8,  // format
+			PropModeReplace,  // mode
+			reinterpret_cast<const unsigned char*>(_title.c_str()),  // data
+			_title.size()  // nelements
 		);
-	if(r != VK_SUCCESS)
-		throw runtime_error(string("VulkanWindow: vkCreateXlibSurfaceKHR() failed (return code: ") + to_string(r) + ").");
-
-	return _surface;
-
-#elif defined(USE_PLATFORM_WAYLAND)
-
-	// init variables
-	_wayland.xdgSurface = nullptr;
-	_wayland.xdgTopLevel = nullptr;
-	_wayland.decoration = nullptr;
-	_wayland.libdecorFrame = nullptr;
-	_wayland.scheduledFrameCallback = nullptr;
-	_wayland.forcedFrame = false;
-	_wayland.numSyncEventsOnTheFly = 0;
-	_wayland.windowState = WindowState::Hidden;
-
-	// create wl surface
-	_wayland.wlSurface = wl_compositor_create_surface(wayland::compositor);
-	if(_wayland.wlSurface == nullptr)
-		throw runtime_error("VulkanWindow: wl_compositor_create_surface() failed.");
-
-	// set tag on surface
-	wl_proxy_set_tag(reinterpret_cast<wl_proxy*>(_wayland.wlSurface), &wayland::vulkanWindowTag);
 
-	// associate surface with VulkanWindow
-	wl_surface_set_user_data(_wayland.wlSurface, this);
+		// create surface
+		PFN_vkCreateXlibSurfaceKHR vulkanCreateXlibSurfaceKHR =
+			reinterpret_cast<PFN_vkCreateXlibSurfaceKHR>(vkGetInstanceProcAddr(_instance, "vkCreateXlibSurfaceKHR"));
+		if(vulkanCreateXlibSurfaceKHR == nullptr)
+			throw runtime_error("VulkanWindow: Failed to get vkCreateXlibSurfaceKHR function pointer.");
+		VkResult r =
+			vulkanCreateXlibSurfaceKHR(
+				instance,  // instance
+				&(const VkXlibSurfaceCreateInfoKHR&)VkXlibSurfaceCreateInfoKHR{  // pCreateInfo
+					VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR,  // sType
+					nullptr,  // pNext
+					0,  // flags
+					_xlib.display,  // dpy
+					_xlib.window  // window
+				},
+				nullptr,  // pAllocator
+				reinterpret_cast<VkSurfaceKHR*>(&_surface)  // pSurface
+			);
+		if(r != VK_SUCCESS)
+			throw runtime_error(string("VulkanWindow: vkCreateXlibSurfaceKHR() failed (return code: ") + to_string(r) + ").");
 
-	// create surface
-	PFN_vkCreateWaylandSurfaceKHR vkCreateWaylandSurfaceKHR =
-		reinterpret_cast<PFN_vkCreateWaylandSurfaceKHR>(vkGetInstanceProcAddr(_instance, "vkCreateWaylandSurfaceKHR"));
-	if(vkCreateWaylandSurfaceKHR == nullptr)
-		throw runtime_error("VulkanWindow: Failed to get vkCreateWaylandSurfaceKHR function pointer.");
-	VkResult r =
-		vkCreateWaylandSurfaceKHR(
-			instance,  // instance
-			&(const VkWaylandSurfaceCreateInfoKHR&)VkWaylandSurfaceCreateInfoKHR{  // pCreateInfo
-				VK_STRUCTURE_TYPE_WAYLAND_SURFACE_CREATE_INFO_KHR,  // sType
-				nullptr,  // pNext
-				0,  // flags
-				wayland::display,  // display
-				_wayland.wlSurface  // surface
-			},
-			nullptr,  // pAllocator
-			reinterpret_cast<VkSurfaceKHR*>(&_surface)  // pSurface
-		);
-	if(r != VK_SUCCESS)
-		throw runtime_error(string("VulkanWindow: vkCreateWaylandSurfaceKHR() failed (return code: ") + to_string(r) + ").");
-	if(wl_display_flush(wayland::display) == -1)
-		throw runtime_error("VulkanWindow: wl_display_flush() failed.");
-	return _surface;
+		return _surface;
+	}
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
+	if(waylandSelected()) {
+		// init variables
+		_wayland.xdgSurface = nullptr;
+		_wayland.xdgTopLevel = nullptr;
+		_wayland.decoration = nullptr;
+		_wayland.libdecorFrame = nullptr;
+		_wayland.scheduledFrameCallback = nullptr;
+		_wayland.placeholderBuffer = nullptr;
+		_wayland.forcedFrame = false;
+		_wayland.numSyncEventsOnTheFly = 0;
+		_wayland.eventQueue = wayland::threadQueue;
+		_wayland.displayWrapper = wayland::threadDisplayWrapper;
+		_wayland.inputBuffer = wayland::threadInputBuffer ? wayland::threadInputBuffer : &wayland::mainInputBuffer;
+
+		// create wl surface
+		_wayland.wlSurface = wl_compositor_create_surface(wayland::compositor);
+		if(_wayland.wlSurface == nullptr)
+			throw runtime_error("VulkanWindow: wl_compositor_create_surface() failed.");
+
+		// assign surface to per-thread event queue
+		// (objects created from the surface, such as frame callbacks, inherit the queue)
+		if(_wayland.eventQueue)
+			wl_proxy_set_queue(reinterpret_cast<wl_proxy*>(_wayland.wlSurface), _wayland.eventQueue);
+
+		// set tag on surface
+		wl_proxy_set_tag(reinterpret_cast<wl_proxy*>(_wayland.wlSurface), &wayland::vulkanWindowTag);
+
+		// associate surface with VulkanWindow
+		// (the listener tracks the outputs the surface is on)
+		if(wl_surface_add_listener(_wayland.wlSurface, &surfaceListener, this))
+			throw runtime_error("wl_surface_add_listener() failed.");
+
+		// create surface
+		PFN_vkCreateWaylandSurfaceKHR vkCreateWaylandSurfaceKHR =
+			reinterpret_cast<PFN_vkCreateWaylandSurfaceKHR>(vkGetInstanceProcAddr(_instance, "vkCreateWaylandSurfaceKHR"));
+		if(vkCreateWaylandSurfaceKHR == nullptr)
+			throw runtime_error("VulkanWindow: Failed to get vkCreateWaylandSurfaceKHR function pointer.");
+		VkResult r =
+			vkCreateWaylandSurfaceKHR(
+				instance,  // instance
+				&(const VkWaylandSurfaceCreateInfoKHR&)VkWaylandSurfaceCreateInfoKHR{  // pCreateInfo
+					VK_STRUCTURE_TYPE_WAYLAND_SURFACE_CREATE_INFO_KHR,  // sType
+					nullptr,  // pNext
+					0,  // flags
+					wayland::display,  // display
+					_wayland.wlSurface  // surface
+				},
+				nullptr,  // pAllocator
+				reinterpret_cast<VkSurfaceKHR*>(&_surface)  // pSurface
+			);
+		if(r != VK_SUCCESS)
+			throw runtime_error(string("VulkanWindow: vkCreateWaylandSurfaceKHR() failed (return code: ") + to_string(r) + ").");
+		if(!deferFlush)
+			if(wl_display_flush(wayland::display) == -1)
+				throw runtime_error("VulkanWindow: wl_display_flush() failed.");
+		return _surface;
+	}
+# endif
+	return _surface;  // not reached as one of the backends is always selected
 
 #elif defined(USE_PLATFORM_SDL3)
 
@@ -2094,6 +3810,7 @@ VkSurfaceKHR VulkanWindow::createInternal(VkInstance instance, uint32_t width, u
 		throw runtime_error(string("VulkanWindow: SDL_CreateWindow() function failed. Error details: ") + SDL_GetError());
 
 	// set pointer to this
+	countRoundTrip();
 	SDL_PropertiesID props = SDL_GetWindowProperties(_sdl.window);
 	if(props == 0)
 		throw runtime_error(string("VulkanWindow: SDL_GetWindowProperties() function failed. Error details: ") + SDL_GetError());
@@ -2194,14 +3911,26 @@ VkSurfaceKHR VulkanWindow::createInternal(VkInstance instance, uint32_t width, u
 			else
 				// schedule frame on window un-minimalization
 				w->scheduleFrame();
+
+			// update window state
+			if(w->_glfw.visible)
+				w->updateWindowState(w->windowState());
+		}
+	);
+	glfwSetWindowMaximizeCallback(
+		_glfw.window,
+		[](GLFWwindow* window, int maximized) {
+			VulkanWindow* w = reinterpret_cast<VulkanWindow*>(glfwGetWindowUserPointer(window));
+			if(w->_glfw.visible)
+				w->updateWindowState(w->windowState());
 		}
 	);
 	glfwSetWindowCloseCallback(
 		_glfw.window,
 		[](GLFWwindow* window) {
 			VulkanWindow* w = reinterpret_cast<VulkanWindow*>(glfwGetWindowUserPointer(window));
-			if(w->_closeCallback)
-				w->_closeCallback(*w);  // VulkanWindow object might be already destroyed when returning from the callback
+			if(w->hasCloseHandler())
+				w->callClose();  // VulkanWindow object might be already destroyed when returning from the callback
 			else {
 				w->hide();
 				VulkanWindow::exitMainLoop();
@@ -2223,8 +3952,8 @@ VkSurfaceKHR VulkanWindow::createInternal(VkInstance instance, uint32_t width, u
 				w->_mouseState.relY = y - w->_mouseState.posY;
 				w->_mouseState.posX = x;
 				w->_mouseState.posY = y;
-				if(w->_mouseMoveCallback)
-					w->_mouseMoveCallback(*w, w->_mouseState);
+				if(w->hasMouseMoveHandler())
+					w->callMouseMove(w->_mouseState);
 			}
 		}
 	);
@@ -2248,16 +3977,16 @@ VkSurfaceKHR VulkanWindow::createInternal(VkInstance instance, uint32_t width, u
 			w->_mouseState.modifiers.set(Modifier::Shift, mods & GLFW_MOD_SHIFT);
 			w->_mouseState.modifiers.set(Modifier::Alt,   mods & GLFW_MOD_ALT);
 			w->_mouseState.modifiers.set(Modifier::Meta,  mods & GLFW_MOD_SUPER);
-			if(w->_mouseButtonCallback)
-				w->_mouseButtonCallback(*w, b, buttonState, w->_mouseState);
+			if(w->hasMouseButtonHandler())
+				w->callMouseButton(b, buttonState, w->_mouseState);
 		}
 	);
 	glfwSetScrollCallback(
 		_glfw.window,
 		[](GLFWwindow* window, double xoffset, double yoffset) {
 			VulkanWindow* w = reinterpret_cast<VulkanWindow*>(glfwGetWindowUserPointer(window));
-			if(w->_mouseWheelCallback)
-				w->_mouseWheelCallback(*w, -float(xoffset), float(yoffset), w->_mouseState);
+			if(w->hasMouseWheelHandler())
+				w->callMouseWheel(-float(xoffset), float(yoffset), w->_mouseState);
 		}
 	);
 	glfwSetKeyCallback(
@@ -2269,7 +3998,7 @@ VkSurfaceKHR VulkanWindow::createInternal(VkInstance instance, uint32_t width, u
 				w->_mouseState.modifiers.set(Modifier::Shift, mods & GLFW_MOD_SHIFT);
 				w->_mouseState.modifiers.set(Modifier::Alt,   mods & GLFW_MOD_ALT);
 				w->_mouseState.modifiers.set(Modifier::Meta,  mods & GLFW_MOD_SUPER);
-				if(w->_keyCallback) {
+				if(w->hasKeyHandler()) {
 # ifdef _WIN32
 					ScanCode scanCode = translateScanCode(nativeScanCode);
 # else
@@ -2277,7 +4006,7 @@ VkSurfaceKHR VulkanWindow::createInternal(VkInstance instance, uint32_t width, u
 # endif
 					if(key >= 'A' && key <= 'Z')
 						key += 32;
-					w->_keyCallback(*w, (action == GLFW_PRESS) ? KeyState::Pressed : KeyState::Released, scanCode, KeyCode(key));
+					w->callKey((action == GLFW_PRESS) ? KeyState::Pressed : KeyState::Released, scanCode, KeyCode(key));
 				}
 			}
 		}
@@ -2290,6 +4019,25 @@ VkSurfaceKHR VulkanWindow::createInternal(VkInstance instance, uint32_t width, u
 				w->_glfw.savedPosX = posX;
 				w->_glfw.savedPosY = posY;
 			}
+			VulkanWindow* w = reinterpret_cast<VulkanWindow*>(glfwGetWindowUserPointer(window));
+			if(w->hasOutputsChangedHandler())
+				w->updateOutputs();
+		}
+	);
+	glfwSetWindowFocusCallback(
+		_glfw.window,
+		[](GLFWwindow* window, int focused) {
+			VulkanWindow* w = reinterpret_cast<VulkanWindow*>(glfwGetWindowUserPointer(window));
+			w->updateFocus(focused == GLFW_TRUE);
+		}
+	);
+	glfwSetCursorEnterCallback(
+		_glfw.window,
+		[](GLFWwindow* window, int entered) {
+			if(entered == GLFW_FALSE) {
+				VulkanWindow* w = reinterpret_cast<VulkanWindow*>(glfwGetWindowUserPointer(window));
+				w->updatePointerLeave();
+			}
 		}
 	);
 	glfwSetWindowSizeCallback(
@@ -2332,22 +4080,133 @@ VkSurfaceKHR VulkanWindow::createInternal(VkInstance instance, uint32_t width, u
 		throw runtime_error("VulkanWindow::init(): Failed to create surface.");
 	return _surface;
 
-#endif
-}
-
-
-void VulkanWindow::renderFrame()
-{
-	// assert for valid usage
-	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
+#elif defined(USE_PLATFORM_DISPLAY)
 
-	// resize if requested
+	// init variables
+	_display.framePendingState = FramePendingState::NotPending;
+	_display.visible = false;
+
+	// get display
+	DisplayFuncs f = getDisplayFuncs(instance, _vkGetInstanceProcAddr);
+	vector<DisplayInfo> displays = getDisplays(f, instance);
+	if(displays.empty())
+		throw runtime_error("VulkanWindow: Cannot create window. No display was found.");
+	if(display::displayIndex >= displays.size())
+		throw runtime_error("VulkanWindow: Cannot create window. Display index " + to_string(display::displayIndex) +
+		                    " is out of range (number of displays: " + to_string(displays.size()) + ").");
+	const DisplayInfo& d = displays[display::displayIndex];
+
+	// choose display mode
+	// (the mode of the requested size is preferred, then the mode of native resolution;
+	// there is no scaling, so the surface takes the size of the mode)
+	vector<VkDisplayModePropertiesKHR> modes = getDisplayModes(f, d);
+	if(modes.empty())
+		throw runtime_error("VulkanWindow: Cannot create window. The display has no modes.");
+	const VkDisplayModePropertiesKHR* mode = findDisplayMode(modes, width, height);
+	if(mode == nullptr)
+		mode = findDisplayMode(modes, d.properties.physicalResolution.width, d.properties.physicalResolution.height);
+	if(mode == nullptr)
+		mode = &modes.front();
+
+	// choose plane
+	// (the first plane that is not used by other display and that can be used with our display)
+	vector<VkDisplayPlanePropertiesKHR> planes = enumerateVk<VkDisplayPlanePropertiesKHR>(
+		[&](uint32_t* count, VkDisplayPlanePropertiesKHR* a) { return f.vkGetPhysicalDeviceDisplayPlanePropertiesKHR(d.physicalDevice, count, a); },
+		"vkGetPhysicalDeviceDisplayPlanePropertiesKHR");
+	uint32_t planeIndex = display::planeIndex;
+	if(planeIndex == UINT32_MAX) {
+		for(uint32_t i=0; i<planes.size(); i++) {
+			if(planes[i].currentDisplay != 0 && planes[i].currentDisplay != d.properties.display)
+				continue;
+			vector<VkDisplayKHR> supportedDisplays = enumerateVk<VkDisplayKHR>(
+				[&](uint32_t* count, VkDisplayKHR* a) { return f.vkGetDisplayPlaneSupportedDisplaysKHR(d.physicalDevice, i, count, a); },
+				"vkGetDisplayPlaneSupportedDisplaysKHR");
+			if(find(supportedDisplays.begin(), supportedDisplays.end(), d.properties.display) != supportedDisplays.end()) {
+				planeIndex = i;
+				break;
+			}
+		}
+		if(planeIndex == UINT32_MAX)
+			throw runtime_error("VulkanWindow: Cannot create window. No display plane can be used with the display.");
+	}
+	else if(planeIndex >= planes.size())
+		throw runtime_error("VulkanWindow: Cannot create window. Plane index " + to_string(planeIndex) +
+		                    " is out of range (number of planes: " + to_string(planes.size()) + ").");
+
+	// alpha mode
+	// (opaque is preferred; global alpha of 1 is opaque as well)
+	VkDisplayPlaneCapabilitiesKHR capabilities;
+	VkResult r = f.vkGetDisplayPlaneCapabilitiesKHR(d.physicalDevice, mode->displayMode, planeIndex, &capabilities);
+	if(r != VK_SUCCESS)
+		throw runtime_error(string("VulkanWindow: vkGetDisplayPlaneCapabilitiesKHR() failed (return code: ") + to_string(r) + ").");
+	uint32_t alphaMode;
+	if(capabilities.supportedAlpha & VK_DISPLAY_PLANE_ALPHA_OPAQUE_BIT_KHR)
+		alphaMode = VK_DISPLAY_PLANE_ALPHA_OPAQUE_BIT_KHR;
+	else if(capabilities.supportedAlpha & VK_DISPLAY_PLANE_ALPHA_GLOBAL_BIT_KHR)
+		alphaMode = VK_DISPLAY_PLANE_ALPHA_GLOBAL_BIT_KHR;
+	else
+		alphaMode = capabilities.supportedAlpha & (~capabilities.supportedAlpha + 1);  // the lowest supported bit
+
+	// create surface
+	const VkDisplaySurfaceCreateInfoKHR createInfo = {
+		VK_STRUCTURE_TYPE_DISPLAY_SURFACE_CREATE_INFO_KHR,  // sType
+		nullptr,  // pNext
+		0,  // flags
+		mode->displayMode,  // displayMode
+		planeIndex,  // planeIndex
+		planes[planeIndex].currentStackIndex,  // planeStackIndex
+		VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR,  // transform
+		1.f,  // globalAlpha
+		alphaMode,  // alphaMode
+		mode->visibleRegion,  // imageExtent
+	};
+	r = f.vkCreateDisplayPlaneSurfaceKHR(instance, &createInfo, nullptr, &_surface);
+	if(r != VK_SUCCESS)
+		throw runtime_error(string("VulkanWindow: vkCreateDisplayPlaneSurfaceKHR() failed (return code: ") + to_string(r) + ").");
+
+	// window data
+	_display.display = d.properties.display;
+	_display.planeIndex = planeIndex;
+	_surfaceWidth = mode->visibleRegion.width;
+	_surfaceHeight = mode->visibleRegion.height;
+	display::instance = instance;
+	display::getInstanceProcAddr = _vkGetInstanceProcAddr;
+
+	// default frame rate limit
+	// (there is no compositor pacing the frames and vkQueuePresentKHR() does not block in mailbox and immediate
+	// present modes or with drivers without real display, so the main loop would spin; the limit is set slightly
+	// above the refresh rate, so it does not delay the frames when FIFO presentation paces them on vertical blank)
+	if(_frameInterval == 0 && mode->refreshRate != 0)
+		setFrameRateLimit(double(mode->refreshRate) / 1000. * 1.05);
+
+	return _surface;
+
+#endif
+}
+
+
+void VulkanWindow::renderFrame()
+{
+	// assert for valid usage
+	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
+
+	// frame rate limit and idle throttling
+	// (we wait before the input snapshot, so the frame uses the latest input)
+	if(_frameInterval != 0 || _idleTimeout != 0)
+		if(!waitForFrameTime())
+			return;
+
+	// take input snapshot
+	if(_inputStateTracking)
+		takeInputSnapshot();
+
+	// resize if requested
 	if(_resizePending) {
 
 		// resize callback
 		// (it usually recreates the swapchain)
 		_resizePending = false;
-		_resizeCallback(*this, _surfaceWidth, _surfaceHeight);
+		callResize(_surfaceWidth, _surfaceHeight);
 
 		// check for zero window size
 		if(_surfaceWidth == 0 || _surfaceHeight == 0) {
@@ -2361,14 +4220,424 @@ void VulkanWindow::renderFrame()
 
 	// render scene
 #if !defined(USE_PLATFORM_QT)
-	_frameCallback(*this);
+	callFrame();
 #else
 # if (QT_VERSION >= QT_VERSION_CHECK(5, 15, 0))
 	qt::qVulkanInstance->presentAboutToBeQueued(_qt.window);
 # endif
-	_frameCallback(*this);
+	callFrame();
 	qt::qVulkanInstance->presentQueued(_qt.window);
 #endif
+
+	// scheduleFrame() called by the frame callback is not an activity
+	_activity = false;
+}
+
+
+// time spent spinning before the frame time
+// (the main loop wakes up by the absolute time timer shortly before the frame time,
+// which absorbs the wake-up latency of the timer, and the rest is spun in waitForFrameTime())
+static constexpr int64_t frameSpinDuration = 80000;
+
+
+bool VulkanWindow::waitForFrameTime()
+{
+	int64_t now = steadyNanoseconds();
+	int64_t frameInterval = _frameInterval;
+
+	// idle throttling
+	if(_idleTimeout != 0) {
+
+		// update idle state
+		if(_activity) {
+			_activity = false;
+			_lastActivityTime = now;
+		}
+		bool idle = now - _lastActivityTime >= _idleTimeout || (!_focused && _throttleWhenUnfocused);
+		if(idle)
+			frameInterval = max(frameInterval, _idleFrameInterval);
+
+		// leaving idle state
+		// (the next frame time computed with the idle interval is replaced by the one using the full frame rate)
+		if(_idle && !idle)
+			_nextFrameTime += frameInterval - max(_frameInterval, _idleFrameInterval);
+		_idle = idle;
+
+	}
+
+	// defer the frame until its time
+	// (renderFrame() does not sleep; the main loop waits for the frame time while processing events
+	// and schedules the frame again; the scheduleFrame() call that triggered this frame is not counted as an activity)
+	if(now < _nextFrameTime) {
+		int64_t wakeUpTime = _nextFrameTime - frameSpinDuration;
+		if(now < wakeUpTime) {
+#if !defined(USE_PLATFORM_QT)
+			_activity = false;
+			VulkanWindowPrivate::deferFrame(this);
+			return false;
+#else
+			// Qt timers have millisecond resolution, so the last fraction of millisecond is slept here
+			int timeout = timeoutMilliseconds(wakeUpTime);
+			if(timeout > 0) {
+				_activity = false;
+				static_cast<QtRenderingWindow*>(_qt.window)->scheduleFrameTimer(timeout);
+				return false;
+			}
+			sleepUntil(wakeUpTime);
+#endif
+		}
+		while(steadyNanoseconds() < _nextFrameTime);
+		now = _nextFrameTime;
+	}
+#if !defined(USE_PLATFORM_QT)
+	if(_frameDeferred)
+		VulkanWindowPrivate::cancelDeferredFrame(this);
+#endif
+
+	// schedule the next frame
+	// (we keep the cadence if the frame is late by less than the frame interval,
+	// otherwise we start from now instead of rendering a burst of frames to catch up)
+	if(now - _nextFrameTime < frameInterval)
+		_nextFrameTime += frameInterval;
+	else
+		_nextFrameTime = now + frameInterval;
+	return true;
+}
+
+
+#if !defined(USE_PLATFORM_QT)
+
+void VulkanWindowPrivate::deferFrame(VulkanWindow* w)
+{
+	VulkanWindowPrivate* p = static_cast<VulkanWindowPrivate*>(w);
+	if(p->_frameDeferred)
+		return;
+	p->_frameDeferred = true;
+	deferredFrameWindows.push_back(w);
+}
+
+
+void VulkanWindowPrivate::cancelDeferredFrame(VulkanWindow* w)
+{
+	static_cast<VulkanWindowPrivate*>(w)->_frameDeferred = false;
+	for(size_t i=0; i<deferredFrameWindows.size(); i++)
+		if(deferredFrameWindows[i] == w) {
+			deferredFrameWindows[i] = deferredFrameWindows.back();
+			deferredFrameWindows.pop_back();
+			break;
+		}
+}
+
+
+int64_t VulkanWindowPrivate::scheduleDeferredFrames()
+{
+	// schedule frames whose time came
+	// (activity schedules the frame immediately as it might end the idle state and change the frame time;
+	// the scheduleFrame() call itself is not counted as an activity)
+	int64_t now = steadyNanoseconds();
+	int64_t wakeUpTime = -1;
+	for(size_t i=0; i<deferredFrameWindows.size(); ) {
+		VulkanWindowPrivate* w = static_cast<VulkanWindowPrivate*>(deferredFrameWindows[i]);
+		int64_t t = w->_nextFrameTime - frameSpinDuration;
+		if(t > now && !w->_activity) {
+			if(wakeUpTime == -1 || t < wakeUpTime)
+				wakeUpTime = t;
+			i++;
+			continue;
+		}
+		w->_frameDeferred = false;
+		deferredFrameWindows[i] = deferredFrameWindows.back();
+		deferredFrameWindows.pop_back();
+		bool activity = w->_activity;
+		w->scheduleFrame();
+		w->_activity = activity;
+	}
+	return wakeUpTime;
+}
+
+#endif
+
+
+void VulkanWindow::setIdleThrottling(double idleTimeout, double idleFrameRate, bool throttleWhenUnfocused)
+{
+	_idleTimeout = (idleTimeout > 0.) ? int64_t(idleTimeout * 1e9 + 0.5) : 0;
+	_idleFrameInterval = (idleFrameRate > 0.) ? int64_t(1e9 / idleFrameRate + 0.5) : 0;
+	_throttleWhenUnfocused = throttleWhenUnfocused;
+	_lastActivityTime = steadyNanoseconds();
+	_idle = false;
+}
+
+
+void VulkanWindow::updateFocus(bool focused)
+{
+	// focus gain is an activity
+	_focused = focused;
+	if(focused)
+		_activity = true;
+
+	// forget pressed keys and buttons on focus loss
+	// (their release events are delivered to the window that has the focus)
+	else {
+		_inputState.keys.reset();
+		_inputState.buttons.reset();
+	}
+}
+
+
+void VulkanWindow::updatePointerLeave()
+{
+	// forget pressed buttons when the pointer leaves the window
+	// (their release events might be delivered to another window)
+	_inputState.buttons.reset();
+}
+
+
+double VulkanWindow::recommendedFrameRateLimit() const
+{
+	// find the output with the lowest refresh rate among the window outputs
+	const Output* output = nullptr;
+	vector<Output> l = windowOutputs();
+	for(const Output& o : l)
+		if(o.refreshRate > 0. && (output == nullptr || o.refreshRate < output->refreshRate))
+			output = &o;
+	if(output == nullptr)
+		return 0.;
+
+	// stay a few percent below the top of the VRR range when the range is known,
+	// so the frames are not delayed by the vsync at the top of the range
+	if(output->vrrCapable && output->vrrMaxRefreshRate > 0.)
+		return max(min(output->refreshRate, output->vrrMaxRefreshRate) * 0.97, output->vrrMinRefreshRate);
+	return output->refreshRate;
+}
+
+
+void VulkanWindow::Listener::onClose(VulkanWindow& window)
+{
+	window.hide();
+	VulkanWindow::exitMainLoop();
+}
+
+
+void VulkanWindow::callResize(uint32_t& widthToBeSet, uint32_t& heightToBeSet)
+{
+	if(_eventQueueEnabled) {
+		Event& e = queueEvent(Event::Type::Resize);
+		e.resize.width = widthToBeSet;
+		e.resize.height = heightToBeSet;
+	}
+	if(_listener)
+		_listener->onResize(*this, widthToBeSet, heightToBeSet);
+	else
+		_resizeCallback(*this, widthToBeSet, heightToBeSet);
+}
+
+
+void VulkanWindow::callClose()
+{
+	if(_eventQueueEnabled)
+		queueEvent(Event::Type::Close);
+	if(_listener)
+		_listener->onClose(*this);
+	else if(_closeCallback)
+		_closeCallback(*this);
+}
+
+
+void VulkanWindow::callWindowStateChanged(WindowState windowState)
+{
+	if(_eventQueueEnabled)
+		queueEvent(Event::Type::WindowStateChanged).windowState = windowState;
+	if(_listener)
+		_listener->onWindowStateChanged(*this, windowState);
+	else if(_windowStateChangedCallback)
+		_windowStateChangedCallback(*this, windowState);
+}
+
+
+void VulkanWindow::storeMouseMove(const MouseState& mouseState)
+{
+	if(_inputStateTracking) {
+		trackMouseState(mouseState);
+		_inputState.relX += mouseState.relX;
+		_inputState.relY += mouseState.relY;
+	}
+	if(_eventQueueEnabled)
+		queueEvent(Event::Type::MouseMove);
+}
+
+
+void VulkanWindow::storeMouseButton(MouseButton::EnumType button, ButtonState buttonState, const MouseState& mouseState)
+{
+	if(_inputStateTracking)
+		trackMouseState(mouseState);
+	if(_eventQueueEnabled) {
+		Event& e = queueEvent(Event::Type::MouseButton);
+		e.mouseButton.button = button;
+		e.mouseButton.buttonState = buttonState;
+	}
+}
+
+
+void VulkanWindow::storeMouseWheel(float wheelX, float wheelY, const MouseState& mouseState)
+{
+	if(_inputStateTracking) {
+		trackMouseState(mouseState);
+		_inputState.wheelX += wheelX;
+		_inputState.wheelY += wheelY;
+	}
+	if(_eventQueueEnabled) {
+		Event& e = queueEvent(Event::Type::MouseWheel);
+		e.mouseWheel.wheelX = wheelX;
+		e.mouseWheel.wheelY = wheelY;
+	}
+}
+
+
+void VulkanWindow::storeKey(KeyState newKeyState, ScanCode scanCode, KeyCode key)
+{
+	if(_inputStateTracking && size_t(scanCode) < _inputState.keys.size())
+		_inputState.keys[size_t(scanCode)] = (newKeyState == KeyState::Pressed);
+	if(_eventQueueEnabled) {
+		Event& e = queueEvent(Event::Type::Key);
+		e.key.keyState = newKeyState;
+		e.key.scanCode = scanCode;
+		e.key.key = key;
+	}
+}
+
+
+void VulkanWindow::trackMouseState(const MouseState& mouseState)
+{
+	_inputState.posX = mouseState.posX;
+	_inputState.posY = mouseState.posY;
+	_inputState.buttons = mouseState.buttons;
+	_inputState.modifiers = mouseState.modifiers;
+}
+
+
+void VulkanWindow::takeInputSnapshot()
+{
+	_inputSnapshot = _inputState;
+	_inputState.relX = 0.f;
+	_inputState.relY = 0.f;
+	_inputState.wheelX = 0.f;
+	_inputState.wheelY = 0.f;
+}
+
+
+VulkanWindow::Event& VulkanWindow::queueEvent(Event::Type type)
+{
+	// drop the oldest event when the queue is full
+	if(_eventQueue.size() - _eventQueueFront >= maxQueuedEvents)
+		_eventQueueFront++;
+
+	// reuse the space of the retrieved events
+	// (the events are moved to the beginning once at least half of the buffer was retrieved,
+	// so each event is moved at most once on average)
+	if(_eventQueueFront != 0 && _eventQueueFront >= _eventQueue.size() / 2) {
+		_eventQueue.erase(_eventQueue.begin(), _eventQueue.begin() + _eventQueueFront);
+		_eventQueueFront = 0;
+	}
+
+	Event& e = _eventQueue.emplace_back();
+	e.type = type;
+	e.mouseState = _mouseState;
+	return e;
+}
+
+
+size_t VulkanWindow::pollEvents(Event* events, size_t capacity)
+{
+	size_t n = min(capacity, _eventQueue.size() - _eventQueueFront);
+	copy(_eventQueue.begin() + _eventQueueFront, _eventQueue.begin() + _eventQueueFront + n, events);
+	_eventQueueFront += n;
+
+	// empty the buffer when all events were retrieved
+	// (its capacity is kept for the next events)
+	if(_eventQueueFront == _eventQueue.size()) {
+		_eventQueue.clear();
+		_eventQueueFront = 0;
+	}
+	return n;
+}
+
+
+void VulkanWindow::setEventQueueEnabled(bool value)
+{
+	_eventQueueEnabled = value;
+	if(!value) {
+		_eventQueue.clear();
+		_eventQueueFront = 0;
+	}
+}
+
+
+vector<VulkanWindow::Output> VulkanWindow::outputs()
+{
+	size_t numRoundTrips = 0;
+	vector<Output> l = queryOutputs(numRoundTrips);
+	_globalRoundTripCount += numRoundTrips;
+	return l;
+}
+
+
+vector<VulkanWindow::Output> VulkanWindow::windowOutputs() const
+{
+	// get handles of the outputs the window is on
+	// (Wayland reports them by wl_surface events, other platforms are queried)
+#if defined(USE_PLATFORM_WAYLAND) && defined(USE_PLATFORM_XLIB)
+	vector<void*> handles = waylandSelected() ? _outputHandles : queryOutputHandles();
+#elif defined(USE_PLATFORM_WAYLAND)
+	const vector<void*>& handles = _outputHandles;
+#else
+	vector<void*> handles = queryOutputHandles();
+#endif
+
+	// filter all outputs by the handles
+	// (output queries are counted as the window round trips as well)
+	size_t numRoundTrips = 0;
+	vector<Output> l = queryOutputs(numRoundTrips);
+	_roundTripCount += numRoundTrips;
+	_globalRoundTripCount += numRoundTrips;
+	l.erase(
+		remove_if(l.begin(), l.end(),
+			[&handles](const Output& o) { return find(handles.begin(), handles.end(), o.handle) == handles.end(); }),
+		l.end());
+	return l;
+}
+
+
+#if !defined(USE_PLATFORM_WAYLAND) || defined(USE_PLATFORM_XLIB)
+
+void VulkanWindow::updateOutputs()
+{
+	// call the callback if the window outputs changed
+	vector<void*> handles = queryOutputHandles();
+	if(handles == _outputHandles)
+		return;
+	_outputHandles.swap(handles);
+	callOutputsChanged();
+}
+
+#endif
+
+
+void VulkanWindow::setPlaceholderColor(float r, float g, float b)
+{
+	auto toByte = [](float c) -> uint32_t { return uint32_t(clamp(c, 0.f, 1.f) * 255.f + 0.5f); };
+	_placeholderColor = 0xff000000 | (toByte(r) << 16) | (toByte(g) << 8) | toByte(b);
+}
+
+
+void VulkanWindow::updateWindowState(WindowState windowState)
+{
+	// update last known window state
+	// and call the callback on change
+	if(_windowState == windowState)
+		return;
+	_windowState = windowState;
+	if(hasWindowStateChangedHandler())
+		callWindowStateChanged(windowState);
 }
 
 
@@ -2385,8 +4654,8 @@ void VulkanWindow::show()
 {
 	// asserts for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
-	assert(_resizeCallback && "Resize callback must be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::mainLoop().");
-	assert(_frameCallback && "Frame callback need to be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::mainLoop().");
+	assert(hasResizeHandler() && "Resize callback must be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::mainLoop().");
+	assert(hasFrameHandler() && "Frame callback need to be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::mainLoop().");
 
 	// show window
 	ShowWindow(HWND(_win32.hwnd), SW_SHOW);
@@ -2409,7 +4678,21 @@ void VulkanWindow::mainLoop()
 	MSG msg;
 	BOOL r;
 	thrownException = nullptr;
-	while((r = GetMessage(&msg, NULL, 0, 0)) != 0) {
+	while(true) {
+
+		// wait for messages or for the time of the deferred frame
+		int64_t wakeUpTime = VulkanWindowPrivate::scheduleDeferredFrames();
+		if(wakeUpTime != -1 && !PeekMessage(&msg, NULL, 0, 0, PM_NOREMOVE)) {
+			HANDLE timer = armFrameTimer(wakeUpTime);
+			if(MsgWaitForMultipleObjects(1, &timer, FALSE, INFINITE, QS_ALLINPUT) == WAIT_FAILED)
+				throw runtime_error("MsgWaitForMultipleObjects(): The function failed.");
+			continue;
+		}
+
+		// get message
+		r = GetMessage(&msg, NULL, 0, 0);
+		if(r == 0)
+			break;
 
 		// handle errors
 		if(r == -1)
@@ -2448,8 +4731,8 @@ try
 				w->_mouseState.relY = y - w->_mouseState.posY;
 				w->_mouseState.posX = x;
 				w->_mouseState.posY = y;
-				if(w->_mouseMoveCallback)
-					w->_mouseMoveCallback(*w, w->_mouseState);
+				if(w->hasMouseMoveHandler())
+					w->callMouseMove(w->_mouseState);
 			}
 		};
 	auto handleMouseButton =
@@ -2471,8 +4754,8 @@ try
 				w->_mouseState.relY = y - w->_mouseState.posY;
 				w->_mouseState.posX = x;
 				w->_mouseState.posY = y;
-				if(w->_mouseMoveCallback)
-					w->_mouseMoveCallback(*w, w->_mouseState);
+				if(w->hasMouseMoveHandler())
+					w->callMouseMove(w->_mouseState);
 			}
 
 			// set new state and capture mouse
@@ -2487,8 +4770,8 @@ try
 			}
 
 			// callback
-			if(w->_mouseButtonCallback)
-				w->_mouseButtonCallback(*w, mouseButton, buttonState, w->_mouseState);
+			if(w->hasMouseButtonHandler())
+				w->callMouseButton(mouseButton, buttonState, w->_mouseState);
 
 			return 0;
 		};
@@ -2581,6 +4864,26 @@ try
 			}
 			handleModifiers(w, wParam);
 			handleMouseMove(w, float(GET_X_LPARAM(lParam)), float(GET_Y_LPARAM(lParam)));
+
+			// request WM_MOUSELEAVE
+			// (the request is one-shot and must be repeated after each WM_MOUSELEAVE)
+			if(!w->_win32.trackingMouseLeave) {
+				TRACKMOUSEEVENT t;
+				t.cbSize = sizeof(TRACKMOUSEEVENT);
+				t.dwFlags = TME_LEAVE;
+				t.hwndTrack = hwnd;
+				t.dwHoverTime = 0;
+				if(TrackMouseEvent(&t))
+					w->_win32.trackingMouseLeave = true;
+			}
+			return 0;
+		}
+
+		// mouse leave
+		case WM_MOUSELEAVE: {
+			VulkanWindowPrivate* w = reinterpret_cast<VulkanWindowPrivate*>(GetWindowLongPtr(hwnd, 0));
+			w->_win32.trackingMouseLeave = false;
+			w->updatePointerLeave();
 			return 0;
 		}
 
@@ -2651,8 +4954,8 @@ try
 			if(ScreenToClient(hwnd, &p) == 0)
 				thrownException = make_exception_ptr(runtime_error("ScreenToClient(): The function failed."));
 			handleMouseMove(w, float(p.x), float(p.y));
-			if(w->_mouseWheelCallback)
-				w->_mouseWheelCallback(*w, 0, float(GET_WHEEL_DELTA_WPARAM(wParam)) / 120.f, w->_mouseState);
+			if(w->hasMouseWheelHandler())
+				w->callMouseWheel(0, float(GET_WHEEL_DELTA_WPARAM(wParam)) / 120.f, w->_mouseState);
 			return 0;
 		}
 		case WM_MOUSEHWHEEL: {
@@ -2662,8 +4965,8 @@ try
 			if(ScreenToClient(hwnd, &p) == 0)
 				thrownException = make_exception_ptr(runtime_error("ScreenToClient(): The function failed."));
 			handleMouseMove(w, float(p.x), float(p.y));
-			if(w->_mouseWheelCallback)
-				w->_mouseWheelCallback(*w, float(GET_WHEEL_DELTA_WPARAM(wParam)) / 120.f, 0, w->_mouseState);
+			if(w->hasMouseWheelHandler())
+				w->callMouseWheel(float(GET_WHEEL_DELTA_WPARAM(wParam)) / 120.f, 0, w->_mouseState);
 			return 0;
 		}
 
@@ -2681,7 +4984,7 @@ try
 
 			// callback
 			VulkanWindowPrivate* w = reinterpret_cast<VulkanWindowPrivate*>(GetWindowLongPtr(hwnd, 0));
-			if(w->_keyCallback)
+			if(w->hasKeyHandler())
 			{
 				// scan code
 				unsigned nativeScanCode = (lParam >> 16) & 0x1ff;
@@ -2701,7 +5004,7 @@ try
 				}
 
 				// callback
-				w->_keyCallback(*w, KeyState::Pressed, scanCode, keyCode);
+				w->callKey(KeyState::Pressed, scanCode, keyCode);
 			}
 			return 0;
 		}
@@ -2709,7 +5012,7 @@ try
 		case WM_SYSKEYUP:  // LeftAlt, RightAlt and F10 come through WM_SYSKEYDOWN
 		{
 			VulkanWindowPrivate* w = reinterpret_cast<VulkanWindowPrivate*>(GetWindowLongPtr(hwnd, 0));
-			if(w->_keyCallback)
+			if(w->hasKeyHandler())
 			{
 				// scan code
 				unsigned nativeScanCode = (lParam >> 16) & 0x1ff;
@@ -2729,7 +5032,7 @@ try
 				}
 
 				// callback
-				w->_keyCallback(*w, KeyState::Released, scanCode, key);
+				w->callKey(KeyState::Released, scanCode, key);
 			}
 			return 0;
 		}
@@ -2745,10 +5048,36 @@ try
 		#ifdef VULKAN_WINDOW_DEBUG
 			cout << "WM_SIZE message (" << LOWORD(lParam) << "x" << HIWORD(lParam) << ")" << endl;
 		#endif
-			if(LOWORD(lParam) != 0 && HIWORD(lParam) != 0) {
-				VulkanWindowPrivate* w = reinterpret_cast<VulkanWindowPrivate*>(GetWindowLongPtr(hwnd, 0));
+			VulkanWindowPrivate* w = reinterpret_cast<VulkanWindowPrivate*>(GetWindowLongPtr(hwnd, 0));
+			if(LOWORD(lParam) != 0 && HIWORD(lParam) != 0)
 				w->scheduleResize();
-			}
+
+			// update window state
+			if(w->_win32.visible)
+				switch(wParam) {
+				case SIZE_MINIMIZED: w->updateWindowState(WindowState::Minimized); break;
+				case SIZE_MAXIMIZED: w->updateWindowState(WindowState::Maximized); break;
+				case SIZE_RESTORED:  w->updateWindowState(WindowState::Normal); break;
+				}
+			return DefWindowProcW(hwnd, msg, wParam, lParam);
+		}
+
+		// keyboard focus messages
+		case WM_SETFOCUS:
+		case WM_KILLFOCUS: {
+			VulkanWindowPrivate* w = reinterpret_cast<VulkanWindowPrivate*>(GetWindowLongPtr(hwnd, 0));
+			if(w)
+				w->updateFocus(msg == WM_SETFOCUS);
+			return DefWindowProcW(hwnd, msg, wParam, lParam);
+		}
+
+		// window move and display change messages
+		// (we check whether the window moved to another monitor)
+		case WM_MOVE:
+		case WM_DISPLAYCHANGE: {
+			VulkanWindowPrivate* w = reinterpret_cast<VulkanWindowPrivate*>(GetWindowLongPtr(hwnd, 0));
+			if(w && w->hasOutputsChangedHandler())
+				w->updateOutputs();
 			return DefWindowProcW(hwnd, msg, wParam, lParam);
 		}
 
@@ -2781,6 +5110,7 @@ try
 				}
 
 			}
+			w->updateWindowState(w->_win32.visible ? w->windowState() : WindowState::Hidden);
 			return DefWindowProcW(hwnd, msg, wParam, lParam);
 		}
 
@@ -2792,8 +5122,8 @@ try
 			cout << "WM_CLOSE message" << endl;
 		#endif
 			VulkanWindowPrivate* w = reinterpret_cast<VulkanWindowPrivate*>(GetWindowLongPtr(hwnd, 0));
-			if(w->_closeCallback)
-				w->_closeCallback(*w);  // VulkanWindow object might be already destroyed when returning from the callback
+			if(w->hasCloseHandler())
+				w->callClose();  // VulkanWindow object might be already destroyed when returning from the callback
 			else {
 				w->hide();
 				VulkanWindow::exitMainLoop();
@@ -2841,6 +5171,8 @@ void VulkanWindow::scheduleFrame()
 	// assert for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
 
+	_activity = true;  // for idle throttling
+
 	if(_win32.framePendingState == FramePendingState::Pending)
 		return;
 
@@ -2857,38 +5189,67 @@ void VulkanWindow::scheduleFrame()
 }
 
 
-#elif defined(USE_PLATFORM_XLIB)
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
 
+# if defined(USE_PLATFORM_XLIB)
 
+
+#  if defined(USE_PLATFORM_WAYLAND)
+bool VulkanWindow::xlibIsVisible() const
+#  else
 bool VulkanWindow::isVisible() const
+#  endif
 {
 	return _xlib.window && _xlib.visible;
 }
 
 
+#  if defined(USE_PLATFORM_WAYLAND)
+void VulkanWindow::xlibShow()
+#  else
 void VulkanWindow::show()
+#  endif
 {
 	// asserts for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
-	assert(_resizeCallback && "Resize callback must be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::mainLoop().");
-	assert(_frameCallback && "Frame callback need to be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::mainLoop().");
+	assert(hasResizeHandler() && "Resize callback must be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::mainLoop().");
+	assert(hasFrameHandler() && "Frame callback need to be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::mainLoop().");
 
 	if(_xlib.visible)
 		return;
 
+	// placeholder content
+	// (X server paints window background immediately on map, before the first frame is rendered;
+	// the pixel value is computed from the visual's color masks)
+	if(_placeholderColor != 0) {
+		Visual* v = DefaultVisual(_xlib.display, DefaultScreen(_xlib.display));
+		auto channel = [](uint32_t c, unsigned long mask) { return (unsigned long)(double(c) / 255. * double(mask)) & mask; };
+		XSetWindowBackground(_xlib.display, _xlib.window,
+			channel((_placeholderColor >> 16) & 0xff, v->red_mask) |
+			channel((_placeholderColor >> 8) & 0xff, v->green_mask) |
+			channel(_placeholderColor & 0xff, v->blue_mask));
+	}
+	else
+		XSetWindowBackgroundPixmap(_xlib.display, _xlib.window, None);
+
 	// show window
 	_xlib.visible = true;
 	_xlib.iconVisible = true;
 	_xlib.fullyObscured = false;
-	XMapWindow(xlib::display, _xlib.window);
+	XMapWindow(_xlib.display, _xlib.window);
 	if(_xlib.minimized)
-		XIconifyWindow(xlib::display, _xlib.window, XDefaultScreen(xlib::display));
+		XIconifyWindow(_xlib.display, _xlib.window, XDefaultScreen(_xlib.display));
 	else
 		scheduleFrame();
+	updateWindowState(_xlib.minimized ? WindowState::Minimized : WindowState::Normal);
 }
 
 
+#  if defined(USE_PLATFORM_WAYLAND)
+void VulkanWindow::xlibHide()
+#  else
 void VulkanWindow::hide()
+#  endif
 {
 	// assert for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
@@ -2904,12 +5265,13 @@ void VulkanWindow::hide()
 	updateMinimized();
 
 	// unmap window and hide taskbar icon
-	XWithdrawWindow(xlib::display, _xlib.window, XDefaultScreen(xlib::display));
+	XWithdrawWindow(_xlib.display, _xlib.window, XDefaultScreen(_xlib.display));
 
 	// delete all Expose events and cancel any pending frames
 	XEvent tmp;
-	while(XCheckTypedWindowEvent(xlib::display, _xlib.window, Expose, &tmp) == True);
+	while(XCheckTypedWindowEvent(_xlib.display, _xlib.window, Expose, &tmp) == True);
 	_xlib.framePending = false;
+	updateWindowState(WindowState::Hidden);
 }
 
 
@@ -2921,8 +5283,9 @@ void VulkanWindow::updateMinimized()
 	int actualFormat;
 	unsigned long itemsRead;
 	unsigned long bytesAfter;
+	countRoundTrip();
 	if(XGetWindowProperty(
-			xlib::display,  // display
+			_xlib.display,  // display
 			_xlib.window,  // window
 			xlib::wmStateProperty,  // property
 			0, 1,  // long_offset, long_length
@@ -2940,6 +5303,8 @@ void VulkanWindow::updateMinimized()
 	#endif
 		_xlib.minimized = *reinterpret_cast<unsigned*>(data) == 3;
 		XFree(data);
+		if(_xlib.iconVisible)
+			updateWindowState(_xlib.minimized ? WindowState::Minimized : WindowState::Normal);
 	}
 	#ifdef VULKAN_WINDOW_DEBUG
 	else
@@ -2948,7 +5313,11 @@ void VulkanWindow::updateMinimized()
 }
 
 
+#  if defined(USE_PLATFORM_WAYLAND)
+void VulkanWindow::xlibMainLoop()
+#  else
 void VulkanWindow::mainLoop()
+#  endif
 {
 	// mouse functions
 	auto handleModifiers =
@@ -2969,8 +5338,8 @@ void VulkanWindow::mainLoop()
 				w->_mouseState.relY = newY - w->_mouseState.posY;
 				w->_mouseState.posX = newX;
 				w->_mouseState.posY = newY;
-				if(w->_mouseMoveCallback)
-					w->_mouseMoveCallback(*w, w->_mouseState);
+				if(w->hasMouseMoveHandler())
+					w->callMouseMove(w->_mouseState);
 			}
 		};
 	auto getMouseButton =
@@ -2986,27 +5355,56 @@ void VulkanWindow::mainLoop()
 			}
 		};
 
+	// display connection
+	// (per-thread connection is used if initThread() was called on the current thread)
+	Display* display = xlib::threadDisplay ? xlib::threadDisplay : xlib::display;
+
 	// run Xlib event loop
 	XEvent e;
 	xlib::running = true;
 	while(xlib::running) {
 
+		// wait for events or for the time of the deferred frame
+		// (XPending() flushes the requests and checks the events already read into the queue
+		// that select() on the connection would not see)
+		int64_t wakeUpTime = VulkanWindowPrivate::scheduleDeferredFrames();
+		if(wakeUpTime != -1 && XPending(display) == 0) {
+			frameTimer.arm(wakeUpTime);
+			int fd = ConnectionNumber(display);
+			int timerFd = frameTimer.getFd();
+			fd_set fds;
+			FD_ZERO(&fds);
+			FD_SET(fd, &fds);
+			FD_SET(timerFd, &fds);
+			if(select(max(fd, timerFd) + 1, &fds, nullptr, nullptr, nullptr) == -1) {
+				if(errno != EINTR)
+					throw runtime_error("select() failed.");
+			}
+			else if(FD_ISSET(timerFd, &fds))
+				frameTimer.reset();
+			continue;
+		}
+
 		// get event
-		XNextEvent(xlib::display, &e);
+		XNextEvent(display, &e);
 
 		// get VulkanWindow
 		// (we use std::map because per-window data using XGetWindowProperty() would require X-server roundtrip)
-		auto it = xlib::vulkanWindowMap.find(e.xany.window);
-		if(it == xlib::vulkanWindowMap.end())
-			continue;
-		VulkanWindow* w = it->second;
+		VulkanWindow* w;
+		{
+			lock_guard<mutex> lock(xlib::vulkanWindowMapMutex);
+			auto it = xlib::vulkanWindowMap.find(e.xany.window);
+			if(it == xlib::vulkanWindowMap.end())
+				continue;
+			w = it->second;
+		}
 
 		// expose event
 		if(e.type == Expose)
 		{
 			// remove all other Expose events
 			XEvent tmp;
-			while(XCheckTypedWindowEvent(xlib::display, w->_xlib.window, Expose, &tmp) == True);
+			while(XCheckTypedWindowEvent(display, w->_xlib.window, Expose, &tmp) == True);
 
 			// perform rendering
 			w->_xlib.framePending = false;
@@ -3022,6 +5420,8 @@ void VulkanWindow::mainLoop()
 			#endif
 				w->scheduleResize();
 			}
+			if(w->hasOutputsChangedHandler())
+				w->updateOutputs();  // makes round trips, so it is done only when outputs changes are handled
 			continue;
 		}
 
@@ -3040,8 +5440,8 @@ void VulkanWindow::mainLoop()
 			if(e.xbutton.button < Button4 || e.xbutton.button > 7) {
 				MouseButton::EnumType button = getMouseButton(e.xbutton.button);
 				w->_mouseState.buttons.set(button, true);
-				if(w->_mouseButtonCallback)
-					w->_mouseButtonCallback(*w, button, ButtonState::Pressed, w->_mouseState);
+				if(w->hasMouseButtonHandler())
+					w->callMouseButton(button, ButtonState::Pressed, w->_mouseState);
 			}
 			else {
 				float wheelX, wheelY;
@@ -3053,8 +5453,8 @@ void VulkanWindow::mainLoop()
 					wheelX = (e.xbutton.button == 6) ? -1.f : 1.f;
 					wheelY = 0.f;
 				}
-				if(w->_mouseWheelCallback)
-					w->_mouseWheelCallback(*w, wheelX, wheelY, w->_mouseState);
+				if(w->hasMouseWheelHandler())
+					w->callMouseWheel(wheelX, wheelY, w->_mouseState);
 			}
 			continue;
 		}
@@ -3064,8 +5464,8 @@ void VulkanWindow::mainLoop()
 			if(e.xbutton.button < Button4 || e.xbutton.button > 7) {
 				MouseButton::EnumType button = getMouseButton(e.xbutton.button);
 				w->_mouseState.buttons.set(button, false);
-				if(w->_mouseButtonCallback)
-					w->_mouseButtonCallback(*w, button, ButtonState::Released, w->_mouseState);
+				if(w->hasMouseButtonHandler())
+					w->callMouseButton(button, ButtonState::Released, w->_mouseState);
 			}
 			continue;
 		}
@@ -3074,7 +5474,7 @@ void VulkanWindow::mainLoop()
 		if(e.type == KeyPress)
 		{
 			// callback
-			if(w->_keyCallback)
+			if(w->hasKeyHandler())
 			{
 				// get scan code
 				ScanCode scanCode = ScanCode(e.xkey.keycode - 8);
@@ -3088,29 +5488,30 @@ void VulkanWindow::mainLoop()
 				                  Mod4Mask |  // ignore WinKey  );
 				                  Mod5Mask);  // ignore unknown modifier
 				XLookupString(&e.xkey, nullptr, 0, &keySym, nullptr);
-				uint32_t codePoint = xkb_keysym_to_utf32(keySym);
+				loadXkbCommon();
+				uint32_t codePoint = xkbcommon::funcs.xkb_keysym_to_utf32(keySym);
 
 				// callback
-				w->_keyCallback(*w, KeyState::Pressed, scanCode, KeyCode(codePoint));
+				w->callKey(KeyState::Pressed, scanCode, KeyCode(codePoint));
 			}
 			continue;
 		}
 		if(e.type == KeyRelease)
 		{
 			// skip auto-repeat key events
-			if(XEventsQueued(xlib::display, QueuedAfterReading)) {
+			if(XEventsQueued(display, QueuedAfterReading)) {
 				XEvent nextEvent;
-				XPeekEvent(xlib::display, &nextEvent);
+				XPeekEvent(display, &nextEvent);
 				if(nextEvent.type == KeyPress && nextEvent.xkey.time == e.xkey.time &&
 				   nextEvent.xkey.keycode == e.xkey.keycode)
 				{
-					XNextEvent(xlib::display, &nextEvent);
+					XNextEvent(display, &nextEvent);
 					continue;
 				}
 			}
 
 			// callback
-			if(w->_keyCallback)
+			if(w->hasKeyHandler())
 			{
 				// get scan code
 				ScanCode scanCode = ScanCode(e.xkey.keycode - 8);
@@ -3124,14 +5525,29 @@ void VulkanWindow::mainLoop()
 				                  Mod4Mask |  // ignore WinKey  );
 				                  Mod5Mask);  // ignore unknown modifier
 				XLookupString(&e.xkey, nullptr, 0, &keySym, nullptr);
-				uint32_t codePoint = xkb_keysym_to_utf32(keySym);
+				loadXkbCommon();
+				uint32_t codePoint = xkbcommon::funcs.xkb_keysym_to_utf32(keySym);
 
 				// callback
-				w->_keyCallback(*w, KeyState::Released, scanCode, KeyCode(codePoint));
+				w->callKey(KeyState::Released, scanCode, KeyCode(codePoint));
 			}
 			continue;
 		}
 
+		// keyboard focus
+		// (focus changes caused by keyboard grabs are ignored)
+		if(e.type == FocusIn || e.type == FocusOut) {
+			if(e.xfocus.mode != NotifyGrab && e.xfocus.mode != NotifyUngrab)
+				w->updateFocus(e.type == FocusIn);
+			continue;
+		}
+
+		// pointer leave
+		if(e.type == LeaveNotify) {
+			w->updatePointerLeave();
+			continue;
+		}
+
 		// map, unmap, obscured, unobscured
 		if(e.type == MapNotify)
 		{
@@ -3156,7 +5572,7 @@ void VulkanWindow::mainLoop()
 			w->_xlib.fullyObscured = true;
 
 			XEvent tmp;
-			while(XCheckTypedWindowEvent(xlib::display, w->_xlib.window, Expose, &tmp) == True);
+			while(XCheckTypedWindowEvent(display, w->_xlib.window, Expose, &tmp) == True);
 			w->_xlib.framePending = false;
 			continue;
 		}
@@ -3176,7 +5592,7 @@ void VulkanWindow::mainLoop()
 			#endif
 				w->_xlib.fullyObscured = true;
 				XEvent tmp;
-				while(XCheckTypedWindowEvent(xlib::display, w->_xlib.window, Expose, &tmp) == True);
+				while(XCheckTypedWindowEvent(display, w->_xlib.window, Expose, &tmp) == True);
 				w->_xlib.framePending = false;
 				continue;
 			}
@@ -3191,8 +5607,8 @@ void VulkanWindow::mainLoop()
 
 		// handle window close
 		if(e.type==ClientMessage && ulong(e.xclient.data.l[0])==xlib::wmDeleteMessage) {
-			if(w->_closeCallback)
-				w->_closeCallback(*w);  // VulkanWindow object might be already destroyed when returning from the callback
+			if(w->hasCloseHandler())
+				w->callClose();  // VulkanWindow object might be already destroyed when returning from the callback
 			else {
 				w->hide();
 				VulkanWindow::exitMainLoop();
@@ -3203,24 +5619,34 @@ void VulkanWindow::mainLoop()
 }
 
 
+#  if defined(USE_PLATFORM_WAYLAND)
+void VulkanWindow::xlibExitMainLoop()
+#  else
 void VulkanWindow::exitMainLoop()
+#  endif
 {
 	xlib::running = false;
 }
 
 
+#  if defined(USE_PLATFORM_WAYLAND)
+void VulkanWindow::xlibScheduleFrame()
+#  else
 void VulkanWindow::scheduleFrame()
+#  endif
 {
 	// assert for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
 
+	_activity = true;  // for idle throttling
+
 	if(_xlib.framePending || !_xlib.visible || _xlib.fullyObscured)
 		return;
 
 	_xlib.framePending = true;
 
 	XSendEvent(
-		xlib::display,  // display
+		_xlib.display,  // display
 		_xlib.window,  // w
 		False,  // propagate
 		ExposureMask,  // event_mask
@@ -3229,7 +5655,7 @@ void VulkanWindow::scheduleFrame()
 				Expose,  // type
 				0,  // serial
 				True,  // send_event
-				xlib::display,  // display
+				_xlib.display,  // display
 				_xlib.window,  // window
 				0, 0,  // x, y
 				0, 0,  // width, height
@@ -3238,18 +5664,28 @@ void VulkanWindow::scheduleFrame()
 	);
 }
 
-
-#elif defined(USE_PLATFORM_WAYLAND)
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
 
 
 bool VulkanWindow::isVisible() const
 {
+#  if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected())
+		return xlibIsVisible();
+#  endif
 	return _wayland.wlSurface && (_wayland.xdgSurface || _wayland.libdecorFrame);
 }
 
 
 void VulkanWindow::show()
 {
+#  if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		xlibShow();
+		return;
+	}
+#  endif
 	show([](VulkanWindow&){}, [](VulkanWindow&){});
 }
 
@@ -3258,8 +5694,8 @@ void VulkanWindow::show(void (*xdgConfigFunc)(VulkanWindow&), void (*libdecorCon
 {
 	// asserts for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
-	assert(_resizeCallback && "Resize callback must be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::mainLoop().");
-	assert(_frameCallback && "Frame callback need to be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::mainLoop().");
+	assert(hasResizeHandler() && "Resize callback must be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::mainLoop().");
+	assert(hasFrameHandler() && "Frame callback need to be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::mainLoop().");
 
 	// check for already shown window
 	if(_wayland.xdgSurface || _wayland.libdecorFrame)
@@ -3281,7 +5717,14 @@ void VulkanWindow::show(void (*xdgConfigFunc)(VulkanWindow&), void (*libdecorCon
 	{
 
 		// create xdg surface
-		_wayland.xdgSurface = xdg_wm_base_get_xdg_surface(wayland::xdgWmBase, _wayland.wlSurface);
+		// (xdgWmBase lives on seatQueue, so xdg surface is created through a wrapper
+		// assigned to the window's queue; this way, no event can reach the surface on seatQueue)
+		xdg_wm_base* xdgWmBaseWrapper = static_cast<xdg_wm_base*>(wl_proxy_create_wrapper(wayland::xdgWmBase));
+		if(xdgWmBaseWrapper == nullptr)
+			throw runtime_error("wl_proxy_create_wrapper() failed.");
+		wl_proxy_set_queue(reinterpret_cast<wl_proxy*>(xdgWmBaseWrapper), _wayland.eventQueue);
+		_wayland.xdgSurface = xdg_wm_base_get_xdg_surface(xdgWmBaseWrapper, _wayland.wlSurface);
+		wl_proxy_wrapper_destroy(xdgWmBaseWrapper);
 		if(_wayland.xdgSurface == nullptr)
 			throw runtime_error("xdg_wm_base_get_xdg_surface() failed.");
 		if(xdg_surface_add_listener(_wayland.xdgSurface, &xdgSurfaceListener, this))
@@ -3304,11 +5747,12 @@ void VulkanWindow::show(void (*xdgConfigFunc)(VulkanWindow&), void (*libdecorCon
 	}
 
 	// send callback
-	wl_callback* callback = wl_display_sync(wayland::display);
+	wl_callback* callback = wl_display_sync(_wayland.displayWrapper ? _wayland.displayWrapper : wayland::display);
 	if(wl_callback_add_listener(callback, &syncListener, this))
 		throw runtime_error("wl_callback_add_listener() failed.");
 	_wayland.numSyncEventsOnTheFly++;
-	wl_display_flush(wayland::display);
+	if(!deferFlush)
+		wl_display_flush(wayland::display);
 
 	_wayland.forcedFrame = true;
 	_resizePending = true;
@@ -3337,11 +5781,11 @@ void VulkanWindowPrivate::xdgToplevelListenerConfigure(void* data, xdg_toplevel*
 		}
 	}
 	if(fullscreen)
-		w->_wayland.windowState = WindowState::FullScreen;
+		w->updateWindowState(WindowState::FullScreen);
 	else if(maximized)
-		w->_wayland.windowState = WindowState::Maximized;
+		w->updateWindowState(WindowState::Maximized);
 	else
-		w->_wayland.windowState = WindowState::Normal;
+		w->updateWindowState(WindowState::Normal);
 
 	// if width or height of the window changed,
 	// schedule swapchain resize and force new frame rendering
@@ -3359,24 +5803,89 @@ void VulkanWindowPrivate::xdgToplevelListenerConfigure(void* data, xdg_toplevel*
 }
 
 
-void VulkanWindowPrivate::xdgSurfaceListenerConfigure(void* data, xdg_surface* xdgSurface, uint32_t serial)
+void VulkanWindowPrivate::xdgToplevelListenerConfigureBounds(void* data, xdg_toplevel* toplevel, int32_t width, int32_t height)
 {
 #ifdef VULKAN_WINDOW_DEBUG
-	cout << "surface configure" << endl;
+	cout << "toplevel configure bounds (width=" << width << ", height=" << height << ")" << endl;
 #endif
-	VulkanWindowPrivate* w = static_cast<VulkanWindowPrivate*>(data);
-	xdg_surface_ack_configure(xdgSurface, serial);
-	wl_surface_commit(w->_wayland.wlSurface);
 
-	// we need to explicitly generate the first frame
-	// otherwise the window is not shown
-	// and no frame callbacks will be delivered through _frameListener
-	if(w->_wayland.forcedFrame) {
-		w->_wayland.forcedFrame = false;
-		w->renderFrame();
+	// make the window fit into the bounds
+	// (the bounds are sent before the configure event, so the first swapchain is created with the final size;
+	// zero width or height means unknown bounds)
+	VulkanWindowPrivate* w = static_cast<VulkanWindowPrivate*>(data);
+	if(width > 0 && w->_surfaceWidth > uint32_t(width)) {
+		w->_surfaceWidth = width;
+		w->scheduleResize();
 	}
-}
-
+	if(height > 0 && w->_surfaceHeight > uint32_t(height)) {
+		w->_surfaceHeight = height;
+		w->scheduleResize();
+	}
+}
+
+
+void VulkanWindowPrivate::placeholderBufferListenerRelease(void* data, wl_buffer* buffer)
+{
+	// placeholder buffer was replaced by the first presented frame
+	VulkanWindowPrivate* w = static_cast<VulkanWindowPrivate*>(data);
+	assert(w->_wayland.placeholderBuffer == buffer && "VulkanWindow: Released placeholder buffer is not owned by the window.");
+	wl_buffer_destroy(buffer);
+	w->_wayland.placeholderBuffer = nullptr;
+}
+
+
+void VulkanWindowPrivate::xdgSurfaceListenerConfigure(void* data, xdg_surface* xdgSurface, uint32_t serial)
+{
+#ifdef VULKAN_WINDOW_DEBUG
+	cout << "surface configure" << endl;
+#endif
+	VulkanWindowPrivate* w = static_cast<VulkanWindowPrivate*>(data);
+	xdg_surface_ack_configure(xdgSurface, serial);
+
+	// show placeholder content before the first frame
+	// (single pixel buffer is scaled to the window size by the viewport;
+	// the viewport is destroyed immediately, so the scaling is removed
+	// by the next commit that is done by the first Vulkan present)
+	if(w->_wayland.forcedFrame && w->_placeholderColor != 0 &&
+	   wayland::singlePixelBufferManager && wayland::viewporter &&
+	   w->_surfaceWidth != 0 && w->_surfaceHeight != 0)
+	{
+		// (the buffer is owned by the window; it is destroyed
+		// either on release or in destroy())
+		if(w->_wayland.placeholderBuffer)
+			wl_buffer_destroy(w->_wayland.placeholderBuffer);
+		auto channel = [](uint32_t c) -> uint32_t { return c * 0x01010101; };  // scales 8-bit value to 32-bit range
+		wl_buffer* buffer =
+			wp_single_pixel_buffer_manager_v1_create_u32_rgba_buffer(
+				wayland::singlePixelBufferManager,
+				channel((w->_placeholderColor >> 16) & 0xff),
+				channel((w->_placeholderColor >> 8) & 0xff),
+				channel(w->_placeholderColor & 0xff),
+				0xffffffff);
+		if(w->_wayland.eventQueue)
+			wl_proxy_set_queue(reinterpret_cast<wl_proxy*>(buffer), w->_wayland.eventQueue);
+		wl_buffer_add_listener(buffer, &placeholderBufferListener, w);
+		w->_wayland.placeholderBuffer = buffer;
+		wp_viewport* viewport = wp_viewporter_get_viewport(wayland::viewporter, w->_wayland.wlSurface);
+		wp_viewport_set_destination(viewport, int32_t(w->_surfaceWidth), int32_t(w->_surfaceHeight));
+		wl_surface_attach(w->_wayland.wlSurface, buffer, 0, 0);
+		wl_surface_damage(w->_wayland.wlSurface, 0, 0, INT32_MAX, INT32_MAX);
+		wl_surface_commit(w->_wayland.wlSurface);
+		wp_viewport_destroy(viewport);
+		wl_display_flush(wayland::display);
+	}
+	else
+		wl_surface_commit(w->_wayland.wlSurface);
+
+	// we need to explicitly generate the first frame
+	// otherwise the window is not shown
+	// and no frame callbacks will be delivered through _frameListener
+	if(w->_wayland.forcedFrame) {
+		w->_wayland.forcedFrame = false;
+		w->renderFrame();
+	}
+}
+
 
 void VulkanWindowPrivate::libdecorFrameConfigure(libdecor_frame* frame, libdecor_configuration* config, void* data)
 {
@@ -3386,11 +5895,11 @@ void VulkanWindowPrivate::libdecorFrameConfigure(libdecor_frame* frame, libdecor
 	libdecor_window_state s;
 	if(wayland::funcs.libdecor_configuration_get_window_state(config, &s)) {
 		if(s & LIBDECOR_WINDOW_STATE_FULLSCREEN)
-			w->_wayland.windowState = WindowState::FullScreen;
+			w->updateWindowState(WindowState::FullScreen);
 		else if(s & LIBDECOR_WINDOW_STATE_MAXIMIZED)
-			w->_wayland.windowState = WindowState::Maximized;
+			w->updateWindowState(WindowState::Maximized);
 		else
-			w->_wayland.windowState = WindowState::Normal;
+			w->updateWindowState(WindowState::Normal);
 	}
 	else
 		throw runtime_error("libdecor_configuration_get_window_state() failed.");
@@ -3454,8 +5963,8 @@ void VulkanWindowPrivate::libdecorFrameDismissPopup(libdecor_frame* frame, const
 void VulkanWindowPrivate::xdgToplevelListenerClose(void* data, xdg_toplevel* xdgTopLevel)
 {
 	VulkanWindowPrivate* w = static_cast<VulkanWindowPrivate*>(data);
-	if(w->_closeCallback)
-		w->_closeCallback(*w);  // VulkanWindow object might be already destroyed when returning from the callback
+	if(w->hasCloseHandler())
+		w->callClose();  // VulkanWindow object might be already destroyed when returning from the callback
 	else {
 		w->hide();
 		VulkanWindow::exitMainLoop();
@@ -3463,15 +5972,15 @@ void VulkanWindowPrivate::xdgToplevelListenerClose(void* data, xdg_toplevel* xdg
 
 	// update window state
 	if(w->_wayland.xdgTopLevel == nullptr)
-		w->_wayland.windowState = WindowState::Hidden;
+		w->updateWindowState(WindowState::Hidden);
 }
 
 
 void VulkanWindowPrivate::libdecorFrameClose(libdecor_frame* frame, void* data)
 {
 	VulkanWindowPrivate* w = static_cast<VulkanWindowPrivate*>(data);
-	if(w->_closeCallback)
-		w->_closeCallback(*w);  // VulkanWindow object might be already destroyed when returning from the callback
+	if(w->hasCloseHandler())
+		w->callClose();  // VulkanWindow object might be already destroyed when returning from the callback
 	else {
 		w->hide();
 		VulkanWindow::exitMainLoop();
@@ -3479,12 +5988,18 @@ void VulkanWindowPrivate::libdecorFrameClose(libdecor_frame* frame, void* data)
 
 	// update window state
 	if(w->_wayland.libdecorFrame == nullptr)
-		w->_wayland.windowState = WindowState::Hidden;
+		w->updateWindowState(WindowState::Hidden);
 }
 
 
 void VulkanWindow::hide()
 {
+#  if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		xlibHide();
+		return;
+	}
+#  endif
 	// assert for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
 
@@ -3515,12 +6030,68 @@ void VulkanWindow::hide()
 		wl_surface_attach(_wayland.wlSurface, nullptr, 0, 0);
 		wl_surface_commit(_wayland.wlSurface);
 	}
-	_wayland.windowState = WindowState::Hidden;
+	updateWindowState(WindowState::Hidden);
+}
+
+
+// dispatch seatQueue
+// (any thread might do it; if another thread is dispatching it already,
+// seatQueuePending makes that thread dispatch the newly read events as well)
+static void dispatchSeatQueue()
+{
+	wayland::seatQueuePending = true;
+	while(wayland::seatQueuePending) {
+		unique_lock<mutex> lock(wayland::seatQueueMutex, try_to_lock);
+		if(!lock.owns_lock())
+			return;
+		wayland::seatQueuePending = false;
+		if(wl_display_dispatch_queue_pending(wayland::display, wayland::seatQueue) == -1)
+			throw runtime_error("wl_display_dispatch_queue_pending() failed.");
+	}
+}
+
+
+// forward input event to the thread owning the window
+// (it is called by seatQueue listeners with inputMutex locked)
+void VulkanWindowPrivate::postInputEvent(const InputEvent& e)
+{
+	WaylandInputBuffer& b = *e.window->_wayland.inputBuffer;
+	{
+		lock_guard<mutex> lock(b.eventsMutex);
+		b.events.push_back(e);
+	}
+	uint64_t one = 1;
+	if(write(b.wakeFd, &one, sizeof(one)) == -1 && errno != EAGAIN)
+		throw runtime_error("write() to eventfd failed.");
+}
+
+
+// process input events forwarded to the current thread
+// (no lock is held while the callbacks are called, so they might create or destroy windows)
+static void processInputEvents(WaylandInputBuffer& b)
+{
+	while(true) {
+		VulkanWindowPrivate::InputEvent e;
+		{
+			lock_guard<mutex> lock(b.eventsMutex);
+			if(b.events.empty())
+				return;
+			e = b.events.front();
+			b.events.pop_front();
+		}
+		VulkanWindowPrivate::processInputEvent(e);
+	}
 }
 
 
 void VulkanWindow::mainLoop()
 {
+#  if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		xlibMainLoop();
+		return;
+	}
+#  endif
 	// flush outgoing buffers
 #ifdef VULKAN_WINDOW_DEBUG
 	cout << "Entering main loop." << endl;
@@ -3528,21 +6099,113 @@ void VulkanWindow::mainLoop()
 	if(wl_display_flush(wayland::display) == -1)
 		throw runtime_error("wl_display_flush() failed.");
 
+	// file descriptors to wait on
+	// (libdecor plugin might use its own file descriptor in addition to the Wayland display one;
+	// per-thread loop dispatches only the events of the windows created on the current thread;
+	// wake fd signals input events forwarded to the current thread)
+	wl_event_queue* queue = wayland::threadQueue;
+	WaylandInputBuffer& inputBuffer = queue ? *wayland::threadInputBuffer : wayland::mainInputBuffer;
+	pollfd fds[4] = {};
+	fds[0] = { wl_display_get_fd(wayland::display), POLLIN, 0 };
+	fds[1] = { inputBuffer.wakeFd, POLLIN, 0 };
+	fds[2] = { frameTimer.getFd(), POLLIN, 0 };
+	nfds_t numFds = 3;
+	if(wayland::libdecorContext && !queue) {
+		int libdecorFd = wayland::funcs.libdecor_get_fd(wayland::libdecorContext);
+		if(libdecorFd >= 0 && libdecorFd != fds[0].fd) {
+			fds[3] = { libdecorFd, POLLIN, 0 };
+			numFds = 4;
+		}
+	}
+
 	// main loop
+	// (single readiness-driven loop: whatever becomes ready, Wayland display, forwarded input or libdecor,
+	// is dispatched immediately without blocking on the other one)
 	wayland::running = true;
 	while(wayland::running) {
 
-		// dispatch libdecor events
-		if(wayland::libdecorContext)
-			wayland::funcs.libdecor_dispatch(wayland::libdecorContext, -1);
+		// dispatch input
+		// (events might have been read outside of the main loop, for instance by waitAllSyncEvents())
+		dispatchSeatQueue();
+		processInputEvents(inputBuffer);
+		if(!wayland::running)
+			break;
 
-		// dispatch Wayland events
-		if(wl_display_dispatch(wayland::display) == -1)  // it blocks if there are no events
-			throw runtime_error("wl_display_dispatch() failed.");
+		// schedule deferred frames whose time came
+		// and arm the frame timer for the next one
+		frameTimer.arm(VulkanWindowPrivate::scheduleDeferredFrames());
+
+		// prepare for reading
+		// (events already in the queue must be dispatched first)
+		if(queue) {
+			while(wl_display_prepare_read_queue(wayland::display, queue) != 0)
+				if(wl_display_dispatch_queue_pending(wayland::display, queue) == -1)
+					throw runtime_error("wl_display_dispatch_queue_pending() failed.");
+		}
+		else
+			while(wl_display_prepare_read(wayland::display) != 0)
+				if(wl_display_dispatch_pending(wayland::display) == -1)
+					throw runtime_error("wl_display_dispatch_pending() failed.");
 
 		// flush outgoing buffers
-		if(wl_display_flush(wayland::display) == -1)
-			throw runtime_error("wl_display_flush() failed.");
+		// (if the socket buffer is full, wait until the display fd becomes writable
+		// and flush the rest in the next iteration)
+		if(wl_display_flush(wayland::display) == -1) {
+			if(errno != EAGAIN) {
+				wl_display_cancel_read(wayland::display);
+				throw runtime_error("wl_display_flush() failed.");
+			}
+			fds[0].events = POLLIN | POLLOUT;
+		}
+		else
+			fds[0].events = POLLIN;
+
+		// wait for events or for the time of the deferred frame
+		if(poll(fds, numFds, -1) == -1) {
+			wl_display_cancel_read(wayland::display);
+			if(errno == EINTR)
+				continue;
+			throw runtime_error("poll() failed.");
+		}
+
+		// read events
+		// (events of the other queues are read as well and delivered to their queues)
+		if(fds[0].revents & POLLIN) {
+			if(wl_display_read_events(wayland::display) == -1)
+				throw runtime_error("wl_display_read_events() failed.");
+		}
+		else {
+			wl_display_cancel_read(wayland::display);
+			if(fds[0].revents & (POLLERR | POLLHUP))
+				throw runtime_error("Wayland display connection lost.");
+		}
+
+		// reset wake fd
+		if(fds[1].revents & POLLIN) {
+			uint64_t counter;
+			if(read(inputBuffer.wakeFd, &counter, sizeof(counter)) == -1 && errno != EAGAIN)
+				throw runtime_error("read() from eventfd failed.");
+		}
+
+		// reset frame timer
+		if(fds[2].revents & POLLIN)
+			frameTimer.reset();
+
+		// dispatch Wayland events
+		dispatchSeatQueue();
+		if(queue) {
+			if(wl_display_dispatch_queue_pending(wayland::display, queue) == -1)
+				throw runtime_error("wl_display_dispatch_queue_pending() failed.");
+		}
+		else
+			if(wl_display_dispatch_pending(wayland::display) == -1)
+				throw runtime_error("wl_display_dispatch_pending() failed.");
+
+		// dispatch libdecor events
+		// (zero timeout makes it non-blocking; it processes plugin events that are already available)
+		if(wayland::libdecorContext && !queue)
+			if(wayland::funcs.libdecor_dispatch(wayland::libdecorContext, 0) < 0)
+				throw runtime_error("libdecor_dispatch() failed.");
 
 	}
 #ifdef VULKAN_WINDOW_DEBUG
@@ -3553,15 +6216,29 @@ void VulkanWindow::mainLoop()
 
 void VulkanWindow::exitMainLoop()
 {
+#  if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		xlibExitMainLoop();
+		return;
+	}
+#  endif
 	wayland::running = false;
 }
 
 
 void VulkanWindow::scheduleFrame()
 {
+#  if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		xlibScheduleFrame();
+		return;
+	}
+#  endif
 	// assert for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
 
+	_activity = true;  // for idle throttling
+
 	if(_wayland.scheduledFrameCallback)
 		return;
 
@@ -3615,6 +6292,53 @@ void VulkanWindowPrivate::seatListenerCapabilities(void* data, wl_seat* seat, ui
 }
 
 
+void VulkanWindowPrivate::loadCursor()
+{
+	auto t = chrono::steady_clock::now();
+
+	// cursor size
+	const char* cursorSizeString = getenv("XCURSOR_SIZE");
+	char* endp = nullptr;
+	int cursorSize = 0;
+	if(cursorSizeString) {
+		auto cursorSizeLong = strtol(cursorSizeString, &endp, 10);
+		if(endp-cursorSizeString == ptrdiff_t(strlen(cursorSizeString)) &&
+		   cursorSizeLong > 0 && cursorSizeLong <= INT_MAX)
+		{
+			cursorSize = int(cursorSizeLong);
+		}
+	}
+	if(cursorSize == 0)
+		cursorSize = 24;
+
+	// cursor theme name
+	const char* cursorThemeName = getenv("XCURSOR_THEME");
+
+	// load cursor theme
+	wayland::cursorTheme = wl_cursor_theme_load(cursorThemeName, cursorSize, wayland::shm);
+	if(wayland::cursorTheme == nullptr)
+		throw runtime_error("Failed to load default cursor theme.");
+
+	// cursor surface
+	// (we need cursor for VulkanWindow, otherwise no cursor might be shown inside the window)
+	wayland::cursorSurface = wl_compositor_create_surface(wayland::compositor);
+	if(!wayland::cursorSurface)
+		throw runtime_error("wl_compositor_create_surface() failed to create cursor surface.");
+	wl_cursor* cursor = wl_cursor_theme_get_cursor(wayland::cursorTheme, "left_ptr");
+	if(!cursor)
+		throw runtime_error("Cursor error: Cannot load \"left_ptr\" cursor.");
+	wl_cursor_image* cursorImage = cursor->images[0];
+	wayland::cursorHotspotX = cursorImage->hotspot_x;
+	wayland::cursorHotspotY = cursorImage->hotspot_y;
+	wl_buffer* cursorBuffer = wl_cursor_image_get_buffer(cursorImage);
+	if(!cursorBuffer)
+		throw runtime_error("wl_cursor_image_get_buffer() failed.");
+	wl_surface_attach(wayland::cursorSurface, cursorBuffer, 0, 0);
+	wl_surface_commit(wayland::cursorSurface);
+	_startupTimes.cursorThemeLoad = secondsSince(t);
+}
+
+
 void VulkanWindowPrivate::pointerListenerEnter(void* data, wl_pointer* pointer, uint32_t serial,
                                                wl_surface* surface, wl_fixed_t surface_x, wl_fixed_t surface_y)
 {
@@ -3623,31 +6347,43 @@ void VulkanWindowPrivate::pointerListenerEnter(void* data, wl_pointer* pointer,
 	if(wl_proxy_get_tag(reinterpret_cast<wl_proxy*>(surface)) != &wayland::vulkanWindowTag)
 		return;
 
+	// load cursor on the first pointer enter
+	if(wayland::cursorSurface == nullptr)
+		loadCursor();
+
 	// set cursor
 	wl_pointer_set_cursor(pointer, serial, wayland::cursorSurface, wayland::cursorHotspotX, wayland::cursorHotspotY);
 
 	// get window pointer
+	// (input events are dispatched on seatQueue by any thread, so windowUnderPointer and windowWithKbFocus
+	// are protected by inputMutex; the events are processed by the thread owning the window)
+	lock_guard<mutex> lock(wayland::inputMutex);
 	wayland::windowUnderPointer = static_cast<VulkanWindowPrivate*>(wl_surface_get_user_data(surface));
 	assert(wayland::windowUnderPointer && "wl_surface userData does not contain pointer to VulkanWindow.");
 
-	// update mouse state
-	float x = float(wl_fixed_to_double(surface_x));
-	float y = float(wl_fixed_to_double(surface_y));
-	if(wayland::windowUnderPointer->_mouseState.posX != x ||
-	   wayland::windowUnderPointer->_mouseState.posY != y)
-	{
-		wayland::windowUnderPointer->_mouseState.relX = 0;
-		wayland::windowUnderPointer->_mouseState.relY = 0;
-		wayland::windowUnderPointer->_mouseState.posX = x;
-		wayland::windowUnderPointer->_mouseState.posY = y;
-		if(wayland::windowUnderPointer->_mouseMoveCallback)
-			wayland::windowUnderPointer->_mouseMoveCallback(*wayland::windowUnderPointer, wayland::windowUnderPointer->_mouseState);
-	}
+	// forward event
+	InputEvent e;
+	e.type = InputEvent::Type::PointerEnter;
+	e.window = wayland::windowUnderPointer;
+	e.modifiers = wayland::modifiers;
+	e.x = float(wl_fixed_to_double(surface_x));
+	e.y = float(wl_fixed_to_double(surface_y));
+	postInputEvent(e);
 }
 
 
 void VulkanWindowPrivate::pointerListenerLeave(void* data, wl_pointer* pointer, uint32_t serial, wl_surface* surface)
 {
+	// handle unknown window
+	lock_guard<mutex> lock(wayland::inputMutex);
+	if(wayland::windowUnderPointer == nullptr)
+		return;
+
+	// forward event
+	InputEvent e;
+	e.type = InputEvent::Type::PointerLeave;
+	e.window = wayland::windowUnderPointer;
+	postInputEvent(e);
 	wayland::windowUnderPointer = nullptr;
 }
 
@@ -3655,74 +6391,63 @@ void VulkanWindowPrivate::pointerListenerLeave(void* data, wl_pointer* pointer,
 void VulkanWindowPrivate::pointerListenerMotion(void* data, wl_pointer* pointer, uint32_t time, wl_fixed_t surface_x, wl_fixed_t surface_y)
 {
 	// handle unknown window
+	lock_guard<mutex> lock(wayland::inputMutex);
 	if(wayland::windowUnderPointer == nullptr)
 		return;
 
-	float x = float(wl_fixed_to_double(surface_x));
-	float y = float(wl_fixed_to_double(surface_y));
-	if(wayland::windowUnderPointer->_mouseState.posX != x ||
-	   wayland::windowUnderPointer->_mouseState.posY != y)
-	{
-		wayland::windowUnderPointer->_mouseState.relX = x - wayland::windowUnderPointer->_mouseState.posX;
-		wayland::windowUnderPointer->_mouseState.relY = y - wayland::windowUnderPointer->_mouseState.posY;
-		wayland::windowUnderPointer->_mouseState.posX = x;
-		wayland::windowUnderPointer->_mouseState.posY = y;
-		if(wayland::windowUnderPointer->_mouseMoveCallback) {
-			wayland::windowUnderPointer->_mouseState.modifiers = wayland::modifiers;
-			wayland::windowUnderPointer->_mouseMoveCallback(*wayland::windowUnderPointer, wayland::windowUnderPointer->_mouseState);
-		}
-	}
+	// forward event
+	InputEvent e;
+	e.type = InputEvent::Type::PointerMotion;
+	e.window = wayland::windowUnderPointer;
+	e.modifiers = wayland::modifiers;
+	e.x = float(wl_fixed_to_double(surface_x));
+	e.y = float(wl_fixed_to_double(surface_y));
+	postInputEvent(e);
 }
 
 
 void VulkanWindowPrivate::pointerListenerButton(void* data, wl_pointer* pointer, uint32_t serial, uint32_t time, uint32_t button, uint32_t state)
 {
 	// handle unknown window
+	lock_guard<mutex> lock(wayland::inputMutex);
 	if(wayland::windowUnderPointer == nullptr)
 		return;
 
-	MouseButton::EnumType index;
-	switch(button) {
-	// button codes taken from linux/input-event-codes.h
-	case 0x110: index = MouseButton::Left; break;
-	case 0x111: index = MouseButton::Right; break;
-	case 0x112: index = MouseButton::Middle; break;
-	case 0x113: index = MouseButton::X1; break;
-	case 0x114: index = MouseButton::X2; break;
-	default: index = MouseButton::Unknown;
-	}
-	wayland::windowUnderPointer->_mouseState.buttons.set(index, state == WL_POINTER_BUTTON_STATE_PRESSED);
-	if(wayland::windowUnderPointer->_mouseButtonCallback) {
-		wayland::windowUnderPointer->_mouseState.modifiers = wayland::modifiers;
-		ButtonState buttonState =
-			(state == WL_POINTER_BUTTON_STATE_PRESSED) ? ButtonState::Pressed : ButtonState::Released;
-		wayland::windowUnderPointer->_mouseButtonCallback(
-			*wayland::windowUnderPointer, index, buttonState, wayland::windowUnderPointer->_mouseState);
-	}
+	// forward event
+	InputEvent e;
+	e.type = InputEvent::Type::PointerButton;
+	e.pressed = (state == WL_POINTER_BUTTON_STATE_PRESSED);
+	e.window = wayland::windowUnderPointer;
+	e.modifiers = wayland::modifiers;
+	e.code = button;
+	postInputEvent(e);
 }
 
 
 void VulkanWindowPrivate::pointerListenerAxis(void* data, wl_pointer* pointer, uint32_t time, uint32_t axis, wl_fixed_t value)
 {
 	// handle unknown window
+	lock_guard<mutex> lock(wayland::inputMutex);
 	if(wayland::windowUnderPointer == nullptr)
 		return;
 
+	// forward event
 	float v = float(wl_fixed_to_double(value)) * 8 / 120.f;
-	float wheelX, wheelY;
+	InputEvent e;
+	e.type = InputEvent::Type::PointerAxis;
+	e.window = wayland::windowUnderPointer;
+	e.modifiers = wayland::modifiers;
 	if(axis == WL_POINTER_AXIS_VERTICAL_SCROLL) {
-		wheelX = 0;
-		wheelY = -v;
+		e.x = 0;
+		e.y = -v;
 	}
 	else if(axis == WL_POINTER_AXIS_HORIZONTAL_SCROLL) {
-		wheelX = v;
-		wheelY = 0;
-	}
-	if(wayland::windowUnderPointer->_mouseWheelCallback) {
-		wayland::windowUnderPointer->_mouseState.modifiers = wayland::modifiers;
-		wayland::windowUnderPointer->_mouseWheelCallback(
-			*wayland::windowUnderPointer, wheelX, wheelY, wayland::windowUnderPointer->_mouseState);
+		e.x = v;
+		e.y = 0;
 	}
+	else
+		return;
+	postInputEvent(e);
 }
 
 
@@ -3731,13 +6456,28 @@ void VulkanWindowPrivate::keyboardListenerKeymap(void* data, wl_keyboard* keyboa
 	if(format != WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1)
 		return;
 
+	// create xkb_context on the first keymap event
+	if(wayland::xkbContext == nullptr) {
+		try {
+			loadXkbCommon();
+		} catch(...) {
+			close(fd);
+			throw;
+		}
+		wayland::xkbContext = xkbcommon::funcs.xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+		if(wayland::xkbContext == nullptr) {
+			close(fd);
+			throw runtime_error("VulkanWindow: Cannot create XKB context.");
+		}
+	}
+
 	// map memory
 	char* m = static_cast<char*>(mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
 	if(m == MAP_FAILED)
 		throw runtime_error("VulkanWindow::init(): Failed to map memory in keymap event.");
 
 	// create keymap
-	struct xkb_keymap* keymap = xkb_keymap_new_from_string(wayland::xkbContext,
+	struct xkb_keymap* keymap = xkbcommon::funcs.xkb_keymap_new_from_string(wayland::xkbContext,
 		m, XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
 	int r1 = munmap(m, size);
 	int r2 = close(fd);
@@ -3746,21 +6486,21 @@ void VulkanWindowPrivate::keyboardListenerKeymap(void* data, wl_keyboard* keyboa
 	if(keymap == nullptr)
 		throw runtime_error("VulkanWindow::init(): Failed to create keymap in keymap event.");
 	if(r1 != 0) {
-		xkb_keymap_unref(keymap);
+		xkbcommon::funcs.xkb_keymap_unref(keymap);
 		throw runtime_error("VulkanWindow::init(): Failed to unmap memory in keymap event.");
 	}
 	if(r2 != 0) {
-		xkb_keymap_unref(keymap);
+		xkbcommon::funcs.xkb_keymap_unref(keymap);
 		throw runtime_error("VulkanWindow::init(): Failed to close file descriptor in keymap event.");
 	}
 
 	// unref old xkb_state
 	if(wayland::xkbState)
-		xkb_state_unref(wayland::xkbState);
+		xkbcommon::funcs.xkb_state_unref(wayland::xkbState);
 
 	// create new xkb_state
-	wayland::xkbState = xkb_state_new(keymap);
-	xkb_keymap_unref(keymap);
+	wayland::xkbState = xkbcommon::funcs.xkb_state_new(keymap);
+	xkbcommon::funcs.xkb_keymap_unref(keymap);
 	if(wayland::xkbState == nullptr)
 		throw runtime_error("VulkanWindow::create(): Cannot create XKB state object in keymap event.");
 }
@@ -3768,9 +6508,17 @@ void VulkanWindowPrivate::keyboardListenerKeymap(void* data, wl_keyboard* keyboa
 
 void VulkanWindowPrivate::keyboardListenerEnter(void* data, wl_keyboard* keyboard, uint32_t serial, wl_surface* surface, wl_array* keys)
 {
+	lock_guard<mutex> lock(wayland::inputMutex);
 	wayland::windowWithKbFocus = static_cast<VulkanWindowPrivate*>(wl_surface_get_user_data(surface));
 	assert(wayland::windowWithKbFocus && "wl_surface userData does not contain pointer to VulkanWindow.");
 
+	// forward event
+	InputEvent e;
+	e.type = InputEvent::Type::KeyboardEnter;
+	e.window = wayland::windowWithKbFocus;
+	e.modifiers = wayland::modifiers;
+	postInputEvent(e);
+
 #if 0 // this seems not needed for our simple key down and key up callbacks
 	// iterate keys array;
 	// the keys array contains currently pressed keys
@@ -3789,24 +6537,35 @@ void VulkanWindowPrivate::keyboardListenerEnter(void* data, wl_keyboard* keyboar
 
 void VulkanWindowPrivate::keyboardListenerLeave(void* data, wl_keyboard* keyboard, uint32_t serial, wl_surface* surface)
 {
+	lock_guard<mutex> lock(wayland::inputMutex);
+	if(wayland::windowWithKbFocus) {
+		InputEvent e;
+		e.type = InputEvent::Type::KeyboardLeave;
+		e.window = wayland::windowWithKbFocus;
+		e.modifiers = wayland::modifiers;
+		postInputEvent(e);
+	}
 	wayland::windowWithKbFocus = nullptr;
 }
 
 
 void VulkanWindowPrivate::keyboardListenerKey(void* data, wl_keyboard* keyboard, uint32_t serial, uint32_t time, uint32_t scanCode, uint32_t state)
 {
-	// get code point
-	uint32_t codePoint = xkb_state_key_get_utf32(wayland::xkbState, scanCode + 8);
+	// handle unknown window
+	lock_guard<mutex> lock(wayland::inputMutex);
+	if(wayland::windowWithKbFocus == nullptr)
+		return;
 
-	// callback
-	if(wayland::windowWithKbFocus->_keyCallback) {
-		wayland::windowWithKbFocus->_keyCallback(
-			*wayland::windowWithKbFocus,
-			state==WL_KEYBOARD_KEY_STATE_PRESSED ? KeyState::Pressed : KeyState::Released,
-			ScanCode(scanCode),
-			KeyCode(codePoint)
-		);
-	}
+	// forward event
+	// (code point is computed here as xkbState is owned by seatQueue listeners)
+	InputEvent e;
+	e.type = InputEvent::Type::Key;
+	e.pressed = (state == WL_KEYBOARD_KEY_STATE_PRESSED);
+	e.window = wayland::windowWithKbFocus;
+	e.modifiers = wayland::modifiers;
+	e.code = scanCode;
+	e.codePoint = wayland::xkbState ? xkbcommon::funcs.xkb_state_key_get_utf32(wayland::xkbState, scanCode + 8) : 0;
+	postInputEvent(e);
 }
 
 
@@ -3826,13 +6585,93 @@ void VulkanWindowPrivate::keyboardListenerModifiers(void* data, wl_keyboard* key
 }
 
 
+// process input event forwarded to the thread owning the window
+void VulkanWindowPrivate::processInputEvent(const InputEvent& e)
+{
+	VulkanWindowPrivate* w = e.window;
+	switch(e.type) {
+
+	case InputEvent::Type::PointerEnter:
+		if(w->_mouseState.posX != e.x || w->_mouseState.posY != e.y) {
+			w->_mouseState.relX = 0;
+			w->_mouseState.relY = 0;
+			w->_mouseState.posX = e.x;
+			w->_mouseState.posY = e.y;
+			if(w->hasMouseMoveHandler()) {
+				w->_mouseState.modifiers = e.modifiers;
+				w->callMouseMove(w->_mouseState);
+			}
+		}
+		break;
+
+	case InputEvent::Type::PointerLeave:
+		w->updatePointerLeave();
+		break;
+
+	case InputEvent::Type::PointerMotion:
+		if(w->_mouseState.posX != e.x || w->_mouseState.posY != e.y) {
+			w->_mouseState.relX = e.x - w->_mouseState.posX;
+			w->_mouseState.relY = e.y - w->_mouseState.posY;
+			w->_mouseState.posX = e.x;
+			w->_mouseState.posY = e.y;
+			if(w->hasMouseMoveHandler()) {
+				w->_mouseState.modifiers = e.modifiers;
+				w->callMouseMove(w->_mouseState);
+			}
+		}
+		break;
+
+	case InputEvent::Type::PointerButton: {
+		MouseButton::EnumType index;
+		switch(e.code) {
+		// button codes taken from linux/input-event-codes.h
+		case 0x110: index = MouseButton::Left; break;
+		case 0x111: index = MouseButton::Right; break;
+		case 0x112: index = MouseButton::Middle; break;
+		case 0x113: index = MouseButton::X1; break;
+		case 0x114: index = MouseButton::X2; break;
+		default: index = MouseButton::Unknown;
+		}
+		w->_mouseState.buttons.set(index, e.pressed);
+		if(w->hasMouseButtonHandler()) {
+			w->_mouseState.modifiers = e.modifiers;
+			w->callMouseButton(index, e.pressed ? ButtonState::Pressed : ButtonState::Released, w->_mouseState);
+		}
+		break;
+	}
+
+	case InputEvent::Type::PointerAxis:
+		if(w->hasMouseWheelHandler()) {
+			w->_mouseState.modifiers = e.modifiers;
+			w->callMouseWheel(e.x, e.y, w->_mouseState);
+		}
+		break;
+
+	case InputEvent::Type::KeyboardEnter:
+		w->updateFocus(true);
+		break;
+
+	case InputEvent::Type::KeyboardLeave:
+		w->updateFocus(false);
+		break;
+
+	case InputEvent::Type::Key:
+		if(w->hasKeyHandler())
+			w->callKey(e.pressed ? KeyState::Pressed : KeyState::Released, ScanCode(e.code), KeyCode(e.codePoint));
+		break;
+
+	}
+}
+
+# endif
+
 #elif defined(USE_PLATFORM_SDL3)
 
 
 const vector<const char*>& VulkanWindow::requiredExtensions()
 {
 	// SDL must be initialized to call this function
-	assert(sdl::initialized && "VulkanWindow::init() must be called before calling VulkanWindow::requiredExtensions().");
+	init();
 
 	// get required instance extensions
 	Uint32 count;
@@ -3862,8 +6701,8 @@ void VulkanWindow::show()
 {
 	// asserts for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
-	assert(_resizeCallback && "Resize callback must be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::mainLoop().");
-	assert(_frameCallback && "Frame callback need to be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::mainLoop().");
+	assert(hasResizeHandler() && "Resize callback must be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::mainLoop().");
+	assert(hasFrameHandler() && "Frame callback need to be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::mainLoop().");
 
 	// do nothing on already shown window
 	if(_sdl.visible)
@@ -3917,8 +6756,8 @@ void VulkanWindow::mainLoop()
 				w->_mouseState.relY = newY - w->_mouseState.posY;
 				w->_mouseState.posX = newX;
 				w->_mouseState.posY = newY;
-				if(w->_mouseMoveCallback)
-					w->_mouseMoveCallback(*w, w->_mouseState);
+				if(w->hasMouseMoveHandler())
+					w->callMouseMove(w->_mouseState);
 			}
 		};
 	auto handleMouseButton =
@@ -3937,8 +6776,8 @@ void VulkanWindow::mainLoop()
 
 			// callback with new button state
 			w->_mouseState.buttons.set(mouseButton, buttonState==ButtonState::Pressed);
-			if(w->_mouseButtonCallback)
-				w->_mouseButtonCallback(*w, mouseButton, buttonState, w->_mouseState);
+			if(w->hasMouseButtonHandler())
+				w->callMouseButton(mouseButton, buttonState, w->_mouseState);
 		};
 
 	// main loop
@@ -3947,9 +6786,20 @@ void VulkanWindow::mainLoop()
 	do {
 
 		// get event
-		// (wait for one if no events are in the queue yet)
-		if(!SDL_WaitEvent(&event))
-			throw runtime_error(string("VulkanWindow: SDL_WaitEvent() function failed. Error details: ") + SDL_GetError());
+		// (wait for one if no events are in the queue yet, but not longer than until the time of the deferred frame;
+		// the last fraction of millisecond is slept by sleepUntil())
+		int64_t wakeUpTime = VulkanWindowPrivate::scheduleDeferredFrames();
+		int timeout = timeoutMilliseconds(wakeUpTime);
+		if(timeout == -1) {
+			if(!SDL_WaitEvent(&event))
+				throw runtime_error(string("VulkanWindow: SDL_WaitEvent() function failed. Error details: ") + SDL_GetError());
+		}
+		else
+			if(!SDL_WaitEventTimeout(&event, timeout)) {
+				if(timeout == 0)
+					sleepUntil(wakeUpTime);
+				continue;
+			}
 
 		// convert SDL_WindowID to VulkanWindow*
 		auto getWindow =
@@ -3998,6 +6848,9 @@ void VulkanWindow::mainLoop()
 				w->_sdl.hiddenWindowFramePending = false;
 				w->scheduleFrame();
 			}
+			w->updateWindowState(w->windowState());
+			if(w->hasOutputsChangedHandler())
+				w->updateOutputs();
 			break;
 		}
 
@@ -4011,6 +6864,7 @@ void VulkanWindow::mainLoop()
 				w->_sdl.hiddenWindowFramePending = true;
 				w->_sdl.framePending = false;
 			}
+			w->updateWindowState(w->windowState());
 			break;
 		}
 
@@ -4024,6 +6878,7 @@ void VulkanWindow::mainLoop()
 				w->_sdl.hiddenWindowFramePending = true;
 				w->_sdl.framePending = false;
 			}
+			w->updateWindowState(w->windowState());
 			break;
 		}
 
@@ -4037,6 +6892,35 @@ void VulkanWindow::mainLoop()
 				w->_sdl.hiddenWindowFramePending = false;
 				w->scheduleFrame();
 			}
+			w->updateWindowState(w->windowState());
+			break;
+		}
+
+		case SDL_EVENT_WINDOW_MAXIMIZED:
+		case SDL_EVENT_WINDOW_ENTER_FULLSCREEN:
+		case SDL_EVENT_WINDOW_LEAVE_FULLSCREEN: {
+			VulkanWindow* w = getWindow(event.window.windowID);
+			w->updateWindowState(w->windowState());
+			break;
+		}
+
+		case SDL_EVENT_WINDOW_FOCUS_GAINED:
+		case SDL_EVENT_WINDOW_FOCUS_LOST: {
+			VulkanWindow* w = getWindow(event.window.windowID);
+			w->updateFocus(event.type == SDL_EVENT_WINDOW_FOCUS_GAINED);
+			break;
+		}
+
+		case SDL_EVENT_WINDOW_MOUSE_LEAVE: {
+			VulkanWindow* w = getWindow(event.window.windowID);
+			w->updatePointerLeave();
+			break;
+		}
+
+		case SDL_EVENT_WINDOW_DISPLAY_CHANGED: {
+			VulkanWindow* w = getWindow(event.window.windowID);
+			if(w->hasOutputsChangedHandler())
+				w->updateOutputs();
 			break;
 		}
 
@@ -4045,8 +6929,8 @@ void VulkanWindow::mainLoop()
 			cout << "Close event" << endl;
 		#endif
 			VulkanWindow* w = getWindow(event.window.windowID);
-			if(w->_closeCallback)
-				w->_closeCallback(*w);  // VulkanWindow object might be already destroyed when returning from the callback
+			if(w->hasCloseHandler())
+				w->callClose();  // VulkanWindow object might be already destroyed when returning from the callback
 			else {
 				w->hide();
 				VulkanWindow::exitMainLoop();
@@ -4079,34 +6963,34 @@ void VulkanWindow::mainLoop()
 		{
 			VulkanWindow* w = getWindow(event.button.windowID);
 
-			if(w->_mouseWheelCallback)
+			if(w->hasMouseWheelHandler())
 			{
 				handleModifiers(w);
 
 				// handle wheel rotation
 				// (value is relative to last wheel event)
-				w->_mouseWheelCallback(*w, event.wheel.x, event.wheel.y, w->_mouseState);
+				w->callMouseWheel(event.wheel.x, event.wheel.y, w->_mouseState);
 			}
 			break;
 		}
 
 		case SDL_EVENT_KEY_DOWN: {
 			VulkanWindow* w = getWindow(event.key.windowID);
-			if(w->_keyCallback && event.key.repeat == 0)
+			if(w->hasKeyHandler() && event.key.repeat == 0)
 			{
 				ScanCode scanCode = translateScanCode(event.key.scancode);
 				KeyCode keyCode = KeyCode((event.key.key & SDLK_SCANCODE_MASK) ? 0 : event.key.key);
-				w->_keyCallback(*w, KeyState::Pressed, scanCode, keyCode);
+				w->callKey(KeyState::Pressed, scanCode, keyCode);
 			}
 			break;
 		}
 		case SDL_EVENT_KEY_UP: {
 			VulkanWindow* w = getWindow(event.key.windowID);
-			if(w->_keyCallback && event.key.repeat == 0)
+			if(w->hasKeyHandler() && event.key.repeat == 0)
 			{
 				ScanCode scanCode = translateScanCode(event.key.scancode);
 				KeyCode keyCode = KeyCode((event.key.key & SDLK_SCANCODE_MASK) ? 0 : event.key.key);
-				w->_keyCallback(*w, KeyState::Released, scanCode, keyCode);
+				w->callKey(KeyState::Released, scanCode, keyCode);
 			}
 			break;
 		}
@@ -4134,6 +7018,8 @@ void VulkanWindow::scheduleFrame()
 	// assert for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
 
+	_activity = true;  // for idle throttling
+
 	if(_sdl.framePending)
 		return;
 
@@ -4161,7 +7047,7 @@ void VulkanWindow::scheduleFrame()
 const vector<const char*>& VulkanWindow::requiredExtensions()
 {
 	// SDL must be initialized to call this function
-	assert(sdl::initialized && "VulkanWindow::init() must be called before calling VulkanWindow::requiredExtensions().");
+	init();
 
 	// cache the result in static local variable
 	// so extension list is constructed only once
@@ -4209,8 +7095,8 @@ void VulkanWindow::show()
 {
 	// asserts for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
-	assert(_resizeCallback && "Resize callback must be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::mainLoop().");
-	assert(_frameCallback && "Frame callback need to be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::mainLoop().");
+	assert(hasResizeHandler() && "Resize callback must be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::mainLoop().");
+	assert(hasFrameHandler() && "Frame callback need to be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::mainLoop().");
 
 	// show window
 	// and set _visible flag immediately
@@ -4253,8 +7139,8 @@ void VulkanWindow::mainLoop()
 				w->_mouseState.relY = newY - w->_mouseState.posY;
 				w->_mouseState.posX = newX;
 				w->_mouseState.posY = newY;
-				if(w->_mouseMoveCallback)
-					w->_mouseMoveCallback(*w, w->_mouseState);
+				if(w->hasMouseMoveHandler())
+					w->callMouseMove(w->_mouseState);
 			}
 		};
 	auto handleMouseButton =
@@ -4273,8 +7159,8 @@ void VulkanWindow::mainLoop()
 
 			// callback with new button state
 			w->_mouseState.buttons.set(mouseButton, buttonState==ButtonState::Pressed);
-			if(w->_mouseButtonCallback)
-				w->_mouseButtonCallback(*w, mouseButton, buttonState, w->_mouseState);
+			if(w->hasMouseButtonHandler())
+				w->callMouseButton(mouseButton, buttonState, w->_mouseState);
 		};
 
 	// main loop
@@ -4283,9 +7169,21 @@ void VulkanWindow::mainLoop()
 	do {
 
 		// get event
-		// (wait for one if no events are in the queue yet)
-		if(SDL_WaitEvent(&event) == 0)
-			throw runtime_error(string("VulkanWindow: SDL_WaitEvent() function failed. Error details: ") + SDL_GetError());
+		// (wait for one if no events are in the queue yet, but not longer than until the time of the deferred frame;
+		// the last fraction of millisecond is slept by sleepUntil();
+		// SDL_WaitEventTimeout() returns zero on timeout as well as on error)
+		int64_t wakeUpTime = VulkanWindowPrivate::scheduleDeferredFrames();
+		int timeout = timeoutMilliseconds(wakeUpTime);
+		if(timeout == -1) {
+			if(SDL_WaitEvent(&event) == 0)
+				throw runtime_error(string("VulkanWindow: SDL_WaitEvent() function failed. Error details: ") + SDL_GetError());
+		}
+		else
+			if(SDL_WaitEventTimeout(&event, timeout) == 0) {
+				if(timeout == 0)
+					sleepUntil(wakeUpTime);
+				continue;
+			}
 
 		// handle event
 		// (Make sure that all event types (event.type) handled here, such as SDL_WINDOWEVENT,
@@ -4311,6 +7209,7 @@ void VulkanWindow::mainLoop()
 				VulkanWindow* w = reinterpret_cast<VulkanWindow*>(
 					SDL_GetWindowData(SDL_GetWindowFromID(event.window.windowID), sdl::windowPointerName));
 				w->scheduleResize();
+				w->updateWindowState(w->windowState());  // SDL2 has no fullscreen events
 				break;
 			}
 
@@ -4326,6 +7225,9 @@ void VulkanWindow::mainLoop()
 					w->_sdl.hiddenWindowFramePending = false;
 					w->scheduleFrame();
 				}
+				w->updateWindowState(w->windowState());
+				if(w->hasOutputsChangedHandler())
+					w->updateOutputs();
 				break;
 			}
 
@@ -4340,6 +7242,7 @@ void VulkanWindow::mainLoop()
 					w->_sdl.hiddenWindowFramePending = true;
 					w->_sdl.framePending = false;
 				}
+				w->updateWindowState(w->windowState());
 				break;
 			}
 
@@ -4354,6 +7257,7 @@ void VulkanWindow::mainLoop()
 					w->_sdl.hiddenWindowFramePending = true;
 					w->_sdl.framePending = false;
 				}
+				w->updateWindowState(w->windowState());
 				break;
 			}
 
@@ -4368,6 +7272,43 @@ void VulkanWindow::mainLoop()
 					w->_sdl.hiddenWindowFramePending = false;
 					w->scheduleFrame();
 				}
+				w->updateWindowState(w->windowState());
+				break;
+			}
+
+			case SDL_WINDOWEVENT_MAXIMIZED: {
+				VulkanWindow* w = reinterpret_cast<VulkanWindow*>(
+					SDL_GetWindowData(SDL_GetWindowFromID(event.window.windowID), sdl::windowPointerName));
+				w->updateWindowState(w->windowState());
+				break;
+			}
+
+			case SDL_WINDOWEVENT_FOCUS_GAINED:
+			case SDL_WINDOWEVENT_FOCUS_LOST: {
+				VulkanWindow* w = reinterpret_cast<VulkanWindow*>(
+					SDL_GetWindowData(SDL_GetWindowFromID(event.window.windowID), sdl::windowPointerName));
+				w->updateFocus(event.window.event == SDL_WINDOWEVENT_FOCUS_GAINED);
+				break;
+			}
+
+			case SDL_WINDOWEVENT_LEAVE: {
+				VulkanWindow* w = reinterpret_cast<VulkanWindow*>(
+					SDL_GetWindowData(SDL_GetWindowFromID(event.window.windowID), sdl::windowPointerName));
+				w->updatePointerLeave();
+				break;
+			}
+
+			// window moved, possibly to another display
+			// (SDL_WINDOWEVENT_DISPLAY_CHANGED is available since SDL 2.0.18)
+			case SDL_WINDOWEVENT_MOVED:
+		#if SDL_VERSION_ATLEAST(2,0,18)
+			case SDL_WINDOWEVENT_DISPLAY_CHANGED:
+		#endif
+			{
+				VulkanWindow* w = reinterpret_cast<VulkanWindow*>(
+					SDL_GetWindowData(SDL_GetWindowFromID(event.window.windowID), sdl::windowPointerName));
+				if(w->hasOutputsChangedHandler())
+					w->updateOutputs();
 				break;
 			}
 
@@ -4377,8 +7318,8 @@ void VulkanWindow::mainLoop()
 			#endif
 				VulkanWindow* w = reinterpret_cast<VulkanWindow*>(
 					SDL_GetWindowData(SDL_GetWindowFromID(event.window.windowID), sdl::windowPointerName));
-				if(w->_closeCallback)
-					w->_closeCallback(*w);  // VulkanWindow object might be already destroyed when returning from the callback
+				if(w->hasCloseHandler())
+					w->callClose();  // VulkanWindow object might be already destroyed when returning from the callback
 				else {
 					w->hide();
 					VulkanWindow::exitMainLoop();
@@ -4417,7 +7358,7 @@ void VulkanWindow::mainLoop()
 			VulkanWindow* w = reinterpret_cast<VulkanWindow*>(
 				SDL_GetWindowData(SDL_GetWindowFromID(event.button.windowID), sdl::windowPointerName));
 
-			if(w->_mouseWheelCallback)
+			if(w->hasMouseWheelHandler())
 			{
 				handleModifiers(w);
 
@@ -4430,7 +7371,7 @@ void VulkanWindow::mainLoop()
 				float wheelX = float(event.wheel.x);
 				float wheelY = float(event.wheel.y);
 			#endif
-				w->_mouseWheelCallback(*w, wheelX, wheelY, w->_mouseState);
+				w->callMouseWheel(wheelX, wheelY, w->_mouseState);
 			}
 			break;
 		}
@@ -4438,22 +7379,22 @@ void VulkanWindow::mainLoop()
 		case SDL_KEYDOWN: {
 			VulkanWindow* w = reinterpret_cast<VulkanWindow*>(
 				SDL_GetWindowData(SDL_GetWindowFromID(event.key.windowID), sdl::windowPointerName));
-			if(w->_keyCallback && event.key.repeat == 0)
+			if(w->hasKeyHandler() && event.key.repeat == 0)
 			{
 				ScanCode scanCode = translateScanCode(event.key.keysym.scancode);
 				KeyCode keyCode = KeyCode((event.key.keysym.sym & SDLK_SCANCODE_MASK) ? 0 : event.key.keysym.sym);
-				w->_keyCallback(*w, KeyState::Pressed, scanCode, keyCode);
+				w->callKey(KeyState::Pressed, scanCode, keyCode);
 			}
 			break;
 		}
 		case SDL_KEYUP: {
 			VulkanWindow* w = reinterpret_cast<VulkanWindow*>(
 				SDL_GetWindowData(SDL_GetWindowFromID(event.key.windowID), sdl::windowPointerName));
-			if(w->_keyCallback && event.key.repeat == 0)
+			if(w->hasKeyHandler() && event.key.repeat == 0)
 			{
 				ScanCode scanCode = translateScanCode(event.key.keysym.scancode);
 				KeyCode keyCode = KeyCode((event.key.keysym.sym & SDLK_SCANCODE_MASK) ? 0 : event.key.keysym.sym);
-				w->_keyCallback(*w, KeyState::Released, scanCode, keyCode);
+				w->callKey(KeyState::Released, scanCode, keyCode);
 			}
 			break;
 		}
@@ -4480,6 +7421,8 @@ void VulkanWindow::scheduleFrame()
 	// assert for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
 
+	_activity = true;  // for idle throttling
+
 	if(_sdl.framePending)
 		return;
 
@@ -4512,6 +7455,9 @@ const vector<const char*>& VulkanWindow::requiredExtensions()
 	static const vector<const char*> l =
 		[]() {
 
+			// GLFW must be initialized to call glfwGetRequiredInstanceExtensions()
+			init();
+
 			// get required extensions
 			uint32_t count;
 			const char** a = glfwGetRequiredInstanceExtensions(&count);
@@ -4549,14 +7495,15 @@ void VulkanWindow::show()
 {
 	// asserts for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
-	assert(_resizeCallback && "Resize callback must be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::mainLoop().");
-	assert(_frameCallback && "Frame callback need to be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::mainLoop().");
+	assert(hasResizeHandler() && "Resize callback must be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::mainLoop().");
+	assert(hasFrameHandler() && "Frame callback need to be set before VulkanWindow::mainLoop() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::mainLoop().");
 
 	// show window
 	_glfw.visible = true;
 	glfwShowWindow(_glfw.window);
 	checkError("glfwShowWindow");
 	scheduleFrame();
+	updateWindowState(windowState());
 }
 
 
@@ -4580,6 +7527,7 @@ void VulkanWindow::hide()
 				break;
 			}
 	}
+	updateWindowState(WindowState::Hidden);
 }
 
 
@@ -4589,15 +7537,32 @@ void VulkanWindow::mainLoop()
 	glfw::running = true;
 	do {
 
-		if(glfw::framePendingWindows.empty())
+		// process events
+		// (wait for them if no frame is pending, but not longer than until the time of the deferred frame;
+		// the last fraction of millisecond is slept by sleepUntil())
+		int64_t wakeUpTime = VulkanWindowPrivate::scheduleDeferredFrames();
+		int timeout = timeoutMilliseconds(wakeUpTime);
+		if(!glfw::framePendingWindows.empty())
 		{
-			glfwWaitEvents();
-			checkError("glfwWaitEvents");
+			glfwPollEvents();
+			checkError("glfwPollEvents");
 		}
-		else
+		else if(timeout > 0)
+		{
+			glfwWaitEventsTimeout(timeout * 0.001);
+			checkError("glfwWaitEventsTimeout");
+		}
+		else if(timeout == 0)
 		{
 			glfwPollEvents();
 			checkError("glfwPollEvents");
+			if(glfw::framePendingWindows.empty())
+				sleepUntil(wakeUpTime);
+		}
+		else
+		{
+			glfwWaitEvents();
+			checkError("glfwWaitEvents");
 		}
 
 		// render all windows with _framePendingState set to Pending
@@ -4643,6 +7608,8 @@ void VulkanWindow::scheduleFrame()
 	// assert for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
 
+	_activity = true;  // for idle throttling
+
 	if(_glfw.framePendingState == FramePendingState::Pending)
 		return;
 
@@ -4660,6 +7627,7 @@ const vector<const char*>& VulkanWindow::requiredExtensions()
 {
 	static vector<const char*> l =
 		[]() {
+			init();  // QGuiApplication must exist to get platform name
 			QString platform = QGuiApplication::platformName();
 			if(platform == "wayland")
 				return vector<const char*>{ "VK_KHR_surface", "VK_KHR_wayland_surface" };
@@ -4691,8 +7659,8 @@ void VulkanWindow::show()
 {
 	// asserts for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
-	assert(_resizeCallback && "Resize callback must be set before VulkanWindow::show() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::show().");
-	assert(_frameCallback && "Frame callback need to be set before VulkanWindow::show() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::show().");
+	assert(hasResizeHandler() && "Resize callback must be set before VulkanWindow::show() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::show().");
+	assert(hasFrameHandler() && "Frame callback need to be set before VulkanWindow::show() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::show().");
 
 	// show window
 	_qt.window->setVisible(true);
@@ -4725,10 +7693,25 @@ void VulkanWindow::exitMainLoop()
 }
 
 
-bool QtRenderingWindow::event(QEvent* event)
+QtRenderingWindow::QtRenderingWindow(QWindow* parent, VulkanWindow* vulkanWindow_)
+	: QWindow(parent)
+	, vulkanWindow(vulkanWindow_)
 {
-	try {
-
+	// track the screen the window is on
+	// (vulkanWindow is read at the time of the signal as it changes when VulkanWindow is moved)
+	QObject::connect(this, &QWindow::screenChanged,
+		[this](QScreen*) {
+			if(vulkanWindow->hasOutputsChangedHandler())
+				vulkanWindow->updateOutputs();
+		}
+	);
+}
+
+
+bool QtRenderingWindow::event(QEvent* event)
+{
+	try {
+
 		// mouse functions
 		auto getMouseButton =
 			[](QMouseEvent* e) -> VulkanWindow::MouseButton::EnumType {
@@ -4760,8 +7743,8 @@ bool QtRenderingWindow::event(QEvent* event)
 					vulkanWindow->_mouseState.relY = newY - vulkanWindow->_mouseState.posY;
 					vulkanWindow->_mouseState.posX = newX;
 					vulkanWindow->_mouseState.posY = newY;
-					if(vulkanWindow->_mouseMoveCallback)
-						vulkanWindow->_mouseMoveCallback(*vulkanWindow, vulkanWindow->_mouseState);
+					if(vulkanWindow->hasMouseMoveHandler())
+						vulkanWindow->callMouseMove(vulkanWindow->_mouseState);
 				}
 			};
 		auto handleMouseButton =
@@ -4775,14 +7758,14 @@ bool QtRenderingWindow::event(QEvent* event)
 					vulkanWindow->_mouseState.relY = y - vulkanWindow->_mouseState.posY;
 					vulkanWindow->_mouseState.posX = x;
 					vulkanWindow->_mouseState.posY = y;
-					if(vulkanWindow->_mouseMoveCallback)
-						vulkanWindow->_mouseMoveCallback(*vulkanWindow, vulkanWindow->_mouseState);
+					if(vulkanWindow->hasMouseMoveHandler())
+						vulkanWindow->callMouseMove(vulkanWindow->_mouseState);
 				}
 
 				// callback with new button state
 				vulkanWindow->_mouseState.buttons.set(mouseButton, buttonState==VulkanWindow::ButtonState::Pressed);
-				if(vulkanWindow->_mouseButtonCallback)
-					vulkanWindow->_mouseButtonCallback(*vulkanWindow, mouseButton, buttonState, vulkanWindow->_mouseState);
+				if(vulkanWindow->hasMouseButtonHandler())
+					vulkanWindow->callMouseButton(mouseButton, buttonState, vulkanWindow->_mouseState);
 				return true;
 
 			};
@@ -4881,17 +7864,20 @@ bool QtRenderingWindow::event(QEvent* event)
 
 			// handle wheel rotation
 			// (value is relative since last wheel event)
-			if(vulkanWindow->_mouseWheelCallback) {
+			if(vulkanWindow->hasMouseWheelHandler()) {
 				p = QPointF(e->angleDelta()) / 120.f;
-				vulkanWindow->_mouseWheelCallback(*vulkanWindow, -p.x(), p.y(), vulkanWindow->_mouseState);
+				vulkanWindow->callMouseWheel(-p.x(), p.y(), vulkanWindow->_mouseState);
 			}
 			return true;
 
 		}
+		case QEvent::Type::Leave:
+			vulkanWindow->updatePointerLeave();
+			return QWindow::event(event);
 
 		// handle key events
 		case QEvent::Type::KeyPress: {
-			if(vulkanWindow->_keyCallback) {
+			if(vulkanWindow->hasKeyHandler()) {
 				QKeyEvent *keyEvent = static_cast<QKeyEvent*>(event);
 				if(!keyEvent->isAutoRepeat()) {
 
@@ -4912,13 +7898,13 @@ bool QtRenderingWindow::event(QEvent* event)
 					}
 
 					// callback
-					vulkanWindow->_keyCallback(*vulkanWindow, VulkanWindow::KeyState::Pressed, scanCode, VulkanWindow::KeyCode(k));
+					vulkanWindow->callKey(VulkanWindow::KeyState::Pressed, scanCode, VulkanWindow::KeyCode(k));
 				}
 			}
 			return true;
 		}
 		case QEvent::Type::KeyRelease: {
-			if(vulkanWindow->_keyCallback) {
+			if(vulkanWindow->hasKeyHandler()) {
 				QKeyEvent *keyEvent = static_cast<QKeyEvent*>(event);
 				if(!keyEvent->isAutoRepeat()) {
 
@@ -4939,19 +7925,33 @@ bool QtRenderingWindow::event(QEvent* event)
 					}
 
 					// callback
-					vulkanWindow->_keyCallback(*vulkanWindow, VulkanWindow::KeyState::Released, scanCode, VulkanWindow::KeyCode(k));
+					vulkanWindow->callKey(VulkanWindow::KeyState::Released, scanCode, VulkanWindow::KeyCode(k));
 				}
 			}
 			return true;
 		}
 
+		// keyboard focus changes
+		case QEvent::Type::FocusIn:
+		case QEvent::Type::FocusOut:
+			vulkanWindow->updateFocus(event->type() == QEvent::Type::FocusIn);
+			return QWindow::event(event);
+
+		// window state changes
+		// (update last known state and let QWindow process the event)
+		case QEvent::Type::WindowStateChange:
+		case QEvent::Type::Show:
+		case QEvent::Type::Hide:
+			vulkanWindow->updateWindowState(vulkanWindow->windowState());
+			return QWindow::event(event);
+
 		// hide window on close
 		// (we must not really close it as Vulkan surface would be destroyed
 		// and this would make a problem as swapchain still exists and Vulkan
 		// requires the swapchain to be destroyed first)
 		case QEvent::Type::Close:
-			if(vulkanWindow->_closeCallback)
-				vulkanWindow->_closeCallback(*vulkanWindow);  // VulkanWindow object might be already destroyed when returning from the callback
+			if(vulkanWindow->hasCloseHandler())
+				vulkanWindow->callClose();  // VulkanWindow object might be already destroyed when returning from the callback
 			else {
 				vulkanWindow->hide();
 				VulkanWindow::exitMainLoop();
@@ -4970,13 +7970,21 @@ bool QtRenderingWindow::event(QEvent* event)
 }
 
 
-void QtRenderingWindow::scheduleFrameTimer()
+void QtRenderingWindow::scheduleFrameTimer(int timeout)
 {
-	// start zero timeout timer
+	// scheduled frame replaces the deferred one
+	// (the frame time might change as scheduleFrame() call might end the idle state)
+	if(timer != 0 && deferredFrameTimer && timeout == 0) {
+		killTimer(timer);
+		timer = 0;
+	}
+
+	// start the timer
 	if(timer == 0) {
-		timer = startTimer(0);
+		timer = startTimer(timeout, Qt::PreciseTimer);
 		if(timer == 0)
 			throw runtime_error("VulkanWindow::scheduleNextFrame(): Cannot allocate timer.");
+		deferredFrameTimer = (timeout != 0);
 	}
 }
 
@@ -4986,11 +7994,371 @@ void VulkanWindow::scheduleFrame()
 	// assert for valid usage
 	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
 
+	_activity = true;  // for idle throttling
+
 	// start zero timeout timer
 	static_cast<QtRenderingWindow*>(_qt.window)->scheduleFrameTimer();
 }
 
 
+#elif defined(USE_PLATFORM_DISPLAY)
+
+
+bool VulkanWindow::isVisible() const
+{
+	return _display.display && _display.visible;
+}
+
+
+void VulkanWindow::show()
+{
+	// asserts for valid usage
+	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
+	assert(hasResizeHandler() && "Resize callback must be set before VulkanWindow::show() call. Please, call VulkanWindow::setResizeCallback() before VulkanWindow::show().");
+	assert(hasFrameHandler() && "Frame callback need to be set before VulkanWindow::show() call. Please, call VulkanWindow::setFrameCallback() before VulkanWindow::show().");
+
+	// do nothing on already shown window
+	if(_display.visible)
+		return;
+
+	// the last shown window receives input
+	if(display::windowWithFocus)
+		display::windowWithFocus->updateFocus(false);
+	display::windowWithFocus = static_cast<VulkanWindowPrivate*>(this);
+	updateFocus(true);
+
+	// show window
+	// (the plane shows the content as soon as the first image is presented)
+	_display.visible = true;
+	scheduleFrame();
+	updateWindowState(WindowState::FullScreen);
+}
+
+
+void VulkanWindow::hide()
+{
+	// assert for valid usage
+	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
+
+	// do nothing on already hidden window
+	// (the plane keeps the last presented image until the surface is destroyed,
+	// so hiding just stops the rendering)
+	if(!_display.visible)
+		return;
+	_display.visible = false;
+
+	// cancel pending frame, if any
+	if(_display.framePendingState != FramePendingState::NotPending) {
+		_display.framePendingState = FramePendingState::NotPending;
+		for(size_t i=0; i<display::framePendingWindows.size(); i++)
+			if(display::framePendingWindows[i] == this) {
+				display::framePendingWindows[i] = display::framePendingWindows.back();
+				display::framePendingWindows.pop_back();
+				break;
+			}
+	}
+
+	// release input focus
+	if(display::windowWithFocus == this) {
+		updateFocus(false);
+		display::windowWithFocus = nullptr;
+	}
+	updateWindowState(WindowState::Hidden);
+}
+
+
+void VulkanWindowPrivate::openInputDevices()
+{
+	// open all evdev devices with keys or relative axes
+	// (devices that cannot be opened, usually because of missing permissions, are skipped;
+	// if enabled by setDisplayInputGrab(), the devices are grabbed, so the console below
+	// does not receive the key presses, and devices grabbed by other programs are skipped)
+	bool keyboardFound = false;
+	DIR* dir = opendir("/dev/input");
+	if(dir) {
+		constexpr size_t bitsPerLong = sizeof(unsigned long) * 8;
+		while(dirent* entry = readdir(dir)) {
+			if(strncmp(entry->d_name, "event", 5) != 0)
+				continue;
+			string path = string("/dev/input/") + entry->d_name;
+			int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+			if(fd == -1)
+				continue;
+			unsigned long evBits[EV_MAX/bitsPerLong+1] = {};
+			unsigned long keyBits[KEY_MAX/bitsPerLong+1] = {};
+			if(ioctl(fd, EVIOCGBIT(0, sizeof(evBits)), evBits) == -1 ||
+			   ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) == -1)
+			{
+				close(fd);
+				continue;
+			}
+			auto hasBit = [](const unsigned long* a, unsigned bit) { return (a[bit/bitsPerLong] >> (bit%bitsPerLong)) & 1; };
+			if(!hasBit(evBits, EV_KEY) && !hasBit(evBits, EV_REL)) {
+				close(fd);
+				continue;
+			}
+			if(display::grabInput && ioctl(fd, EVIOCGRAB, 1) == -1) {
+				close(fd);
+				continue;
+			}
+			if(hasBit(evBits, EV_KEY) && hasBit(keyBits, KEY_A))
+				keyboardFound = true;
+			display::pollFds.push_back({ fd, POLLIN, 0 });
+		}
+		closedir(dir);
+	}
+
+	// keymap for KeyCode translation
+	// (it is compiled from XKB_DEFAULT_* environment variables or xkbcommon defaults;
+	// without libxkbcommon, all keys are reported with KeyCode::Unknown)
+	if(!keyboardFound)
+		return;
+	try {
+		loadXkbCommon();
+	} catch(runtime_error&) {
+		return;
+	}
+	display::xkbContext = xkbcommon::funcs.xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+	if(display::xkbContext == nullptr)
+		throw runtime_error("VulkanWindow: Cannot create XKB context.");
+	struct xkb_keymap* keymap = xkbcommon::funcs.xkb_keymap_new_from_names(display::xkbContext, nullptr, XKB_KEYMAP_COMPILE_NO_FLAGS);
+	if(keymap == nullptr)
+		throw runtime_error("VulkanWindow::init(): Cannot create XKB keymap.");
+	display::xkbState = xkbcommon::funcs.xkb_state_new(keymap);
+	xkbcommon::funcs.xkb_keymap_unref(keymap);
+	if(display::xkbState == nullptr)
+		throw runtime_error("VulkanWindow::init(): Cannot create XKB state object.");
+}
+
+
+void VulkanWindowPrivate::processInputEvent(const input_event& e)
+{
+	VulkanWindowPrivate* w = display::windowWithFocus;
+
+	switch(e.type) {
+
+	case EV_KEY: {
+
+		// ignore autorepeat
+		if(e.value == 2)
+			return;
+		bool pressed = e.value != 0;
+
+		// mouse buttons
+		if(e.code >= BTN_MOUSE && e.code < BTN_JOYSTICK) {
+			if(w == nullptr)
+				return;
+			MouseButton::EnumType index;
+			switch(e.code) {
+			case BTN_LEFT:   index = MouseButton::Left; break;
+			case BTN_RIGHT:  index = MouseButton::Right; break;
+			case BTN_MIDDLE: index = MouseButton::Middle; break;
+			case BTN_SIDE:   index = MouseButton::X1; break;
+			case BTN_EXTRA:  index = MouseButton::X2; break;
+			default: index = MouseButton::Unknown;
+			}
+			// update button state
+			// (Unknown does not fit into the buttons bitset, so only the callback gets it)
+			if(index != MouseButton::Unknown)
+				w->_mouseState.buttons.set(index, pressed);
+			if(w->hasMouseButtonHandler()) {
+				w->_mouseState.modifiers = display::modifiers;
+				w->callMouseButton(index, pressed ? ButtonState::Pressed : ButtonState::Released, w->_mouseState);
+			}
+			return;
+		}
+
+		// keyboard keys
+		// (evdev codes are the values of ScanCode enum)
+		if(e.code >= BTN_MISC && e.code < KEY_OK)
+			return;
+		switch(e.code) {
+		case KEY_LEFTCTRL:  case KEY_RIGHTCTRL:  display::modifiers.set(Modifier::Ctrl,  pressed); break;
+		case KEY_LEFTSHIFT: case KEY_RIGHTSHIFT: display::modifiers.set(Modifier::Shift, pressed); break;
+		case KEY_LEFTALT:   case KEY_RIGHTALT:   display::modifiers.set(Modifier::Alt,   pressed); break;
+		case KEY_LEFTMETA:  case KEY_RIGHTMETA:  display::modifiers.set(Modifier::Meta,  pressed); break;
+		}
+		if(w == nullptr)
+			return;
+		uint32_t codePoint = display::xkbState ? xkbcommon::funcs.xkb_state_key_get_utf32(display::xkbState, e.code + 8) : 0;
+		if(w->hasKeyHandler())
+			w->callKey(pressed ? KeyState::Pressed : KeyState::Released, ScanCode(e.code), KeyCode(codePoint));
+		return;
+	}
+
+	case EV_REL:
+
+		// relative motion is accumulated until EV_SYN
+		switch(e.code) {
+		case REL_X: display::pointerRelX += float(e.value); return;
+		case REL_Y: display::pointerRelY += float(e.value); return;
+		case REL_WHEEL:
+			if(w && w->hasMouseWheelHandler()) {
+				w->_mouseState.modifiers = display::modifiers;
+				w->callMouseWheel(0.f, float(e.value), w->_mouseState);
+			}
+			return;
+		case REL_HWHEEL:
+			if(w && w->hasMouseWheelHandler()) {
+				w->_mouseState.modifiers = display::modifiers;
+				w->callMouseWheel(float(e.value), 0.f, w->_mouseState);
+			}
+			return;
+		}
+		return;
+
+	case EV_SYN: {
+
+		// move pointer
+		// (there is no cursor; the position is kept inside the surface)
+		if(display::pointerRelX == 0.f && display::pointerRelY == 0.f)
+			return;
+		float relX = display::pointerRelX;
+		float relY = display::pointerRelY;
+		display::pointerRelX = 0.f;
+		display::pointerRelY = 0.f;
+		if(w == nullptr)
+			return;
+		float x = clamp(w->_mouseState.posX + relX, 0.f, float(max(w->_surfaceWidth, 1u) - 1));
+		float y = clamp(w->_mouseState.posY + relY, 0.f, float(max(w->_surfaceHeight, 1u) - 1));
+		if(w->_mouseState.posX != x || w->_mouseState.posY != y) {
+			w->_mouseState.relX = x - w->_mouseState.posX;
+			w->_mouseState.relY = y - w->_mouseState.posY;
+			w->_mouseState.posX = x;
+			w->_mouseState.posY = y;
+			if(w->hasMouseMoveHandler()) {
+				w->_mouseState.modifiers = display::modifiers;
+				w->callMouseMove(w->_mouseState);
+			}
+		}
+		return;
+	}
+
+	}
+}
+
+
+// wake up the main loop waiting in poll()
+static void wakeUpDisplayMainLoop()
+{
+	uint64_t one = 1;
+	if(!display::pollFds.empty() && write(display::pollFds[0].fd, &one, sizeof(one)) == -1 && errno != EAGAIN)
+		throw runtime_error("VulkanWindow: write() to eventfd failed.");
+}
+
+
+void VulkanWindow::mainLoop()
+{
+	// main loop
+	display::running = true;
+	do {
+
+		// wait for input, wake-up or the time of the deferred frame
+		// (poll() does not block while any frame is pending; pending frames are paced by the frame rate limit
+		// set by create(), which defers them to the frame timer, and by vkQueuePresentKHR() that blocks
+		// in FIFO present mode until a swapchain image is released on vertical blank)
+		frameTimer.arm(VulkanWindowPrivate::scheduleDeferredFrames());
+		int r = poll(display::pollFds.data(), nfds_t(display::pollFds.size()),
+		             display::framePendingWindows.empty() ? -1 : 0);
+		if(r == -1) {
+			if(errno != EINTR)
+				throw runtime_error("VulkanWindow::mainLoop(): poll() failed.");
+			continue;
+		}
+
+		// reset wake fd
+		if(display::pollFds[0].revents & POLLIN) {
+			uint64_t counter;
+			if(read(display::pollFds[0].fd, &counter, sizeof(counter)) == -1 && errno != EAGAIN)
+				throw runtime_error("VulkanWindow::mainLoop(): read() from eventfd failed.");
+		}
+
+		// reset frame timer
+		if(display::pollFds[1].revents & POLLIN)
+			frameTimer.reset();
+
+		// process input
+		for(size_t i=display::firstInputFd; r>0 && i<display::pollFds.size(); ) {
+			pollfd& p = display::pollFds[i];
+			bool remove = p.revents & (POLLERR | POLLHUP | POLLNVAL);
+			if(p.revents & POLLIN) {
+				input_event events[64];
+				ssize_t n;
+				while((n = read(p.fd, events, sizeof(events))) > 0)
+					for(size_t j=0, c=size_t(n)/sizeof(input_event); j<c; j++)
+						VulkanWindowPrivate::processInputEvent(events[j]);
+				if(n == -1 && errno != EAGAIN && errno != EINTR)
+					remove = true;
+			}
+			if(remove) {
+				// unplugged device
+				close(p.fd);
+				display::pollFds.erase(display::pollFds.begin() + i);
+				continue;
+			}
+			i++;
+		}
+		if(!display::running)
+			break;
+
+		// render all windows with _framePendingState set to Pending
+		for(size_t i=0; i<display::framePendingWindows.size(); ) {
+
+			// render frame
+			VulkanWindow* w = display::framePendingWindows[i];
+			w->_display.framePendingState = FramePendingState::TentativePending;
+			w->renderFrame();
+
+			// was frame scheduled again?
+			// (it might be rescheduled again in renderFrame())
+			if(w->_display.framePendingState == FramePendingState::TentativePending) {
+
+				// update state to no-frame-pending
+				w->_display.framePendingState = FramePendingState::NotPending;
+				if(display::framePendingWindows.size() == 1) {
+					display::framePendingWindows.clear();  // all iterators are invalidated
+					break;
+				}
+				else {
+					display::framePendingWindows[i] = display::framePendingWindows.back();
+					display::framePendingWindows.pop_back();  // end() iterator is invalidated
+					continue;
+				}
+			}
+			i++;
+
+		}
+
+	} while(display::running);
+}
+
+
+void VulkanWindow::exitMainLoop()
+{
+	display::running = false;
+	wakeUpDisplayMainLoop();
+}
+
+
+void VulkanWindow::scheduleFrame()
+{
+	// assert for valid usage
+	assert(_surface && "VulkanWindow::_surface is null, indicating invalid VulkanWindow object. Call VulkanWindow::create() to initialize it.");
+
+	_activity = true;  // for idle throttling
+
+	if(_display.framePendingState == FramePendingState::Pending)
+		return;
+
+	if(_display.framePendingState == FramePendingState::NotPending) {
+		display::framePendingWindows.push_back(this);
+		wakeUpDisplayMainLoop();
+	}
+
+	_display.framePendingState = FramePendingState::Pending;
+}
+
+
 #endif
 
 
@@ -5004,13 +8372,19 @@ void VulkanWindow::updateTitle()
 		throw runtime_error("VulkanWindow::updateTitle(): Failed to set window title.");
 }
 
-#elif defined(USE_PLATFORM_XLIB)
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
+
+# if defined(USE_PLATFORM_XLIB)
 
+#  if defined(USE_PLATFORM_WAYLAND)
+void VulkanWindow::xlibUpdateTitle()
+#  else
 void VulkanWindow::updateTitle()
+#  endif
 {
-	XStoreName(xlib::display, _xlib.window, _title.c_str());
+	XStoreName(_xlib.display, _xlib.window, _title.c_str());
 	XChangeProperty(
-		xlib::display,
+		_xlib.display,
 		_xlib.window,
 		xlib::netWmName,  // property
 		xlib::utf8String,  // type
@@ -5021,10 +8395,17 @@ void VulkanWindow::updateTitle()
 	);
 }
 
-#elif defined(USE_PLATFORM_WAYLAND)
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
 
 void VulkanWindow::updateTitle()
 {
+#  if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		xlibUpdateTitle();
+		return;
+	}
+#  endif
 	// if libdecor is used, use libdecor_frame_set_title()
 	// otherwise set it using xdg_toplevel_set_title()
 	if(_wayland.libdecorFrame)
@@ -5033,6 +8414,8 @@ void VulkanWindow::updateTitle()
 		xdg_toplevel_set_title(_wayland.xdgTopLevel, _title.c_str());
 }
 
+# endif
+
 #elif defined(USE_PLATFORM_SDL3)
 
 void VulkanWindow::updateTitle()
@@ -5062,6 +8445,13 @@ void VulkanWindow::updateTitle()
 	_qt.window->setTitle(_title.c_str()); // this treats _title as utf8 string
 }
 
+#elif defined(USE_PLATFORM_DISPLAY)
+
+void VulkanWindow::updateTitle()
+{
+	// there is no title bar on the display
+}
+
 #endif
 
 
@@ -5075,6 +8465,7 @@ VulkanWindow::WindowState VulkanWindow::windowState() const
 
 	WINDOWPLACEMENT wp;
 	wp.length = sizeof(WINDOWPLACEMENT);
+	countRoundTrip();
 	if(!GetWindowPlacement(HWND(_win32.hwnd), &wp))
 		throw runtime_error("VulkanWindow::windowState(): The function GetWindowPlacement() failed.");
 
@@ -5107,9 +8498,15 @@ void VulkanWindow::setWindowState(WindowState windowState)
 	}
 }
 
-#elif defined(USE_PLATFORM_XLIB)
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
+
+# if defined(USE_PLATFORM_XLIB)
 
+#  if defined(USE_PLATFORM_WAYLAND)
+VulkanWindow::WindowState VulkanWindow::xlibWindowState() const
+#  else
 VulkanWindow::WindowState VulkanWindow::windowState() const
+#  endif
 {
 	if(!_xlib.window)
 		return WindowState::Hidden;
@@ -5117,11 +8514,16 @@ VulkanWindow::WindowState VulkanWindow::windowState() const
 	return WindowState::Normal;
 }
 
+#  if defined(USE_PLATFORM_WAYLAND)
+void VulkanWindow::xlibSetWindowState(WindowState windowState)
+#  else
 void VulkanWindow::setWindowState(WindowState windowState)
+#  endif
 {
 }
 
-#elif defined(USE_PLATFORM_WAYLAND)
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
 
 void VulkanWindowPrivate::syncListenerDone(void *data, wl_callback* cb, uint32_t time)
 {
@@ -5131,18 +8533,51 @@ void VulkanWindowPrivate::syncListenerDone(void *data, wl_callback* cb, uint32_t
 
 VulkanWindow::WindowState VulkanWindow::windowState() const
 {
+#  if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected())
+		return xlibWindowState();
+#  endif
 	if(!_wayland.wlSurface)
 		return WindowState::Hidden;
 
 	// make sure all window state changes were processed by Wayland server
-	waitAllSyncEvents(const_cast<unsigned&>(_wayland.numSyncEventsOnTheFly));
+	if(waitAllSyncEvents(const_cast<unsigned&>(_wayland.numSyncEventsOnTheFly), _wayland.eventQueue))
+		countRoundTrip();
 
-	return _wayland.windowState;
+	return _windowState;
 }
 
 void VulkanWindow::setWindowState(WindowState windowState)
 {
-	assert(_wayland.wlSurface && "VulkanWindow::setWindowState() called on VulkanWindow without created wlSurface. Call VulkanWindow::create() first.");
+#  if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		xlibSetWindowState(windowState);
+		return;
+	}
+#  endif
+	// request the change
+	requestWindowState(windowState);
+
+	// wait for the server to process it
+	countRoundTrip();
+	if(_wayland.eventQueue) {
+		if(wl_display_roundtrip_queue(wayland::display, _wayland.eventQueue) == -1)
+			throw runtime_error("wl_display_roundtrip_queue() failed.");
+	}
+	else
+		if(wl_display_roundtrip(wayland::display) == -1)
+			throw runtime_error("wl_display_roundtrip() failed.");
+}
+
+void VulkanWindow::requestWindowState(WindowState windowState)
+{
+#  if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected()) {
+		xlibSetWindowState(windowState);
+		return;
+	}
+#  endif
+	assert(_wayland.wlSurface && "VulkanWindow::requestWindowState() called on VulkanWindow without created wlSurface. Call VulkanWindow::create() first.");
 
 	// change window state
 	switch(windowState) {
@@ -5189,7 +8624,7 @@ void VulkanWindow::setWindowState(WindowState windowState)
 			}
 
 			// send callback
-			wl_callback* callback = wl_display_sync(wayland::display);
+			wl_callback* callback = wl_display_sync(_wayland.displayWrapper ? _wayland.displayWrapper : wayland::display);
 			if(wl_callback_add_listener(callback, &syncListener, this))
 				throw runtime_error("wl_callback_add_listener() failed.");
 			_wayland.numSyncEventsOnTheFly++;
@@ -5219,7 +8654,7 @@ void VulkanWindow::setWindowState(WindowState windowState)
 			}
 
 			// send callback
-			wl_callback* callback = wl_display_sync(wayland::display);
+			wl_callback* callback = wl_display_sync(_wayland.displayWrapper ? _wayland.displayWrapper : wayland::display);
 			if(wl_callback_add_listener(callback, &syncListener, this))
 				throw runtime_error("wl_callback_add_listener() failed.");
 			_wayland.numSyncEventsOnTheFly++;
@@ -5245,7 +8680,7 @@ void VulkanWindow::setWindowState(WindowState windowState)
 				xdg_toplevel_set_fullscreen(_wayland.xdgTopLevel, nullptr);
 
 			// send callback
-			wl_callback* callback = wl_display_sync(wayland::display);
+			wl_callback* callback = wl_display_sync(_wayland.displayWrapper ? _wayland.displayWrapper : wayland::display);
 			if(wl_callback_add_listener(callback, &syncListener, this))
 				throw runtime_error("wl_callback_add_listener() failed.");
 			_wayland.numSyncEventsOnTheFly++;
@@ -5254,12 +8689,12 @@ void VulkanWindow::setWindowState(WindowState windowState)
 		}
 		break;
 	default:
-		throw runtime_error("VulkanWindow::setWindowState(): Invalid WindowState value passed as parameter.");
+		throw runtime_error("VulkanWindow::requestWindowState(): Invalid WindowState value passed as parameter.");
 	}
-	if(wl_display_roundtrip(wayland::display) == -1)
-		throw runtime_error("wl_display_roundtrip() failed.");
 }
 
+# endif
+
 #elif defined(USE_PLATFORM_SDL3)
 
 VulkanWindow::WindowState VulkanWindow::windowState() const
@@ -5267,6 +8702,7 @@ VulkanWindow::WindowState VulkanWindow::windowState() const
 	if(!_sdl.window)
 		return WindowState::Hidden;
 
+	countRoundTrip();
 	SDL_WindowFlags f = SDL_GetWindowFlags(_sdl.window);
 	if(f & SDL_WINDOW_HIDDEN)
 		return WindowState::Hidden;
@@ -5283,6 +8719,7 @@ VulkanWindow::WindowState VulkanWindow::windowState() const
 void VulkanWindow::setWindowState(WindowState windowState)
 {
 	// leave fullscreen mode if needed
+	countRoundTrip();
 	SDL_WindowFlags f = SDL_GetWindowFlags(_sdl.window);
 	if(f & SDL_WINDOW_FULLSCREEN) {
 		if(windowState == WindowState::FullScreen)
@@ -5328,6 +8765,7 @@ VulkanWindow::WindowState VulkanWindow::windowState() const
 	if(!_sdl.window)
 		return WindowState::Hidden;
 
+	countRoundTrip();
 	Uint32 f = SDL_GetWindowFlags(_sdl.window);
 	if(f & SDL_WINDOW_HIDDEN)
 		return WindowState::Hidden;
@@ -5344,6 +8782,7 @@ VulkanWindow::WindowState VulkanWindow::windowState() const
 void VulkanWindow::setWindowState(WindowState windowState)
 {
 	// leave fullscreen mode if needed
+	countRoundTrip();
 	Uint32 f = SDL_GetWindowFlags(_sdl.window);
 	if(f & SDL_WINDOW_FULLSCREEN) {
 		if(windowState == WindowState::FullScreen)
@@ -5373,6 +8812,7 @@ VulkanWindow::WindowState VulkanWindow::windowState() const
 	if(!_glfw.window)
 		return WindowState::Hidden;
 
+	countRoundTrip();
 	if(!glfwGetWindowAttrib(_glfw.window, GLFW_VISIBLE))
 		return WindowState::Hidden;
 	if(glfwGetWindowAttrib(_glfw.window, GLFW_ICONIFIED))
@@ -5415,6 +8855,10 @@ void VulkanWindow::setWindowState(WindowState windowState)
 		}
 	default: throw runtime_error("VulkanWindow::setWindowState(): Invalid WindowState value passed as parameter.");
 	}
+
+	// GLFW has no fullscreen change callback
+	if(_glfw.visible)
+		updateWindowState(windowState());
 }
 
 #elif defined(USE_PLATFORM_QT)
@@ -5424,6 +8868,7 @@ VulkanWindow::WindowState VulkanWindow::windowState() const
 	if(!_qt.window || !_qt.window->isVisible())
 		return WindowState::Hidden;
 
+	countRoundTrip();
 	switch(_qt.window->windowState()) {
 	case Qt::WindowMinimized:   return WindowState::Minimized;
 	case Qt::WindowNoState:     return WindowState::Normal;
@@ -5445,6 +8890,526 @@ void VulkanWindow::setWindowState(WindowState windowState)
 	}
 }
 
+#elif defined(USE_PLATFORM_DISPLAY)
+
+VulkanWindow::WindowState VulkanWindow::windowState() const
+{
+	// the window always covers the whole display
+	if(!_display.display || !_display.visible)
+		return WindowState::Hidden;
+	return WindowState::FullScreen;
+}
+
+void VulkanWindow::setWindowState(WindowState windowState)
+{
+	switch(windowState) {
+	case WindowState::Hidden:     hide(); break;
+	case WindowState::Minimized:
+	case WindowState::Normal:
+	case WindowState::Maximized:
+	case WindowState::FullScreen: show(); break;
+	default: throw runtime_error("VulkanWindow::setWindowState(): Invalid WindowState value passed as parameter.");
+	}
+}
+
+#endif
+
+
+#if !defined(USE_PLATFORM_WAYLAND)
+
+// setWindowState() does not block on the other platforms,
+// so requestWindowState() is the same function
+void VulkanWindow::requestWindowState(WindowState windowState)
+{
+	setWindowState(windowState);
+}
+
+#endif
+
+
+
+#if defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_GLFW)
+
+// return handles of the outputs intersecting the rectangle
+static vector<void*> outputsIntersectingRect(const vector<VulkanWindow::Output>& outputs, int x, int y, int width, int height)
+{
+	vector<void*> r;
+	width = max(width, 1);
+	height = max(height, 1);
+	for(const VulkanWindow::Output& o : outputs)
+		if(x < o.posX + int(o.width) && o.posX < x + width &&
+		   y < o.posY + int(o.height) && o.posY < y + height)
+			r.push_back(o.handle);
+	return r;
+}
+
+#endif
+
+
+#if defined(USE_PLATFORM_WIN32)
+
+static BOOL CALLBACK monitorEnumProc(HMONITOR hMonitor, HDC, LPRECT, LPARAM data)
+{
+	// GetDpiForMonitor() is available since Windows 8.1,
+	// so we get it dynamically
+	typedef HRESULT (WINAPI *PFN_GetDpiForMonitor)(HMONITOR hmonitor, int dpiType, UINT* dpiX, UINT* dpiY);
+	static const PFN_GetDpiForMonitor getDpiForMonitor =
+		[]() -> PFN_GetDpiForMonitor {
+			HMODULE h = LoadLibraryW(L"Shcore.dll");
+			return h ? reinterpret_cast<PFN_GetDpiForMonitor>(GetProcAddress(h, "GetDpiForMonitor")) : nullptr;
+		}();
+
+	// monitor info
+	MONITORINFOEXW info;
+	info.cbSize = sizeof(MONITORINFOEXW);
+	if(!GetMonitorInfoW(hMonitor, &info))
+		return TRUE;
+	VulkanWindow::Output& o = reinterpret_cast<vector<VulkanWindow::Output>*>(data)->emplace_back();
+	int l = WideCharToMultiByte(CP_UTF8, 0, info.szDevice, -1, nullptr, 0, nullptr, nullptr);
+	if(l > 1) {
+		o.name.resize(l-1);
+		WideCharToMultiByte(CP_UTF8, 0, info.szDevice, -1, o.name.data(), l, nullptr, nullptr);
+	}
+	o.posX = info.rcMonitor.left;
+	o.posY = info.rcMonitor.top;
+	o.width = info.rcMonitor.right - info.rcMonitor.left;
+	o.height = info.rcMonitor.bottom - info.rcMonitor.top;
+
+	// refresh rate
+	// (values 0 and 1 mean default refresh rate of the hardware)
+	DEVMODEW mode;
+	mode.dmSize = sizeof(DEVMODEW);
+	mode.dmDriverExtra = 0;
+	if(EnumDisplaySettingsW(info.szDevice, ENUM_CURRENT_SETTINGS, &mode) && mode.dmDisplayFrequency > 1)
+		o.refreshRate = mode.dmDisplayFrequency;
+
+	// scale
+	UINT dpiX, dpiY;
+	if(getDpiForMonitor && getDpiForMonitor(hMonitor, 0 /*MDT_EFFECTIVE_DPI*/, &dpiX, &dpiY) == S_OK)
+		o.scale = double(dpiX) / 96.;
+
+	o.handle = hMonitor;
+	return TRUE;
+}
+
+
+vector<VulkanWindow::Output> VulkanWindow::queryOutputs(size_t& numRoundTrips)
+{
+	vector<Output> l;
+	numRoundTrips++;
+	if(!EnumDisplayMonitors(NULL, NULL, monitorEnumProc, LPARAM(&l)))
+		throw runtime_error("VulkanWindow::outputs(): EnumDisplayMonitors() failed.");
+	return l;
+}
+
+
+vector<void*> VulkanWindow::queryOutputHandles() const
+{
+	// Win32 reports only the monitor with the largest intersection
+	countRoundTrip();
+	HMONITOR m = MonitorFromWindow(HWND(_win32.hwnd), MONITOR_DEFAULTTONULL);
+	if(m == NULL)
+		return {};
+	return { m };
+}
+
+#elif defined(USE_PLATFORM_XLIB) || defined(USE_PLATFORM_WAYLAND)
+
+# if defined(USE_PLATFORM_XLIB)
+
+// vertical refresh range from the display range limits descriptor of EDID base block
+// (descriptors are at offsets 54, 72, 90 and 108; the range limits descriptor has tag 0xFD,
+// byte 4 holds EDID 1.4 offset flags adding 255 Hz to the rates, bytes 5 and 6 hold min and max rate in Hz)
+static void getEdidRefreshRange(const unsigned char* edid, size_t size, double& minRate, double& maxRate)
+{
+	if(size < 128)
+		return;
+	for(size_t offset : { 54, 72, 90, 108 }) {
+		const unsigned char* d = edid + offset;
+		if(d[0] != 0 || d[1] != 0 || d[2] != 0 || d[3] != 0xfd)
+			continue;
+		unsigned minOffset = (d[4] & 0x03) == 0x03 ? 255 : 0;
+		unsigned maxOffset = (d[4] & 0x02) ? 255 : 0;
+		if(d[5] != 0 && d[6] >= d[5]) {
+			minRate = d[5] + minOffset;
+			maxRate = d[6] + maxOffset;
+		}
+		return;
+	}
+}
+
+
+// query outputs using XRandR
+// (each XRandR request is a round trip, their number is added to numRoundTrips)
+static vector<VulkanWindow::Output> getXrandrOutputs(Display* display, size_t& numRoundTrips)
+{
+	loadXrandr();
+
+	// screen resources
+	XRRScreenResources* resources = xrandr::funcs.XRRGetScreenResourcesCurrent(display, DefaultRootWindow(display));
+	numRoundTrips++;
+	if(resources == nullptr)
+		throw runtime_error("VulkanWindow::outputs(): XRRGetScreenResourcesCurrent() failed.");
+	Atom vrrCapableAtom = XInternAtom(display, "vrr_capable", True);
+	numRoundTrips++;
+	Atom edidAtom = XInternAtom(display, "EDID", True);
+	numRoundTrips++;
+
+	// scale given by Xft.dpi resource
+	// (XResourceManagerString() returns cached string without round trip)
+	double scale = 1.;
+	if(const char* resourceString = XResourceManagerString(display); resourceString)
+		if(const char* s = strstr(resourceString, "Xft.dpi:"); s) {
+			double dpi = strtod(s + 8, nullptr);
+			if(dpi > 0.)
+				scale = dpi / 96.;
+		}
+
+	// connected outputs driven by a CRTC
+	vector<VulkanWindow::Output> l;
+	for(int i=0; i<resources->noutput; i++) {
+
+		XRROutputInfo* outputInfo = xrandr::funcs.XRRGetOutputInfo(display, resources, resources->outputs[i]);
+		numRoundTrips++;
+		if(outputInfo == nullptr)
+			continue;
+		if(outputInfo->connection != RR_Connected || outputInfo->crtc == 0) {
+			xrandr::funcs.XRRFreeOutputInfo(outputInfo);
+			continue;
+		}
+		XRRCrtcInfo* crtcInfo = xrandr::funcs.XRRGetCrtcInfo(display, resources, outputInfo->crtc);
+		numRoundTrips++;
+		if(crtcInfo == nullptr) {
+			xrandr::funcs.XRRFreeOutputInfo(outputInfo);
+			continue;
+		}
+
+		// position and size
+		// (CRTC size already includes rotation)
+		VulkanWindow::Output& o = l.emplace_back();
+		o.name.assign(outputInfo->name, outputInfo->nameLen);
+		o.posX = crtcInfo->x;
+		o.posY = crtcInfo->y;
+		o.width = crtcInfo->width;
+		o.height = crtcInfo->height;
+		o.scale = scale;
+		o.handle = reinterpret_cast<void*>(resources->outputs[i]);
+
+		// refresh rate computed from mode timings
+		for(int j=0; j<resources->nmode; j++) {
+			const XRRModeInfo& m = resources->modes[j];
+			if(m.id == crtcInfo->mode) {
+				double vTotal = m.vTotal;
+				if(m.modeFlags & RR_DoubleScan)
+					vTotal *= 2.;
+				if(m.modeFlags & RR_Interlace)
+					vTotal /= 2.;
+				if(m.hTotal != 0 && vTotal != 0.)
+					o.refreshRate = double(m.dotClock) / (double(m.hTotal) * vTotal);
+				break;
+			}
+		}
+
+		// VRR capability
+		// (vrr_capable property is set by amdgpu, i915 and nouveau drivers)
+		if(vrrCapableAtom != None) {
+			Atom actualType;
+			int actualFormat;
+			unsigned long numItems, bytesAfter;
+			unsigned char* prop = nullptr;
+			if(xrandr::funcs.XRRGetOutputProperty(display, resources->outputs[i], vrrCapableAtom, 0, 1, False, False,
+					AnyPropertyType, &actualType, &actualFormat, &numItems, &bytesAfter, &prop) == Success && prop)
+			{
+				if(actualFormat == 32 && numItems == 1)
+					o.vrrCapable = *reinterpret_cast<long*>(prop) != 0;
+				XFree(prop);
+			}
+			numRoundTrips++;
+		}
+
+		// VRR range
+		// (monitor refresh range from EDID; the property length is given in 32-bit units)
+		if(o.vrrCapable && edidAtom != None) {
+			Atom actualType;
+			int actualFormat;
+			unsigned long numItems, bytesAfter;
+			unsigned char* prop = nullptr;
+			if(xrandr::funcs.XRRGetOutputProperty(display, resources->outputs[i], edidAtom, 0, 32, False, False,
+					AnyPropertyType, &actualType, &actualFormat, &numItems, &bytesAfter, &prop) == Success && prop)
+			{
+				if(actualFormat == 8)
+					getEdidRefreshRange(prop, numItems, o.vrrMinRefreshRate, o.vrrMaxRefreshRate);
+				XFree(prop);
+			}
+			numRoundTrips++;
+		}
+
+		xrandr::funcs.XRRFreeCrtcInfo(crtcInfo);
+		xrandr::funcs.XRRFreeOutputInfo(outputInfo);
+	}
+	xrandr::funcs.XRRFreeScreenResources(resources);
+	return l;
+}
+
+
+#  if defined(USE_PLATFORM_WAYLAND)
+vector<VulkanWindow::Output> VulkanWindow::xlibQueryOutputs(size_t& numRoundTrips)
+#  else
+vector<VulkanWindow::Output> VulkanWindow::queryOutputs(size_t& numRoundTrips)
+#  endif
+{
+	assert(xlib::display && "VulkanWindow::init() must be called before VulkanWindow::outputs().");
+
+	return getXrandrOutputs(xlib::threadDisplay ? xlib::threadDisplay : xlib::display, numRoundTrips);
+}
+
+
+vector<void*> VulkanWindow::queryOutputHandles() const
+{
+	// window rectangle in root window coordinates
+	Display* display = _xlib.display;
+	Window root, child;
+	int x, y;
+	unsigned width, height, borderWidth, depth;
+	XGetGeometry(display, _xlib.window, &root, &x, &y, &width, &height, &borderWidth, &depth);
+	XTranslateCoordinates(display, _xlib.window, root, 0, 0, &x, &y, &child);
+	size_t numRoundTrips = 2;
+
+	// outputs intersecting the window
+	vector<Output> l = getXrandrOutputs(display, numRoundTrips);
+	_roundTripCount += numRoundTrips;
+	_globalRoundTripCount += numRoundTrips;
+	return outputsIntersectingRect(l, x, y, int(width), int(height));
+}
+
+# endif
+# if defined(USE_PLATFORM_WAYLAND)
+
+vector<VulkanWindow::Output> VulkanWindow::queryOutputs(size_t& numRoundTrips)
+{
+#  if defined(USE_PLATFORM_XLIB)
+	if(xlibSelected())
+		return xlibQueryOutputs(numRoundTrips);
+#  endif
+	// outputs are maintained by wl_output events
+	lock_guard<mutex> lock(wayland::outputsMutex);
+	vector<Output> l;
+	l.reserve(wayland::outputs.size());
+	for(auto& item : wayland::outputs)
+		l.push_back(item.second.output);
+	return l;
+}
+
+# endif
+
+#elif defined(USE_PLATFORM_SDL3)
+
+vector<VulkanWindow::Output> VulkanWindow::queryOutputs(size_t& numRoundTrips)
+{
+	int count;
+	numRoundTrips++;
+	SDL_DisplayID* displays = SDL_GetDisplays(&count);
+	if(displays == nullptr)
+		throw runtime_error(string("VulkanWindow::outputs(): SDL_GetDisplays() function failed. Error details: ") + SDL_GetError());
+
+	vector<Output> l;
+	l.reserve(count);
+	for(int i=0; i<count; i++) {
+		SDL_DisplayID id = displays[i];
+		Output& o = l.emplace_back();
+		if(const char* name = SDL_GetDisplayName(id); name)
+			o.name = name;
+		SDL_Rect r;
+		if(SDL_GetDisplayBounds(id, &r)) {
+			o.posX = r.x;
+			o.posY = r.y;
+		}
+		if(const SDL_DisplayMode* mode = SDL_GetCurrentDisplayMode(id); mode) {
+			o.width = uint32_t(lroundf(mode->w * mode->pixel_density));
+			o.height = uint32_t(lroundf(mode->h * mode->pixel_density));
+			o.refreshRate = mode->refresh_rate;
+		}
+		float scale = SDL_GetDisplayContentScale(id);
+		o.scale = (scale > 0.f) ? scale : 1.;
+		o.handle = reinterpret_cast<void*>(uintptr_t(id));
+	}
+	SDL_free(displays);
+	return l;
+}
+
+
+vector<void*> VulkanWindow::queryOutputHandles() const
+{
+	countRoundTrip();
+	SDL_DisplayID id = SDL_GetDisplayForWindow(_sdl.window);
+	if(id == 0)
+		return {};
+	return { reinterpret_cast<void*>(uintptr_t(id)) };
+}
+
+#elif defined(USE_PLATFORM_SDL2)
+
+vector<VulkanWindow::Output> VulkanWindow::queryOutputs(size_t& numRoundTrips)
+{
+	numRoundTrips++;
+	int count = SDL_GetNumVideoDisplays();
+	if(count < 0)
+		throw runtime_error(string("VulkanWindow::outputs(): SDL_GetNumVideoDisplays() function failed. Error details: ") + SDL_GetError());
+
+	// handle is display index + 1
+	// (SDL2 has no display ids and nullptr is not a valid handle)
+	vector<Output> l;
+	l.reserve(count);
+	for(int i=0; i<count; i++) {
+		Output& o = l.emplace_back();
+		if(const char* name = SDL_GetDisplayName(i); name)
+			o.name = name;
+		SDL_Rect r;
+		if(SDL_GetDisplayBounds(i, &r) == 0) {
+			o.posX = r.x;
+			o.posY = r.y;
+		}
+		SDL_DisplayMode mode;
+		if(SDL_GetCurrentDisplayMode(i, &mode) == 0) {
+			o.width = mode.w;
+			o.height = mode.h;
+			o.refreshRate = mode.refresh_rate;
+		}
+		float hdpi;
+		o.scale = (SDL_GetDisplayDPI(i, nullptr, &hdpi, nullptr) == 0 && hdpi > 0.f) ? hdpi / 96. : 1.;
+		o.handle = reinterpret_cast<void*>(uintptr_t(i + 1));
+	}
+	return l;
+}
+
+
+vector<void*> VulkanWindow::queryOutputHandles() const
+{
+	countRoundTrip();
+	int index = SDL_GetWindowDisplayIndex(_sdl.window);
+	if(index < 0)
+		return {};
+	return { reinterpret_cast<void*>(uintptr_t(index + 1)) };
+}
+
+#elif defined(USE_PLATFORM_GLFW)
+
+vector<VulkanWindow::Output> VulkanWindow::queryOutputs(size_t& numRoundTrips)
+{
+	int count;
+	numRoundTrips++;
+	GLFWmonitor** monitors = glfwGetMonitors(&count);
+	if(monitors == nullptr)
+		return {};
+
+	vector<Output> l;
+	l.reserve(count);
+	for(int i=0; i<count; i++) {
+		GLFWmonitor* m = monitors[i];
+		Output& o = l.emplace_back();
+		if(const char* name = glfwGetMonitorName(m); name)
+			o.name = name;
+		glfwGetMonitorPos(m, &o.posX, &o.posY);
+		if(const GLFWvidmode* mode = glfwGetVideoMode(m); mode) {
+			o.width = mode->width;
+			o.height = mode->height;
+			o.refreshRate = mode->refreshRate;
+		}
+		float xScale, yScale;
+		glfwGetMonitorContentScale(m, &xScale, &yScale);
+		o.scale = (xScale > 0.f) ? xScale : 1.;
+		o.handle = m;
+	}
+	return l;
+}
+
+
+vector<void*> VulkanWindow::queryOutputHandles() const
+{
+	// fullscreen window is assigned to a monitor
+	if(GLFWmonitor* m = glfwGetWindowMonitor(_glfw.window); m)
+		return { m };
+
+	// windowed mode
+	int x, y, width, height;
+	glfwGetWindowPos(_glfw.window, &x, &y);
+	glfwGetWindowSize(_glfw.window, &width, &height);
+	size_t numRoundTrips = 2;
+	vector<Output> l = queryOutputs(numRoundTrips);
+	_roundTripCount += numRoundTrips;
+	_globalRoundTripCount += numRoundTrips;
+	return outputsIntersectingRect(l, x, y, width, height);
+}
+
+#elif defined(USE_PLATFORM_QT)
+
+vector<VulkanWindow::Output> VulkanWindow::queryOutputs(size_t& numRoundTrips)
+{
+	numRoundTrips++;
+	const QList<QScreen*> screens = QGuiApplication::screens();
+	vector<Output> l;
+	l.reserve(screens.size());
+	for(QScreen* screen : screens) {
+		Output& o = l.emplace_back();
+		o.name = screen->name().toStdString();
+		QRect g = screen->geometry();
+		double dpr = screen->devicePixelRatio();
+		o.posX = g.x();
+		o.posY = g.y();
+		o.width = uint32_t(lround(g.width() * dpr));
+		o.height = uint32_t(lround(g.height() * dpr));
+		o.refreshRate = screen->refreshRate();
+		o.scale = dpr;
+		o.handle = screen;
+	}
+	return l;
+}
+
+
+vector<void*> VulkanWindow::queryOutputHandles() const
+{
+	countRoundTrip();
+	QScreen* screen = _qt.window->screen();
+	if(screen == nullptr)
+		return {};
+	return { screen };
+}
+
+#elif defined(USE_PLATFORM_DISPLAY)
+
+vector<VulkanWindow::Output> VulkanWindow::queryOutputs(size_t&)
+{
+	// displays are enumerated through the Vulkan instance,
+	// so no outputs are known before the first create()
+	if(display::instance == nullptr)
+		return {};
+
+	DisplayFuncs f = getDisplayFuncs(display::instance, display::getInstanceProcAddr);
+	vector<DisplayInfo> displays = getDisplays(f, display::instance);
+	vector<Output> l;
+	l.reserve(displays.size());
+	for(const DisplayInfo& d : displays) {
+		Output& o = l.emplace_back();
+		if(d.properties.displayName)
+			o.name = d.properties.displayName;
+		o.width = d.properties.physicalResolution.width;
+		o.height = d.properties.physicalResolution.height;
+		const VkDisplayModePropertiesKHR* mode = findDisplayMode(getDisplayModes(f, d), o.width, o.height);
+		if(mode)
+			o.refreshRate = double(mode->refreshRate) / 1000.;
+		o.handle = reinterpret_cast<void*>(uintptr_t(d.properties.display));
+	}
+	return l;
+}
+
+
+vector<void*> VulkanWindow::queryOutputHandles() const
+{
+	if(!_display.display)
+		return {};
+	return { reinterpret_cast<void*>(uintptr_t(_display.display)) };
+}
+
 #endif
 
 
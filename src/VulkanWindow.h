@@ -5,12 +5,14 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <cstdint>
 #include <exception>
 #include <functional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 // Vulkan C99 API
 // (the minimal part required by VulkanWindow.h)
@@ -53,6 +55,31 @@ public:
 
 	// window state
 	enum class WindowState { Hidden, Minimized, Normal, Maximized, FullScreen };
+	typedef void WindowStateChangedCallback(VulkanWindow& window, WindowState windowState);
+
+	// outputs (monitors)
+	struct Output {
+		std::string name;
+		int32_t posX = 0, posY = 0;  // position in the desktop coordinates; Wayland compositors often report zero
+		uint32_t width = 0, height = 0;  // resolution of the current mode in pixels
+		double refreshRate = 0.;  // in Hz; zero if unknown
+		double scale = 1.;  // content scale, 1 if the output is not scaled
+		bool vrrCapable = false;  // variable refresh rate support; reported only on Xlib, false if unknown
+		double vrrMinRefreshRate = 0., vrrMaxRefreshRate = 0.;  // VRR range in Hz from EDID; reported only on Xlib, zero if unknown
+		void* handle = nullptr;  // HMONITOR, RROutput, wl_output*, SDL_DisplayID (display index + 1 on SDL2), GLFWmonitor*, QScreen* or VkDisplayKHR
+	};
+	typedef void OutputsChangedCallback(VulkanWindow& window);
+
+	// startup timing
+	// (duration of particular init() and create() steps in seconds;
+	// steps not performed on the current platform remain zero)
+	struct StartupTimes {
+		double displayConnection;  // X or Wayland connection, SDL or GLFW initialization
+		double registryRoundTrips;  // Wayland only
+		double cursorThemeLoad;  // Wayland only, measured on the first pointer enter
+		double libdecorLoad;  // Wayland only, dlopen() and libdecor_new()
+		double surfaceCreation;  // window and VkSurfaceKHR creation of the last create() call
+	};
 
 	// input structures and enums
 	struct MouseButton {
@@ -122,78 +149,147 @@ public:
 	static std::string toString(KeyCode keyCode);
 	static std::array<char, 5> toCharArray(KeyCode keyCode);
 
+	// polled input state
+	// (kept up to date by the event processing; relative motion and wheel are accumulated
+	// since the last frame; snapshot() returns the state taken at the start of the last renderFrame())
+	struct InputState {
+		std::bitset<256> keys;  // indexed by ScanCode
+		std::bitset<16> buttons;  // indexed by MouseButton
+		std::bitset<16> modifiers;  // indexed by Modifier
+		float posX, posY;
+		float relX, relY;
+		float wheelX, wheelY;
+		bool isKeyPressed(ScanCode scanCode) const  { return size_t(scanCode) < keys.size() && keys[size_t(scanCode)]; }
+		bool isButtonPressed(MouseButton::EnumType button) const  { return size_t(button) < buttons.size() && buttons[button]; }
+	};
+
+	// queued event
+	// (returned by pollEvents(); mouseState is valid for mouse events)
+	struct Event {
+		enum class Type : uint8_t { MouseMove, MouseButton, MouseWheel, Key, Resize, Close, WindowStateChanged };
+		Type type;
+		union {
+			struct { MouseButton::EnumType button; ButtonState buttonState; } mouseButton;
+			struct { float wheelX, wheelY; } mouseWheel;
+			struct { KeyState keyState; ScanCode scanCode; KeyCode key; } key;
+			struct { uint32_t width, height; } resize;
+			WindowState windowState;
+		};
+		MouseState mouseState;
+	};
+
 	// input function prototypes
 	typedef void MouseMoveCallback(VulkanWindow& window, const MouseState& mouseState);
 	typedef void MouseButtonCallback(VulkanWindow& window, MouseButton::EnumType button, ButtonState buttonState, const MouseState& mouseState);
 	typedef void MouseWheelCallback(VulkanWindow& window, float wheelX, float wheelY, const MouseState& mouseState);
 	typedef void KeyCallback(VulkanWindow& window, KeyState newKeyState, ScanCode scanCode, KeyCode key);
 
+	// listener
+	// (alternative to std::function callbacks; when the listener is set, it receives all events
+	// instead of the callbacks, each dispatched by a single virtual call)
+	class Listener {
+	public:
+		virtual ~Listener() = default;
+		virtual void onFrame(VulkanWindow& window) = 0;
+		virtual void onResize(VulkanWindow& window, uint32_t& widthToBeSet, uint32_t& heightToBeSet) = 0;
+		virtual void onClose(VulkanWindow& window);  // default implementation hides the window and exits main loop
+		virtual void onWindowStateChanged(VulkanWindow& /*window*/, WindowState /*windowState*/)  {}
+		virtual void onMouseMove(VulkanWindow& /*window*/, const MouseState& /*mouseState*/)  {}
+		virtual void onMouseButton(VulkanWindow& /*window*/, MouseButton::EnumType /*button*/, ButtonState /*buttonState*/, const MouseState& /*mouseState*/)  {}
+		virtual void onMouseWheel(VulkanWindow& /*window*/, float /*wheelX*/, float /*wheelY*/, const MouseState& /*mouseState*/)  {}
+		virtual void onKey(VulkanWindow& /*window*/, KeyState /*newKeyState*/, ScanCode /*scanCode*/, KeyCode /*key*/)  {}
+		virtual void onOutputsChanged(VulkanWindow& /*window*/)  {}
+	};
+
 protected:
 
 	enum class FramePendingState { NotPending, Pending, TentativePending };
 	friend class QtRenderingWindow;
+	friend class VulkanWindowReplayer;
+
+	// hot data
+	// (touched on every frame or every input event; the members up to the frame pending state
+	// at the beginning of the platform structures fit into the first 64 bytes of the object,
+	// so they occupy a single cache line when the object is allocated on the cache line boundary)
+	uint32_t _surfaceWidth = 0;
+	uint32_t _surfaceHeight = 0;
+	bool _resizePending = true;
+	bool _inputStateTracking = false;
+	bool _eventQueueEnabled = false;
+	bool _activity = false;  // input or scheduleFrame() call since the last frame, used by idle throttling
+	WindowState _windowState = WindowState::Hidden;  // last known window state
+	Listener* _listener = nullptr;
+	MouseState _mouseState = {};
 
+	// platform data
+	// (each structure starts with its frame pending state followed by the window handle
+	// and the cold members)
 	union {
 
 		struct {
-			void* handle = nullptr;
+			uint64_t data[2] = {};  // zero-initializes the frame pending state and the window handle of all platforms
 		} _any;
 
 		struct {
 
-			void* hwnd;  // void* is used instead of HWND type to avoid #include <windows.h>
 			FramePendingState framePendingState;
 			bool visible;
 			bool hiddenWindowFramePending;
 			bool titleBarLeftButtonDownMsgOnHold;
+			bool trackingMouseLeave;
+			void* hwnd;  // void* is used instead of HWND type to avoid #include <windows.h>
 			int64_t titleBarLeftButtonDownPos;
 
 		} _win32;
 
 		struct {
 
-			unsigned long window;  // unsigned long is used for Window type
 			bool framePending;
 			bool visible;
 			bool fullyObscured;
 			bool iconVisible;
 			bool minimized;
+			unsigned long window;  // unsigned long is used for Window type
+			struct _XDisplay* display;  // display connection the window was created on (main or per-thread one)
 
 		} _xlib;
 
 		struct {
 
-			// objects
+			// hot objects and state
+			struct wl_callback* scheduledFrameCallback;
 			struct wl_surface* wlSurface;
+			bool forcedFrame;
+			unsigned numSyncEventsOnTheFly;
+
+			// cold objects
+			struct wl_event_queue* eventQueue;  // per-thread event queue or nullptr for the default queue
+			struct wl_display* displayWrapper;  // display wrapper assigned to eventQueue or nullptr
+			struct WaylandInputBuffer* inputBuffer;  // input events forwarded to the thread owning the window
 			struct xdg_surface* xdgSurface;
 			struct xdg_toplevel* xdgTopLevel;
 			struct zxdg_toplevel_decoration_v1* decoration;
 			struct libdecor_frame* libdecorFrame;
-			struct wl_callback* scheduledFrameCallback;
-
-			// state
-			bool forcedFrame;
-			unsigned numSyncEventsOnTheFly;
-			WindowState windowState;
+			struct wl_buffer* placeholderBuffer;  // placeholder content until the first present, or nullptr
 
 		} _wayland;
 
 		struct {
 
-			struct SDL_Window* window;
 			bool framePending;
 			bool hiddenWindowFramePending;
 			bool visible;
 			bool minimized;
+			struct SDL_Window* window;
 
 		} _sdl;
 
 		struct {
 
-			struct GLFWwindow* window;
 			FramePendingState framePendingState;
 			bool visible;
 			bool minimized;
+			struct GLFWwindow* window;
 			int savedPosX;
 			int savedPosY;
 			int savedWidth;
@@ -207,40 +303,143 @@ protected:
 
 		} _qt;
 
+		struct {
+
+			FramePendingState framePendingState;
+			bool visible;
+			uint64_t display;  // uint64_t is used for VkDisplayKHR type
+			uint32_t planeIndex;
+
+		} _display;
+
 	};
 
+	// frame data
 	std::function<FrameCallback> _frameCallback;
+	int64_t _frameInterval = 0;  // frame rate limit in nanoseconds, zero means no limit
+	int64_t _nextFrameTime = 0;  // steady clock nanoseconds
+	int64_t _idleTimeout = 0;  // nanoseconds without activity before throttling, zero means no idle throttling
+	int64_t _idleFrameInterval = 0;  // frame interval of idle window in nanoseconds
+	int64_t _lastActivityTime = 0;  // steady clock nanoseconds
+	bool _idle = false;
+	bool _focused = true;
+	bool _throttleWhenUnfocused = true;
+	bool _frameDeferred = false;  // the frame waits for its time in the main loop, see waitForFrameTime()
+
+	// input data
+	std::function<MouseMoveCallback> _mouseMoveCallback;
+	InputState _inputState = {};
+	InputState _inputSnapshot = {};
+	std::vector<Event> _eventQueue;
+	size_t _eventQueueFront = 0;  // index of the first event not retrieved by pollEvents()
+
+	// cold data
 	VkInstance _instance = nullptr;
 	VkSurfaceKHR _surface = nullptr;
 	PFN_vkGetInstanceProcAddr _vkGetInstanceProcAddr = nullptr;
-
-	uint32_t _surfaceWidth = 0;
-	uint32_t _surfaceHeight = 0;
-	bool _resizePending = true;
 	std::function<ResizeCallback> _resizeCallback;
 	std::function<CloseCallback> _closeCallback;
-
-	MouseState _mouseState = {};
-	std::function<MouseMoveCallback> _mouseMoveCallback;
+	std::function<WindowStateChangedCallback> _windowStateChangedCallback;
 	std::function<MouseButtonCallback> _mouseButtonCallback;
 	std::function<MouseWheelCallback> _mouseWheelCallback;
 	std::function<KeyCallback> _keyCallback;
-
+	std::function<OutputsChangedCallback> _outputsChangedCallback;
+	std::vector<void*> _outputHandles;  // outputs the window is on; maintained only while outputs changes are handled (always on Wayland)
 	std::string _title;
+	mutable size_t _roundTripCount = 0;  // synchronous server round trips made on behalf of this window
+	uint32_t _placeholderColor = 0;  // 0xAARRGGBB, zero alpha means no placeholder
+	static inline std::atomic<size_t> _globalRoundTripCount = 0;  // all round trips, including init() and all windows
+	static inline StartupTimes _startupTimes = {};
 
 	VkSurfaceKHR createInternal(VkInstance instance, uint32_t width, uint32_t height);
 	void updateTitle();
+	void updateWindowState(WindowState windowState);
 	void show(void (*xdgConfigFunc)(VulkanWindow&), void (*libdecorConfigFunc)(VulkanWindow&));  // wayland-only function
 	void updateMinimized();  // xlib-only function
 
+	// xlib implementation of the functions of the multi-backend build
+	// (when Xlib is selected at runtime, the functions of the same name without xlib prefix forward the calls to these ones)
+	bool xlibIsVisible() const;
+	void xlibShow();
+	void xlibHide();
+	static void xlibMainLoop();
+	static void xlibExitMainLoop();
+	void xlibScheduleFrame();
+	void xlibUpdateTitle();
+	WindowState xlibWindowState() const;
+	void xlibSetWindowState(WindowState windowState);
+	static std::vector<Output> xlibQueryOutputs(size_t& numRoundTrips);
+
+	void countRoundTrip() const;
+
+	// event dispatch
+	// (listener takes precedence over the callbacks)
+	bool hasFrameHandler() const;
+	bool hasResizeHandler() const;
+	bool hasCloseHandler() const;
+	bool hasWindowStateChangedHandler() const;
+	bool hasMouseMoveHandler() const;
+	bool hasMouseButtonHandler() const;
+	bool hasMouseWheelHandler() const;
+	bool hasKeyHandler() const;
+	bool hasOutputsChangedHandler() const;
+	void callFrame();
+	void callResize(uint32_t& widthToBeSet, uint32_t& heightToBeSet);
+	void callClose();
+	void callWindowStateChanged(WindowState windowState);
+	void callMouseMove(const MouseState& mouseState);
+	void callMouseButton(MouseButton::EnumType button, ButtonState buttonState, const MouseState& mouseState);
+	void callMouseWheel(float wheelX, float wheelY, const MouseState& mouseState);
+	void callKey(KeyState newKeyState, ScanCode scanCode, KeyCode key);
+	void callOutputsChanged();
+	void updateOutputs();  // not used on Wayland
+	std::vector<void*> queryOutputHandles() const;  // not used on Wayland
+	static std::vector<Output> queryOutputs(size_t& numRoundTrips);  // numRoundTrips is increased by the number of queries made
+	bool waitForFrameTime();  // returns false if the frame was deferred instead of rendered
+	void updateFocus(bool focused);
+	void updatePointerLeave();
+	void trackMouseState(const MouseState& mouseState);
+	void takeInputSnapshot();  // accumulated values start from zero for the next frame
+	Event& queueEvent(Event::Type type);
+	void storeMouseMove(const MouseState& mouseState);  // updates input state and event queue
+	void storeMouseButton(MouseButton::EnumType button, ButtonState buttonState, const MouseState& mouseState);
+	void storeMouseWheel(float wheelX, float wheelY, const MouseState& mouseState);
+	void storeKey(KeyState newKeyState, ScanCode scanCode, KeyCode key);
+
 public:
 
 	// initialization and finalization
+	// (calling init() is optional; if it is not called explicitly,
+	// it is called by the first create() or requiredExtensions() call;
+	// in the multi-backend build (both Wayland and Xlib compiled in), init() selects the backend:
+	// Wayland is used if libwayland is installed and Wayland server is running, Xlib otherwise;
+	// init(void* data) with non-null data takes the backend of the passed display handle
+	// from the library loaded in the process, either libwayland-client or libX11)
 	static void init();
 	static void init(void* data);
 	static void init(int& argc, char* argv[]);
 	static void finalize() noexcept;
 
+	// per-thread event processing
+	// (windows created on the thread after initThread() call are serviced
+	// by the mainLoop() of the same thread; Xlib and Wayland only;
+	// on Xlib, init() calls XInitThreads(); when the Display handle is passed to init(void*)
+	// and libX11 is older than 1.8, the application must call XInitThreads() before opening it)
+	static void initThread();
+	static void finalizeThread() noexcept;
+
+	// display selection
+	// (Display platform only; the windows created afterwards are shown on the given display,
+	// indexed as in outputs(), using the given plane; UINT32_MAX plane index selects
+	// the first plane that can be used with the display, which is also the default)
+	static void setDisplayTarget(uint32_t displayIndex, uint32_t planeIndex = UINT32_MAX);
+
+	// input grab
+	// (Display platform only; the grab is disabled by default, so the key presses reach the console below
+	// as well; true grabs the evdev input devices exclusively, so the console and other programs
+	// do not receive the input until the grab is released by false or by finalize())
+	static void setDisplayInputGrab(bool grab);
+
 	// construction and destruction
 	VulkanWindow();
 	VulkanWindow(VulkanWindow&& other) noexcept;
@@ -259,6 +458,10 @@ public:
 	void show();
 	void hide();
 	void setVisible(bool value);
+	static void createMany(VulkanWindow* const* windows, size_t count, VkInstance instance, uint32_t width, uint32_t height,
+	                       std::string_view title = "Vulkan window",
+	                       PFN_vkGetInstanceProcAddr getInstanceProcAddr = ::vkGetInstanceProcAddr);
+	static void showMany(VulkanWindow* const* windows, size_t count);
 	void renderFrame();
 	static void mainLoop();
 	static void exitMainLoop();
@@ -270,6 +473,8 @@ public:
 	void setResizeCallback(const std::function<ResizeCallback>& cb);
 	void setCloseCallback(std::function<CloseCallback>&& cb);
 	void setCloseCallback(const std::function<CloseCallback>& cb);
+	void setWindowStateChangedCallback(std::function<WindowStateChangedCallback>&& cb);
+	void setWindowStateChangedCallback(const std::function<WindowStateChangedCallback>& cb);
 	void setMouseMoveCallback(std::function<MouseMoveCallback>&& cb);
 	void setMouseMoveCallback(const std::function<MouseMoveCallback>& cb);
 	void setMouseButtonCallback(std::function<MouseButtonCallback>&& cb);
@@ -278,13 +483,22 @@ public:
 	void setMouseWheelCallback(const std::function<MouseWheelCallback>& cb);
 	void setKeyCallback(std::function<KeyCallback>&& cb);
 	void setKeyCallback(const std::function<KeyCallback>& cb);
+	void setOutputsChangedCallback(std::function<OutputsChangedCallback>&& cb);
+	void setOutputsChangedCallback(const std::function<OutputsChangedCallback>& cb);
 	const std::function<FrameCallback>& frameCallback() const;
 	const std::function<ResizeCallback>& resizeCallback() const;
 	const std::function<CloseCallback>& closeCallback() const;
+	const std::function<WindowStateChangedCallback>& windowStateChangedCallback() const;
 	const std::function<MouseMoveCallback>& mouseMoveCallback() const;
 	const std::function<MouseButtonCallback>& mouseButtonCallback() const;
 	const std::function<MouseWheelCallback>& mouseWheelCallback() const;
 	const std::function<KeyCallback>& keyCallback() const;
+	const std::function<OutputsChangedCallback>& outputsChangedCallback() const;
+
+	// listener
+	// (the listener is not owned by VulkanWindow and must outlive it or be reset by setListener(nullptr))
+	void setListener(Listener* listener);
+	Listener* listener() const;
 
 	// getters
 	VkSurfaceKHR surface() const;
@@ -292,12 +506,47 @@ public:
 	uint32_t surfaceHeight() const;
 	bool isVisible() const;
 	const std::string& title() const;
-	WindowState windowState() const;
+	WindowState windowState() const;  // might wait for the server on Wayland
+	WindowState cachedWindowState() const;  // last known state, it never blocks
+
+	// polled input
+	// (input state tracking is disabled by default; when enabled by setInputStateTracking(true),
+	// input events are processed even if no callback or listener is set)
+	const InputState& inputState() const;  // current state
+	const InputState& snapshot() const;  // state at the start of the last renderFrame()
+	void setInputStateTracking(bool value);
+	bool inputStateTracking() const;
+
+	// event queue
+	// (pull-model alternative to the callbacks; when enabled, input, resize, close and window state events
+	// are stored in the queue until retrieved by pollEvents(); pollEvents() must be called from the thread
+	// processing the window events, usually from the frame callback; with the queue enabled,
+	// the close event does not hide the window and does not exit the main loop unless handled so;
+	// the queue holds up to maxQueuedEvents events, the oldest events are dropped when it is full)
+	static constexpr size_t maxQueuedEvents = 4096;
+	void setEventQueueEnabled(bool value);
+	bool eventQueueEnabled() const;
+	size_t pollEvents(Event* events, size_t capacity);  // moves up to capacity events into the array and returns their number
+	size_t numQueuedEvents() const;
+
+	// outputs
+	// (outputs() lists connected monitors, windowOutputs() those the window is shown on;
+	// OutputsChangedCallback is called when the window moves to another output;
+	// on Xlib, both functions make round trips to the server)
+	static std::vector<Output> outputs();
+	std::vector<Output> windowOutputs() const;
 
 	// setters
 	void setTitle(std::string&& s);
 	void setTitle(std::string_view s);
 	void setWindowState(WindowState windowState);
+	void requestWindowState(WindowState windowState);  // returns immediately, the change is reported by WindowStateChangedCallback
+
+	// placeholder content
+	// (solid color shown immediately after show() until the first frame is presented;
+	// supported on Xlib, and on Wayland with wp_single_pixel_buffer_v1 and wp_viewporter without libdecor)
+	void setPlaceholderColor(float r, float g, float b);
+	void disablePlaceholder();
 
 	// convenience functions calling setWindowState()
 	void showFullScreen();
@@ -309,12 +558,45 @@ public:
 	void scheduleFrame();
 	void scheduleResize();
 
+	// frame rate limit
+	// (frames are rendered at least 1/framesPerSecond apart; too early frame is deferred and the main loop
+	// waits for its time while processing events, waking up by an absolute time timer
+	// and spinning only for the last tens of microseconds; zero disables the limit;
+	// recommendedFrameRateLimit() returns refresh rate of the window outputs, slightly lowered
+	// on VRR outputs with known VRR range to stay inside the range, or zero if unknown;
+	// on Display platform, create() sets the limit slightly above the refresh rate of the display mode
+	// if no limit was set, as there is no compositor to pace the frames)
+	void setFrameRateLimit(double framesPerSecond);
+	double frameRateLimit() const;
+	double recommendedFrameRateLimit() const;
+
+	// idle throttling
+	// (when the window gets no input and no scheduleFrame() calls from outside of the frame callback
+	// for idleTimeout seconds, or when it loses keyboard focus, its frame rate is limited to idleFrameRate;
+	// the next input event, such scheduleFrame() call or focus gain brings the full frame rate back;
+	// zero idleTimeout disables the throttling, which is the default)
+	void setIdleThrottling(double idleTimeout, double idleFrameRate, bool throttleWhenUnfocused = true);
+	double idleTimeout() const;
+	double idleFrameRate() const;
+	bool isIdle() const;  // true if the window was idle at the last frame
+
+	// round trip statistics
+	// (number of synchronous round trips to the windowing system server, such as
+	// wl_display_roundtrip() on Wayland or XGetWindowProperty() on Xlib; on Win32, SDL, GLFW and Qt,
+	// synchronous window state and output queries made through their API are counted instead,
+	// because whether they reach the server depends on the backend)
+	size_t roundTripCount() const;
+	static size_t globalRoundTripCount();
+	void resetRoundTripCount();
+	static void resetGlobalRoundTripCount();
+	static const StartupTimes& startupTimes();
+
 	// exception handling
 	static inline std::exception_ptr thrownException;
 
 	// required Vulkan Instance extensions
-	// (calling VulkanWindow::requiredExtensions() requires already initialized QGuiApplication on Qt,
-	// and VulkanWindow::init(...) already called on SDL and GLFW)
+	// (on SDL, GLFW, Qt and in the multi-backend build, VulkanWindow::requiredExtensions() calls VulkanWindow::init()
+	// if it was not called yet; on other platforms, it does not need display connection)
 	static const std::vector<const char*>& requiredExtensions();
 	static std::vector<const char*>& appendRequiredExtensions(std::vector<const char*>& v);
 	static uint32_t requiredExtensionCount();
@@ -332,6 +614,8 @@ inline void VulkanWindow::setResizeCallback(std::function<ResizeCallback>&& cb)
 inline void VulkanWindow::setResizeCallback(const std::function<ResizeCallback>& cb)  { _resizeCallback = cb; }
 inline void VulkanWindow::setCloseCallback(std::function<CloseCallback>&& cb)  { _closeCallback = move(cb); }
 inline void VulkanWindow::setCloseCallback(const std::function<CloseCallback>& cb)  { _closeCallback = cb; }
+inline void VulkanWindow::setWindowStateChangedCallback(std::function<WindowStateChangedCallback>&& cb)  { _windowStateChangedCallback = move(cb); }
+inline void VulkanWindow::setWindowStateChangedCallback(const std::function<WindowStateChangedCallback>& cb)  { _windowStateChangedCallback = cb; }
 inline void VulkanWindow::setMouseMoveCallback(std::function<MouseMoveCallback>&& cb)  { _mouseMoveCallback = move(cb); }
 inline void VulkanWindow::setMouseMoveCallback(const std::function<MouseMoveCallback>& cb)  { _mouseMoveCallback = cb; }
 inline void VulkanWindow::setMouseButtonCallback(std::function<MouseButtonCallback>&& cb)  { _mouseButtonCallback = move(cb); }
@@ -343,24 +627,115 @@ inline void VulkanWindow::setKeyCallback(const std::function<KeyCallback>& cb)
 inline const std::function<VulkanWindow::FrameCallback>& VulkanWindow::frameCallback() const  { return _frameCallback; }
 inline const std::function<VulkanWindow::ResizeCallback>& VulkanWindow::resizeCallback() const  { return _resizeCallback; }
 inline const std::function<VulkanWindow::CloseCallback>& VulkanWindow::closeCallback() const  { return _closeCallback; }
+inline const std::function<VulkanWindow::WindowStateChangedCallback>& VulkanWindow::windowStateChangedCallback() const  { return _windowStateChangedCallback; }
 inline const std::function<VulkanWindow::MouseMoveCallback>& VulkanWindow::mouseMoveCallback() const  { return _mouseMoveCallback; }
 inline const std::function<VulkanWindow::MouseButtonCallback>& VulkanWindow::mouseButtonCallback() const  { return _mouseButtonCallback; }
 inline const std::function<VulkanWindow::MouseWheelCallback>& VulkanWindow::mouseWheelCallback() const  { return _mouseWheelCallback; }
 inline const std::function<VulkanWindow::KeyCallback>& VulkanWindow::keyCallback() const  { return _keyCallback; }
+inline void VulkanWindow::setOutputsChangedCallback(std::function<OutputsChangedCallback>&& cb)  { _outputsChangedCallback = move(cb); }
+inline void VulkanWindow::setOutputsChangedCallback(const std::function<OutputsChangedCallback>& cb)  { _outputsChangedCallback = cb; }
+inline const std::function<VulkanWindow::OutputsChangedCallback>& VulkanWindow::outputsChangedCallback() const  { return _outputsChangedCallback; }
+inline void VulkanWindow::setListener(Listener* listener)  { _listener = listener; }
+inline VulkanWindow::Listener* VulkanWindow::listener() const  { return _listener; }
 inline VkSurfaceKHR VulkanWindow::surface() const  { return _surface; }
 inline uint32_t VulkanWindow::surfaceWidth() const  { return _surfaceWidth; }
 inline uint32_t VulkanWindow::surfaceHeight() const  { return _surfaceHeight; }
 inline const std::string& VulkanWindow::title() const  { return _title; }
+inline VulkanWindow::WindowState VulkanWindow::cachedWindowState() const  { return _windowState; }
+inline const VulkanWindow::InputState& VulkanWindow::inputState() const  { return _inputState; }
+inline const VulkanWindow::InputState& VulkanWindow::snapshot() const  { return _inputSnapshot; }
+inline void VulkanWindow::setInputStateTracking(bool value)  { _inputStateTracking = value; }
+inline bool VulkanWindow::inputStateTracking() const  { return _inputStateTracking; }
+inline bool VulkanWindow::eventQueueEnabled() const  { return _eventQueueEnabled; }
+inline size_t VulkanWindow::numQueuedEvents() const  { return _eventQueue.size() - _eventQueueFront; }
 inline void VulkanWindow::setTitle(std::string&& s)  { if(s==_title) return; _title=std::move(s); updateTitle(); }
 inline void VulkanWindow::setTitle(std::string_view s)  { if(s==_title) return; _title=s; updateTitle(); }
 inline void VulkanWindow::showFullScreen()  { setWindowState(WindowState::FullScreen); }
 inline void VulkanWindow::showMaximized()  { setWindowState(WindowState::Maximized); }
 inline void VulkanWindow::showNormal()  { setWindowState(WindowState::Normal); }
 inline void VulkanWindow::showMinimized()  { setWindowState(WindowState::Minimized); }
+inline void VulkanWindow::disablePlaceholder()  { _placeholderColor = 0; }
 inline void VulkanWindow::scheduleResize()  { _resizePending = true; scheduleFrame(); }
+inline void VulkanWindow::setFrameRateLimit(double framesPerSecond)  { _frameInterval = (framesPerSecond > 0.) ? int64_t(1e9 / framesPerSecond + 0.5) : 0; }
+inline double VulkanWindow::frameRateLimit() const  { return (_frameInterval != 0) ? 1e9 / double(_frameInterval) : 0.; }
+inline double VulkanWindow::idleTimeout() const  { return double(_idleTimeout) * 1e-9; }
+inline double VulkanWindow::idleFrameRate() const  { return (_idleFrameInterval != 0) ? 1e9 / double(_idleFrameInterval) : 0.; }
+inline bool VulkanWindow::isIdle() const  { return _idle; }
+inline size_t VulkanWindow::roundTripCount() const  { return _roundTripCount; }
+inline size_t VulkanWindow::globalRoundTripCount()  { return _globalRoundTripCount; }
+inline void VulkanWindow::resetRoundTripCount()  { _roundTripCount = 0; }
+inline void VulkanWindow::resetGlobalRoundTripCount()  { _globalRoundTripCount = 0; }
+inline const VulkanWindow::StartupTimes& VulkanWindow::startupTimes()  { return _startupTimes; }
+inline void VulkanWindow::countRoundTrip() const  { _roundTripCount++; _globalRoundTripCount++; }
+inline bool VulkanWindow::hasFrameHandler() const  { return _listener || _frameCallback; }
+inline bool VulkanWindow::hasResizeHandler() const  { return _listener || _resizeCallback; }
+inline bool VulkanWindow::hasCloseHandler() const  { return _listener || _closeCallback || _eventQueueEnabled; }
+inline bool VulkanWindow::hasWindowStateChangedHandler() const  { return _listener || _windowStateChangedCallback || _eventQueueEnabled; }
+inline bool VulkanWindow::hasMouseMoveHandler() const  { return _listener || _mouseMoveCallback || _inputStateTracking || _eventQueueEnabled; }
+inline bool VulkanWindow::hasMouseButtonHandler() const  { return _listener || _mouseButtonCallback || _inputStateTracking || _eventQueueEnabled; }
+inline bool VulkanWindow::hasMouseWheelHandler() const  { return _listener || _mouseWheelCallback || _inputStateTracking || _eventQueueEnabled; }
+inline bool VulkanWindow::hasKeyHandler() const  { return _listener || _keyCallback || _inputStateTracking || _eventQueueEnabled; }
+inline bool VulkanWindow::hasOutputsChangedHandler() const  { return _listener || _outputsChangedCallback; }
+inline void VulkanWindow::callOutputsChanged()  { if(_listener) _listener->onOutputsChanged(*this); else if(_outputsChangedCallback) _outputsChangedCallback(*this); }
 inline constexpr VulkanWindow::KeyCode VulkanWindow::fromAscii(char ch)  { return VulkanWindow::KeyCode(ch); }
 
 
+// event dispatch
+// (called by the backends for each event; input state tracking and the event queue are handled
+// by the out-of-line store functions, so the common path is one flag test and one call)
+inline void VulkanWindow::callFrame()
+{
+	if(_listener)
+		_listener->onFrame(*this);
+	else
+		_frameCallback(*this);
+}
+
+inline void VulkanWindow::callMouseMove(const MouseState& mouseState)
+{
+	_activity = true;
+	if(_inputStateTracking | _eventQueueEnabled)
+		storeMouseMove(mouseState);
+	if(_listener)
+		_listener->onMouseMove(*this, mouseState);
+	else if(_mouseMoveCallback)
+		_mouseMoveCallback(*this, mouseState);
+}
+
+inline void VulkanWindow::callMouseButton(MouseButton::EnumType button, ButtonState buttonState, const MouseState& mouseState)
+{
+	_activity = true;
+	if(_inputStateTracking | _eventQueueEnabled)
+		storeMouseButton(button, buttonState, mouseState);
+	if(_listener)
+		_listener->onMouseButton(*this, button, buttonState, mouseState);
+	else if(_mouseButtonCallback)
+		_mouseButtonCallback(*this, button, buttonState, mouseState);
+}
+
+inline void VulkanWindow::callMouseWheel(float wheelX, float wheelY, const MouseState& mouseState)
+{
+	_activity = true;
+	if(_inputStateTracking | _eventQueueEnabled)
+		storeMouseWheel(wheelX, wheelY, mouseState);
+	if(_listener)
+		_listener->onMouseWheel(*this, wheelX, wheelY, mouseState);
+	else if(_mouseWheelCallback)
+		_mouseWheelCallback(*this, wheelX, wheelY, mouseState);
+}
+
+inline void VulkanWindow::callKey(KeyState newKeyState, ScanCode scanCode, KeyCode key)
+{
+	_activity = true;
+	if(_inputStateTracking | _eventQueueEnabled)
+		storeKey(newKeyState, scanCode, key);
+	if(_listener)
+		_listener->onKey(*this, newKeyState, scanCode, key);
+	else if(_keyCallback)
+		_keyCallback(*this, newKeyState, scanCode, key);
+}
+
+
 // nifty counter / Schwarz counter
 // (VulkanWindow::finalize() must be called after all VulkanWindow objects were destroyed.
 // We are doing it using Nifty counter programming idiom.)
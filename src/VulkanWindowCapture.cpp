@@ -0,0 +1,603 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#include "VulkanWindowCapture.h"
+#include <array>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+
+void VulkanWindowCapture::init(vk::PhysicalDevice physicalDevice, vk::Device device, size_t numSlots)
+{
+	assert(numSlots >= 1 && "VulkanWindowCapture::init(): numSlots must be at least 1.");
+
+	cleanUp();
+
+	_physicalDevice = physicalDevice;
+	_device = device;
+	_slots.resize(numSlots);
+	for(Slot& slot : _slots)
+		slot.fence =
+			_device.createFence(
+				vk::FenceCreateInfo(
+					vk::FenceCreateFlags()  // flags
+				)
+			);
+	_nextSlot = 0;
+	_recordedSlot = ~size_t(0);
+	_frameCounter = 0;
+	_numCaptured = 0;
+	_numDropped = 0;
+	_numFailed = 0;
+
+	// start worker
+	_exitWorker = false;
+	_worker = thread(&VulkanWindowCapture::workerMain, this);
+}
+
+
+void VulkanWindowCapture::cleanUp() noexcept
+{
+	if(!_device)
+		return;
+
+	// deliver outstanding frames
+	// (failures are ignored because cleanUp() is called from the destructor;
+	// if the copies cannot be waited for, we wait for the device idle state before the buffers are destroyed,
+	// ignoring any returned error codes as the device might be in the lost state already)
+	try {
+		flush();
+	}
+	catch(...) {
+		vkDeviceWaitIdle(_device);
+	}
+
+	// stop worker
+	{
+		lock_guard lock(_mutex);
+		_exitWorker = true;
+	}
+	_workAvailable.notify_all();
+	_worker.join();
+
+	// destroy Vulkan objects
+	for(Slot& slot : _slots) {
+		destroySlot(slot);
+		_device.destroy(slot.fence);
+	}
+	_slots.clear();
+	_inFlightSlots.clear();
+	_device = nullptr;
+	_physicalDevice = nullptr;
+
+	// close output
+	if(_y4mFile.is_open())
+		_y4mFile.close();
+}
+
+
+void VulkanWindowCapture::allocateSlot(Slot& slot, vk::DeviceSize size)
+{
+	destroySlot(slot);
+
+	// buffer
+	slot.buffer =
+		_device.createBuffer(
+			vk::BufferCreateInfo(
+				vk::BufferCreateFlags(),  // flags
+				size,  // size
+				vk::BufferUsageFlagBits::eTransferDst,  // usage
+				vk::SharingMode::eExclusive,  // sharingMode
+				0,  // queueFamilyIndexCount
+				nullptr  // pQueueFamilyIndices
+			)
+		);
+
+	// memory
+	// (host cached memory is preferred because it makes the reads on the worker thread much faster;
+	// host visible and coherent memory type is guaranteed to exist by Vulkan spec)
+	vk::MemoryRequirements memoryRequirements = _device.getBufferMemoryRequirements(slot.buffer);
+	vk::PhysicalDeviceMemoryProperties memoryProperties = _physicalDevice.getMemoryProperties();
+	auto findMemoryType =
+		[](const vk::PhysicalDeviceMemoryProperties& memoryProperties, uint32_t typeBits, vk::MemoryPropertyFlags flags) -> uint32_t {
+			for(uint32_t i=0; i<memoryProperties.memoryTypeCount; i++)
+				if((typeBits & (1 << i)) && (memoryProperties.memoryTypes[i].propertyFlags & flags) == flags)
+					return i;
+			return ~uint32_t(0);
+		};
+	uint32_t memoryType =
+		findMemoryType(memoryProperties, memoryRequirements.memoryTypeBits,
+			vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent | vk::MemoryPropertyFlagBits::eHostCached);
+	if(memoryType == ~uint32_t(0))
+		memoryType =
+			findMemoryType(memoryProperties, memoryRequirements.memoryTypeBits,
+				vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+	if(memoryType == ~uint32_t(0))
+		throw runtime_error("VulkanWindowCapture::allocateSlot(): No host visible and coherent memory type found.");
+	slot.memory =
+		_device.allocateMemory(
+			vk::MemoryAllocateInfo(
+				memoryRequirements.size,  // allocationSize
+				memoryType  // memoryTypeIndex
+			)
+		);
+	_device.bindBufferMemory(slot.buffer, slot.memory, 0);
+
+	// keep the memory mapped for the whole lifetime of the slot
+	slot.mappedData = reinterpret_cast<uint8_t*>(_device.mapMemory(slot.memory, 0, VK_WHOLE_SIZE));
+	slot.size = size;
+}
+
+
+void VulkanWindowCapture::destroySlot(Slot& slot)
+{
+	if(slot.memory)
+		_device.unmapMemory(slot.memory);
+	_device.destroy(slot.buffer);
+	_device.free(slot.memory);
+	slot.buffer = nullptr;
+	slot.memory = nullptr;
+	slot.mappedData = nullptr;
+	slot.size = 0;
+}
+
+
+void VulkanWindowCapture::setFrameCallback(FrameCallback cb)
+{
+	flush();
+	_frameCallback = move(cb);
+}
+
+
+void VulkanWindowCapture::setFileOutput(const string& prefix, FileFormat format, unsigned y4mFrameRate)
+{
+	flush();
+	if(_y4mFile.is_open())
+		_y4mFile.close();
+	_filePrefix = prefix;
+	_fileFormat = format;
+	_y4mFrameRate = y4mFrameRate;
+	_y4mWidth = 0;
+	_y4mHeight = 0;
+}
+
+
+bool VulkanWindowCapture::isFormatSupported(vk::Format format)
+{
+	switch(format) {
+	case vk::Format::eB8G8R8A8Unorm:
+	case vk::Format::eB8G8R8A8Srgb:
+	case vk::Format::eR8G8B8A8Unorm:
+	case vk::Format::eR8G8B8A8Srgb:
+	case vk::Format::eA8B8G8R8UnormPack32:
+	case vk::Format::eA8B8G8R8SrgbPack32:
+		return true;
+	default:
+		return false;
+	}
+}
+
+
+bool VulkanWindowCapture::recordCopy(vk::CommandBuffer commandBuffer, vk::Image image, vk::Format format, vk::Extent2D extent)
+{
+	assert(_device && "VulkanWindowCapture::recordCopy(): init() was not called.");
+	assert(_recordedSlot == ~size_t(0) && "VulkanWindowCapture::recordCopy(): submitted() was not called after the previous recordCopy().");
+
+	if(!isFormatSupported(format))
+		throw runtime_error("VulkanWindowCapture::recordCopy(): Unsupported image format " + vk::to_string(format) + ".");
+
+	// hand over finished copies to the worker
+	poll();
+
+	// get free slot or drop the frame
+	uint64_t frameNumber = _frameCounter++;
+	Slot& slot = _slots[_nextSlot];
+	{
+		lock_guard lock(_mutex);
+		if(slot.state != SlotState::Free) {
+			_numDropped++;
+			return false;
+		}
+	}
+
+	// prepare slot
+	vk::DeviceSize size = vk::DeviceSize(extent.width) * extent.height * 4;
+	if(slot.size < size)
+		allocateSlot(slot, size);
+	slot.width = extent.width;
+	slot.height = extent.height;
+	slot.swapRB = format == vk::Format::eB8G8R8A8Unorm || format == vk::Format::eB8G8R8A8Srgb;
+	slot.frameNumber = frameNumber;
+
+	// copy image to the buffer
+	// (image is in ePresentSrcKHR layout after the render pass and it is returned to this layout after the copy)
+	commandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eColorAttachmentOutput,  // srcStageMask
+		vk::PipelineStageFlagBits::eTransfer,  // dstStageMask
+		vk::DependencyFlags(),  // dependencyFlags
+		nullptr,  // memoryBarriers
+		nullptr,  // bufferMemoryBarriers
+		vk::ImageMemoryBarrier(  // imageMemoryBarriers
+			vk::AccessFlagBits::eColorAttachmentWrite,  // srcAccessMask
+			vk::AccessFlagBits::eTransferRead,  // dstAccessMask
+			vk::ImageLayout::ePresentSrcKHR,  // oldLayout
+			vk::ImageLayout::eTransferSrcOptimal,  // newLayout
+			VK_QUEUE_FAMILY_IGNORED,  // srcQueueFamilyIndex
+			VK_QUEUE_FAMILY_IGNORED,  // dstQueueFamilyIndex
+			image,  // image
+			vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)  // subresourceRange
+		)
+	);
+	commandBuffer.copyImageToBuffer(
+		image,  // srcImage
+		vk::ImageLayout::eTransferSrcOptimal,  // srcImageLayout
+		slot.buffer,  // dstBuffer
+		vk::BufferImageCopy(  // regions
+			0,  // bufferOffset
+			0,  // bufferRowLength
+			0,  // bufferImageHeight
+			vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1),  // imageSubresource
+			vk::Offset3D(0, 0, 0),  // imageOffset
+			vk::Extent3D(extent.width, extent.height, 1)  // imageExtent
+		)
+	);
+	commandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTransfer,  // srcStageMask
+		vk::PipelineStageFlagBits::eBottomOfPipe | vk::PipelineStageFlagBits::eHost,  // dstStageMask
+		vk::DependencyFlags(),  // dependencyFlags
+		nullptr,  // memoryBarriers
+		vk::BufferMemoryBarrier(  // bufferMemoryBarriers
+			vk::AccessFlagBits::eTransferWrite,  // srcAccessMask
+			vk::AccessFlagBits::eHostRead,  // dstAccessMask
+			VK_QUEUE_FAMILY_IGNORED,  // srcQueueFamilyIndex
+			VK_QUEUE_FAMILY_IGNORED,  // dstQueueFamilyIndex
+			slot.buffer,  // buffer
+			0,  // offset
+			size  // size
+		),
+		vk::ImageMemoryBarrier(  // imageMemoryBarriers
+			vk::AccessFlags(),  // srcAccessMask
+			vk::AccessFlags(),  // dstAccessMask
+			vk::ImageLayout::eTransferSrcOptimal,  // oldLayout
+			vk::ImageLayout::ePresentSrcKHR,  // newLayout
+			VK_QUEUE_FAMILY_IGNORED,  // srcQueueFamilyIndex
+			VK_QUEUE_FAMILY_IGNORED,  // dstQueueFamilyIndex
+			image,  // image
+			vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)  // subresourceRange
+		)
+	);
+
+	slot.state = SlotState::Recorded;
+	_recordedSlot = _nextSlot;
+	_nextSlot = (_nextSlot + 1) % _slots.size();
+	return true;
+}
+
+
+void VulkanWindowCapture::submitted(vk::Queue queue)
+{
+	if(_recordedSlot == ~size_t(0))
+		return;
+
+	// submit the fence only
+	// (it is signaled when all the work previously submitted to the queue is finished,
+	// including the command buffer with the copy)
+	Slot& slot = _slots[_recordedSlot];
+	queue.submit(vk::ArrayProxy<const vk::SubmitInfo>(0, nullptr), slot.fence);
+	slot.state = SlotState::InFlight;
+	_inFlightSlots.push_back(_recordedSlot);
+	_recordedSlot = ~size_t(0);
+}
+
+
+void VulkanWindowCapture::poll()
+{
+	// pass finished slots to the worker in submission order
+	bool notify = false;
+	while(!_inFlightSlots.empty()) {
+		size_t i = _inFlightSlots.front();
+		Slot& slot = _slots[i];
+		if(_device.getFenceStatus(slot.fence) != vk::Result::eSuccess)
+			break;
+		_device.resetFences(slot.fence);
+		_inFlightSlots.pop_front();
+		lock_guard lock(_mutex);
+		slot.state = SlotState::Processing;
+		_workQueue.push_back(i);
+		notify = true;
+	}
+	if(notify)
+		_workAvailable.notify_one();
+}
+
+
+void VulkanWindowCapture::flush()
+{
+	if(!_device)
+		return;
+
+	// wait for the copies
+	// (it is the only place where the device is waited for)
+	for(size_t i : _inFlightSlots) {
+		vk::Result r = _device.waitForFences(_slots[i].fence, VK_TRUE, uint64_t(3e9));
+		if(r != vk::Result::eSuccess)
+			throw runtime_error("VulkanWindowCapture::flush(): vkWaitForFences() failed with error " + vk::to_string(r) + ".");
+	}
+	poll();
+
+	// wait for the worker
+	unique_lock lock(_mutex);
+	_workDone.wait(lock, [this]() { return _workQueue.empty() && !_workerBusy; });
+}
+
+
+void VulkanWindowCapture::workerMain()
+{
+	unique_lock lock(_mutex);
+	while(true) {
+
+		// wait for work
+		// (exit only after all the queued frames are processed)
+		_workAvailable.wait(lock, [this]() { return _exitWorker || !_workQueue.empty(); });
+		if(_workQueue.empty())
+			return;
+		size_t i = _workQueue.front();
+		_workQueue.pop_front();
+		_workerBusy = true;
+
+		// process frame
+		lock.unlock();
+		processSlot(_slots[i]);
+		lock.lock();
+
+		_slots[i].state = SlotState::Free;
+		_workerBusy = false;
+		_workDone.notify_all();
+	}
+}
+
+
+void VulkanWindowCapture::processSlot(Slot& slot)
+{
+	// convert to RGBA
+	// (R8G8B8A8 and A8B8G8R8 pack32 formats have RGBA byte order already, so no copy is needed)
+	const uint8_t* data = slot.mappedData;
+	size_t numPixels = size_t(slot.width) * slot.height;
+	if(slot.swapRB) {
+		_rgba.resize(numPixels * 4);
+		const uint8_t* src = slot.mappedData;
+		uint8_t* dst = _rgba.data();
+		for(size_t i=0; i<numPixels; i++, src+=4, dst+=4) {
+			dst[0] = src[2];
+			dst[1] = src[1];
+			dst[2] = src[0];
+			dst[3] = src[3];
+		}
+		data = _rgba.data();
+	}
+
+	// deliver frame
+	// (exceptions must not escape the worker thread)
+	Frame frame{ slot.width, slot.height, slot.frameNumber, data };
+	try {
+		if(_frameCallback)
+			_frameCallback(frame);
+		else if(!_filePrefix.empty())
+			writeFrame(frame);
+		_numCaptured++;
+	} catch(...) {
+		_numFailed++;
+	}
+}
+
+
+void VulkanWindowCapture::writeFrame(const Frame& frame)
+{
+	if(_fileFormat == FileFormat::Y4M) {
+
+		// open stream on the first frame
+		if(!_y4mFile.is_open()) {
+			_y4mFile.open(_filePrefix + ".y4m", ios::out | ios::binary);
+			if(!_y4mFile)
+				throw runtime_error("Cannot open " + _filePrefix + ".y4m.");
+			_y4mWidth = frame.width;
+			_y4mHeight = frame.height;
+			encodeY4MHeader(_encodeBuffer, _y4mWidth, _y4mHeight, _y4mFrameRate);
+			_y4mFile.write(reinterpret_cast<const char*>(_encodeBuffer.data()), _encodeBuffer.size());
+		}
+
+		// Y4M stream cannot change the frame size
+		if(frame.width != _y4mWidth || frame.height != _y4mHeight)
+			throw runtime_error("Frame size changed.");
+
+		encodeY4MFrame(_encodeBuffer, frame.data, frame.width, frame.height);
+		_y4mFile.write(reinterpret_cast<const char*>(_encodeBuffer.data()), _encodeBuffer.size());
+		if(!_y4mFile)
+			throw runtime_error("Cannot write " + _filePrefix + ".y4m.");
+
+	}
+	else {
+
+		// one file per frame
+		const char* ext;
+		if(_fileFormat == FileFormat::PNG) {
+			encodePNG(_encodeBuffer, frame.data, frame.width, frame.height);
+			ext = ".png";
+		} else {
+			encodePPM(_encodeBuffer, frame.data, frame.width, frame.height);
+			ext = ".ppm";
+		}
+		string fileName = _filePrefix + to_string(frame.frameNumber) + ext;
+		ofstream f(fileName, ios::out | ios::binary);
+		f.write(reinterpret_cast<const char*>(_encodeBuffer.data()), _encodeBuffer.size());
+		if(!f)
+			throw runtime_error("Cannot write " + fileName + ".");
+
+	}
+}
+
+
+static void appendString(vector<uint8_t>& out, const char* s)
+{
+	out.insert(out.end(), s, s + strlen(s));
+}
+
+
+void VulkanWindowCapture::encodePPM(vector<uint8_t>& out, const uint8_t* rgba, uint32_t width, uint32_t height)
+{
+	// header
+	char header[64];
+	snprintf(header, sizeof(header), "P6\n%u %u\n255\n", width, height);
+	out.clear();
+	appendString(out, header);
+
+	// RGB data
+	size_t numPixels = size_t(width) * height;
+	size_t pos = out.size();
+	out.resize(pos + numPixels * 3);
+	uint8_t* dst = out.data() + pos;
+	for(size_t i=0; i<numPixels; i++, rgba+=4, dst+=3) {
+		dst[0] = rgba[0];
+		dst[1] = rgba[1];
+		dst[2] = rgba[2];
+	}
+}
+
+
+static void appendBigEndian32(vector<uint8_t>& out, uint32_t value)
+{
+	out.push_back(uint8_t(value >> 24));
+	out.push_back(uint8_t(value >> 16));
+	out.push_back(uint8_t(value >> 8));
+	out.push_back(uint8_t(value));
+}
+
+
+static uint32_t crc32(const uint8_t* data, size_t size)
+{
+	static const array<uint32_t, 256> table =
+		[]() {
+			array<uint32_t, 256> t;
+			for(uint32_t i=0; i<256; i++) {
+				uint32_t c = i;
+				for(int k=0; k<8; k++)
+					c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+				t[i] = c;
+			}
+			return t;
+		}();
+
+	uint32_t c = 0xffffffff;
+	for(size_t i=0; i<size; i++)
+		c = table[(c ^ data[i]) & 0xff] ^ (c >> 8);
+	return c ^ 0xffffffff;
+}
+
+
+static void appendPngChunk(vector<uint8_t>& out, const char type[4], const uint8_t* data, size_t size)
+{
+	appendBigEndian32(out, uint32_t(size));
+	size_t crcStart = out.size();
+	out.insert(out.end(), type, type + 4);
+	out.insert(out.end(), data, data + size);
+	appendBigEndian32(out, crc32(out.data() + crcStart, size + 4));
+}
+
+
+void VulkanWindowCapture::encodePNG(vector<uint8_t>& out, const uint8_t* rgba, uint32_t width, uint32_t height)
+{
+	// PNG signature and header
+	// (8-bit RGBA, no interlacing)
+	out.clear();
+	static constexpr const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+	out.insert(out.end(), signature, signature + 8);
+	vector<uint8_t> ihdr;
+	appendBigEndian32(ihdr, width);
+	appendBigEndian32(ihdr, height);
+	ihdr.insert(ihdr.end(), { 8, 6, 0, 0, 0 });  // bit depth, color type, compression, filter, interlace
+	appendPngChunk(out, "IHDR", ihdr.data(), ihdr.size());
+
+	// zlib stream made of stored (uncompressed) deflate blocks
+	// (compression would be too slow for capturing many frames per second;
+	// each row is prefixed by filter type 0)
+	size_t rowSize = size_t(width) * 4;
+	size_t rawSize = (rowSize + 1) * height;
+	size_t numBlocks = (rawSize + 65534) / 65535;
+	vector<uint8_t> idat;
+	idat.reserve(2 + rawSize + numBlocks * 5 + 4);
+	idat.push_back(0x78);  // CMF: deflate, 32KiB window
+	idat.push_back(0x01);  // FLG: no preset dictionary, fastest compression, check bits
+	uint32_t adlerA = 1, adlerB = 0;
+	size_t blockRemaining = 0;
+	size_t rawRemaining = rawSize;
+	auto appendRaw =
+		[&](const uint8_t* data, size_t size) {
+			while(size > 0) {
+				if(blockRemaining == 0) {
+					// block header: BFINAL flag, BTYPE 00, LEN and NLEN in little endian
+					blockRemaining = min(rawRemaining, size_t(65535));
+					rawRemaining -= blockRemaining;
+					idat.push_back(rawRemaining == 0 ? 1 : 0);
+					idat.push_back(uint8_t(blockRemaining));
+					idat.push_back(uint8_t(blockRemaining >> 8));
+					idat.push_back(uint8_t(~blockRemaining));
+					idat.push_back(uint8_t(~blockRemaining >> 8));
+				}
+				size_t n = min(size, blockRemaining);
+				idat.insert(idat.end(), data, data + n);
+				for(size_t i=0; i<n; i++) {
+					adlerA = (adlerA + data[i]) % 65521;
+					adlerB = (adlerB + adlerA) % 65521;
+				}
+				data += n;
+				size -= n;
+				blockRemaining -= n;
+			}
+		};
+	static constexpr const uint8_t filterNone = 0;
+	for(uint32_t y=0; y<height; y++) {
+		appendRaw(&filterNone, 1);
+		appendRaw(rgba + y * rowSize, rowSize);
+	}
+	appendBigEndian32(idat, (adlerB << 16) | adlerA);
+	appendPngChunk(out, "IDAT", idat.data(), idat.size());
+
+	// end
+	appendPngChunk(out, "IEND", nullptr, 0);
+}
+
+
+void VulkanWindowCapture::encodeY4MHeader(vector<uint8_t>& out, uint32_t width, uint32_t height, unsigned frameRate)
+{
+	// 4:4:4 chroma is used to avoid subsampling of odd sized frames
+	char header[128];
+	snprintf(header, sizeof(header), "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C444\n", width, height, frameRate);
+	out.clear();
+	appendString(out, header);
+}
+
+
+void VulkanWindowCapture::encodeY4MFrame(vector<uint8_t>& out, const uint8_t* rgba, uint32_t width, uint32_t height)
+{
+	// frame header followed by Y, Cb and Cr planes
+	// (BT.601 limited range)
+	out.clear();
+	appendString(out, "FRAME\n");
+	size_t numPixels = size_t(width) * height;
+	size_t pos = out.size();
+	out.resize(pos + numPixels * 3);
+	uint8_t* yPlane = out.data() + pos;
+	uint8_t* cbPlane = yPlane + numPixels;
+	uint8_t* crPlane = cbPlane + numPixels;
+	for(size_t i=0; i<numPixels; i++, rgba+=4) {
+		int r = rgba[0], g = rgba[1], b = rgba[2];
+		yPlane[i] = uint8_t(((66*r + 129*g + 25*b + 128) >> 8) + 16);
+		cbPlane[i] = uint8_t(((-38*r - 74*g + 112*b + 128) >> 8) + 128);
+		crPlane[i] = uint8_t(((112*r - 94*g - 18*b + 128) >> 8) + 128);
+	}
+}
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// Captures rendered images without stalling the rendering.
+// The image is copied into one of the host-visible staging buffers of the ring
+// by the commands recorded into the application's command buffer.
+// When the copy is finished, the frame is converted to RGBA on the worker thread
+// and delivered to the frame callback or written to disk.
+// If all the staging buffers are in use, the frame is dropped instead of waiting for the device.
+//
+// Usage in the frame callback:
+//    - call recordCopy() after the render pass is ended (the image must be in ePresentSrcKHR layout
+//      and the swapchain must be created with eTransferSrc usage),
+//    - call submitted() after the command buffer was submitted to the queue.
+class VulkanWindowCapture {
+public:
+
+	struct Frame {
+		uint32_t width;
+		uint32_t height;
+		uint64_t frameNumber;
+		const uint8_t* data;  // RGBA, 4 bytes per pixel, rows are tightly packed
+	};
+	using FrameCallback = std::function<void(const Frame& frame)>;
+	enum class FileFormat { PPM, PNG, Y4M };
+
+protected:
+
+	enum class SlotState { Free, Recorded, InFlight, Processing };
+	struct Slot {
+		vk::Buffer buffer;
+		vk::DeviceMemory memory;
+		vk::Fence fence;
+		vk::DeviceSize size = 0;
+		uint8_t* mappedData = nullptr;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		bool swapRB = false;
+		uint64_t frameNumber = 0;
+		SlotState state = SlotState::Free;
+	};
+
+	vk::PhysicalDevice _physicalDevice;
+	vk::Device _device;
+	std::vector<Slot> _slots;
+	size_t _nextSlot = 0;
+	std::deque<size_t> _inFlightSlots;  // in submission order
+	size_t _recordedSlot = ~size_t(0);
+	uint64_t _frameCounter = 0;
+	std::atomic<size_t> _numCaptured = 0;
+	size_t _numDropped = 0;
+	std::atomic<size_t> _numFailed = 0;
+
+	// worker thread
+	std::thread _worker;
+	std::mutex _mutex;
+	std::condition_variable _workAvailable;
+	std::condition_variable _workDone;
+	std::deque<size_t> _workQueue;
+	bool _workerBusy = false;
+	bool _exitWorker = false;
+
+	// output
+	FrameCallback _frameCallback;
+	FileFormat _fileFormat = FileFormat::PPM;
+	std::string _filePrefix;
+	std::ofstream _y4mFile;
+	uint32_t _y4mWidth = 0;
+	uint32_t _y4mHeight = 0;
+	unsigned _y4mFrameRate = 60;
+	std::vector<uint8_t> _rgba;  // used by worker only
+	std::vector<uint8_t> _encodeBuffer;  // used by worker only
+
+	void allocateSlot(Slot& slot, vk::DeviceSize size);
+	void destroySlot(Slot& slot);
+	void workerMain();
+	void processSlot(Slot& slot);
+	void writeFrame(const Frame& frame);
+
+public:
+
+	// construction and destruction
+	VulkanWindowCapture() = default;
+	~VulkanWindowCapture();
+
+	// deleted constructors and operators
+	VulkanWindowCapture(const VulkanWindowCapture&) = delete;
+	VulkanWindowCapture& operator=(const VulkanWindowCapture&) = delete;
+
+	// initialization and clean up
+	// (cleanUp() waits for the outstanding frames and must be called before the device is destroyed;
+	// it does not throw as it is called from the destructor, the frames it fails to wait for are not delivered)
+	void init(vk::PhysicalDevice physicalDevice, vk::Device device, size_t numSlots = 3);
+	void cleanUp() noexcept;
+
+	// output
+	// (frames go either to the frame callback or to the files;
+	// PPM and PNG produce one file per frame named <prefix><frameNumber>.<ext>,
+	// Y4M writes all the frames into <prefix>.y4m that must keep the size of the first frame)
+	void setFrameCallback(FrameCallback cb);
+	void setFileOutput(const std::string& prefix, FileFormat format, unsigned y4mFrameRate = 60);
+
+	// capturing
+	// (recordCopy() returns false if the frame was dropped)
+	bool recordCopy(vk::CommandBuffer commandBuffer, vk::Image image, vk::Format format, vk::Extent2D extent);
+	void submitted(vk::Queue queue);
+	void poll();
+	void flush();  // waits until all captured frames are delivered; throws if the copies cannot be waited for
+
+	// statistics
+	size_t numCaptured() const;
+	size_t numDropped() const;
+	size_t numFailed() const;
+
+	// encoders
+	// (image data are RGBA, 4 bytes per pixel, rows are tightly packed)
+	static bool isFormatSupported(vk::Format format);
+	static void encodePPM(std::vector<uint8_t>& out, const uint8_t* rgba, uint32_t width, uint32_t height);
+	static void encodePNG(std::vector<uint8_t>& out, const uint8_t* rgba, uint32_t width, uint32_t height);
+	static void encodeY4MHeader(std::vector<uint8_t>& out, uint32_t width, uint32_t height, unsigned frameRate);
+	static void encodeY4MFrame(std::vector<uint8_t>& out, const uint8_t* rgba, uint32_t width, uint32_t height);
+
+};
+
+
+// inline methods
+inline VulkanWindowCapture::~VulkanWindowCapture()  { cleanUp(); }
+inline size_t VulkanWindowCapture::numCaptured() const  { return _numCaptured; }
+inline size_t VulkanWindowCapture::numDropped() const  { return _numDropped; }
+inline size_t VulkanWindowCapture::numFailed() const  { return _numFailed; }
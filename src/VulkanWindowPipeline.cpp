@@ -0,0 +1,259 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#include "VulkanWindowPipeline.h"
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace std;
+
+
+// pipeline cache header as defined by Vulkan spec
+// (VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+static constexpr size_t cacheHeaderSize = 16 + VK_UUID_SIZE;
+
+
+static uint32_t readUint32(const uint8_t* p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+
+void VulkanWindowPipelineCache::init(vk::PhysicalDevice physicalDevice, vk::Device device, const string& fileName)
+{
+	cleanUp();
+
+	_device = device;
+	_fileName = fileName;
+
+	// load file
+	vector<uint8_t> data;
+	ifstream f(fileName, ios::in | ios::binary);
+	if(f)
+		data.assign(istreambuf_iterator<char>(f), istreambuf_iterator<char>());
+
+	// validate header
+	// (some drivers do not validate the data properly,
+	// so the data of different device or driver version are not passed to them)
+	if(data.size() >= cacheHeaderSize) {
+		vk::PhysicalDeviceProperties properties = physicalDevice.getProperties();
+		if(readUint32(&data[0]) < cacheHeaderSize ||
+		   readUint32(&data[4]) != uint32_t(vk::PipelineCacheHeaderVersion::eOne) ||
+		   readUint32(&data[8]) != properties.vendorID ||
+		   readUint32(&data[12]) != properties.deviceID ||
+		   memcmp(&data[16], properties.pipelineCacheUUID.data(), VK_UUID_SIZE) != 0)
+			data.clear();
+	}
+	else
+		data.clear();
+
+	// create cache
+	_pipelineCache =
+		_device.createPipelineCache(
+			vk::PipelineCacheCreateInfo(
+				vk::PipelineCacheCreateFlags(),  // flags
+				data.size(),  // initialDataSize
+				data.data()  // pInitialData
+			)
+		);
+	_loadedSize = data.size();
+}
+
+
+void VulkanWindowPipelineCache::save() noexcept
+{
+	if(!_pipelineCache)
+		return;
+
+	// write into temporary file and rename it
+	// (it avoids damaged cache file when the application is killed during the write
+	// or when more application instances save the cache at the same time;
+	// failures, including exceptions, are ignored because the cache is only an optimization
+	// and save() is called from the destructor)
+	try {
+		vector<uint8_t> data = _device.getPipelineCacheData(_pipelineCache);
+		string tmpFileName = _fileName + ".tmp";
+		{
+			ofstream f(tmpFileName, ios::out | ios::binary | ios::trunc);
+			f.write(reinterpret_cast<const char*>(data.data()), data.size());
+			if(!f) {
+				f.close();
+				remove(tmpFileName.c_str());
+				return;
+			}
+		}
+
+		// replace the cache file
+		// (rename() replaces the file atomically on POSIX, so other instances never see it missing;
+		// on Win32, rename() does not overwrite, so the old file is removed first)
+#ifdef _WIN32
+		remove(_fileName.c_str());
+#endif
+		if(rename(tmpFileName.c_str(), _fileName.c_str()) != 0)
+			remove(tmpFileName.c_str());
+	}
+	catch(...) {
+	}
+}
+
+
+void VulkanWindowPipelineCache::cleanUp() noexcept
+{
+	if(!_pipelineCache)
+		return;
+
+	save();
+	_device.destroy(_pipelineCache);
+	_pipelineCache = nullptr;
+	_device = nullptr;
+	_loadedSize = 0;
+}
+
+
+vk::Pipeline VulkanWindowPipeline::createSimple(vk::Device device, vk::PipelineCache pipelineCache,
+	vk::PipelineLayout pipelineLayout, vk::RenderPass renderPass,
+	vk::ShaderModule vsModule, vk::ShaderModule fsModule, vk::PrimitiveTopology topology)
+{
+	return
+		device.createGraphicsPipeline(
+			pipelineCache,  // pipelineCache
+			vk::GraphicsPipelineCreateInfo(
+				vk::PipelineCreateFlags(),  // flags
+
+				// shader stages
+				2,  // stageCount
+				array{  // pStages
+					vk::PipelineShaderStageCreateInfo{
+						vk::PipelineShaderStageCreateFlags(),  // flags
+						vk::ShaderStageFlagBits::eVertex,  // stage
+						vsModule,  // module
+						"main",  // pName
+						nullptr  // pSpecializationInfo
+					},
+					vk::PipelineShaderStageCreateInfo{
+						vk::PipelineShaderStageCreateFlags(),  // flags
+						vk::ShaderStageFlagBits::eFragment,  // stage
+						fsModule,  // module
+						"main",  // pName
+						nullptr  // pSpecializationInfo
+					},
+				}.data(),
+
+				// vertex input
+				&(const vk::PipelineVertexInputStateCreateInfo&)vk::PipelineVertexInputStateCreateInfo{  // pVertexInputState
+					vk::PipelineVertexInputStateCreateFlags(),  // flags
+					0,        // vertexBindingDescriptionCount
+					nullptr,  // pVertexBindingDescriptions
+					0,        // vertexAttributeDescriptionCount
+					nullptr   // pVertexAttributeDescriptions
+				},
+
+				// input assembly
+				&(const vk::PipelineInputAssemblyStateCreateInfo&)vk::PipelineInputAssemblyStateCreateInfo{  // pInputAssemblyState
+					vk::PipelineInputAssemblyStateCreateFlags(),  // flags
+					topology,  // topology
+					VK_FALSE  // primitiveRestartEnable
+				},
+
+				// tessellation
+				nullptr, // pTessellationState
+
+				// viewport
+				// (viewport and scissor are dynamic states)
+				&(const vk::PipelineViewportStateCreateInfo&)vk::PipelineViewportStateCreateInfo{  // pViewportState
+					vk::PipelineViewportStateCreateFlags(),  // flags
+					1,  // viewportCount
+					nullptr,  // pViewports
+					1,  // scissorCount
+					nullptr,  // pScissors
+				},
+
+				// rasterization
+				&(const vk::PipelineRasterizationStateCreateInfo&)vk::PipelineRasterizationStateCreateInfo{  // pRasterizationState
+					vk::PipelineRasterizationStateCreateFlags(),  // flags
+					VK_FALSE,  // depthClampEnable
+					VK_FALSE,  // rasterizerDiscardEnable
+					vk::PolygonMode::eFill,  // polygonMode
+					vk::CullModeFlagBits::eNone,  // cullMode
+					vk::FrontFace::eCounterClockwise,  // frontFace
+					VK_FALSE,  // depthBiasEnable
+					0.f,  // depthBiasConstantFactor
+					0.f,  // depthBiasClamp
+					0.f,  // depthBiasSlopeFactor
+					1.f   // lineWidth
+				},
+
+				// multisampling
+				&(const vk::PipelineMultisampleStateCreateInfo&)vk::PipelineMultisampleStateCreateInfo{  // pMultisampleState
+					vk::PipelineMultisampleStateCreateFlags(),  // flags
+					vk::SampleCountFlagBits::e1,  // rasterizationSamples
+					VK_FALSE,  // sampleShadingEnable
+					0.f,       // minSampleShading
+					nullptr,   // pSampleMask
+					VK_FALSE,  // alphaToCoverageEnable
+					VK_FALSE   // alphaToOneEnable
+				},
+
+				// depth and stencil
+				nullptr,  // pDepthStencilState
+
+				// blending
+				&(const vk::PipelineColorBlendStateCreateInfo&)vk::PipelineColorBlendStateCreateInfo{  // pColorBlendState
+					vk::PipelineColorBlendStateCreateFlags(),  // flags
+					VK_FALSE,  // logicOpEnable
+					vk::LogicOp::eClear,  // logicOp
+					1,  // attachmentCount
+					array{  // pAttachments
+						vk::PipelineColorBlendAttachmentState{
+							VK_FALSE,  // blendEnable
+							vk::BlendFactor::eZero,  // srcColorBlendFactor
+							vk::BlendFactor::eZero,  // dstColorBlendFactor
+							vk::BlendOp::eAdd,       // colorBlendOp
+							vk::BlendFactor::eZero,  // srcAlphaBlendFactor
+							vk::BlendFactor::eZero,  // dstAlphaBlendFactor
+							vk::BlendOp::eAdd,       // alphaBlendOp
+							vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
+								vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA  // colorWriteMask
+						},
+					}.data(),
+					array<float,4>{0.f,0.f,0.f,0.f}  // blendConstants
+				},
+
+				// dynamic state
+				&(const vk::PipelineDynamicStateCreateInfo&)vk::PipelineDynamicStateCreateInfo{  // pDynamicState
+					vk::PipelineDynamicStateCreateFlags(),  // flags
+					2,  // dynamicStateCount
+					array{  // pDynamicStates
+						vk::DynamicState::eViewport,
+						vk::DynamicState::eScissor,
+					}.data()
+				},
+
+				pipelineLayout,  // layout
+				renderPass,  // renderPass
+				0,  // subpass
+				vk::Pipeline(nullptr),  // basePipelineHandle
+				-1 // basePipelineIndex
+			)
+		).value;
+}
+
+
+void VulkanWindowPipeline::setViewportAndScissor(vk::CommandBuffer commandBuffer, vk::Extent2D extent)
+{
+	commandBuffer.setViewport(
+		0,  // firstViewport
+		vk::Viewport(0.f, 0.f, float(extent.width), float(extent.height), 0.f, 1.f)  // viewports
+	);
+	commandBuffer.setScissor(
+		0,  // firstScissor
+		vk::Rect2D(vk::Offset2D(0, 0), extent)  // scissors
+	);
+}
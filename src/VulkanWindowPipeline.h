@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+#include <string>
+
+
+// Pipeline cache persisted on disk.
+// The cache is loaded by init() and stored by save() or cleanUp().
+// A single cache is meant to be shared by all the pipelines of the application,
+// including the pipelines of different windows.
+class VulkanWindowPipelineCache {
+protected:
+
+	vk::Device _device;
+	vk::PipelineCache _pipelineCache;
+	std::string _fileName;
+	size_t _loadedSize = 0;
+
+public:
+
+	// construction and destruction
+	VulkanWindowPipelineCache() = default;
+	~VulkanWindowPipelineCache();
+
+	// deleted constructors and operators
+	VulkanWindowPipelineCache(const VulkanWindowPipelineCache&) = delete;
+	VulkanWindowPipelineCache& operator=(const VulkanWindowPipelineCache&) = delete;
+
+	// initialization and clean up
+	// (cache file that is missing, damaged or created by different device or driver is ignored;
+	// cleanUp() saves the cache and must be called before the device is destroyed;
+	// save() does not throw as it is called from the destructor, its failures are ignored)
+	void init(vk::PhysicalDevice physicalDevice, vk::Device device, const std::string& fileName);
+	void save() noexcept;
+	void cleanUp() noexcept;
+
+	// getters
+	vk::PipelineCache get() const;
+	size_t loadedSize() const;  // size of the data loaded from the file, zero if nothing was loaded
+
+};
+
+
+// Helper functions for the pipelines of the examples.
+// Viewport and scissor are dynamic states, so the pipelines do not need to be recreated on window resize.
+class VulkanWindowPipeline {
+public:
+
+	// creates pipeline made of vertex and fragment shader, single color attachment without blending,
+	// no vertex attributes, no depth buffer and dynamic viewport and scissor
+	static vk::Pipeline createSimple(vk::Device device, vk::PipelineCache pipelineCache,
+		vk::PipelineLayout pipelineLayout, vk::RenderPass renderPass,
+		vk::ShaderModule vsModule, vk::ShaderModule fsModule, vk::PrimitiveTopology topology);
+
+	// sets viewport and scissor to cover whole extent
+	static void setViewportAndScissor(vk::CommandBuffer commandBuffer, vk::Extent2D extent);
+
+};
+
+
+// inline methods
+inline VulkanWindowPipelineCache::~VulkanWindowPipelineCache()  { cleanUp(); }
+inline vk::PipelineCache VulkanWindowPipelineCache::get() const  { return _pipelineCache; }
+inline size_t VulkanWindowPipelineCache::loadedSize() const  { return _loadedSize; }
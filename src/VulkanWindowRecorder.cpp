@@ -0,0 +1,350 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#include "VulkanWindowRecorder.h"
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+
+// file format
+// (the header is followed by the events; each event is made of
+// event type (uint8), timestamp in nanoseconds since the start of recording (uint64)
+// and event specific data; all values are stored in the native byte order)
+static constexpr char fileMagic[8] = { 'V', 'W', 'R', 'E', 'C', '0', '0', '1' };
+enum EventType : uint8_t {
+	Frame, Resize, Close, WindowStateChanged, MouseMove, MouseButton, MouseWheel, Key,
+};
+static constexpr size_t mouseStateSize = 4*sizeof(float) + 2*sizeof(uint16_t);
+static constexpr size_t flushThreshold = 65536;
+
+
+template<typename T>
+static void append(vector<uint8_t>& buffer, T value)
+{
+	size_t pos = buffer.size();
+	buffer.resize(pos + sizeof(T));
+	memcpy(buffer.data() + pos, &value, sizeof(T));
+}
+
+
+template<typename T>
+static T read(const uint8_t*& p)
+{
+	T value;
+	memcpy(&value, p, sizeof(T));
+	p += sizeof(T);
+	return value;
+}
+
+
+static VulkanWindow::MouseState readMouseState(const uint8_t*& p)
+{
+	VulkanWindow::MouseState s;
+	s.posX = read<float>(p);
+	s.posY = read<float>(p);
+	s.relX = read<float>(p);
+	s.relY = read<float>(p);
+	s.buttons = read<uint16_t>(p);
+	s.modifiers = read<uint16_t>(p);
+	return s;
+}
+
+
+void VulkanWindowRecorder::start(VulkanWindow& window, const string& fileName)
+{
+	stop();
+
+	// open file
+	_file.open(fileName, ios::out | ios::binary | ios::trunc);
+	if(!_file)
+		throw runtime_error("VulkanWindowRecorder::start(): Cannot open file \"" + fileName + "\".");
+	_buffer.assign(begin(fileMagic), end(fileMagic));
+
+	// install itself as the window listener
+	_window = &window;
+	_previousListener = window.listener();
+	window.setListener(this);
+	_numEvents = 0;
+	_startTime = chrono::steady_clock::now();
+}
+
+
+void VulkanWindowRecorder::stop()
+{
+	if(_window == nullptr)
+		return;
+
+	_window->setListener(_previousListener);
+	_window = nullptr;
+	_previousListener = nullptr;
+	flush();
+	_file.close();
+}
+
+
+void VulkanWindowRecorder::beginEvent(uint8_t eventType)
+{
+	if(_buffer.size() >= flushThreshold)
+		flush();
+
+	append(_buffer, eventType);
+	append(_buffer, uint64_t(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - _startTime).count()));
+	_numEvents++;
+}
+
+
+void VulkanWindowRecorder::appendMouseState(const VulkanWindow::MouseState& mouseState)
+{
+	append(_buffer, mouseState.posX);
+	append(_buffer, mouseState.posY);
+	append(_buffer, mouseState.relX);
+	append(_buffer, mouseState.relY);
+	append(_buffer, uint16_t(mouseState.buttons.to_ulong()));
+	append(_buffer, uint16_t(mouseState.modifiers.to_ulong()));
+}
+
+
+void VulkanWindowRecorder::flush()
+{
+	_file.write(reinterpret_cast<const char*>(_buffer.data()), _buffer.size());
+	_buffer.clear();
+}
+
+
+void VulkanWindowRecorder::onFrame(VulkanWindow& window)
+{
+	beginEvent(EventType::Frame);
+	if(_previousListener)
+		_previousListener->onFrame(window);
+	else
+		window.frameCallback()(window);
+}
+
+
+void VulkanWindowRecorder::onResize(VulkanWindow& window, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
+{
+	beginEvent(EventType::Resize);
+	append(_buffer, widthToBeSet);
+	append(_buffer, heightToBeSet);
+	if(_previousListener)
+		_previousListener->onResize(window, widthToBeSet, heightToBeSet);
+	else
+		window.resizeCallback()(window, widthToBeSet, heightToBeSet);
+}
+
+
+void VulkanWindowRecorder::onClose(VulkanWindow& window)
+{
+	beginEvent(EventType::Close);
+	flush();  // window might be destroyed inside the callback
+	if(_previousListener)
+		_previousListener->onClose(window);
+	else if(window.closeCallback())
+		window.closeCallback()(window);
+	else
+		Listener::onClose(window);
+}
+
+
+void VulkanWindowRecorder::onWindowStateChanged(VulkanWindow& window, VulkanWindow::WindowState windowState)
+{
+	beginEvent(EventType::WindowStateChanged);
+	append(_buffer, uint8_t(windowState));
+	if(_previousListener)
+		_previousListener->onWindowStateChanged(window, windowState);
+	else if(window.windowStateChangedCallback())
+		window.windowStateChangedCallback()(window, windowState);
+}
+
+
+void VulkanWindowRecorder::onMouseMove(VulkanWindow& window, const VulkanWindow::MouseState& mouseState)
+{
+	beginEvent(EventType::MouseMove);
+	appendMouseState(mouseState);
+	if(_previousListener)
+		_previousListener->onMouseMove(window, mouseState);
+	else if(window.mouseMoveCallback())
+		window.mouseMoveCallback()(window, mouseState);
+}
+
+
+void VulkanWindowRecorder::onMouseButton(VulkanWindow& window, VulkanWindow::MouseButton::EnumType button,
+                                         VulkanWindow::ButtonState buttonState, const VulkanWindow::MouseState& mouseState)
+{
+	beginEvent(EventType::MouseButton);
+	append(_buffer, uint8_t(button));
+	append(_buffer, uint8_t(buttonState));
+	appendMouseState(mouseState);
+	if(_previousListener)
+		_previousListener->onMouseButton(window, button, buttonState, mouseState);
+	else if(window.mouseButtonCallback())
+		window.mouseButtonCallback()(window, button, buttonState, mouseState);
+}
+
+
+void VulkanWindowRecorder::onMouseWheel(VulkanWindow& window, float wheelX, float wheelY, const VulkanWindow::MouseState& mouseState)
+{
+	beginEvent(EventType::MouseWheel);
+	append(_buffer, wheelX);
+	append(_buffer, wheelY);
+	appendMouseState(mouseState);
+	if(_previousListener)
+		_previousListener->onMouseWheel(window, wheelX, wheelY, mouseState);
+	else if(window.mouseWheelCallback())
+		window.mouseWheelCallback()(window, wheelX, wheelY, mouseState);
+}
+
+
+void VulkanWindowRecorder::onKey(VulkanWindow& window, VulkanWindow::KeyState newKeyState,
+                                 VulkanWindow::ScanCode scanCode, VulkanWindow::KeyCode key)
+{
+	beginEvent(EventType::Key);
+	append(_buffer, uint8_t(newKeyState));
+	append(_buffer, uint16_t(scanCode));
+	append(_buffer, uint32_t(key));
+	if(_previousListener)
+		_previousListener->onKey(window, newKeyState, scanCode, key);
+	else if(window.keyCallback())
+		window.keyCallback()(window, newKeyState, scanCode, key);
+}
+
+
+void VulkanWindowRecorder::onOutputsChanged(VulkanWindow& window)
+{
+	if(_previousListener)
+		_previousListener->onOutputsChanged(window);
+	else if(window.outputsChangedCallback())
+		window.outputsChangedCallback()(window);
+}
+
+
+void VulkanWindowReplayer::load(const string& fileName)
+{
+	// read file
+	ifstream f(fileName, ios::in | ios::binary);
+	if(!f)
+		throw runtime_error("VulkanWindowReplayer::load(): Cannot open file \"" + fileName + "\".");
+	_data.assign(istreambuf_iterator<char>(f), istreambuf_iterator<char>());
+	if(f.bad())
+		throw runtime_error("VulkanWindowReplayer::load(): Error while reading file \"" + fileName + "\".");
+
+	// check header
+	if(_data.size() < sizeof(fileMagic) || memcmp(_data.data(), fileMagic, sizeof(fileMagic)) != 0) {
+		_data.clear();
+		throw runtime_error("VulkanWindowReplayer::load(): File \"" + fileName + "\" is not a VulkanWindow recording.");
+	}
+
+	// validate events
+	_numEvents = 0;
+	_duration = 0;
+	const uint8_t* p = _data.data() + sizeof(fileMagic);
+	const uint8_t* end = _data.data() + _data.size();
+	while(p != end) {
+		if(size_t(end - p) < 1 + sizeof(uint64_t))
+			goto truncated;
+		uint8_t eventType = read<uint8_t>(p);
+		_duration = read<uint64_t>(p);
+		size_t size;
+		switch(eventType) {
+		case EventType::Frame:
+		case EventType::Close:              size = 0; break;
+		case EventType::Resize:             size = 2*sizeof(uint32_t); break;
+		case EventType::WindowStateChanged: size = 1; break;
+		case EventType::MouseMove:          size = mouseStateSize; break;
+		case EventType::MouseButton:        size = 2 + mouseStateSize; break;
+		case EventType::MouseWheel:         size = 2*sizeof(float) + mouseStateSize; break;
+		case EventType::Key:                size = 1 + sizeof(uint16_t) + sizeof(uint32_t); break;
+		default:
+			_data.clear();
+			throw runtime_error("VulkanWindowReplayer::load(): Unknown event in file \"" + fileName + "\".");
+		}
+		if(size_t(end - p) < size)
+			goto truncated;
+		p += size;
+		_numEvents++;
+	}
+	return;
+
+truncated:
+	_data.clear();
+	throw runtime_error("VulkanWindowReplayer::load(): File \"" + fileName + "\" is truncated.");
+}
+
+
+void VulkanWindowReplayer::replay(VulkanWindow& window, Speed speed) const
+{
+	if(_data.empty())
+		return;
+
+	chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+	const uint8_t* p = _data.data() + sizeof(fileMagic);
+	const uint8_t* end = _data.data() + _data.size();
+	while(p != end) {
+
+		// wait for the event time
+		uint8_t eventType = read<uint8_t>(p);
+		uint64_t timestamp = read<uint64_t>(p);
+		if(speed == Speed::Original)
+			this_thread::sleep_until(startTime + chrono::nanoseconds(timestamp));
+
+		// dispatch event
+		switch(eventType) {
+		case EventType::Frame:
+			if(window._inputStateTracking)
+				window.takeInputSnapshot();
+			if(window.hasFrameHandler())
+				window.callFrame();
+			break;
+		case EventType::Resize:
+			window._surfaceWidth = read<uint32_t>(p);
+			window._surfaceHeight = read<uint32_t>(p);
+			if(window.hasResizeHandler())
+				window.callResize(window._surfaceWidth, window._surfaceHeight);
+			break;
+		case EventType::Close:
+			// default close handling is skipped as the window might not be created;
+			// the replay ends here because VulkanWindow object might be already destroyed when returning from the callback
+			if(window.hasCloseHandler())
+				window.callClose();
+			return;
+		case EventType::WindowStateChanged:
+			window._windowState = VulkanWindow::WindowState(read<uint8_t>(p));
+			if(window.hasWindowStateChangedHandler())
+				window.callWindowStateChanged(window._windowState);
+			break;
+		case EventType::MouseMove:
+			window._mouseState = readMouseState(p);
+			if(window.hasMouseMoveHandler())
+				window.callMouseMove(window._mouseState);
+			break;
+		case EventType::MouseButton: {
+			auto button = VulkanWindow::MouseButton::EnumType(read<uint8_t>(p));
+			auto buttonState = VulkanWindow::ButtonState(read<uint8_t>(p));
+			window._mouseState = readMouseState(p);
+			if(window.hasMouseButtonHandler())
+				window.callMouseButton(button, buttonState, window._mouseState);
+			break;
+		}
+		case EventType::MouseWheel: {
+			float wheelX = read<float>(p);
+			float wheelY = read<float>(p);
+			window._mouseState = readMouseState(p);
+			if(window.hasMouseWheelHandler())
+				window.callMouseWheel(wheelX, wheelY, window._mouseState);
+			break;
+		}
+		case EventType::Key: {
+			auto keyState = VulkanWindow::KeyState(read<uint8_t>(p));
+			auto scanCode = VulkanWindow::ScanCode(read<uint16_t>(p));
+			auto keyCode = VulkanWindow::KeyCode(read<uint32_t>(p));
+			if(window.hasKeyHandler())
+				window.callKey(keyState, scanCode, keyCode);
+			break;
+		}
+		}
+	}
+}
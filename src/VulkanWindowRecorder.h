@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#pragma once
+
+#include "VulkanWindow.h"
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+// Records all events delivered to the window into a binary file.
+// When recording, VulkanWindowRecorder is installed as the window listener
+// and it forwards each event to the previous listener or to the window callbacks.
+class VulkanWindowRecorder : public VulkanWindow::Listener {
+protected:
+
+	VulkanWindow* _window = nullptr;
+	VulkanWindow::Listener* _previousListener = nullptr;
+	std::ofstream _file;
+	std::vector<uint8_t> _buffer;
+	std::chrono::steady_clock::time_point _startTime;
+	size_t _numEvents = 0;
+
+	void beginEvent(uint8_t eventType);
+	void appendMouseState(const VulkanWindow::MouseState& mouseState);
+	void flush();
+
+public:
+
+	// construction and destruction
+	VulkanWindowRecorder() = default;
+	~VulkanWindowRecorder();
+
+	// deleted constructors and operators
+	VulkanWindowRecorder(const VulkanWindowRecorder&) = delete;
+	VulkanWindowRecorder& operator=(const VulkanWindowRecorder&) = delete;
+
+	// recording
+	// (stop() must be called before the window is destroyed or moved)
+	void start(VulkanWindow& window, const std::string& fileName);
+	void stop();
+	bool isRecording() const;
+	size_t numEvents() const;
+
+	// listener methods
+	void onFrame(VulkanWindow& window) override;
+	void onResize(VulkanWindow& window, uint32_t& widthToBeSet, uint32_t& heightToBeSet) override;
+	void onClose(VulkanWindow& window) override;
+	void onWindowStateChanged(VulkanWindow& window, VulkanWindow::WindowState windowState) override;
+	void onMouseMove(VulkanWindow& window, const VulkanWindow::MouseState& mouseState) override;
+	void onMouseButton(VulkanWindow& window, VulkanWindow::MouseButton::EnumType button,
+	                   VulkanWindow::ButtonState buttonState, const VulkanWindow::MouseState& mouseState) override;
+	void onMouseWheel(VulkanWindow& window, float wheelX, float wheelY, const VulkanWindow::MouseState& mouseState) override;
+	void onKey(VulkanWindow& window, VulkanWindow::KeyState newKeyState,
+	           VulkanWindow::ScanCode scanCode, VulkanWindow::KeyCode key) override;
+	void onOutputsChanged(VulkanWindow& window) override;  // forwarded only, outputs are not recorded
+
+};
+
+
+// Feeds a recording made by VulkanWindowRecorder back to the window.
+// Events are dispatched to the window listener or callbacks in the same way as the windowing system events.
+// The window does not need to be created, so the replay works on headless systems as well.
+class VulkanWindowReplayer {
+protected:
+
+	std::vector<uint8_t> _data;
+	size_t _numEvents = 0;
+	uint64_t _duration = 0;  // in nanoseconds
+
+public:
+
+	enum class Speed { Original, Maximum };
+
+	void load(const std::string& fileName);
+	void replay(VulkanWindow& window, Speed speed = Speed::Maximum) const;  // stops after the replayed close event
+	size_t numEvents() const;
+	double duration() const;  // in seconds
+
+};
+
+
+// inline methods
+inline VulkanWindowRecorder::~VulkanWindowRecorder()  { stop(); }
+inline bool VulkanWindowRecorder::isRecording() const  { return _window != nullptr; }
+inline size_t VulkanWindowRecorder::numEvents() const  { return _numEvents; }
+inline size_t VulkanWindowReplayer::numEvents() const  { return _numEvents; }
+inline double VulkanWindowReplayer::duration() const  { return double(_duration) * 1e-9; }
@@ -0,0 +1,541 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#include "VulkanWindowCapture.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Capture test verifies the image encoders used by VulkanWindowCapture.
+// The PNG is decoded back (stored deflate blocks only) and its checksums are verified.
+// Then the frames are captured from an offscreen image on any Vulkan device with VK_KHR_swapchain,
+// so it runs headless (lavapipe works as well); no window is created. The capture part is skipped
+// if no such device is found.
+
+
+// constants
+constexpr const char* appName = "CaptureTest";
+constexpr uint32_t width = 301;  // odd width and many rows to get multiple deflate blocks
+constexpr uint32_t height = 257;
+
+
+static vector<uint8_t> makeImage()
+{
+	vector<uint8_t> image(size_t(width) * height * 4);
+	for(size_t i=0; i<image.size(); i++)
+		image[i] = uint8_t(i * 7 + i / 1021);
+	return image;
+}
+
+
+static uint32_t readBigEndian32(const uint8_t* p)
+{
+	return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+
+static uint32_t crc32(const uint8_t* data, size_t size)
+{
+	uint32_t c = 0xffffffff;
+	for(size_t i=0; i<size; i++) {
+		c ^= data[i];
+		for(int k=0; k<8; k++)
+			c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+	}
+	return c ^ 0xffffffff;
+}
+
+
+// decode PNG produced by encodePNG() and return error message or empty string on success
+static string decodePNG(const vector<uint8_t>& png, vector<uint8_t>& rgba)
+{
+	static constexpr const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+	if(png.size() < 8 || memcmp(png.data(), signature, 8) != 0)
+		return "Wrong PNG signature.";
+
+	// chunks
+	vector<uint8_t> zlibData;
+	uint32_t w = 0, h = 0;
+	bool end = false;
+	size_t pos = 8;
+	while(!end) {
+		if(pos + 12 > png.size())
+			return "Truncated PNG chunk.";
+		uint32_t size = readBigEndian32(&png[pos]);
+		if(pos + 12 + size > png.size())
+			return "Truncated PNG chunk.";
+		const uint8_t* type = &png[pos+4];
+		const uint8_t* data = &png[pos+8];
+		if(crc32(type, size + 4) != readBigEndian32(data + size))
+			return "Wrong PNG chunk CRC.";
+		if(memcmp(type, "IHDR", 4) == 0) {
+			w = readBigEndian32(data);
+			h = readBigEndian32(data + 4);
+			if(size != 13 || data[8] != 8 || data[9] != 6)
+				return "Wrong IHDR.";
+		}
+		else if(memcmp(type, "IDAT", 4) == 0)
+			zlibData.insert(zlibData.end(), data, data + size);
+		else if(memcmp(type, "IEND", 4) == 0)
+			end = true;
+		pos += 12 + size;
+	}
+	if(w != width || h != height)
+		return "Wrong image size.";
+
+	// zlib stream of stored blocks
+	if(zlibData.size() < 6 || ((zlibData[0] << 8) | zlibData[1]) % 31 != 0)
+		return "Wrong zlib header.";
+	vector<uint8_t> raw;
+	pos = 2;
+	bool last = false;
+	while(!last) {
+		if(pos + 5 > zlibData.size())
+			return "Truncated deflate block.";
+		last = zlibData[pos] & 1;
+		if((zlibData[pos] >> 1) != 0)
+			return "Deflate block is not stored block.";
+		uint16_t len = uint16_t(zlibData[pos+1] | (zlibData[pos+2] << 8));
+		uint16_t nlen = uint16_t(zlibData[pos+3] | (zlibData[pos+4] << 8));
+		if(uint16_t(~len) != nlen)
+			return "Wrong deflate block length.";
+		pos += 5;
+		if(pos + len > zlibData.size())
+			return "Truncated deflate block.";
+		raw.insert(raw.end(), &zlibData[pos], &zlibData[pos] + len);
+		pos += len;
+	}
+	uint32_t a = 1, b = 0;
+	for(uint8_t v : raw) {
+		a = (a + v) % 65521;
+		b = (b + a) % 65521;
+	}
+	if(pos + 4 != zlibData.size() || readBigEndian32(&zlibData[pos]) != ((b << 16) | a))
+		return "Wrong Adler-32 checksum.";
+
+	// remove filter bytes
+	size_t rowSize = size_t(w) * 4;
+	if(raw.size() != (rowSize + 1) * h)
+		return "Wrong image data size.";
+	rgba.clear();
+	for(size_t y=0; y<h; y++) {
+		if(raw[y * (rowSize+1)] != 0)
+			return "Unexpected filter type.";
+		rgba.insert(rgba.end(), &raw[y * (rowSize+1) + 1], &raw[y * (rowSize+1) + 1] + rowSize);
+	}
+	return {};
+}
+
+
+// Vulkan objects of the capture test
+// (the offscreen image takes the role of the swapchain image)
+struct Headless {
+	vk::Instance instance;
+	vk::PhysicalDevice physicalDevice;
+	uint32_t queueFamily = 0;
+	vk::Device device;
+	vk::Queue queue;
+	vk::CommandPool commandPool;
+	vk::CommandBuffer commandBuffer;
+	vk::Image image;
+	vk::DeviceMemory imageMemory;
+	static constexpr vk::Format format = vk::Format::eB8G8R8A8Unorm;  // exercises the BGRA to RGBA conversion
+	static constexpr vk::Extent2D extent = { 67, 41 };
+	~Headless();
+	bool init();
+	bool renderFrame(VulkanWindowCapture& capture, uint64_t frameNumber);
+};
+
+
+Headless::~Headless()
+{
+	if(device) {
+		vkDeviceWaitIdle(device);
+		device.destroy(image);
+		device.freeMemory(imageMemory);
+		device.destroy(commandPool);
+		device.destroy();
+	}
+	instance.destroy();
+}
+
+
+// create device and offscreen image, return false if no suitable device was found
+bool Headless::init()
+{
+	// instance
+	// (missing Vulkan driver skips the test)
+	try {
+		instance =
+			vk::createInstance(
+				vk::InstanceCreateInfo{
+					vk::InstanceCreateFlags(),  // flags
+					&(const vk::ApplicationInfo&)vk::ApplicationInfo{
+						appName,                 // application name
+						VK_MAKE_VERSION(0,0,0),  // application version
+						nullptr,                 // engine name
+						VK_MAKE_VERSION(0,0,0),  // engine version
+						VK_API_VERSION_1_0,      // api version
+					},
+					0, nullptr,  // no layers
+					0, nullptr,  // no extensions
+				}
+			);
+	} catch(vk::IncompatibleDriverError&) {
+		return false;
+	}
+
+	// device with graphics queue and VK_KHR_swapchain
+	// (VK_KHR_swapchain is required for ePresentSrcKHR layout expected by recordCopy())
+	for(vk::PhysicalDevice pd : instance.enumeratePhysicalDevices()) {
+		bool swapchainSupported = false;
+		for(vk::ExtensionProperties& e : pd.enumerateDeviceExtensionProperties())
+			if(strcmp(e.extensionName, "VK_KHR_swapchain") == 0)
+				swapchainSupported = true;
+		if(!swapchainSupported)
+			continue;
+		vector<vk::QueueFamilyProperties> queueFamilyList = pd.getQueueFamilyProperties();
+		for(uint32_t i=0, c=uint32_t(queueFamilyList.size()); i<c; i++)
+			if(queueFamilyList[i].queueFlags & vk::QueueFlagBits::eGraphics) {
+				physicalDevice = pd;
+				queueFamily = i;
+				goto deviceFound;
+			}
+	}
+	return false;
+deviceFound:
+
+	// create device
+	device =
+		physicalDevice.createDevice(
+			vk::DeviceCreateInfo{
+				vk::DeviceCreateFlags(),  // flags
+				1,  // queueCreateInfoCount
+				array{  // pQueueCreateInfos
+					vk::DeviceQueueCreateInfo{
+						vk::DeviceQueueCreateFlags(),
+						queueFamily,
+						1,
+						&(const float&)1.f,
+					},
+				}.data(),
+				0, nullptr,  // no layers
+				1,           // number of enabled extensions
+				array<const char*, 1>{ "VK_KHR_swapchain" }.data(),  // enabled extension names
+				nullptr,    // enabled features
+			}
+		);
+	queue = device.getQueue(queueFamily, 0);
+
+	// command buffer
+	commandPool =
+		device.createCommandPool(
+			vk::CommandPoolCreateInfo(
+				vk::CommandPoolCreateFlagBits::eResetCommandBuffer,  // flags
+				queueFamily  // queueFamilyIndex
+			)
+		);
+	commandBuffer =
+		device.allocateCommandBuffers(
+			vk::CommandBufferAllocateInfo(
+				commandPool,  // commandPool
+				vk::CommandBufferLevel::ePrimary,  // level
+				1  // commandBufferCount
+			)
+		)[0];
+
+	// offscreen image
+	image =
+		device.createImage(
+			vk::ImageCreateInfo(
+				vk::ImageCreateFlags(),  // flags
+				vk::ImageType::e2D,  // imageType
+				format,  // format
+				vk::Extent3D(extent.width, extent.height, 1),  // extent
+				1,  // mipLevels
+				1,  // arrayLayers
+				vk::SampleCountFlagBits::e1,  // samples
+				vk::ImageTiling::eOptimal,  // tiling
+				vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst,  // usage
+				vk::SharingMode::eExclusive,  // sharingMode
+				0,  // queueFamilyIndexCount
+				nullptr,  // pQueueFamilyIndices
+				vk::ImageLayout::eUndefined  // initialLayout
+			)
+		);
+	vk::MemoryRequirements memoryRequirements = device.getImageMemoryRequirements(image);
+	uint32_t memoryTypeIndex = 0;
+	while(!(memoryRequirements.memoryTypeBits & (1u << memoryTypeIndex)))
+		memoryTypeIndex++;
+	imageMemory =
+		device.allocateMemory(
+			vk::MemoryAllocateInfo(
+				memoryRequirements.size,  // allocationSize
+				memoryTypeIndex  // memoryTypeIndex
+			)
+		);
+	device.bindImageMemory(image, imageMemory, 0);
+	return true;
+}
+
+
+// color of the frame
+static array<uint8_t, 4> frameColor(uint64_t frameNumber)
+{
+	return { uint8_t(frameNumber * 40 + 10), uint8_t(255 - frameNumber * 30), uint8_t(frameNumber * 7), 255 };
+}
+
+
+// clear the image to the frame color and capture it, return value of recordCopy()
+bool Headless::renderFrame(VulkanWindowCapture& capture, uint64_t frameNumber)
+{
+	array<uint8_t, 4> c = frameColor(frameNumber);
+	commandBuffer.begin(
+		vk::CommandBufferBeginInfo(
+			vk::CommandBufferUsageFlagBits::eOneTimeSubmit,  // flags
+			nullptr  // pInheritanceInfo
+		)
+	);
+	commandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTopOfPipe,  // srcStageMask
+		vk::PipelineStageFlagBits::eTransfer,  // dstStageMask
+		vk::DependencyFlags(),  // dependencyFlags
+		nullptr,  // memoryBarriers
+		nullptr,  // bufferMemoryBarriers
+		vk::ImageMemoryBarrier(  // imageMemoryBarriers
+			vk::AccessFlags(),  // srcAccessMask
+			vk::AccessFlagBits::eTransferWrite,  // dstAccessMask
+			vk::ImageLayout::eUndefined,  // oldLayout
+			vk::ImageLayout::eTransferDstOptimal,  // newLayout
+			VK_QUEUE_FAMILY_IGNORED,  // srcQueueFamilyIndex
+			VK_QUEUE_FAMILY_IGNORED,  // dstQueueFamilyIndex
+			image,  // image
+			vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)  // subresourceRange
+		)
+	);
+	commandBuffer.clearColorImage(
+		image,  // image
+		vk::ImageLayout::eTransferDstOptimal,  // imageLayout
+		vk::ClearColorValue(array<float, 4>{ c[0] / 255.f, c[1] / 255.f, c[2] / 255.f, c[3] / 255.f }),  // color
+		vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)  // ranges
+	);
+	commandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTransfer,  // srcStageMask
+		vk::PipelineStageFlagBits::eColorAttachmentOutput,  // dstStageMask
+		vk::DependencyFlags(),  // dependencyFlags
+		nullptr,  // memoryBarriers
+		nullptr,  // bufferMemoryBarriers
+		vk::ImageMemoryBarrier(  // imageMemoryBarriers
+			vk::AccessFlagBits::eTransferWrite,  // srcAccessMask
+			vk::AccessFlags(),  // dstAccessMask
+			vk::ImageLayout::eTransferDstOptimal,  // oldLayout
+			vk::ImageLayout::ePresentSrcKHR,  // newLayout
+			VK_QUEUE_FAMILY_IGNORED,  // srcQueueFamilyIndex
+			VK_QUEUE_FAMILY_IGNORED,  // dstQueueFamilyIndex
+			image,  // image
+			vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)  // subresourceRange
+		)
+	);
+	bool captured = capture.recordCopy(commandBuffer, image, format, extent);
+	commandBuffer.end();
+
+	// submit and wait
+	// (the command buffer is reused by the next frame)
+	queue.submit(
+		vk::ArrayProxy<const vk::SubmitInfo>(
+			1,
+			&(const vk::SubmitInfo&)vk::SubmitInfo(
+				0, nullptr, nullptr,  // waitSemaphoreCount + pWaitSemaphores + pWaitDstStageMask
+				1, &commandBuffer,  // commandBufferCount + pCommandBuffers
+				0, nullptr  // signalSemaphoreCount + pSignalSemaphores
+			)
+		),
+		vk::Fence()  // fence
+	);
+	capture.submitted(queue);
+	queue.waitIdle();
+	return captured;
+}
+
+
+// captured frames
+// (the frame callback is called on the worker thread)
+struct CapturedFrames {
+	mutex m;
+	vector<uint64_t> frameNumbers;
+	string error;
+	atomic<bool> blocked = false;  // blocks the worker, so the staging buffers cannot be freed
+
+	void callback(const VulkanWindowCapture::Frame& frame)
+	{
+		while(blocked)
+			this_thread::sleep_for(chrono::milliseconds(1));
+		lock_guard lock(m);
+		frameNumbers.push_back(frame.frameNumber);
+		array<uint8_t, 4> c = frameColor(frame.frameNumber);
+		if(frame.width != Headless::extent.width || frame.height != Headless::extent.height)
+			error = "Wrong size of captured frame.";
+		for(size_t i=0, n=size_t(frame.width)*frame.height*4; i<n; i++)
+			if(frame.data[i] != c[i%4]) {
+				error = "Wrong pixel value in captured frame " + to_string(frame.frameNumber) + ".";
+				break;
+			}
+	}
+};
+
+
+static int testCapture()
+{
+	cout << "Testing headless capture..." << flush;
+	Headless headless;
+	if(!headless.init()) {
+		cout << " Skipped.\n   No Vulkan device with VK_KHR_swapchain and graphics queue." << endl;
+		return 0;
+	}
+	CapturedFrames frames;
+	VulkanWindowCapture capture;  // destroyed before the device and the frames
+
+	// capture frames
+	// (flush() after each frame makes the staging buffers free, so no frame is dropped)
+	constexpr size_t numFrames = 6;
+	capture.init(headless.physicalDevice, headless.device, 3);
+	capture.setFrameCallback([&frames](const VulkanWindowCapture::Frame& f) { frames.callback(f); });
+	for(uint64_t i=0; i<numFrames; i++) {
+		if(!headless.renderFrame(capture, i)) {
+			cout << " Failed.\n   Frame " << i << " was dropped." << endl;
+			return 1;
+		}
+		capture.flush();
+	}
+	if(capture.numCaptured() != numFrames || capture.numDropped() != 0 || capture.numFailed() != 0) {
+		cout << " Failed.\n   Captured " << capture.numCaptured() << ", dropped " << capture.numDropped()
+		     << " and failed " << capture.numFailed() << " frames instead of " << numFrames << ", 0 and 0." << endl;
+		return 1;
+	}
+	if(!frames.error.empty()) {
+		cout << " Failed.\n   " << frames.error << endl;
+		return 1;
+	}
+	if(frames.frameNumbers != vector<uint64_t>{ 0, 1, 2, 3, 4, 5 }) {
+		cout << " Failed.\n   Wrong frame numbers of captured frames." << endl;
+		return 1;
+	}
+	cout << " Done." << endl;
+
+	// dropping
+	// (with the worker blocked, the first frame is processed by the worker, the second one waits in its queue
+	// and the frames recorded afterwards find no free staging buffer)
+	cout << "Testing dropping of frames..." << flush;
+	capture.init(headless.physicalDevice, headless.device, 2);
+	frames.frameNumbers.clear();
+	frames.blocked = true;
+	bool captured[4];
+	for(uint64_t i=0; i<4; i++)
+		captured[i] = headless.renderFrame(capture, i);
+	frames.blocked = false;
+	capture.flush();
+	if(!captured[0] || !captured[1] || captured[2] || captured[3] ||
+	   capture.numCaptured() != 2 || capture.numDropped() != 2 || capture.numFailed() != 0)
+	{
+		cout << " Failed.\n   Captured " << capture.numCaptured() << ", dropped " << capture.numDropped()
+		     << " and failed " << capture.numFailed() << " frames instead of 2, 2 and 0." << endl;
+		return 1;
+	}
+	if(!frames.error.empty()) {
+		cout << " Failed.\n   " << frames.error << endl;
+		return 1;
+	}
+	if(frames.frameNumbers != vector<uint64_t>{ 0, 1 }) {
+		cout << " Failed.\n   Wrong frame numbers of captured frames." << endl;
+		return 1;
+	}
+	capture.cleanUp();
+	cout << " Done." << endl;
+	return 0;
+}
+
+
+int main(int, char**)
+{
+	cout << appName << ":" << endl;
+	vector<uint8_t> image = makeImage();
+	vector<uint8_t> out;
+
+	// PNG
+	cout << "Testing PNG encoding..." << flush;
+	VulkanWindowCapture::encodePNG(out, image.data(), width, height);
+	vector<uint8_t> decoded;
+	string error = decodePNG(out, decoded);
+	if(!error.empty()) {
+		cout << " Failed.\n   " << error << endl;
+		return 1;
+	}
+	if(decoded != image) {
+		cout << " Failed.\n   Decoded image differs from the original." << endl;
+		return 1;
+	}
+	cout << " Done." << endl;
+
+	// PPM
+	cout << "Testing PPM encoding..." << flush;
+	VulkanWindowCapture::encodePPM(out, image.data(), width, height);
+	string header = "P6\n" + to_string(width) + " " + to_string(height) + "\n255\n";
+	if(out.size() != header.size() + size_t(width) * height * 3 ||
+	   memcmp(out.data(), header.data(), header.size()) != 0 ||
+	   out[header.size() + 3] != image[4] || out[header.size() + 5] != image[6])
+	{
+		cout << " Failed.\n   Wrong PPM data." << endl;
+		return 1;
+	}
+	cout << " Done." << endl;
+
+	// Y4M
+	// (black and white map to the limits of BT.601 limited range)
+	cout << "Testing Y4M encoding..." << flush;
+	VulkanWindowCapture::encodeY4MHeader(out, width, height, 30);
+	if(string(out.begin(), out.end()) != "YUV4MPEG2 W301 H257 F30:1 Ip A1:1 C444\n") {
+		cout << " Failed.\n   Wrong Y4M header." << endl;
+		return 1;
+	}
+	const uint8_t blackAndWhite[8] = { 0, 0, 0, 255, 255, 255, 255, 255 };
+	VulkanWindowCapture::encodeY4MFrame(out, blackAndWhite, 2, 1);
+	const uint8_t expected[] = { 'F', 'R', 'A', 'M', 'E', '\n', 16, 235, 128, 128, 128, 128 };
+	if(out.size() != sizeof(expected) || memcmp(out.data(), expected, sizeof(expected)) != 0) {
+		cout << " Failed.\n   Wrong Y4M frame data." << endl;
+		return 1;
+	}
+	cout << " Done." << endl;
+
+	// supported formats
+	cout << "Testing supported formats..." << flush;
+	if(!VulkanWindowCapture::isFormatSupported(vk::Format::eB8G8R8A8Srgb) ||
+	   VulkanWindowCapture::isFormatSupported(vk::Format::eR16G16B16A16Sfloat))
+	{
+		cout << " Failed.\n   Wrong result of isFormatSupported()." << endl;
+		return 1;
+	}
+	cout << " Done." << endl;
+
+	// capture
+	// (vulkan.hpp functions throw if they fail)
+	try {
+		if(testCapture() != 0)
+			return 1;
+	} catch(exception& e) {
+		cout << " Failed because of exception: " << e.what() << endl;
+		return 1;
+	}
+
+	cout << "All tests passed." << endl;
+	return 0;
+}
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#include "VulkanWindow.h"
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+// Dispatch benchmark measures per-event cost of delivering input events
+// through std::function callbacks and through VulkanWindow::Listener.
+// No window is created; events are dispatched by the same code paths
+// that the windowing backends use.
+
+
+// constants
+constexpr const char* appName = "DispatchBenchmark";
+constexpr size_t numEvents = 20'000'000;
+
+
+// window exposing event dispatch functions
+class BenchmarkWindow : public VulkanWindow {
+public:
+	void dispatchMouseMove()  { if(hasMouseMoveHandler()) callMouseMove(_mouseState); }
+	void dispatchMouseMoveDirectly()  { if(_mouseMoveCallback) _mouseMoveCallback(*this, _mouseState); }  // dispatch without Listener support
+	void dispatchKey(ScanCode scanCode)  { if(hasKeyHandler()) callKey(KeyState::Pressed, scanCode, KeyCode::Space); }
+};
+
+
+// event consumers
+static size_t counter = 0;
+
+struct App {
+	void mouseMove(VulkanWindow&, const VulkanWindow::MouseState& mouseState)  { counter += size_t(mouseState.posX) + 1; }
+	void key(VulkanWindow&, VulkanWindow::KeyState, VulkanWindow::ScanCode scanCode, VulkanWindow::KeyCode)  { counter += size_t(scanCode); }
+};
+
+class AppListener final : public VulkanWindow::Listener {
+public:
+	void onFrame(VulkanWindow&) override  {}
+	void onResize(VulkanWindow&, uint32_t&, uint32_t&) override  {}
+	void onMouseMove(VulkanWindow&, const VulkanWindow::MouseState& mouseState) override  { counter += size_t(mouseState.posX) + 1; }
+	void onKey(VulkanWindow&, VulkanWindow::KeyState, VulkanWindow::ScanCode scanCode, VulkanWindow::KeyCode) override  { counter += size_t(scanCode); }
+};
+
+
+template<typename Func>
+static double measure(const char* name, size_t expectedChecksum, Func f)
+{
+	counter = 0;
+	auto t1 = chrono::steady_clock::now();
+	f();
+	auto t2 = chrono::steady_clock::now();
+	double ns = chrono::duration<double, nano>(t2 - t1).count() / numEvents;
+	cout << "   " << name << ": " << ns << "ns per event (checksum " << counter << ")" << endl;
+	if(counter != expectedChecksum)
+		throw runtime_error(string(name) + ": wrong checksum, events were not dispatched correctly.");
+	return ns;
+}
+
+
+int main(int, char**)
+{
+	cout << appName << ":" << endl;
+
+	// expected checksums
+	// (mouse move adds one per event, key adds scan code cycling through 0..127)
+	constexpr size_t mouseChecksum = numEvents;
+	constexpr size_t keyChecksum = numEvents / 128 * (127 * 128 / 2);
+
+	try {
+
+		BenchmarkWindow window;
+		App app;
+		AppListener listener;
+
+		// no handler
+		measure("no handler, mouse move", 0, [&]() {
+			for(size_t i=0; i<numEvents; i++)
+				window.dispatchMouseMove();
+		});
+
+		// std::function with lambda
+		window.setMouseMoveCallback(
+			[](VulkanWindow&, const VulkanWindow::MouseState& mouseState) { counter += size_t(mouseState.posX) + 1; });
+		window.setKeyCallback(
+			[](VulkanWindow&, VulkanWindow::KeyState, VulkanWindow::ScanCode scanCode, VulkanWindow::KeyCode) { counter += size_t(scanCode); });
+		double directNs = measure("std::function (lambda) without dispatch helpers, mouse move", mouseChecksum, [&]() {
+			for(size_t i=0; i<numEvents; i++)
+				window.dispatchMouseMoveDirectly();
+		});
+		double lambdaNs = measure("std::function (lambda), mouse move", mouseChecksum, [&]() {
+			for(size_t i=0; i<numEvents; i++)
+				window.dispatchMouseMove();
+		});
+		measure("std::function (lambda), key", keyChecksum, [&]() {
+			for(size_t i=0; i<numEvents; i++)
+				window.dispatchKey(VulkanWindow::ScanCode(i & 0x7f));
+		});
+
+		// std::function with bind to member function
+		window.setMouseMoveCallback(bind(&App::mouseMove, &app, placeholders::_1, placeholders::_2));
+		window.setKeyCallback(bind(&App::key, &app, placeholders::_1, placeholders::_2, placeholders::_3, placeholders::_4));
+		measure("std::function (bind), mouse move", mouseChecksum, [&]() {
+			for(size_t i=0; i<numEvents; i++)
+				window.dispatchMouseMove();
+		});
+		measure("std::function (bind), key", keyChecksum, [&]() {
+			for(size_t i=0; i<numEvents; i++)
+				window.dispatchKey(VulkanWindow::ScanCode(i & 0x7f));
+		});
+
+		// listener
+		window.setListener(&listener);
+		double listenerNs = measure("Listener, mouse move", mouseChecksum, [&]() {
+			for(size_t i=0; i<numEvents; i++)
+				window.dispatchMouseMove();
+		});
+		measure("Listener, key", keyChecksum, [&]() {
+			for(size_t i=0; i<numEvents; i++)
+				window.dispatchKey(VulkanWindow::ScanCode(i & 0x7f));
+		});
+		window.setListener(nullptr);
+
+		// dispatch overhead
+		// (the bound is loose to stay reliable on loaded machines; it catches dispatch helpers
+		// that stop being inlined or that do much more work than a flag test per event)
+		cout << "   Dispatch helpers to direct call ratio: " << lambdaNs / directNs << endl;
+		cout << "   Listener to std::function ratio: " << listenerNs / lambdaNs << endl;
+		if(lambdaNs > directNs * 2. + 2. || listenerNs > directNs * 2. + 2.)
+			throw runtime_error("Dispatch through VulkanWindow helpers is much slower than the direct call.");
+
+	// catch exceptions
+	} catch(exception& e) {
+		cout << "Failed because of exception: " << e.what() << endl;
+		return 1;
+	} catch(...) {
+		cout << "Failed because of unspecified exception." << endl;
+		return 1;
+	}
+
+	cout << "Done." << endl;
+	return 0;
+}
@@ -0,0 +1,280 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#include "VulkanWindow.h"
+#include <vulkan/vulkan.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+// Display test checks display, mode and plane selection of the Display platform (GUI_TYPE=Display).
+// The VK_KHR_display functions are provided by the test through getInstanceProcAddr parameter
+// of VulkanWindow::create(), so no Vulkan driver and no display hardware is needed.
+// (To run the other tests and examples on the Display platform without a display,
+// use Vulkan mock ICD or vkms virtual KMS driver.)
+
+
+// constants
+constexpr const char* appName = "DisplayTest";
+
+
+#if defined(USE_PLATFORM_DISPLAY)
+
+// fake displays
+// (display 1 is driven by plane 0, plane 1 is free and it can be used with both displays)
+static const VkPhysicalDevice physicalDevice = reinterpret_cast<VkPhysicalDevice>(uintptr_t(0x10));
+static const VkDisplayKHR display1 = VkDisplayKHR(0x21);
+static const VkDisplayKHR display2 = VkDisplayKHR(0x22);
+static const VkDisplayPropertiesKHR displays[] = {
+	{ display1, "Fake-1", { 527, 296 }, { 1920, 1080 }, VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR, VK_FALSE, VK_FALSE },
+	{ display2, "Fake-2", { 280, 210 }, { 800, 600 }, VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR, VK_FALSE, VK_FALSE },
+};
+static const VkDisplayModePropertiesKHR display1Modes[] = {
+	{ VkDisplayModeKHR(0x31), { { 1920, 1080 }, 60000 } },
+	{ VkDisplayModeKHR(0x32), { { 1920, 1080 }, 75000 } },
+	{ VkDisplayModeKHR(0x33), { { 1280, 720 }, 60000 } },
+};
+static const VkDisplayModePropertiesKHR display2Modes[] = {
+	{ VkDisplayModeKHR(0x34), { { 800, 600 }, 60000 } },
+};
+static const VkDisplayPlanePropertiesKHR planes[] = {
+	{ display1, 0 },
+	{ VK_NULL_HANDLE, 1 },
+};
+static VkDisplaySurfaceCreateInfoKHR lastCreateInfo;
+static unsigned numSurfaces = 0;
+
+
+// return array in the way of Vulkan enumeration functions
+template<typename T, size_t N>
+static VkResult enumerate(const T (&a)[N], uint32_t* count, T* data, size_t n = N)
+{
+	if(data == nullptr) {
+		*count = uint32_t(n);
+		return VK_SUCCESS;
+	}
+	uint32_t c = min(*count, uint32_t(n));
+	memcpy(data, a, c * sizeof(T));
+	*count = c;
+	return (c < n) ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+
+static VKAPI_ATTR VkResult VKAPI_CALL fakeEnumeratePhysicalDevices(VkInstance, uint32_t* count, VkPhysicalDevice* data)
+{
+	const VkPhysicalDevice a[] = { physicalDevice };
+	return enumerate(a, count, data);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL fakeGetPhysicalDeviceDisplayPropertiesKHR(VkPhysicalDevice, uint32_t* count, VkDisplayPropertiesKHR* data)
+{
+	return enumerate(displays, count, data);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL fakeGetPhysicalDeviceDisplayPlanePropertiesKHR(VkPhysicalDevice, uint32_t* count, VkDisplayPlanePropertiesKHR* data)
+{
+	return enumerate(planes, count, data);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL fakeGetDisplayPlaneSupportedDisplaysKHR(VkPhysicalDevice, uint32_t planeIndex, uint32_t* count, VkDisplayKHR* data)
+{
+	const VkDisplayKHR a[] = { display1, display2 };
+	return enumerate(a, count, data, planeIndex == 0 ? 1 : 2);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL fakeGetDisplayModePropertiesKHR(VkPhysicalDevice, VkDisplayKHR display, uint32_t* count, VkDisplayModePropertiesKHR* data)
+{
+	if(display == display1)
+		return enumerate(display1Modes, count, data);
+	else
+		return enumerate(display2Modes, count, data);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL fakeGetDisplayPlaneCapabilitiesKHR(VkPhysicalDevice, VkDisplayModeKHR, uint32_t, VkDisplayPlaneCapabilitiesKHR* capabilities)
+{
+	*capabilities = {};
+	capabilities->supportedAlpha = VK_DISPLAY_PLANE_ALPHA_GLOBAL_BIT_KHR | VK_DISPLAY_PLANE_ALPHA_OPAQUE_BIT_KHR;
+	return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL fakeCreateDisplayPlaneSurfaceKHR(VkInstance, const VkDisplaySurfaceCreateInfoKHR* createInfo, const VkAllocationCallbacks*, VkSurfaceKHR* surface)
+{
+	lastCreateInfo = *createInfo;
+	numSurfaces++;
+	*surface = VkSurfaceKHR(uintptr_t(0x40 + numSurfaces));
+	return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL fakeDestroySurfaceKHR(VkInstance, VkSurfaceKHR, const VkAllocationCallbacks*)
+{
+	numSurfaces--;
+}
+
+static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL fakeGetInstanceProcAddr(VkInstance, const char* name)
+{
+	struct { const char* name; PFN_vkVoidFunction func; } funcs[] = {
+		{ "vkEnumeratePhysicalDevices", PFN_vkVoidFunction(fakeEnumeratePhysicalDevices) },
+		{ "vkGetPhysicalDeviceDisplayPropertiesKHR", PFN_vkVoidFunction(fakeGetPhysicalDeviceDisplayPropertiesKHR) },
+		{ "vkGetPhysicalDeviceDisplayPlanePropertiesKHR", PFN_vkVoidFunction(fakeGetPhysicalDeviceDisplayPlanePropertiesKHR) },
+		{ "vkGetDisplayPlaneSupportedDisplaysKHR", PFN_vkVoidFunction(fakeGetDisplayPlaneSupportedDisplaysKHR) },
+		{ "vkGetDisplayModePropertiesKHR", PFN_vkVoidFunction(fakeGetDisplayModePropertiesKHR) },
+		{ "vkGetDisplayPlaneCapabilitiesKHR", PFN_vkVoidFunction(fakeGetDisplayPlaneCapabilitiesKHR) },
+		{ "vkCreateDisplayPlaneSurfaceKHR", PFN_vkVoidFunction(fakeCreateDisplayPlaneSurfaceKHR) },
+		{ "vkDestroySurfaceKHR", PFN_vkVoidFunction(fakeDestroySurfaceKHR) },
+	};
+	for(auto& f : funcs)
+		if(strcmp(f.name, name) == 0)
+			return f.func;
+	return nullptr;
+}
+
+
+static bool checkSurface(const VulkanWindow& window, uint32_t width, uint32_t height, VkDisplayModeKHR mode, uint32_t planeIndex)
+{
+	if(window.surfaceWidth() != width || window.surfaceHeight() != height) {
+		cout << " Failed.\n   Surface size is " << window.surfaceWidth() << "x" << window.surfaceHeight()
+		     << " instead of " << width << "x" << height << "." << endl;
+		return false;
+	}
+	if(lastCreateInfo.displayMode != mode || lastCreateInfo.planeIndex != planeIndex ||
+	   lastCreateInfo.planeStackIndex != planes[planeIndex].currentStackIndex ||
+	   lastCreateInfo.alphaMode != VK_DISPLAY_PLANE_ALPHA_OPAQUE_BIT_KHR ||
+	   lastCreateInfo.imageExtent.width != width || lastCreateInfo.imageExtent.height != height)
+	{
+		cout << " Failed.\n   Wrong VkDisplaySurfaceCreateInfoKHR content." << endl;
+		return false;
+	}
+	return true;
+}
+
+
+int main(int, char**)
+{
+	cout << appName << ":" << endl;
+	VkInstance instance = reinterpret_cast<VkInstance>(uintptr_t(0x1));
+
+	// catch exceptions
+	try {
+
+		// required extensions
+		cout << "Testing required instance extensions..." << flush;
+		const vector<const char*>& extensions = VulkanWindow::requiredExtensions();
+		if(extensions.size() != 2 || strcmp(extensions[0], "VK_KHR_surface") != 0 || strcmp(extensions[1], "VK_KHR_display") != 0) {
+			cout << " Failed.\n   VK_KHR_surface and VK_KHR_display are expected." << endl;
+			return 1;
+		}
+		cout << " Done." << endl;
+
+		// mode of requested size
+		cout << "Testing display mode of requested size..." << flush;
+		VulkanWindow window;
+		window.create(instance, 1280, 720, appName, fakeGetInstanceProcAddr);
+		if(!checkSurface(window, 1280, 720, display1Modes[2].displayMode, 0))
+			return 1;
+		cout << " Done." << endl;
+
+		// native mode
+		cout << "Testing native display mode..." << flush;
+		window.create(instance, 1000, 1000, appName, fakeGetInstanceProcAddr);
+		if(!checkSurface(window, 1920, 1080, display1Modes[1].displayMode, 0))
+			return 1;
+		if(numSurfaces != 1) {
+			cout << " Failed.\n   The surface of the previous create() call was not destroyed." << endl;
+			return 1;
+		}
+		cout << " Done." << endl;
+
+		// the other display
+		// (plane 0 is used by display 1, so plane 1 must be chosen)
+		cout << "Testing display and plane selection..." << flush;
+		VulkanWindow::setDisplayTarget(1);
+		window.create(instance, 0, 0, appName, fakeGetInstanceProcAddr);
+		if(!checkSurface(window, 800, 600, display2Modes[0].displayMode, 1))
+			return 1;
+		cout << " Done." << endl;
+
+		// outputs
+		cout << "Testing outputs..." << flush;
+		vector<VulkanWindow::Output> outputs = VulkanWindow::outputs();
+		if(outputs.size() != 2 || outputs[0].name != "Fake-1" || outputs[0].width != 1920 || outputs[0].height != 1080 ||
+		   outputs[0].refreshRate != 75. || outputs[1].name != "Fake-2" || outputs[1].refreshRate != 60.)
+		{
+			cout << " Failed.\n   Wrong outputs reported." << endl;
+			return 1;
+		}
+		vector<VulkanWindow::Output> windowOutputs = window.windowOutputs();
+		if(windowOutputs.size() != 1 || windowOutputs[0].name != "Fake-2") {
+			cout << " Failed.\n   Wrong window output reported." << endl;
+			return 1;
+		}
+		cout << " Done." << endl;
+
+		// main loop
+		cout << "Testing main loop..." << flush;
+		uint32_t resizeWidth = 0, resizeHeight = 0;
+		unsigned numFrames = 0;
+		window.setResizeCallback(
+			[&](VulkanWindow&, uint32_t& width, uint32_t& height) {
+				resizeWidth = width;
+				resizeHeight = height;
+			});
+		window.setFrameCallback(
+			[&](VulkanWindow& w) {
+				if(++numFrames == 3)
+					VulkanWindow::exitMainLoop();
+				else
+					w.scheduleFrame();
+			});
+		window.show();
+		if(window.windowState() != VulkanWindow::WindowState::FullScreen) {
+			cout << " Failed.\n   Shown window is not in FullScreen state." << endl;
+			return 1;
+		}
+		VulkanWindow::mainLoop();
+		if(numFrames != 3 || resizeWidth != 800 || resizeHeight != 600) {
+			cout << " Failed.\n   Rendered " << numFrames << " frames with resize to "
+			     << resizeWidth << "x" << resizeHeight << " instead of 3 frames with 800x600 resize." << endl;
+			return 1;
+		}
+		window.hide();
+		if(window.windowState() != VulkanWindow::WindowState::Hidden) {
+			cout << " Failed.\n   Hidden window is not in Hidden state." << endl;
+			return 1;
+		}
+		cout << " Done." << endl;
+
+		// destroy
+		cout << "Testing window destruction..." << flush;
+		window.destroy();
+		if(numSurfaces != 0) {
+			cout << " Failed.\n   The surface was not destroyed." << endl;
+			return 1;
+		}
+		VulkanWindow::finalize();
+		cout << " Done." << endl;
+
+	// catch exceptions
+	} catch(exception& e) {
+		cout << " Failed because of exception: " << e.what() << endl;
+		return 1;
+	} catch(...) {
+		cout << " Failed because of unspecified exception." << endl;
+		return 1;
+	}
+
+	cout << "All tests passed." << endl;
+	return 0;
+}
+
+#else
+
+int main(int, char**)
+{
+	cout << appName << ": Skipped. The test requires GUI_TYPE=Display." << endl;
+	return 0;
+}
+
+#endif
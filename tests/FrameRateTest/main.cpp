@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#include "VulkanWindow.h"
+#include <vulkan/vulkan.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// Frame rate test checks the frame rate limit and the idle throttling.
+// The frames are driven by VulkanWindow::mainLoop(); the frame callback does not render anything,
+// it only records the frame time and schedules the next frame. Each test phase runs the main loop
+// until the given number of frames is rendered and exitMainLoop() is called.
+// Frame times depend on the system load, so the tests check the frame ordering and the bounds
+// of the frame intervals with generous margins instead of exact means.
+
+
+// constants
+constexpr const char* appName = "FrameRateTest";
+constexpr double frameRateLimit = 20.;
+constexpr double idleTimeout = 0.2;
+constexpr double idleFrameRate = 5.;
+constexpr double minIntervalFactor = 0.5;  // single interval might be shortened after a late frame to keep the cadence
+constexpr double minMeanIntervalFactor = 0.9;
+constexpr double maxMeanIntervalFactor = 1.5;
+
+
+// window recording its frames
+class TestWindow : public VulkanWindow {
+public:
+	struct Frame {
+		double time;  // since the start of the test phase
+		bool idle;
+	};
+	vector<Frame> frames;
+	size_t numFramesToRender = 0;
+	chrono::steady_clock::time_point startTime;
+
+	TestWindow(VkInstance instance)
+	{
+		create(instance, 256, 256, appName);
+		setResizeCallback([](VulkanWindow&, uint32_t&, uint32_t&) {});  // no swapchain is created
+		setFrameCallback(
+			[this](VulkanWindow&) {
+				frames.push_back({ chrono::duration<double>(chrono::steady_clock::now() - startTime).count(), isIdle() });
+				scheduleFrame();
+				if(frames.size() >= numFramesToRender)
+					VulkanWindow::exitMainLoop();
+			});
+		setMouseMoveCallback([](VulkanWindow&, const MouseState&) {});
+	}
+
+	// run main loop until the given number of frames is rendered
+	// (frames keep being scheduled after the main loop exits, so the next phase continues the frame sequence)
+	const vector<Frame>& runFrames(size_t numFrames)
+	{
+		frames.clear();
+		numFramesToRender = numFrames;
+		startTime = chrono::steady_clock::now();
+		VulkanWindow::mainLoop();
+		return frames;
+	}
+
+	void dispatchMouseMove()  { callMouseMove(_mouseState); }
+	void setFocus(bool focused)  { updateFocus(focused); }
+};
+
+
+// check the intervals of the frames starting at the frame first
+// (frame times are increasing, no interval is much shorter than the requested one
+// and the mean interval is within the bounds)
+static bool checkIntervals(const vector<TestWindow::Frame>& frames, size_t first, double interval, const char* what)
+{
+	if(frames.size() - first < 2) {
+		cout << " Failed.\n   Not enough " << what << " frames." << endl;
+		return false;
+	}
+	for(size_t i=first+1; i<frames.size(); i++) {
+		double t = frames[i].time - frames[i-1].time;
+		if(t <= 0.) {
+			cout << " Failed.\n   Frame times of " << what << " frames are not increasing." << endl;
+			return false;
+		}
+		if(t < interval * minIntervalFactor) {
+			cout << " Failed.\n   Interval of " << what << " frame " << i << " is " << t * 1000.
+			     << "ms while the frame interval is " << interval * 1000. << "ms." << endl;
+			return false;
+		}
+	}
+	double meanInterval = (frames.back().time - frames[first].time) / double(frames.size() - first - 1);
+	if(meanInterval < interval * minMeanIntervalFactor || meanInterval > interval * maxMeanIntervalFactor) {
+		cout << " Failed.\n   Mean interval of " << what << " frames is " << meanInterval * 1000.
+		     << "ms instead of " << interval * 1000. << "ms." << endl;
+		return false;
+	}
+	return true;
+}
+
+
+static int runTests(VkInstance instance)
+{
+	TestWindow window(instance);
+	window.show();
+	window.scheduleFrame();
+
+	// frame rate limit
+	cout << "Testing frame rate limit..." << flush;
+	window.setFrameRateLimit(frameRateLimit);
+	window.runFrames(2);  // the first frames might be delayed by window mapping
+	if(!checkIntervals(window.runFrames(20), 0, 1. / frameRateLimit, "limited"))
+		return 1;
+	cout << " Done." << endl;
+
+	// idle throttling after timeout
+	cout << "Testing idle throttling..." << flush;
+	window.setIdleThrottling(idleTimeout, idleFrameRate);
+	const vector<TestWindow::Frame>& frames = window.runFrames(size_t(idleTimeout * frameRateLimit) + 6);
+	size_t firstIdle = 0;
+	while(firstIdle < frames.size() && !frames[firstIdle].idle)
+		firstIdle++;
+	if(firstIdle == 0 || firstIdle == frames.size()) {
+		cout << " Failed.\n   Window is " << (firstIdle == 0 ? "idle before" : "not idle after") << " the idle timeout." << endl;
+		return 1;
+	}
+	if(frames[firstIdle].time < idleTimeout * minMeanIntervalFactor) {
+		cout << " Failed.\n   Window became idle after " << frames[firstIdle].time << "s instead of " << idleTimeout << "s." << endl;
+		return 1;
+	}
+	if(!checkIntervals(frames, firstIdle, 1. / idleFrameRate, "idle"))
+		return 1;
+	cout << " Done." << endl;
+
+	// input brings the full frame rate back
+	// (the frame deferred by the idle throttling is rendered at the full frame rate cadence;
+	// only the frames before the next idle timeout are checked)
+	cout << "Testing return from idle state on input..." << flush;
+	window.dispatchMouseMove();
+	const vector<TestWindow::Frame>& activeFrames = window.runFrames(size_t(idleTimeout * frameRateLimit) - 1);
+	if(activeFrames.front().idle || activeFrames.front().time > (1. / frameRateLimit) * maxMeanIntervalFactor) {
+		cout << " Failed.\n   Window did not return to the full frame rate after input." << endl;
+		return 1;
+	}
+	if(!checkIntervals(activeFrames, 0, 1. / frameRateLimit, "active"))
+		return 1;
+	cout << " Done." << endl;
+
+	// focus
+	cout << "Testing idle state on focus loss..." << flush;
+	window.setFocus(false);
+	if(!window.runFrames(1).back().idle) {
+		cout << " Failed.\n   Window is not idle after focus loss." << endl;
+		return 1;
+	}
+	window.setFocus(true);
+	if(window.runFrames(1).back().idle) {
+		cout << " Failed.\n   Window is idle after focus gain." << endl;
+		return 1;
+	}
+	cout << " Done." << endl;
+
+	cout << "All tests passed." << endl;
+	return 0;
+}
+
+
+int main(int, char**)
+{
+	cout << appName << ":" << endl;
+	VkInstance instance = nullptr;
+	int r = 1;
+
+	// catch exceptions
+	try {
+
+		// init VulkanWindow
+		VulkanWindow::init();
+
+		// Vulkan instance
+		VkApplicationInfo appInfo{ VK_STRUCTURE_TYPE_APPLICATION_INFO, nullptr, appName, 0, nullptr, 0, VK_API_VERSION_1_0 };
+		VkInstanceCreateInfo createInfo{
+			VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO, nullptr, 0, &appInfo, 0, nullptr,
+			VulkanWindow::requiredExtensionCount(), VulkanWindow::requiredExtensionNames() };
+		if(vkCreateInstance(&createInfo, nullptr, &instance) != VK_SUCCESS)
+			throw runtime_error("vkCreateInstance() failed.");
+
+		r = runTests(instance);
+
+	// catch exceptions
+	} catch(exception& e) {
+		cout << "Failed because of exception: " << e.what() << endl;
+	} catch(...) {
+		cout << "Failed because of exception." << endl;
+	}
+
+	// finalize VulkanWindow before the instance is destroyed
+	// (see the libXext workaround in the other tests)
+	VulkanWindow::finalize();
+	if(instance)
+		vkDestroyInstance(instance, nullptr);
+	return r;
+}
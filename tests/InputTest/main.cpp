@@ -3,8 +3,10 @@
 // SPDX-License-Identifier: MIT-0
 
 #include "VulkanWindow.h"
+#include "VulkanWindowRecorder.h"
 #include <vulkan/vulkan.hpp>
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #ifdef _WIN32
 # define WIN32_LEAN_AND_MEAN  // reduce amount of included files by windows.h
@@ -41,6 +43,11 @@ public:
 	// This is required especially by Wayland.
 	VulkanWindow window;
 
+	// input recording
+	// (recorder is destroyed before the window; it is enabled by --record <file> command line option)
+	string recordFileName;
+	VulkanWindowRecorder recorder;
+
 	// Vulkan variables, handles and objects
 	// (they need to be destructed in non-arbitrary order in the destructor)
 	vk::PhysicalDevice physicalDevice;
@@ -66,6 +73,10 @@ public:
 /// Construct application object
 App::App(int argc, char** argv)
 {
+	// process command-line arguments
+	for(int i=1; i<argc; i++)
+		if(strcmp(argv[i], "--record") == 0 && i+1 < argc)
+			recordFileName = argv[++i];
 }
 
 
@@ -716,8 +727,11 @@ int main(int argc, char* argv[])
 		app.window.setMouseButtonCallback(bind(&App::mouseButton, &app, placeholders::_1, placeholders::_2, placeholders::_3, placeholders::_4));
 		app.window.setMouseWheelCallback(bind(&App::mouseWheel, &app, placeholders::_1, placeholders::_2, placeholders::_3, placeholders::_4));
 		app.window.setKeyCallback(bind(&App::key, &app, placeholders::_1, placeholders::_2, placeholders::_3, placeholders::_4));
+		if(!app.recordFileName.empty())
+			app.recorder.start(app.window, app.recordFileName);
 		app.window.show();
 		app.window.mainLoop();
+		app.recorder.stop();
 
 	// catch exceptions
 	} catch(vk::Error& e) {
@@ -3,10 +3,13 @@
 // SPDX-License-Identifier: MIT-0
 
 #include "VulkanWindow.h"
+#include "VulkanWindowPipeline.h"
 #include <vulkan/vulkan.hpp>
 #include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 
@@ -31,7 +34,6 @@ public:
 	vector<vk::ImageView> swapchainImageViews;
 	vector<vk::Framebuffer> framebuffers;
 	vector<vk::Semaphore> renderingFinishedSemaphores;
-	vk::Pipeline pipeline;
 	vk::Device device;
 
 	Window(vk::Instance instance, uint32_t width, uint32_t height, const char* title = "Vulkan window")
@@ -47,8 +49,6 @@ public:
 		swapchainImageViews = move(other.swapchainImageViews);
 		framebuffers = move(other.framebuffers);
 		renderingFinishedSemaphores = move(other.renderingFinishedSemaphores);
-		pipeline = other.pipeline;
-		other.pipeline = nullptr;
 		device = other.device;
 	}
 	~Window()  { destroyMembers(); }
@@ -61,8 +61,6 @@ public:
 		swapchainImageViews = move(rhs.swapchainImageViews);
 		framebuffers = move(rhs.framebuffers);
 		renderingFinishedSemaphores = move(rhs.renderingFinishedSemaphores);
-		pipeline = rhs.pipeline;
-		rhs.pipeline = nullptr;
 		device = rhs.device;
 		return *this;
 	}
@@ -83,8 +81,6 @@ void Window::destroyMembers() noexcept
 	vkDeviceWaitIdle(device);
 
 	// destroy resources
-	device.destroy(pipeline);
-	pipeline = nullptr;
 	for(auto s : renderingFinishedSemaphores)  device.destroy(s);
 	for(auto f : framebuffers)  device.destroy(f);
 	for(auto v : swapchainImageViews)  device.destroy(v);
@@ -106,6 +102,8 @@ public:
 	void init();
 	void resize(VulkanWindow& window, uint32_t& widthToBeSet, uint32_t& heightToBeSet);
 	void frame(VulkanWindow& window);
+	void windowThreadMain();
+	static void setInputThreadChecks(VulkanWindow& window);
 
 	// Vulkan instance must be destructed as the last Vulkan handle.
 	// It is probably good idea to destroy it after the display connection.
@@ -132,6 +130,8 @@ public:
 	vk::ShaderModule vsModule;
 	vk::ShaderModule fsModule;
 	vk::PipelineLayout pipelineLayout;
+	VulkanWindowPipelineCache pipelineCache;
+	vk::Pipeline pipeline;
 
 	enum class FrameUpdateMode { OnDemand, Continuous, MaxFrameRate };
 	FrameUpdateMode frameUpdateMode = FrameUpdateMode::Continuous;
@@ -139,6 +139,12 @@ public:
 	size_t fpsNumFrames = ~size_t(0);
 	chrono::high_resolution_clock::time_point fpsStartTime;
 
+	// window thread
+	// (with --threads, one more window is created and serviced by its own thread;
+	// rendering resources are shared, so resize and frame callbacks are serialized by renderMutex)
+	bool useWindowThread = false;
+	recursive_mutex renderMutex;
+
 };
 
 
@@ -153,6 +159,8 @@ App::App(int argc, char** argv)
 			frameUpdateMode = FrameUpdateMode::Continuous;
 		else if(strcmp(argv[i], "--max-frame-rate") == 0)
 			frameUpdateMode = FrameUpdateMode::MaxFrameRate;
+		else if(strcmp(argv[i], "--threads") == 0)
+			useWindowThread = true;
 		else {
 			if(strcmp(argv[i], "--help") != 0 && strcmp(argv[i], "-h") != 0)
 				cout << "Unrecognized option: " << argv[i] << endl;
@@ -163,7 +171,10 @@ App::App(int argc, char** argv)
 			        "   --continuous:  constantly update window content using\n"
 			        "                  screen refresh rate, this is the default\n"
 			        "   --max-frame-rate:  ignore screen refresh rate, update\n"
-			        "                      window content as often as possible\n" << endl;
+			        "                      window content as often as possible\n"
+			        "   --threads:     create one more window on its own thread\n"
+			        "                  and check that its events, including input,\n"
+			        "                  are delivered to that thread\n" << endl;
 			exit(99);
 		}
 }
@@ -184,6 +195,8 @@ App::~App()
 	// destroy handles
 	// (the handles are destructed in certain (not arbitrary) order)
 	if(device) {
+		device.destroy(pipeline);
+		pipelineCache.cleanUp();
 		device.destroy(pipelineLayout);
 		device.destroy(fsModule);
 		device.destroy(vsModule);
@@ -531,14 +544,32 @@ void App::init()
 				nullptr  // pPushConstantRanges
 			}
 		);
+
+	// pipeline cache
+	// (it is stored on disk to speed up the next application start)
+	pipelineCache.init(physicalDevice, device, string(appName) + ".pipelineCache");
+
+	// pipeline
+	// (viewport and scissor are dynamic, so the pipeline is not recreated on resize)
+	pipeline =
+		VulkanWindowPipeline::createSimple(
+			device,  // device
+			pipelineCache.get(),  // pipelineCache
+			pipelineLayout,  // pipelineLayout
+			renderPass,  // renderPass
+			vsModule,  // vsModule
+			fsModule,  // fsModule
+			vk::PrimitiveTopology::eTriangleList  // topology
+		);
 }
 
 
-/** Recreate swapchain and pipeline callback.
+/** Recreate swapchain callback.
  *  The function is usually called after the window resize and on the application start. */
 void App::resize(VulkanWindow& w, uint32_t& widthToBeSet, uint32_t& heightToBeSet)
 {
 	Window& window = static_cast<Window&>(w);
+	lock_guard<recursive_mutex> lock(renderMutex);
 
 	// make sure that we finished all the rendering
 	// (this is necessary for swapchain re-creation)
@@ -581,8 +612,6 @@ void App::resize(VulkanWindow& w, uint32_t& widthToBeSet, uint32_t& heightToBeSe
 	window.swapchainImageViews.clear();
 	for(auto f : window.framebuffers)  device.destroy(f);
 	window.framebuffers.clear();
-	device.destroy(window.pipeline);
-	window.pipeline = nullptr;
 
 	// print info
 	cout << "Recreating swapchain (extent: " << newSurfaceExtent.width << "x" << newSurfaceExtent.height
@@ -686,130 +715,13 @@ void App::resize(VulkanWindow& w, uint32_t& widthToBeSet, uint32_t& heightToBeSe
 			window.renderingFinishedSemaphores.emplace_back(
 				device.createSemaphore(semaphoreCreateInfo));
 	}
-
-	// pipeline
-	window.pipeline =
-		device.createGraphicsPipeline(
-			nullptr,  // pipelineCache
-			vk::GraphicsPipelineCreateInfo(
-				vk::PipelineCreateFlags(),  // flags
-
-				// shader stages
-				2,  // stageCount
-				array{  // pStages
-					vk::PipelineShaderStageCreateInfo{
-						vk::PipelineShaderStageCreateFlags(),  // flags
-						vk::ShaderStageFlagBits::eVertex,  // stage
-						vsModule,  // module
-						"main",  // pName
-						nullptr  // pSpecializationInfo
-					},
-					vk::PipelineShaderStageCreateInfo{
-						vk::PipelineShaderStageCreateFlags(),  // flags
-						vk::ShaderStageFlagBits::eFragment,  // stage
-						fsModule,  // module
-						"main",  // pName
-						nullptr  // pSpecializationInfo
-					},
-				}.data(),
-
-				// vertex input
-				&(const vk::PipelineVertexInputStateCreateInfo&)vk::PipelineVertexInputStateCreateInfo{  // pVertexInputState
-					vk::PipelineVertexInputStateCreateFlags(),  // flags
-					0,        // vertexBindingDescriptionCount
-					nullptr,  // pVertexBindingDescriptions
-					0,        // vertexAttributeDescriptionCount
-					nullptr   // pVertexAttributeDescriptions
-				},
-
-				// input assembly
-				&(const vk::PipelineInputAssemblyStateCreateInfo&)vk::PipelineInputAssemblyStateCreateInfo{  // pInputAssemblyState
-					vk::PipelineInputAssemblyStateCreateFlags(),  // flags
-					vk::PrimitiveTopology::eTriangleList,  // topology
-					VK_FALSE  // primitiveRestartEnable
-				},
-
-				// tessellation
-				nullptr, // pTessellationState
-
-				// viewport
-				&(const vk::PipelineViewportStateCreateInfo&)vk::PipelineViewportStateCreateInfo{  // pViewportState
-					vk::PipelineViewportStateCreateFlags(),  // flags
-					1,  // viewportCount
-					array{  // pViewports
-						vk::Viewport(0.f, 0.f, float(newSurfaceExtent.width), float(newSurfaceExtent.height), 0.f, 1.f),
-					}.data(),
-					1,  // scissorCount
-					array{  // pScissors
-						vk::Rect2D(vk::Offset2D(0,0), newSurfaceExtent)
-					}.data(),
-				},
-
-				// rasterization
-				&(const vk::PipelineRasterizationStateCreateInfo&)vk::PipelineRasterizationStateCreateInfo{  // pRasterizationState
-					vk::PipelineRasterizationStateCreateFlags(),  // flags
-					VK_FALSE,  // depthClampEnable
-					VK_FALSE,  // rasterizerDiscardEnable
-					vk::PolygonMode::eFill,  // polygonMode
-					vk::CullModeFlagBits::eNone,  // cullMode
-					vk::FrontFace::eCounterClockwise,  // frontFace
-					VK_FALSE,  // depthBiasEnable
-					0.f,  // depthBiasConstantFactor
-					0.f,  // depthBiasClamp
-					0.f,  // depthBiasSlopeFactor
-					1.f   // lineWidth
-				},
-
-				// multisampling
-				&(const vk::PipelineMultisampleStateCreateInfo&)vk::PipelineMultisampleStateCreateInfo{  // pMultisampleState
-					vk::PipelineMultisampleStateCreateFlags(),  // flags
-					vk::SampleCountFlagBits::e1,  // rasterizationSamples
-					VK_FALSE,  // sampleShadingEnable
-					0.f,       // minSampleShading
-					nullptr,   // pSampleMask
-					VK_FALSE,  // alphaToCoverageEnable
-					VK_FALSE   // alphaToOneEnable
-				},
-
-				// depth and stencil
-				nullptr,  // pDepthStencilState
-
-				// blending
-				&(const vk::PipelineColorBlendStateCreateInfo&)vk::PipelineColorBlendStateCreateInfo{  // pColorBlendState
-					vk::PipelineColorBlendStateCreateFlags(),  // flags
-					VK_FALSE,  // logicOpEnable
-					vk::LogicOp::eClear,  // logicOp
-					1,  // attachmentCount
-					array{  // pAttachments
-						vk::PipelineColorBlendAttachmentState{
-							VK_FALSE,  // blendEnable
-							vk::BlendFactor::eZero,  // srcColorBlendFactor
-							vk::BlendFactor::eZero,  // dstColorBlendFactor
-							vk::BlendOp::eAdd,       // colorBlendOp
-							vk::BlendFactor::eZero,  // srcAlphaBlendFactor
-							vk::BlendFactor::eZero,  // dstAlphaBlendFactor
-							vk::BlendOp::eAdd,       // alphaBlendOp
-							vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
-								vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA  // colorWriteMask
-						},
-					}.data(),
-					array<float,4>{0.f,0.f,0.f,0.f}  // blendConstants
-				},
-
-				nullptr,  // pDynamicState
-				pipelineLayout,  // layout
-				renderPass,  // renderPass
-				0,  // subpass
-				vk::Pipeline(nullptr),  // basePipelineHandle
-				-1 // basePipelineIndex
-			)
-		).value;
 }
 
 
 void App::frame(VulkanWindow& w)
 {
 	Window& window = static_cast<Window&>(w);
+	lock_guard<recursive_mutex> lock(renderMutex);
 	cout << "x" << flush;
 
 	// wait for previous frame rendering work
@@ -888,7 +800,9 @@ void App::frame(VulkanWindow& w)
 	);
 
 	// rendering commands
-	commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, window.pipeline);  // bind pipeline
+	commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);  // bind pipeline
+	VulkanWindowPipeline::setViewportAndScissor(  // set dynamic viewport and scissor
+		commandBuffer, vk::Extent2D(window.surfaceWidth(), window.surfaceHeight()));
 	commandBuffer.draw(  // draw single triangle
 		3,  // vertexCount
 		1,  // instanceCount
@@ -942,6 +856,64 @@ void App::frame(VulkanWindow& w)
 }
 
 
+/** Install input callbacks that check that the events are delivered
+ *  to the thread that created the window. */
+void App::setInputThreadChecks(VulkanWindow& window)
+{
+	thread::id threadId = this_thread::get_id();
+	window.setMouseButtonCallback(
+		[threadId](VulkanWindow&, VulkanWindow::MouseButton::EnumType, VulkanWindow::ButtonState, const VulkanWindow::MouseState&) {
+			if(this_thread::get_id() != threadId)
+				throw runtime_error("Mouse button event was not delivered to the thread owning the window.");
+			cout << "Mouse button event delivered to the owning thread." << endl;
+		});
+	window.setKeyCallback(
+		[threadId](VulkanWindow&, VulkanWindow::KeyState, VulkanWindow::ScanCode, VulkanWindow::KeyCode) {
+			if(this_thread::get_id() != threadId)
+				throw runtime_error("Key event was not delivered to the thread owning the window.");
+			cout << "Key event delivered to the owning thread." << endl;
+		});
+}
+
+
+/** Window thread.
+ *  It creates its own window, runs its own main loop
+ *  and leaves when the window is closed. */
+void App::windowThreadMain()
+{
+	try {
+
+		VulkanWindow::initThread();
+		{
+			unique_lock<recursive_mutex> destroyLock(renderMutex, defer_lock);
+			Window window(instance, 400, 300, "MultiWindowTest - window thread");
+			window.device = device;
+			if(!physicalDevice.getSurfaceSupportKHR(presentationQueueFamily, window.surface()))
+				throw runtime_error("Presentation is not supported on the window created by the window thread.");
+			window.setResizeCallback(
+				bind(&App::resize, this, placeholders::_1, placeholders::_2, placeholders::_3));
+			window.setFrameCallback(
+				bind(&App::frame, this, placeholders::_1));
+			window.setCloseCallback(
+				[](VulkanWindow&) { VulkanWindow::exitMainLoop(); });
+			setInputThreadChecks(window);
+			window.show();
+			VulkanWindow::mainLoop();
+			destroyLock.lock();  // window destructor waits for device idle, so it must not run concurrently with the rendering
+		}
+		VulkanWindow::finalizeThread();
+
+	// catch exceptions
+	} catch(vk::Error& e) {
+		cout << "Window thread failed because of Vulkan exception: " << e.what() << endl;
+		VulkanWindow::finalizeThread();
+	} catch(exception& e) {
+		cout << "Window thread failed because of exception: " << e.what() << endl;
+		VulkanWindow::finalizeThread();
+	}
+}
+
+
 int main(int argc, char* argv[])
 {
 	// catch exceptions
@@ -967,6 +939,7 @@ int main(int argc, char* argv[])
 			w.setCloseCallback(
 				bind(
 					[](VulkanWindow& window, App& app){
+						lock_guard<recursive_mutex> lock(app.renderMutex);  // window destruction must not run concurrently with the window thread rendering
 #if 0
 						window.hide();
 						for(Window& w : app.windowList)
@@ -1031,6 +1004,10 @@ int main(int argc, char* argv[])
 				)
 			);
 
+			// input callbacks checking the delivering thread
+			if(app.useWindowThread)
+				App::setInputThreadChecks(w);
+
 			// test of hide()/show()/isVisible()
 			w.show();
 #if 1
@@ -1045,8 +1022,22 @@ int main(int argc, char* argv[])
 #endif
 		}
 
+		// window thread
+		thread windowThread;
+		if(app.useWindowThread)
+			windowThread = thread(&App::windowThreadMain, &app);
+
 		// main loop
-		VulkanWindow::mainLoop();
+		// (the window thread finishes when its window is closed)
+		try {
+			VulkanWindow::mainLoop();
+		} catch(...) {
+			if(windowThread.joinable())
+				windowThread.join();
+			throw;
+		}
+		if(windowThread.joinable())
+			windowThread.join();
 
 	// catch exceptions
 	} catch(vk::Error& e) {
@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#include "VulkanWindow.h"
+#include "VulkanWindowRecorder.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Replay test records a synthetic event sequence and verifies that its replay
+// delivers the same events to the callbacks. No window is created, so it runs headless.
+// When a recording is given on the command line, for example one made by "InputTest --record session.rec",
+// it is replayed through the callbacks and the replay time is reported:
+//    ReplayTest session.rec [--original-speed]
+
+
+// constants
+constexpr const char* appName = "ReplayTest";
+constexpr const char* tmpFileName = "ReplayTest.rec";
+
+
+// event log
+static vector<string> eventLog;
+
+static string toString(const VulkanWindow::MouseState& s)
+{
+	stringstream ss;
+	ss << s.posX << ',' << s.posY << ',' << s.relX << ',' << s.relY << ',' << s.buttons << ',' << s.modifiers;
+	return ss.str();
+}
+
+static void setLoggingCallbacks(VulkanWindow& window)
+{
+	window.setFrameCallback(
+		[](VulkanWindow&) { eventLog.emplace_back("frame"); });
+	window.setResizeCallback(
+		[](VulkanWindow&, uint32_t& width, uint32_t& height) {
+			eventLog.emplace_back("resize " + to_string(width) + "x" + to_string(height));
+		});
+	window.setCloseCallback(
+		[](VulkanWindow&) { eventLog.emplace_back("close"); });
+	window.setWindowStateChangedCallback(
+		[](VulkanWindow&, VulkanWindow::WindowState windowState) {
+			eventLog.emplace_back("state " + to_string(int(windowState)));
+		});
+	window.setMouseMoveCallback(
+		[](VulkanWindow&, const VulkanWindow::MouseState& s) {
+			eventLog.emplace_back("move " + toString(s));
+		});
+	window.setMouseButtonCallback(
+		[](VulkanWindow&, VulkanWindow::MouseButton::EnumType button, VulkanWindow::ButtonState buttonState,
+		   const VulkanWindow::MouseState& s)
+		{
+			eventLog.emplace_back("button " + to_string(button) + " " + to_string(int(buttonState)) + " " + toString(s));
+		});
+	window.setMouseWheelCallback(
+		[](VulkanWindow&, float wheelX, float wheelY, const VulkanWindow::MouseState& s) {
+			eventLog.emplace_back("wheel " + to_string(wheelX) + " " + to_string(wheelY) + " " + toString(s));
+		});
+	window.setKeyCallback(
+		[](VulkanWindow&, VulkanWindow::KeyState keyState, VulkanWindow::ScanCode scanCode, VulkanWindow::KeyCode key) {
+			eventLog.emplace_back("key " + to_string(int(keyState)) + " " + to_string(int(scanCode)) + " " + to_string(uint32_t(key)));
+		});
+}
+
+
+static int replayFile(const char* fileName, VulkanWindowReplayer::Speed speed)
+{
+	VulkanWindowReplayer replayer;
+	replayer.load(fileName);
+	cout << "Replaying " << replayer.numEvents() << " events of " << replayer.duration() << "s long recording..." << flush;
+
+	VulkanWindow window;
+	setLoggingCallbacks(window);
+	auto t1 = chrono::steady_clock::now();
+	replayer.replay(window, speed);
+	auto t2 = chrono::steady_clock::now();
+	cout << " Done.\n"
+	        "   Replay time: " << chrono::duration<double>(t2 - t1).count() << "s" << endl;
+	return 0;
+}
+
+
+int main(int argc, char* argv[])
+{
+	// catch exceptions
+	try {
+
+		cout << appName << ":" << endl;
+
+		// replay given file
+		if(argc >= 2)
+			return replayFile(argv[1],
+				(argc >= 3 && strcmp(argv[2], "--original-speed") == 0)
+					? VulkanWindowReplayer::Speed::Original : VulkanWindowReplayer::Speed::Maximum);
+
+		// record synthetic events
+		// (the recorder is called the same way as the window calls its listener)
+		cout << "Recording synthetic events..." << flush;
+		VulkanWindow window;
+		setLoggingCallbacks(window);
+		VulkanWindowRecorder recorder;
+		recorder.start(window, tmpFileName);
+		if(window.listener() != &recorder)
+			throw runtime_error("Recorder is not installed as window listener.");
+		uint32_t width = 640, height = 480;
+		recorder.onResize(window, width, height);
+		recorder.onWindowStateChanged(window, VulkanWindow::WindowState::Normal);
+		VulkanWindow::MouseState s = { 10.f, 20.f, 1.f, -2.f, 0, 0 };
+		for(int i=0; i<100; i++) {
+			recorder.onFrame(window);
+			s.posX += 1.f;
+			recorder.onMouseMove(window, s);
+		}
+		s.buttons.set(VulkanWindow::MouseButton::Left);
+		recorder.onMouseButton(window, VulkanWindow::MouseButton::Left, VulkanWindow::ButtonState::Pressed, s);
+		recorder.onMouseWheel(window, 0.f, -1.5f, s);
+		s.modifiers.set(VulkanWindow::Modifier::Shift);
+		recorder.onKey(window, VulkanWindow::KeyState::Pressed, VulkanWindow::ScanCode::A, VulkanWindow::KeyCode('A'));
+		recorder.onKey(window, VulkanWindow::KeyState::Released, VulkanWindow::ScanCode::A, VulkanWindow::KeyCode('A'));
+		recorder.onClose(window);
+		recorder.stop();
+		if(window.listener() != nullptr)
+			throw runtime_error("Recorder did not restore window listener.");
+		vector<string> recordedLog;
+		recordedLog.swap(eventLog);
+		cout << " Done." << endl;
+
+		// replay
+		cout << "Replaying events..." << flush;
+		VulkanWindowReplayer replayer;
+		replayer.load(tmpFileName);
+		if(replayer.numEvents() != recorder.numEvents())
+			throw runtime_error("Number of loaded events does not match.");
+		VulkanWindow replayWindow;
+		setLoggingCallbacks(replayWindow);
+		replayWindow.setInputStateTracking(true);
+		replayer.replay(replayWindow);
+		if(eventLog != recordedLog)
+			throw runtime_error("Replayed events differ from the recorded ones.");
+		if(replayWindow.surfaceWidth() != 640 || replayWindow.surfaceHeight() != 480)
+			throw runtime_error("Surface size was not replayed.");
+		cout << " Done." << endl;
+
+		// polled input state
+		cout << "Testing polled input state..." << flush;
+		const VulkanWindow::InputState& inputState = replayWindow.inputState();
+		if(!inputState.isButtonPressed(VulkanWindow::MouseButton::Left) || inputState.isKeyPressed(VulkanWindow::ScanCode::A))
+			throw runtime_error("Input state does not match the replayed events.");
+		if(inputState.posX != 110.f || inputState.wheelY != -1.5f)
+			throw runtime_error("Mouse position or wheel were not tracked.");
+		const VulkanWindow::InputState& snapshot = replayWindow.snapshot();
+		if(snapshot.posX != 109.f || snapshot.relX != 1.f)
+			throw runtime_error("Input snapshot was not taken at the frame start.");
+		cout << " Done." << endl;
+
+		// event queue
+		cout << "Testing event queue..." << flush;
+		VulkanWindow queueWindow;
+		setLoggingCallbacks(queueWindow);
+		queueWindow.setEventQueueEnabled(true);
+		replayer.replay(queueWindow);
+		VulkanWindow::Event events[64];
+		size_t numEvents = 0;
+		size_t numMouseMoves = 0;
+		VulkanWindow::Event lastEvent = {};
+		while(size_t n = queueWindow.pollEvents(events, size(events))) {
+			for(size_t i=0; i<n; i++)
+				if(events[i].type == VulkanWindow::Event::Type::MouseMove)
+					numMouseMoves++;
+			numEvents += n;
+			lastEvent = events[n-1];
+		}
+		if(numEvents != replayer.numEvents() - 100 || numMouseMoves != 100)  // frames are not queued
+			throw runtime_error("Number of queued events does not match.");
+		if(lastEvent.type != VulkanWindow::Event::Type::Close || queueWindow.numQueuedEvents() != 0)
+			throw runtime_error("Event queue content is wrong.");
+		cout << " Done." << endl;
+
+		// event queue limit
+		cout << "Testing event queue limit..." << flush;
+		while(queueWindow.numQueuedEvents() < VulkanWindow::maxQueuedEvents)
+			replayer.replay(queueWindow);
+		replayer.replay(queueWindow);
+		if(queueWindow.numQueuedEvents() != VulkanWindow::maxQueuedEvents)
+			throw runtime_error("Event queue grew over its limit.");
+		numEvents = 0;
+		while(size_t n = queueWindow.pollEvents(events, size(events))) {
+			numEvents += n;
+			lastEvent = events[n-1];
+		}
+		if(numEvents != VulkanWindow::maxQueuedEvents || lastEvent.type != VulkanWindow::Event::Type::Close)
+			throw runtime_error("Full event queue did not keep the newest events.");
+		cout << " Done." << endl;
+		remove(tmpFileName);
+
+	// catch exceptions
+	} catch(exception& e) {
+		cout << " Failed because of exception: " << e.what() << endl;
+		remove(tmpFileName);
+		return 1;
+	} catch(...) {
+		cout << " Failed because of unspecified exception." << endl;
+		remove(tmpFileName);
+		return 1;
+	}
+
+	cout << "All tests passed." << endl;
+	return 0;
+}
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#include "VulkanWindow.h"
+#include <vulkan/vulkan.hpp>
+#include <iostream>
+
+using namespace std;
+
+
+// constants
+constexpr const char* appName = "RoundTripTest";
+
+// round trip budgets
+constexpr size_t createBudget = 0;
+constexpr size_t showBudget = 1;  // Xlib reads WM_STATE property after the window is mapped
+constexpr size_t setWindowStateBudget = 1;  // Wayland waits for the compositor to process the request
+constexpr size_t steadyStateBudget = 0;
+constexpr size_t showFrameCount = 10;  // frames still considered part of show()
+constexpr size_t steadyStateFrameCount = 100;
+
+
+static void checkBudget(const char* operation, size_t roundTrips, size_t budget)
+{
+	cout << "   " << operation << ": " << roundTrips << " round trip(s), budget: " << budget << endl;
+	if(roundTrips > budget)
+		throw runtime_error(string("Round trip budget exceeded in ") + operation + ".");
+}
+
+
+int main(int, char*[])
+{
+	// catch exceptions
+	// (vulkan.hpp functions throw if they fail)
+	try {
+
+		// init VulkanWindow
+		VulkanWindow::init();
+
+		// Vulkan instance
+		// (only the instance is needed to create the window surface;
+		// the test does not render anything, so no device or swapchain is created)
+		vk::Instance instance =
+			vk::createInstance(
+				vk::InstanceCreateInfo{
+					vk::InstanceCreateFlags(),  // flags
+					&(const vk::ApplicationInfo&)vk::ApplicationInfo{
+						appName,                 // application name
+						VK_MAKE_VERSION(0,0,0),  // application version
+						nullptr,                 // engine name
+						VK_MAKE_VERSION(0,0,0),  // engine version
+						VK_API_VERSION_1_0,      // api version
+					},
+					0, nullptr,  // no layers
+					VulkanWindow::requiredExtensionCount(),  // enabled extension count
+					VulkanWindow::requiredExtensionNames(),  // enabled extension names
+				}
+			);
+
+		{
+			cout << "Round trips made by VulkanWindow::init(): " << VulkanWindow::globalRoundTripCount() << endl;
+			cout << "Testing round trips:" << endl;
+
+			// create()
+			VulkanWindow window;
+			size_t globalMark = VulkanWindow::globalRoundTripCount();
+			window.create(instance, 1024, 768, appName);
+			checkBudget("create()", VulkanWindow::globalRoundTripCount() - globalMark, createBudget);
+
+			// placeholder content
+			// (nothing is presented, so the placeholder keeps the window mapped on Wayland
+			// and frame callbacks keep coming)
+			window.setPlaceholderColor(0.0f, 0.5f, 1.0f);
+
+			// callbacks
+			size_t frameNumber = 0;
+			size_t roundTripMark = window.roundTripCount();
+			window.setResizeCallback(
+				[](VulkanWindow&, uint32_t&, uint32_t&) {
+				}
+			);
+			window.setFrameCallback(
+				[&frameNumber, &roundTripMark](VulkanWindow& window) {
+
+					frameNumber++;
+
+					if(frameNumber == showFrameCount) {
+
+						// show() and first frames
+						checkBudget("show()", window.roundTripCount() - roundTripMark, showBudget);
+
+						// setWindowState()
+						roundTripMark = window.roundTripCount();
+						window.setWindowState(VulkanWindow::WindowState::Normal);
+						checkBudget("setWindowState()", window.roundTripCount() - roundTripMark, setWindowStateBudget);
+
+						// windowOutputs()
+						roundTripMark = window.roundTripCount();
+						window.windowOutputs();
+						cout << "   windowOutputs(): " << window.roundTripCount() - roundTripMark << " round trip(s)" << endl;
+						roundTripMark = window.roundTripCount();
+
+					}
+					else if(frameNumber == showFrameCount + steadyStateFrameCount) {
+
+						// steady-state frames
+						checkBudget("steady-state frames", window.roundTripCount() - roundTripMark, steadyStateBudget);
+						VulkanWindow::exitMainLoop();
+						return;
+
+					}
+
+					window.scheduleFrame();
+				}
+			);
+
+			// run main loop
+			window.show();
+			window.mainLoop();
+			cout << "Total round trips: " << VulkanWindow::globalRoundTripCount() << endl;
+			window.destroy();
+		}
+
+#if defined(USE_PLATFORM_XLIB)
+		// On Xlib, VulkanWindow::finalize() needs to be called before instance destroy to avoid crash.
+		// (see HelloWindow example for details)
+		VulkanWindow::finalize();
+#endif
+		instance.destroy();
+
+	// catch exceptions
+	} catch(vk::Error& e) {
+		cout << "Failed because of Vulkan exception: " << e.what() << endl;
+		VulkanWindow::finalize();
+		return 1;
+	} catch(exception& e) {
+		cout << "Failed because of exception: " << e.what() << endl;
+		VulkanWindow::finalize();
+		return 1;
+	} catch(...) {
+		cout << "Failed because of unspecified exception." << endl;
+		VulkanWindow::finalize();
+		return 1;
+	}
+
+	VulkanWindow::finalize();
+	cout << "All tests passed." << endl;
+	return 0;
+}
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#include "VulkanWindow.h"
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+// constants
+constexpr const char* appName = "SizeTest";
+
+// size budget of VulkanWindow object
+// (callbacks, title, mouse state, input state, event queue and output handles are counted by their real sizes as they differ among standard libraries;
+// the rest covers hot members, the platform union, frame limiter data, Vulkan handles and counters;
+// its size of 208 bytes was measured on x86-64 with GCC 12 and libstdc++; 32-bit builds are not checked)
+constexpr size_t otherMembersSize = 208;
+constexpr size_t sizeBudget =
+	9 * sizeof(function<void()>) +
+	sizeof(string) +
+	sizeof(VulkanWindow::MouseState) +
+	2 * sizeof(VulkanWindow::InputState) +
+	sizeof(vector<VulkanWindow::Event>) +
+	sizeof(vector<void*>) +
+	otherMembersSize;
+
+
+int main(int, char**)
+{
+	cout << appName << ":" << endl;
+	if(sizeof(void*) != 8) {
+		cout << "Size budget is defined for 64-bit builds only. Skipping the test." << endl;
+		return 0;
+	}
+	cout << "Testing sizeof(VulkanWindow) (" << sizeof(VulkanWindow)
+	     << " bytes, budget " << sizeBudget << " bytes)..." << flush;
+	if(sizeof(VulkanWindow) > sizeBudget) {
+		cout << " Failed.\n"
+		        "   VulkanWindow grew over its size budget. If the growth is intended,\n"
+		        "   update the budget and check the layout comments in VulkanWindow.h." << endl;
+		return 1;
+	}
+	cout << " Done." << endl;
+	cout << "All tests passed." << endl;
+	return 0;
+}
@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: 2026 PCJohn (Jan Pečiva, peciva@fit.vut.cz)
+//
+// SPDX-License-Identifier: MIT-0
+
+#include "VulkanWindow.h"
+#include <vulkan/vulkan.hpp>
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+// Startup benchmark measures the time from VulkanWindow::init() to the first frame callback.
+// Only the window is benchmarked, no device or swapchain is created;
+// the placeholder content makes the window visible before the first frame.
+// For reproducible numbers, run it on a headless server, for example:
+//    xvfb-run -a ./StartupBenchmark
+//    weston --backend=headless --socket=wayland-bench &  WAYLAND_DISPLAY=wayland-bench ./StartupBenchmark
+
+
+// constants
+constexpr const char* appName = "StartupBenchmark";
+
+
+// timing
+static chrono::steady_clock::time_point startTime;
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+
+int main(int, char*[])
+{
+	// catch exceptions
+	// (vulkan.hpp functions throw if they fail)
+	try {
+
+		// init VulkanWindow
+		startTime = chrono::steady_clock::now();
+		auto t = startTime;
+		VulkanWindow::init();
+		double initTime = secondsSince(t);
+
+		// Vulkan instance
+		t = chrono::steady_clock::now();
+		vk::Instance instance =
+			vk::createInstance(
+				vk::InstanceCreateInfo{
+					vk::InstanceCreateFlags(),  // flags
+					&(const vk::ApplicationInfo&)vk::ApplicationInfo{
+						appName,                 // application name
+						VK_MAKE_VERSION(0,0,0),  // application version
+						nullptr,                 // engine name
+						VK_MAKE_VERSION(0,0,0),  // engine version
+						VK_API_VERSION_1_0,      // api version
+					},
+					0, nullptr,  // no layers
+					VulkanWindow::requiredExtensionCount(),  // enabled extension count
+					VulkanWindow::requiredExtensionNames(),  // enabled extension names
+				}
+			);
+		double instanceTime = secondsSince(t);
+
+		{
+			// create window
+			VulkanWindow window;
+			t = chrono::steady_clock::now();
+			window.create(instance, 1024, 768, appName);
+			double createTime = secondsSince(t);
+			window.setPlaceholderColor(0.0f, 0.5f, 1.0f);
+
+			// callbacks
+			double firstResizeTime = 0.;  // since startTime
+			double firstFrameTime = 0.;  // since startTime
+			window.setResizeCallback(
+				[&firstResizeTime](VulkanWindow&, uint32_t&, uint32_t&) {
+					if(firstResizeTime == 0.)
+						firstResizeTime = secondsSince(startTime);
+				}
+			);
+			window.setFrameCallback(
+				[&firstFrameTime](VulkanWindow&) {
+					firstFrameTime = secondsSince(startTime);
+					VulkanWindow::exitMainLoop();
+				}
+			);
+
+			// show window and run main loop until the first frame
+			t = chrono::steady_clock::now();
+			window.show();
+			double showTime = secondsSince(t);
+			window.mainLoop();
+
+			// print results
+			// (cursor theme is loaded lazily on the first pointer enter,
+			// so it is usually not part of the startup)
+			const VulkanWindow::StartupTimes& st = VulkanWindow::startupTimes();
+			string cursorThemeLoad = (st.cursorThemeLoad == 0.)
+				? "N/A (lazy, loaded on the first pointer enter)"
+				: to_string(st.cursorThemeLoad * 1000.) + "ms";
+			cout << "Startup times:\n"
+			        "   VulkanWindow::init():      " << initTime * 1000. << "ms\n"
+			        "      display connection:     " << st.displayConnection * 1000. << "ms\n"
+			        "      registry round trips:   " << st.registryRoundTrips * 1000. << "ms\n"
+			        "      cursor theme load:      " << cursorThemeLoad << "\n"
+			        "      libdecor load:          " << st.libdecorLoad * 1000. << "ms\n"
+			        "   Vulkan instance:           " << instanceTime * 1000. << "ms\n"
+			        "   VulkanWindow::create():    " << createTime * 1000. << "ms\n"
+			        "      surface creation:       " << st.surfaceCreation * 1000. << "ms\n"
+			        "   VulkanWindow::show():      " << showTime * 1000. << "ms\n"
+			        "   first resize callback at:  " << firstResizeTime * 1000. << "ms\n"
+			        "   first frame callback at:   " << firstFrameTime * 1000. << "ms\n"
+			        "   round trips:               " << VulkanWindow::globalRoundTripCount() << endl;
+
+			window.destroy();
+		}
+
+#if defined(USE_PLATFORM_XLIB)
+		// On Xlib, VulkanWindow::finalize() needs to be called before instance destroy to avoid crash.
+		// (see HelloWindow example for details)
+		VulkanWindow::finalize();
+#endif
+		instance.destroy();
+
+	// catch exceptions
+	} catch(vk::Error& e) {
+		cout << "Failed because of Vulkan exception: " << e.what() << endl;
+	} catch(exception& e) {
+		cout << "Failed because of exception: " << e.what() << endl;
+	} catch(...) {
+		cout << "Failed because of unspecified exception." << endl;
+	}
+
+	VulkanWindow::finalize();
+	return 0;
+}
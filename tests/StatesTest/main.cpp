@@ -888,6 +888,19 @@ void App::key(VulkanWindow& w, VulkanWindow::KeyState keyState, VulkanWindow::Sc
 }
 
 
+static const char* toString(VulkanWindow::WindowState windowState)
+{
+	switch(windowState) {
+	case VulkanWindow::WindowState::Hidden:     return "hidden";
+	case VulkanWindow::WindowState::Minimized:  return "minimized";
+	case VulkanWindow::WindowState::Normal:     return "normal";
+	case VulkanWindow::WindowState::Maximized:  return "maximized";
+	case VulkanWindow::WindowState::FullScreen: return "full screen";
+	default: return "unknown";
+	}
+}
+
+
 int main(int argc, char* argv[])
 {
 	// catch exceptions
@@ -914,6 +927,12 @@ int main(int argc, char* argv[])
 			w.setCloseCallback(bind(&App::closeWindow, &app, placeholders::_1));
 		for(VulkanWindow& w : app.windowList)
 			w.setKeyCallback(bind(&App::key, &app, placeholders::_1, placeholders::_2, placeholders::_3, placeholders::_4));
+		for(size_t i=0,c=app.windowList.size(); i<c; i++)
+			app.windowList[i].setWindowStateChangedCallback(
+				[i](VulkanWindow& w, VulkanWindow::WindowState windowState) {
+					cout << "Window " << i << " state changed to " << toString(windowState) << endl;
+				}
+			);
 		app.windowList[1].showMinimized();
 		app.windowList[3].showMaximized();
 		app.windowList[2].showNormal();
@@ -925,15 +944,7 @@ int main(int argc, char* argv[])
 			cout << "Window " << i << ": ";
 			if(w.isVisible())  cout << "visible, ";
 			else  cout << "not visible, ";
-			switch(w.windowState()) {
-			case VulkanWindow::WindowState::Hidden:     cout << "hidden"; break;
-			case VulkanWindow::WindowState::Minimized:  cout << "minimized"; break;
-			case VulkanWindow::WindowState::Normal:     cout << "normal"; break;
-			case VulkanWindow::WindowState::Maximized:  cout << "maximized"; break;
-			case VulkanWindow::WindowState::FullScreen: cout << "full screen"; break;
-			default: cout << "unknown";
-			}
-			cout << endl;
+			cout << toString(w.windowState()) << endl;
 		}
 
 		app.windowList[0].mainLoop();